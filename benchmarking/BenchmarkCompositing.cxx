@@ -0,0 +1,144 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/Initialize.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/Compositor.h>
+
+#include <vtkm/thirdparty/diy/environment.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Hold configuration state (e.g. active device)
+vtkm::cont::InitializeResult Config;
+
+// Each rank composites this many images, so that a single process also swaps parts
+// of the images between blocks. Run with mpirun to composite across ranks.
+constexpr int ImagesPerRank = 4;
+
+void FillCanvas(vtkm::rendering::CanvasRayTracer& canvas, int image)
+{
+  const vtkm::Id numPixels = canvas.GetWidth() * canvas.GetHeight();
+  auto colors = canvas.GetColorBuffer().WritePortal();
+  auto depths = canvas.GetDepthBuffer().WritePortal();
+  for (vtkm::Id i = 0; i < numPixels; ++i)
+  {
+    const vtkm::Float32 alpha = 0.25f + 0.05f * static_cast<vtkm::Float32>((i + image) % 10);
+    colors.Set(i, vtkm::Vec4f_32(alpha * 0.5f, alpha * 0.25f, alpha, alpha));
+    depths.Set(i, static_cast<vtkm::Float32>((i * 31 + image * 17) % 101));
+  }
+}
+
+// Reports the pixels composited per second, counting the pixels of one image, and the
+// time of each composite.
+void BenchCompositing(::benchmark::State& state)
+{
+  const vtkm::Id width = state.range(0);
+  const vtkm::Id height = state.range(1);
+  const auto algorithm = state.range(2) ? vtkm::rendering::Compositor::Algorithm::RadixK
+                                        : vtkm::rendering::Compositor::Algorithm::BinarySwap;
+  const auto mode = state.range(3) ? vtkm::rendering::Compositor::CompositeMode::Blend
+                                   : vtkm::rendering::Compositor::CompositeMode::ZBuffer;
+  const auto& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+
+  std::vector<vtkm::rendering::CanvasRayTracer> canvases;
+  for (int i = 0; i < ImagesPerRank; ++i)
+  {
+    canvases.emplace_back(width, height);
+    FillCanvas(canvases.back(), comm.rank() * ImagesPerRank + i);
+  }
+  vtkm::rendering::CanvasRayTracer result(width, height);
+
+  vtkm::rendering::Compositor compositor;
+  compositor.SetAlgorithm(algorithm);
+  compositor.SetCompositeMode(mode);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  vtkm::Float64 totalTime = 0.;
+  for (auto _ : state)
+  {
+    (void)_;
+    for (int i = 0; i < ImagesPerRank; ++i)
+    {
+      compositor.AddImage(canvases[static_cast<std::size_t>(i)],
+                          comm.rank() * ImagesPerRank + i);
+    }
+    timer.Start();
+    compositor.Composite(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+    totalTime += timer.GetElapsedTime();
+  }
+  state.SetItemsProcessed(width * height * state.iterations());
+  state.counters["Images"] = comm.size() * ImagesPerRank;
+  state.counters["CompositeTime"] = totalTime / static_cast<double>(state.iterations());
+}
+
+void CompositingSizes(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Width", "Height", "RadixK", "Blend" });
+  // Every rank must run the same number of iterations, or the ranks would wait for each
+  // other forever.
+  bm->Iterations(5);
+  const std::vector<std::pair<int64_t, int64_t>> sizes = {
+    { 512, 512 }, { 1024, 1024 }, { 1920, 1080 }, { 3840, 2160 }
+  };
+  for (const auto& size : sizes)
+  {
+    for (int64_t radixK = 0; radixK < 2; ++radixK)
+    {
+      for (int64_t blend = 0; blend < 2; ++blend)
+      {
+        bm->Args({ size.first, size.second, radixK, blend });
+      }
+    }
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchCompositing, CompositingSizes);
+
+} // end namespace vtkm::benchmarking
+
+int main(int argc, char* argv[])
+{
+  vtkmdiy::mpi::environment env(argc, argv);
+  vtkm::cont::EnvironmentTracker::SetCommunicator(vtkmdiy::mpi::communicator());
+
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
@@ -12,11 +12,15 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/Timer.h>
 
 #include <vtkm/internal/Configure.h>
 
+#include <vtkm/worklet/WorkletMapField.h>
+
 #include <vtkm/List.h>
 
 #include <sstream>
@@ -88,6 +92,138 @@ VTKM_BENCHMARK_TEMPLATES_OPTS(CopySpeed,
                                 ->ArgName("Bytes"),
                               TypeList);
 
+// Scales each value and writes it to another array, so that one element is read and one is
+// written for each element of the input. Unlike `Algorithm::Copy`, a worklet is scheduled with
+// `ScheduleTask`, which uses the same static partition as the first touch when NUMA placement is
+// enabled.
+struct ScaleWorklet : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = _2(_1);
+
+  template <typename T>
+  VTKM_EXEC T operator()(const T& value) const
+  {
+    return T(2) * value;
+  }
+};
+
+// Measures the bandwidth of a worklet with NUMA placement disabled (0 regions) and enabled. The
+// arrays are allocated and filled on the device so that they are first touched by the device
+// threads.
+void WorkletSpeedNuma(benchmark::State& state)
+{
+  using ValueType = vtkm::Float64;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::UInt64 numBytes = static_cast<vtkm::UInt64>(state.range(0));
+  const vtkm::Id numValues = static_cast<vtkm::Id>(numBytes / sizeof(ValueType));
+  const vtkm::Id numRegions = static_cast<vtkm::Id>(state.range(1));
+
+  auto& runtimeConfig = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+  vtkm::Id oldNumRegions;
+  if ((runtimeConfig.GetNumaRegions(oldNumRegions) !=
+       vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS) ||
+      (runtimeConfig.SetNumaRegions(numRegions) !=
+       vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS))
+  {
+    state.SkipWithError("NUMA regions are not supported by this device.");
+    return;
+  }
+
+  {
+    std::ostringstream desc;
+    desc << vtkm::cont::GetHumanReadableSize(numBytes) << " | " << numRegions << " NUMA regions";
+    state.SetLabel(desc.str());
+  }
+
+  {
+    vtkm::cont::ArrayHandle<ValueType> src;
+    vtkm::cont::ArrayHandle<ValueType> dst;
+    vtkm::cont::Algorithm::Fill(device, src, ValueType(1), numValues);
+    vtkm::cont::Algorithm::Fill(device, dst, ValueType(0), numValues);
+
+    vtkm::cont::Invoker invoke{ device };
+    vtkm::cont::Timer timer(device);
+    for (auto _ : state)
+    {
+      (void)_;
+      timer.Start();
+      invoke(ScaleWorklet{}, src, dst);
+      timer.Stop();
+
+      state.SetIterationTime(timer.GetElapsedTime());
+    }
+  }
+
+  runtimeConfig.SetNumaRegions(oldNumRegions);
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+}
+VTKM_BENCHMARK_OPTS(WorkletSpeedNuma,
+                      ->Ranges({ { 1 << 20, COPY_SIZE_MAX }, { 0, 2 } })
+                      ->ArgNames({ "Bytes", "NumaRegions" }));
+
+// Measures the copy bandwidth with host arrays in regular pages (a threshold of 0) and in huge
+// pages (any array of at least the threshold, in MiB). The arrays are filled before timing so
+// that page faults are not counted.
+void CopySpeedHugePages(benchmark::State& state)
+{
+  using ValueType = vtkm::Float64;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::UInt64 numBytes = static_cast<vtkm::UInt64>(state.range(0));
+  const vtkm::Id numValues = static_cast<vtkm::Id>(numBytes / sizeof(ValueType));
+  const vtkm::Id thresholdMB = static_cast<vtkm::Id>(state.range(1));
+
+  auto& runtimeConfig = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+  vtkm::Id oldThresholdMB;
+  if ((runtimeConfig.GetHugePageThreshold(oldThresholdMB) !=
+       vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS) ||
+      (runtimeConfig.SetHugePageThreshold(thresholdMB) !=
+       vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS))
+  {
+    state.SkipWithError("Huge pages are not supported by this device.");
+    return;
+  }
+
+  {
+    std::ostringstream desc;
+    desc << vtkm::cont::GetHumanReadableSize(numBytes) << " | huge page threshold "
+         << thresholdMB << " MiB";
+    state.SetLabel(desc.str());
+  }
+
+  {
+    vtkm::cont::ArrayHandle<ValueType> src;
+    vtkm::cont::ArrayHandle<ValueType> dst;
+    vtkm::cont::Algorithm::Fill(device, src, ValueType(1), numValues);
+    vtkm::cont::Algorithm::Fill(device, dst, ValueType(0), numValues);
+
+    vtkm::cont::Timer timer(device);
+    for (auto _ : state)
+    {
+      (void)_;
+      timer.Start();
+      vtkm::cont::Algorithm::Copy(device, src, dst);
+      timer.Stop();
+
+      state.SetIterationTime(timer.GetElapsedTime());
+    }
+  }
+
+  runtimeConfig.SetHugePageThreshold(oldThresholdMB);
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+}
+VTKM_BENCHMARK_OPTS(CopySpeedHugePages,
+                      ->Ranges({ { 1 << 22, COPY_SIZE_MAX }, { 0, 2 } })
+                      ->ArgNames({ "Bytes", "HugePageThresholdMB" }));
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
@@ -18,8 +18,10 @@
 #include <vtkm/cont/BitField.h>
 #include <vtkm/cont/Initialize.h>
 #include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/Timer.h>
 
+#include <vtkm/worklet/Keys.h>
 #include <vtkm/worklet/StableSortIndices.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
@@ -594,6 +596,66 @@ void BenchCountSetBitsGenerator(benchmark::internal::Benchmark* bm)
 }
 VTKM_BENCHMARK_APPLY(BenchCountSetBits, BenchCountSetBitsGenerator);
 
+void BenchCountingSort(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numBytes = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id numValues = BytesToWords<vtkm::Id>(numBytes);
+
+  const vtkm::Id percentRange = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id keyRange = std::max((numValues * percentRange) / 100, vtkm::Id{ 1 });
+
+  {
+    std::ostringstream desc;
+    desc << SizeAndValuesString(numBytes, numValues) << " | key range " << keyRange << " ("
+         << ((keyRange * 100) / numValues) << "%)";
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> unsorted;
+  {
+    std::mt19937_64 rng;
+    unsorted.Allocate(numValues);
+    auto portal = unsorted.WritePortal();
+    for (vtkm::Id i = 0; i < numValues; ++i)
+    {
+      portal.Set(i, static_cast<vtkm::Id>(rng() % static_cast<std::uint64_t>(keyRange)));
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> array;
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    // Reset the array to the unsorted state:
+    vtkm::cont::Algorithm::Copy(device, unsorted, array);
+
+    timer.Start();
+    vtkm::cont::Algorithm::CountingSort(device, array, keyRange);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+}
+
+void BenchCountingSortGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->RangeMultiplier(SmallRangeMultiplier);
+  bm->ArgNames({ "Size", "%Range" });
+  for (int64_t pcntRange = 0; pcntRange <= 100; pcntRange += 25)
+  {
+    bm->Ranges({ SmallRange, { pcntRange, pcntRange } });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchCountingSort, BenchCountingSortGenerator);
+
 template <typename ValueType>
 void BenchFillArrayHandle(benchmark::State& state)
 {
@@ -685,6 +747,71 @@ VTKM_BENCHMARK_TEMPLATES_OPTS(BenchFillBitFieldMask,
                                 ->ArgName("Size"),
                               FillWordTypes);
 
+void BenchKeysBuildArrays(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numBytes = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id numValues = BytesToWords<vtkm::Id>(numBytes);
+
+  const vtkm::Id percentUnique = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id numUnique = std::max((numValues * percentUnique) / 100, vtkm::Id{ 1 });
+
+  const auto sort = static_cast<vtkm::worklet::KeysSortType>(state.range(2));
+  {
+    std::ostringstream desc;
+    desc << SizeAndValuesString(numBytes, numValues) << " | " << numUnique << " ("
+         << ((numUnique * 100) / numValues) << "%) unique | ";
+    switch (sort)
+    {
+      case vtkm::worklet::KeysSortType::Unstable:
+        desc << "Unstable";
+        break;
+      case vtkm::worklet::KeysSortType::Stable:
+        desc << "Stable";
+        break;
+      case vtkm::worklet::KeysSortType::Hash:
+        desc << "Hash";
+        break;
+    }
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keyArray;
+  FillRandomModTestValue(keyArray, numUnique, numValues);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    vtkm::worklet::Keys<vtkm::Id> keys;
+
+    timer.Start();
+    keys.BuildArrays(keyArray, sort, device);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+}
+
+void BenchKeysBuildArraysGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->RangeMultiplier(SmallRangeMultiplier);
+  bm->ArgNames({ "Size", "%Uniq", "Sort" });
+  for (int64_t sort = 0; sort <= static_cast<int64_t>(vtkm::worklet::KeysSortType::Hash); ++sort)
+  {
+    for (int64_t pcntUnique = 0; pcntUnique <= 100; pcntUnique += 25)
+    {
+      bm->Ranges({ SmallRange, { pcntUnique, pcntUnique }, { sort, sort } });
+    }
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchKeysBuildArrays, BenchKeysBuildArraysGenerator);
+
 template <typename ValueType>
 void BenchLowerBounds(benchmark::State& state)
 {
@@ -821,6 +948,58 @@ void BenchReduceByKeyGenerator(benchmark::internal::Benchmark* bm)
 
 VTKM_BENCHMARK_TEMPLATES_APPLY(BenchReduceByKey, BenchReduceByKeyGenerator, SmallTypeList);
 
+template <typename ValueType>
+void BenchReduceSegmented(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+
+  const vtkm::Id numBytes = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id numValues = BytesToWords<ValueType>(numBytes);
+
+  const vtkm::Id percentSegments = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id numSegments = std::max((numValues * percentSegments) / 100, vtkm::Id{ 1 });
+
+  {
+    std::ostringstream desc;
+    desc << SizeAndValuesString(numBytes, numValues) << " | " << numSegments << " ("
+         << ((numSegments * 100) / numValues) << "%) segments";
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::ArrayHandle<ValueType> valuesIn;
+  vtkm::cont::ArrayHandle<ValueType> valuesOut;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+
+  // The same grouping as BenchReduceByKey, given as offsets instead of keys.
+  FillTestValue(valuesIn, numValues);
+  offsets.Allocate(numSegments + 1);
+  {
+    auto portal = offsets.WritePortal();
+    for (vtkm::Id s = 0; s <= numSegments; ++s)
+    {
+      portal.Set(s, (s * numValues) / numSegments);
+    }
+  }
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::Algorithm::ReduceSegmented(
+      device, valuesIn, offsets, valuesOut, ValueType{}, vtkm::Add{});
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+};
+
+VTKM_BENCHMARK_TEMPLATES_APPLY(BenchReduceSegmented, BenchReduceByKeyGenerator, SmallTypeList);
+
 template <typename ValueType>
 void BenchScanExclusive(benchmark::State& state)
 {
@@ -923,6 +1102,94 @@ VTKM_BENCHMARK_TEMPLATES_OPTS(BenchScanInclusive,
                                 ->ArgName("Size"),
                               TypeList);
 
+// Does a configurable amount of arithmetic for each value to simulate worklets of
+// different cost.
+struct GrainSizeWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+
+  vtkm::IdComponent NumIterations;
+
+  VTKM_CONT GrainSizeWorklet(vtkm::IdComponent numIterations)
+    : NumIterations(numIterations)
+  {
+  }
+
+  VTKM_EXEC void operator()(vtkm::Float32 input, vtkm::Float32& output) const
+  {
+    output = input;
+    for (vtkm::IdComponent i = 0; i < this->NumIterations; ++i)
+    {
+      output = vtkm::Sqrt(output * output + 1.0f);
+    }
+  }
+};
+
+void BenchScheduleGrainSize(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+
+  const vtkm::Id numValues = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id grainSize = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::IdComponent numIterations = static_cast<vtkm::IdComponent>(state.range(2));
+
+  auto& runtimeConfig = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+  vtkm::Id oldGrainSize;
+  if (runtimeConfig.GetGrainSize(oldGrainSize) !=
+      vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS)
+  {
+    state.SkipWithError("Grain size can only be set for the TBB device.");
+    return;
+  }
+  runtimeConfig.SetGrainSize(grainSize);
+
+  {
+    std::ostringstream desc;
+    desc << numValues << " values | grain "
+         << ((grainSize == 0) ? std::string("adaptive") : std::to_string(grainSize)) << " | "
+         << numIterations << " iterations";
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> input;
+  vtkm::cont::ArrayHandle<vtkm::Float32> output;
+  FillTestValue(input, numValues);
+
+  vtkm::cont::Invoker invoker{ device };
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    invoker(GrainSizeWorklet{ numIterations }, input, output);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  runtimeConfig.SetGrainSize(oldGrainSize);
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+}
+
+void BenchScheduleGrainSizeGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Size", "GrainSize", "Iterations" });
+
+  // A grain size of 0 selects the adaptive grain size.
+  for (int64_t grainSize : { 0, 1, 64, 1024, 16384, 262144 })
+  {
+    for (int64_t numIterations : { 1, 256 })
+    {
+      bm->Args({ 1 << 22, grainSize, numIterations });
+    }
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchScheduleGrainSize, BenchScheduleGrainSizeGenerator);
+
 template <typename ValueType>
 void BenchSort(benchmark::State& state)
 {
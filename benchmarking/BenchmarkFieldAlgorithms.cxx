@@ -23,6 +23,7 @@
 #include <vtkm/cont/ArrayHandleVirtual.h>
 #endif
 
+#include <vtkm/worklet/FusedMapField.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -562,6 +563,33 @@ void BenchMathMultiplexerN(::benchmark::State& state)
 };
 VTKM_BENCHMARK_TEMPLATES(BenchMathMultiplexerN, ValueTypes);
 
+template <typename ValueType>
+void BenchMathFusedMapField(::benchmark::State& state)
+{
+  // The same chain of worklets as BenchMathStatic, run as a single FusedMapField dispatch.
+  BenchMathImpl<ValueType> impl{ state };
+  auto fused = vtkm::worklet::MakeFusedMapField(vtkm::worklet::MakeFusedStage<ValueType>(Mag{}),
+                                                vtkm::worklet::MakeFusedStage<ValueType>(Sin{}),
+                                                vtkm::worklet::MakeFusedStage<ValueType>(Square{}),
+                                                Cos{});
+
+  for (auto _ : state)
+  {
+    (void)_;
+
+    impl.Timer.Start();
+    impl.Invoker(fused, impl.InputHandle, impl.TempHandle2);
+    impl.Timer.Stop();
+
+    state.SetIterationTime(impl.Timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  const int64_t numValues = static_cast<int64_t>(impl.ArraySize);
+  state.SetItemsProcessed(numValues * iterations);
+};
+VTKM_BENCHMARK_TEMPLATES(BenchMathFusedMapField, ValueTypes);
+
 template <typename Value>
 struct BenchFusedMathImpl
 {
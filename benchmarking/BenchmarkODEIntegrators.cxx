@@ -10,6 +10,7 @@
 
 #include "Benchmarker.h"
 
+#include <vtkm/cont/AtomicArray.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/ErrorInternal.h>
@@ -19,7 +20,15 @@
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/filter/ParticleAdvection.h>
 #include <vtkm/worklet/particleadvection/EulerIntegrator.h>
+#include <vtkm/worklet/particleadvection/Field.h>
+#include <vtkm/worklet/particleadvection/GridEvaluators.h>
+#include <vtkm/worklet/particleadvection/ParticleAdvectionWorklets.h>
+#include <vtkm/worklet/particleadvection/ParticlesSOA.h>
+#include <vtkm/worklet/particleadvection/RK45Integrator.h>
 #include <vtkm/worklet/particleadvection/RK4Integrator.h>
+#include <vtkm/worklet/particleadvection/Stepper.h>
+
+#include <random>
 
 
 namespace
@@ -75,6 +84,269 @@ VTKM_BENCHMARK_OPTS(BenchParticleAdvection,
                       ->ArgName("Steps")
                       ->Complexity());
 
+// Advects many particles through a rotating field with the RK4 stepper, storing the particles
+// either as an array of vtkm::Particle or as a ParticleArraysSOA.
+void BenchParticleLayout(::benchmark::State& state, bool useSOA)
+{
+  using FieldHandle = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
+  using FieldType = vtkm::worklet::particleadvection::VelocityField<FieldHandle>;
+  using GridEvalType = vtkm::worklet::particleadvection::GridEvaluator<FieldType>;
+  using RK4Type = vtkm::worklet::particleadvection::RK4Integrator<GridEvalType>;
+  using Stepper = vtkm::worklet::particleadvection::Stepper<RK4Type, GridEvalType>;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numSeeds = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id dim = 32;
+  const vtkm::FloatDefault center = static_cast<vtkm::FloatDefault>(dim - 1) / 2;
+  vtkm::Id maxSteps = 100;
+
+  vtkm::cont::DataSet ds = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(dim, dim, dim));
+  std::vector<vtkm::Vec3f> vectorField;
+  vectorField.reserve(static_cast<std::size_t>(dim * dim * dim));
+  for (vtkm::Id k = 0; k < dim; k++)
+    for (vtkm::Id j = 0; j < dim; j++)
+      for (vtkm::Id i = 0; i < dim; i++)
+        vectorField.push_back(vtkm::Vec3f(static_cast<vtkm::FloatDefault>(j) - center,
+                                          center - static_cast<vtkm::FloatDefault>(i),
+                                          1));
+  FieldType velocities(vtkm::cont::make_ArrayHandle(vectorField, vtkm::CopyFlag::On));
+  GridEvalType eval(ds, velocities);
+  Stepper rk4(eval, static_cast<vtkm::FloatDefault>(0.01));
+
+  std::default_random_engine generator(static_cast<vtkm::UInt32>(numSeeds));
+  std::uniform_real_distribution<vtkm::FloatDefault> distribution(center / 2, center * 3 / 2);
+  std::vector<vtkm::Particle> seeds;
+  for (vtkm::Id i = 0; i < numSeeds; i++)
+  {
+    vtkm::Vec3f pos(distribution(generator), distribution(generator), distribution(generator));
+    seeds.push_back(vtkm::Particle(pos, i));
+  }
+
+  vtkm::worklet::particleadvection::ParticleAdvectionWorklet<Stepper, vtkm::Particle> worklet;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    auto particles = vtkm::cont::make_ArrayHandle(seeds, vtkm::CopyFlag::On);
+    if (useSOA)
+    {
+      vtkm::worklet::particleadvection::ParticleArraysSOA soaParticles(particles);
+      timer.Start();
+      worklet.Run(rk4, soaParticles, maxSteps);
+      timer.Stop();
+    }
+    else
+    {
+      timer.Start();
+      worklet.Run(rk4, particles, maxSteps);
+      timer.Stop();
+    }
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numSeeds * maxSteps) * state.iterations());
+}
+
+void BenchParticleAdvectionAOS(::benchmark::State& state)
+{
+  BenchParticleLayout(state, false);
+}
+VTKM_BENCHMARK_OPTS(BenchParticleAdvectionAOS,
+                      ->RangeMultiplier(8)
+                      ->Range(1024, 1024 * 64)
+                      ->ArgName("Seeds"));
+
+void BenchParticleAdvectionSOA(::benchmark::State& state)
+{
+  BenchParticleLayout(state, true);
+}
+VTKM_BENCHMARK_OPTS(BenchParticleAdvectionSOA,
+                      ->RangeMultiplier(8)
+                      ->Range(1024, 1024 * 64)
+                      ->ArgName("Seeds"));
+
+// Counts the field evaluations of the evaluator it wraps.
+template <typename ExecEvaluatorType>
+class ExecCountingEvaluator
+{
+public:
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
+  ExecCountingEvaluator(const ExecEvaluatorType& evaluator,
+                        const vtkm::exec::AtomicArrayExecutionObject<vtkm::Id>& count)
+    : Evaluator(evaluator)
+    , Count(count)
+  {
+  }
+
+  template <typename Point>
+  VTKM_EXEC bool IsWithinSpatialBoundary(const Point point) const
+  {
+    return this->Evaluator.IsWithinSpatialBoundary(point);
+  }
+
+  VTKM_EXEC bool IsWithinTemporalBoundary(const vtkm::FloatDefault& time) const
+  {
+    return this->Evaluator.IsWithinTemporalBoundary(time);
+  }
+
+  VTKM_EXEC vtkm::Bounds GetSpatialBoundary() const { return this->Evaluator.GetSpatialBoundary(); }
+
+  VTKM_EXEC_CONT vtkm::FloatDefault GetTemporalBoundary(vtkm::Id direction) const
+  {
+    return this->Evaluator.GetTemporalBoundary(direction);
+  }
+
+  template <typename Point>
+  VTKM_EXEC vtkm::worklet::particleadvection::GridEvaluatorStatus Evaluate(
+    const Point& point,
+    const vtkm::FloatDefault& time,
+    vtkm::VecVariable<Point, 2>& out,
+    LastCell& lastCell) const
+  {
+    this->Count.Add(0, 1);
+    return this->Evaluator.Evaluate(point, time, out, lastCell);
+  }
+
+private:
+  ExecEvaluatorType Evaluator;
+  vtkm::exec::AtomicArrayExecutionObject<vtkm::Id> Count;
+};
+
+template <typename EvaluatorType>
+class CountingEvaluator : public vtkm::cont::ExecutionObjectBase
+{
+private:
+  EvaluatorType Evaluator;
+  vtkm::cont::ArrayHandle<vtkm::Id> Count;
+
+public:
+  CountingEvaluator() = default;
+
+  CountingEvaluator(const EvaluatorType& evaluator)
+    : Evaluator(evaluator)
+  {
+    this->Count.Allocate(1);
+    this->ResetCount();
+  }
+
+  void ResetCount() { this->Count.WritePortal().Set(0, 0); }
+  vtkm::Id GetCount() const { return this->Count.ReadPortal().Get(0); }
+
+  VTKM_CONT auto PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                     vtkm::cont::Token& token) const
+    -> ExecCountingEvaluator<decltype(this->Evaluator.PrepareForExecution(device, token))>
+  {
+    vtkm::cont::AtomicArray<vtkm::Id> count(this->Count);
+    return { this->Evaluator.PrepareForExecution(device, token),
+             count.PrepareForExecution(device, token) };
+  }
+};
+
+using AccuracyFieldType =
+  vtkm::worklet::particleadvection::VelocityField<vtkm::cont::ArrayHandle<vtkm::Vec3f>>;
+using AccuracyEvalType =
+  CountingEvaluator<vtkm::worklet::particleadvection::GridEvaluator<AccuracyFieldType>>;
+
+// Advects particles once around a rotating field, where the exact positions are known, and
+// reports the largest error and the number of field evaluations per particle.
+template <template <typename> class IntegratorTemplate, typename ConfigureType>
+void BenchIntegratorAccuracy(::benchmark::State& state,
+                             vtkm::Id numSteps,
+                             const ConfigureType& configure)
+{
+  using FieldType = AccuracyFieldType;
+  using GridEvalType = vtkm::worklet::particleadvection::GridEvaluator<FieldType>;
+  using EvalType = AccuracyEvalType;
+  using IntegratorType = IntegratorTemplate<EvalType>;
+  using Stepper = vtkm::worklet::particleadvection::Stepper<IntegratorType, EvalType>;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numSeeds = 1024;
+  const vtkm::Id dim = 33;
+  const vtkm::FloatDefault center = static_cast<vtkm::FloatDefault>(dim - 1) / 2;
+  const vtkm::FloatDefault stepSize =
+    vtkm::TwoPi<vtkm::FloatDefault>() / static_cast<vtkm::FloatDefault>(numSteps);
+
+  vtkm::cont::DataSet ds = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(dim, dim, dim));
+  std::vector<vtkm::Vec3f> vectorField;
+  vectorField.reserve(static_cast<std::size_t>(dim * dim * dim));
+  for (vtkm::Id k = 0; k < dim; k++)
+    for (vtkm::Id j = 0; j < dim; j++)
+      for (vtkm::Id i = 0; i < dim; i++)
+        vectorField.push_back(vtkm::Vec3f(center - static_cast<vtkm::FloatDefault>(j),
+                                          static_cast<vtkm::FloatDefault>(i) - center,
+                                          0));
+  FieldType velocities(vtkm::cont::make_ArrayHandle(vectorField, vtkm::CopyFlag::On));
+  EvalType eval(GridEvalType(ds, velocities));
+  IntegratorType integrator(eval);
+  configure(integrator);
+  Stepper stepper(integrator, eval, stepSize);
+
+  std::default_random_engine generator(static_cast<vtkm::UInt32>(numSeeds));
+  std::uniform_real_distribution<vtkm::FloatDefault> radius(center / 4, center * 3 / 4);
+  std::uniform_real_distribution<vtkm::FloatDefault> angle(0, vtkm::TwoPi<vtkm::FloatDefault>());
+  std::vector<vtkm::Particle> seeds;
+  for (vtkm::Id i = 0; i < numSeeds; i++)
+  {
+    vtkm::FloatDefault r = radius(generator), a = angle(generator);
+    vtkm::Vec3f pos(center + r * vtkm::Cos(a), center + r * vtkm::Sin(a), center);
+    seeds.push_back(vtkm::Particle(pos, i));
+  }
+
+  vtkm::worklet::ParticleAdvection worklet;
+  vtkm::worklet::ParticleAdvectionResult<vtkm::Particle> result;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    auto particles = vtkm::cont::make_ArrayHandle(seeds, vtkm::CopyFlag::On);
+    eval.ResetCount();
+    timer.Start();
+    result = worklet.Run(stepper, particles, numSteps);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  vtkm::FloatDefault maxError = 0;
+  auto portal = result.Particles.ReadPortal();
+  for (vtkm::Id i = 0; i < numSeeds; i++)
+  {
+    auto p = portal.Get(i);
+    vtkm::Vec3f start = seeds[static_cast<std::size_t>(i)].Pos - vtkm::Vec3f(center);
+    vtkm::Vec3f exact(center + start[0] * vtkm::Cos(p.Time) - start[1] * vtkm::Sin(p.Time),
+                      center + start[0] * vtkm::Sin(p.Time) + start[1] * vtkm::Cos(p.Time),
+                      center);
+    maxError = vtkm::Max(maxError, vtkm::Magnitude(p.Pos - exact));
+  }
+  state.counters["MaxError"] = static_cast<double>(maxError);
+  state.counters["EvalsPerParticle"] =
+    static_cast<double>(eval.GetCount()) / static_cast<double>(numSeeds);
+}
+
+// RK4 with more and more steps per revolution.
+void BenchRK4Accuracy(::benchmark::State& state)
+{
+  using vtkm::worklet::particleadvection::RK4Integrator;
+  BenchIntegratorAccuracy<RK4Integrator>(
+    state, static_cast<vtkm::Id>(state.range(0)), [](RK4Integrator<AccuracyEvalType>&) {});
+}
+VTKM_BENCHMARK_OPTS(BenchRK4Accuracy, ->RangeMultiplier(2)->Range(8, 256)->ArgName("Steps"));
+
+// RK45 with eight steps per revolution and tighter and tighter tolerances.
+void BenchRK45Accuracy(::benchmark::State& state)
+{
+  using vtkm::worklet::particleadvection::RK45Integrator;
+  const vtkm::FloatDefault tolerance =
+    vtkm::Pow(vtkm::FloatDefault(10), -static_cast<vtkm::FloatDefault>(state.range(0)));
+  BenchIntegratorAccuracy<RK45Integrator>(
+    state, 8, [=](RK45Integrator<AccuracyEvalType>& integrator) {
+      integrator.SetTolerance(tolerance);
+    });
+}
+VTKM_BENCHMARK_OPTS(BenchRK45Accuracy, ->DenseRange(2, 7)->ArgName("-log10(Tolerance)"));
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
@@ -0,0 +1,302 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/Initialize.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/PointLocatorSparseGrid.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/worklet/KdTree3D.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Provide access to the requested device to the benchmark functions:
+vtkm::cont::InitializeResult Config;
+
+static constexpr vtkm::Id NUM_POINTS_MIN = 1 << 12;
+static constexpr vtkm::Id NUM_POINTS_MAX = 1 << 21;
+static constexpr vtkm::Id NUM_QUERIES = 1 << 16;
+
+// Number of points per bin of the sparse grid for uniformly distributed points.
+static constexpr vtkm::Id POINTS_PER_BIN = 8;
+
+// Point clouds in the unit cube. A uniform cloud (distribution 0) is the best case for the
+// sparse grid. A clustered cloud (distribution 1), with most points in a few small blobs like
+// a scan of a few objects, leaves most bins empty and a few very full.
+vtkm::cont::ArrayHandle<vtkm::Vec3f> MakePointCloud(vtkm::Id numPoints,
+                                                    int distribution,
+                                                    unsigned int seed)
+{
+  std::uniform_real_distribution<vtkm::FloatDefault> uniform(0, 1);
+
+  // The clusters are the same for all seeds.
+  std::mt19937 rng(0);
+  std::vector<vtkm::Vec3f> centers;
+  for (int i = 0; i < 16; ++i)
+  {
+    centers.push_back(vtkm::Vec3f(uniform(rng), uniform(rng), uniform(rng)) * 0.8f +
+                      vtkm::Vec3f(0.1f));
+  }
+  rng.seed(seed);
+  std::normal_distribution<vtkm::FloatDefault> blob(0, 0.01f);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  points.Allocate(numPoints);
+  auto portal = points.WritePortal();
+  for (vtkm::Id i = 0; i < numPoints; ++i)
+  {
+    if (distribution == 0)
+    {
+      portal.Set(i, vtkm::Vec3f(uniform(rng), uniform(rng), uniform(rng)));
+    }
+    else
+    {
+      const vtkm::Vec3f& center = centers[static_cast<std::size_t>(i) % centers.size()];
+      portal.Set(i, center + vtkm::Vec3f(blob(rng), blob(rng), blob(rng)));
+    }
+  }
+  return points;
+}
+
+// Query points follow the distribution of the data, as in point cloud registration or
+// smoothing, where the queries are points of another scan of the same scene.
+vtkm::cont::ArrayHandle<vtkm::Vec3f> MakeQueries(int distribution)
+{
+  return MakePointCloud(NUM_QUERIES, distribution, 1);
+}
+
+vtkm::cont::PointLocatorSparseGrid MakeSparseGrid(
+  const vtkm::cont::ArrayHandle<vtkm::Vec3f>& points)
+{
+  vtkm::Id binsPerAxis = static_cast<vtkm::Id>(
+    vtkm::Cbrt(static_cast<vtkm::Float64>(points.GetNumberOfValues() / POINTS_PER_BIN)));
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  locator.SetCoordinates(vtkm::cont::CoordinateSystem("points", points));
+  locator.SetNumberOfBins(vtkm::Id3(vtkm::Max(binsPerAxis, vtkm::Id(1))));
+  return locator;
+}
+
+struct SparseGridNearestWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, ExecObject, FieldOut, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  template <typename Locator>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const Locator& locator,
+                            vtkm::Id& nearestId,
+                            vtkm::FloatDefault& distance) const
+  {
+    locator.FindNearestNeighbor(point, nearestId, distance);
+  }
+};
+
+void BenchKdTreeBuild(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  auto points = MakePointCloud(numPoints, static_cast<int>(state.range(1)), 0);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::worklet::KdTree3D kdtree;
+    kdtree.Build(points);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numPoints) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchKdTreeBuild,
+                      ->Ranges({ { NUM_POINTS_MIN, NUM_POINTS_MAX }, { 0, 1 } })
+                      ->ArgNames({ "NumPoints", "Clustered" }));
+
+void BenchSparseGridBuild(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  auto points = MakePointCloud(numPoints, static_cast<int>(state.range(1)), 0);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::PointLocatorSparseGrid locator = MakeSparseGrid(points);
+    locator.Update();
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numPoints) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchSparseGridBuild,
+                      ->Ranges({ { NUM_POINTS_MIN, NUM_POINTS_MAX }, { 0, 1 } })
+                      ->ArgNames({ "NumPoints", "Clustered" }));
+
+void BenchKdTreeNearest(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  const int distribution = static_cast<int>(state.range(1));
+  auto points = MakePointCloud(numPoints, distribution, 0);
+  auto queries = MakeQueries(distribution);
+
+  vtkm::worklet::KdTree3D kdtree;
+  kdtree.Build(points);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    kdtree.Run(points, queries, nearestIds, distances, device);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(NUM_QUERIES) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchKdTreeNearest,
+                      ->Ranges({ { NUM_POINTS_MIN, NUM_POINTS_MAX }, { 0, 1 } })
+                      ->ArgNames({ "NumPoints", "Clustered" }));
+
+void BenchSparseGridNearest(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  const int distribution = static_cast<int>(state.range(1));
+  auto points = MakePointCloud(numPoints, distribution, 0);
+  auto queries = MakeQueries(distribution);
+
+  vtkm::cont::PointLocatorSparseGrid locator = MakeSparseGrid(points);
+  locator.Update();
+
+  vtkm::cont::ArrayHandle<vtkm::Id> nearestIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances;
+  vtkm::cont::Invoker invoker{ device };
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    invoker(SparseGridNearestWorklet{}, queries, locator, nearestIds, distances);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(NUM_QUERIES) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchSparseGridNearest,
+                      ->Ranges({ { NUM_POINTS_MIN, NUM_POINTS_MAX }, { 0, 1 } })
+                      ->ArgNames({ "NumPoints", "Clustered" }));
+
+void BenchKdTreeKNearest(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::IdComponent k = static_cast<vtkm::IdComponent>(state.range(1));
+  auto points = MakePointCloud(numPoints, 1, 0);
+  auto queries = MakeQueries(1);
+
+  vtkm::worklet::KdTree3D kdtree;
+  kdtree.Build(points);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    kdtree.RunKNearest(points, queries, k, neighborIds, distances);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(NUM_QUERIES) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchKdTreeKNearest,
+                      ->Ranges({ { NUM_POINTS_MIN, NUM_POINTS_MAX }, { 1, 32 } })
+                      ->ArgNames({ "NumPoints", "K" }));
+
+void BenchKdTreeRadius(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  auto points = MakePointCloud(numPoints, 0, 0);
+  auto queries = MakeQueries(0);
+  // About 16 neighbors per query.
+  const vtkm::FloatDefault radius = static_cast<vtkm::FloatDefault>(
+    vtkm::Cbrt(16.0 / (4.19 * static_cast<vtkm::Float64>(numPoints))));
+
+  vtkm::worklet::KdTree3D kdtree;
+  kdtree.Build(points);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    kdtree.RunRadius(points, queries, radius, neighborIds, distances, offsets);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(NUM_QUERIES) * state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchKdTreeRadius,
+                      ->Range(NUM_POINTS_MIN, NUM_POINTS_MAX)
+                      ->ArgName("NumPoints"));
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
@@ -12,18 +12,25 @@
 
 #include <vtkm/TypeTraits.h>
 
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/Initialize.h>
 #include <vtkm/cont/Timer.h>
 
+#include <vtkm/filter/Contour.h>
 #include <vtkm/source/Tangle.h>
 
 #include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/MapperRayTracer.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 #include <vtkm/rendering/raytracing/RayTracer.h>
 #include <vtkm/rendering/raytracing/SphereIntersector.h>
 #include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+#include <vtkm/rendering/raytracing/VolumeRendererStructured.h>
 
 #include <vtkm/exec/FunctorBase.h>
 
@@ -37,12 +44,66 @@ namespace
 // Hold configuration state (e.g. active device)
 vtkm::cont::InitializeResult Config;
 
-void BenchRayTracing(::benchmark::State& state)
+// Scene 0 is the external faces of a tangle field: large triangles of
+// uniform size. Scene 1 is a stack of contours of the same field: many
+// small triangles spread unevenly, as in isosurfaces of turbulent flows.
+vtkm::cont::DataSet MakeScene(int scene)
 {
   const vtkm::Id3 dims(128, 128, 128);
 
   vtkm::source::Tangle maker(dims);
   vtkm::cont::DataSet dataset = maker.Execute();
+  if (scene == 0)
+  {
+    return dataset;
+  }
+
+  vtkm::filter::Contour contour;
+  contour.SetActiveField("nodevar", vtkm::cont::Field::Association::POINTS);
+  const vtkm::Range range = vtkm::cont::ArrayGetValue(0, dataset.GetField("nodevar").GetRange());
+  const vtkm::Id numIsoValues = 4;
+  contour.SetNumberOfIsoValues(numIsoValues);
+  for (vtkm::Id i = 0; i < numIsoValues; ++i)
+  {
+    contour.SetIsoValue(
+      i, range.Min + range.Length() * static_cast<vtkm::Float64>(i + 1) / (numIsoValues + 1));
+  }
+  return contour.Execute(dataset);
+}
+
+void BenchBVHBuild(::benchmark::State& state)
+{
+  const auto builder = static_cast<vtkm::rendering::raytracing::BVHBuilderType>(state.range(0));
+  vtkm::cont::DataSet dataset = MakeScene(static_cast<int>(state.range(1)));
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+
+  vtkm::rendering::raytracing::TriangleExtractor triExtractor;
+  triExtractor.ExtractCells(dataset.GetCellSet());
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    vtkm::rendering::raytracing::TriangleIntersector triIntersector;
+    triIntersector.SetBVHBuilder(builder);
+    timer.Start();
+    triIntersector.SetData(coords, triExtractor.GetTriangles());
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(triExtractor.GetNumberOfTriangles()) *
+                          state.iterations());
+}
+VTKM_BENCHMARK_OPTS(BenchBVHBuild,
+                      ->Ranges({ { 0, 1 }, { 0, 1 } })
+                      ->ArgNames({ "SAHBuilder", "Contours" }));
+
+// Reports the rate of primary rays traced and shaded as items per second.
+void BenchRayTracing(::benchmark::State& state)
+{
+  const auto builder = static_cast<vtkm::rendering::raytracing::BVHBuilderType>(state.range(0));
+  vtkm::cont::DataSet dataset = MakeScene(static_cast<int>(state.range(1)));
   vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
 
   vtkm::rendering::Camera camera;
@@ -56,9 +117,13 @@ void BenchRayTracing(::benchmark::State& state)
 
   auto triIntersector = std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>(
     vtkm::rendering::raytracing::TriangleIntersector());
+  triIntersector->SetBVHBuilder(builder);
 
   vtkm::rendering::raytracing::RayTracer tracer;
+  vtkm::cont::Timer buildTimer{ Config.Device };
+  buildTimer.Start();
   triIntersector->SetData(coords, triExtractor.GetTriangles());
+  buildTimer.Stop();
   tracer.AddShapeIntersector(triIntersector);
 
   vtkm::rendering::CanvasRayTracer canvas(1920, 1080);
@@ -107,9 +172,171 @@ void BenchRayTracing(::benchmark::State& state)
 
     state.SetIterationTime(timer.GetElapsedTime());
   }
+  state.SetItemsProcessed(static_cast<int64_t>(rays.NumRays) * state.iterations());
+  state.counters["BuildTime"] = buildTimer.GetElapsedTime();
+}
+
+VTKM_BENCHMARK_OPTS(BenchRayTracing,
+                      ->Ranges({ { 0, 1 }, { 0, 1 } })
+                      ->ArgNames({ "SAHBuilder", "Contours" }));
+
+// Reports the rate of primary rays intersected with the contours as items per
+// second, with the scalar or the packet traversal and either triangle test.
+void BenchPacketTraversal(::benchmark::State& state)
+{
+  const bool usePackets = static_cast<bool>(state.range(0));
+  const bool useWaterTight = static_cast<bool>(state.range(1));
+  vtkm::cont::DataSet dataset = MakeScene(1);
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+
+  vtkm::rendering::raytracing::TriangleExtractor triExtractor;
+  triExtractor.ExtractCells(dataset.GetCellSet());
+
+  vtkm::rendering::raytracing::TriangleIntersector triIntersector;
+  triIntersector.SetUsePacketTraversal(usePackets);
+  triIntersector.SetUseWaterTight(useWaterTight);
+  triIntersector.SetData(coords, triExtractor.GetTriangles());
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 1920, 1080);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    rayCamera.CreateRays(rays, coords.GetBounds());
+    timer.Start();
+    triIntersector.IntersectRays(rays);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(rays.NumRays) * state.iterations());
+}
+
+VTKM_BENCHMARK_OPTS(BenchPacketTraversal,
+                      ->Ranges({ { 0, 1 }, { 0, 1 } })
+                      ->ArgNames({ "Packets", "WaterTight" }));
+
+// Renders a sweep of 100 cameras around the contours with MapperRayTracer, as when
+// writing an image database. With ReuseMapper, one mapper renders all frames and
+// reuses its shapes; otherwise each frame gets a new mapper, which rebuilds them.
+// Reports frames per second and the time per frame in seconds.
+void BenchCameraSweep(::benchmark::State& state)
+{
+  const bool reuseMapper = static_cast<bool>(state.range(0));
+  vtkm::cont::DataSet dataset = MakeScene(1);
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  vtkm::cont::Field field = dataset.GetField("nodevar");
+  const vtkm::Range range = vtkm::cont::ArrayGetValue(0, field.GetRange());
+  vtkm::cont::ColorTable colorTable("cool to warm");
+
+  constexpr vtkm::Id numFrames = 100;
+  vtkm::rendering::CanvasRayTracer canvas(512, 512);
+
+  vtkm::cont::Timer timer{ Config.Device };
+  vtkm::Float64 totalTime = 0.;
+  for (auto _ : state)
+  {
+    (void)_;
+    // The sweep includes building the shapes for the first frame.
+    vtkm::rendering::MapperRayTracer mapper;
+    vtkm::rendering::Camera camera;
+    camera.ResetToBounds(coords.GetBounds());
+    timer.Start();
+    for (vtkm::Id frame = 0; frame < numFrames; ++frame)
+    {
+      vtkm::rendering::MapperRayTracer frameMapper;
+      vtkm::rendering::MapperRayTracer& renderer = reuseMapper ? mapper : frameMapper;
+      renderer.SetCanvas(&canvas);
+      renderer.SetActiveColorTable(colorTable);
+      canvas.Clear();
+      renderer.RenderCells(dataset.GetCellSet(), coords, field, colorTable, camera, range);
+      camera.Azimuth(360.f / static_cast<vtkm::Float32>(numFrames));
+    }
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+    totalTime += timer.GetElapsedTime();
+  }
+  state.SetItemsProcessed(numFrames * state.iterations());
+  state.counters["FrameTime"] = totalTime / static_cast<double>(numFrames * state.iterations());
+}
+
+VTKM_BENCHMARK_OPTS(BenchCameraSweep, ->DenseRange(0, 1)->ArgName("ReuseMapper"));
+
+// Volume renders the tangle field at 1024x1024 with a transfer function that makes the
+// lower 70% of the scalar range transparent, with and without empty-space skipping and an
+// opacity threshold (in percent) for early ray termination. Reports rays per second and
+// the average number of samples per ray.
+void BenchVolumeSkipping(::benchmark::State& state)
+{
+  const bool skipping = static_cast<bool>(state.range(0));
+  const vtkm::Float32 opacityThreshold = static_cast<vtkm::Float32>(state.range(1)) / 100.f;
+  vtkm::cont::DataSet dataset = MakeScene(0);
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  const vtkm::cont::Field& field = dataset.GetField("nodevar");
+  const vtkm::Range range = vtkm::cont::ArrayGetValue(0, field.GetRange());
+
+  constexpr vtkm::Id numColors = 1024;
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> colorMap;
+  colorMap.Allocate(numColors);
+  {
+    auto portal = colorMap.WritePortal();
+    for (vtkm::Id i = 0; i < numColors; ++i)
+    {
+      const vtkm::Float32 t = static_cast<vtkm::Float32>(i) / static_cast<vtkm::Float32>(numColors);
+      const vtkm::Float32 alpha = t < 0.5f ? 0.f : (t - 0.5f) / 0.5f;
+      portal.Set(i, vtkm::Vec4f_32(t, 0.5f, 1.f - t, alpha));
+    }
+  }
+
+  vtkm::rendering::raytracing::VolumeRendererStructured tracer;
+  tracer.SetEmptySpaceSkipping(skipping);
+  tracer.SetOpacityThreshold(opacityThreshold);
+  tracer.SetCountSamples(true);
+  tracer.SetData(coords,
+                 field,
+                 dataset.GetCellSet().Cast<vtkm::cont::CellSetStructured<3>>(),
+                 range);
+  tracer.SetColorMap(colorMap);
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 1024, 1024);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+
+  vtkm::cont::Timer timer{ Config.Device };
+  for (auto _ : state)
+  {
+    (void)_;
+    rayCamera.CreateRays(rays, coords.GetBounds());
+    rays.Buffers.at(0).InitConst(0.f);
+    timer.Start();
+    tracer.Render(rays);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(rays.NumRays) * state.iterations());
+
+  vtkm::Id numSamples = vtkm::cont::Algorithm::Reduce(tracer.GetSampleCounts(), vtkm::Id(0));
+  state.counters["SamplesPerRay"] =
+    static_cast<double>(numSamples) / static_cast<double>(rays.NumRays);
 }
 
-VTKM_BENCHMARK(BenchRayTracing);
+VTKM_BENCHMARK_OPTS(BenchVolumeSkipping,
+                      ->ArgNames({ "Skipping", "OpacityThreshold" })
+                      ->Args({ 0, 100 })
+                      ->Args({ 1, 100 })
+                      ->Args({ 0, 95 })
+                      ->Args({ 1, 95 }));
 
 } // end namespace vtkm::benchmarking
 
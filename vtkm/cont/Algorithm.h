@@ -129,6 +129,32 @@ struct CountSetBitsFunctor
   }
 };
 
+struct CountingSortFunctor
+{
+  template <typename Device, typename... Args>
+  VTKM_CONT bool operator()(Device, Args&&... args) const
+  {
+    VTKM_IS_DEVICE_ADAPTER_TAG(Device);
+    vtkm::cont::Token token;
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::CountingSort(
+      PrepareArgForExec<Device>(std::forward<Args>(args), token)...);
+    return true;
+  }
+};
+
+struct CountingSortByKeyFunctor
+{
+  template <typename Device, typename... Args>
+  VTKM_CONT bool operator()(Device, Args&&... args) const
+  {
+    VTKM_IS_DEVICE_ADAPTER_TAG(Device);
+    vtkm::cont::Token token;
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::CountingSortByKey(
+      PrepareArgForExec<Device>(std::forward<Args>(args), token)...);
+    return true;
+  }
+};
+
 struct FillFunctor
 {
   template <typename Device, typename... Args>
@@ -190,6 +216,19 @@ struct ReduceByKeyFunctor
   }
 };
 
+struct ReduceSegmentedFunctor
+{
+  template <typename Device, typename... Args>
+  VTKM_CONT bool operator()(Device, Args&&... args) const
+  {
+    VTKM_IS_DEVICE_ADAPTER_TAG(Device);
+    vtkm::cont::Token token;
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::ReduceSegmented(
+      PrepareArgForExec<Device>(std::forward<Args>(args), token)...);
+    return true;
+  }
+};
+
 template <typename U>
 struct ScanInclusiveResultFunctor
 {
@@ -262,6 +301,19 @@ struct ScanExclusiveByKeyFunctor
   }
 };
 
+struct ScanExclusiveSegmentedFunctor
+{
+  template <typename Device, typename... Args>
+  VTKM_CONT bool operator()(Device, Args&&... args) const
+  {
+    VTKM_IS_DEVICE_ADAPTER_TAG(Device);
+    vtkm::cont::Token token;
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::ScanExclusiveSegmented(
+      PrepareArgForExec<Device>(std::forward<Args>(args), token)...);
+    return true;
+  }
+};
+
 template <typename T>
 struct ScanExtendedFunctor
 {
@@ -315,6 +367,19 @@ struct SortByKeyFunctor
   }
 };
 
+struct SortSegmentedFunctor
+{
+  template <typename Device, typename... Args>
+  VTKM_CONT bool operator()(Device, Args&&... args) const
+  {
+    VTKM_IS_DEVICE_ADAPTER_TAG(Device);
+    vtkm::cont::Token token;
+    vtkm::cont::DeviceAdapterAlgorithm<Device>::SortSegmented(
+      PrepareArgForExec<Device>(std::forward<Args>(args), token)...);
+    return true;
+  }
+};
+
 struct SynchronizeFunctor
 {
   template <typename Device>
@@ -494,6 +559,57 @@ struct Algorithm
     return CountSetBits(vtkm::cont::DeviceAdapterTagAny{}, bits);
   }
 
+
+  template <typename T, class Storage>
+  VTKM_CONT static void CountingSort(vtkm::cont::DeviceAdapterId devId,
+                                     vtkm::cont::ArrayHandle<T, Storage>& keys,
+                                     vtkm::Id keyRange)
+  {
+    vtkm::cont::TryExecuteOnDevice(devId, detail::CountingSortFunctor(), keys, keyRange);
+  }
+  template <typename T, class Storage>
+  VTKM_CONT static void CountingSort(vtkm::cont::ArrayHandle<T, Storage>& keys, vtkm::Id keyRange)
+  {
+    CountingSort(vtkm::cont::DeviceAdapterTagAny(), keys, keyRange);
+  }
+
+
+  template <typename T, typename U, class StorageT, class StorageU>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::DeviceAdapterId devId,
+                                          vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange)
+  {
+    vtkm::cont::TryExecuteOnDevice(
+      devId, detail::CountingSortByKeyFunctor(), keys, values, keyRange);
+  }
+  template <typename T, typename U, class StorageT, class StorageU>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange)
+  {
+    CountingSortByKey(vtkm::cont::DeviceAdapterTagAny(), keys, values, keyRange);
+  }
+
+  template <typename T, typename U, class StorageT, class StorageU, class StorageO>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::DeviceAdapterId devId,
+                                          vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange,
+                                          vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets)
+  {
+    vtkm::cont::TryExecuteOnDevice(
+      devId, detail::CountingSortByKeyFunctor(), keys, values, keyRange, keyOffsets);
+  }
+  template <typename T, typename U, class StorageT, class StorageU, class StorageO>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange,
+                                          vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets)
+  {
+    CountingSortByKey(vtkm::cont::DeviceAdapterTagAny(), keys, values, keyRange, keyOffsets);
+  }
+
   VTKM_CONT static void Fill(vtkm::cont::DeviceAdapterId devId,
                              vtkm::cont::BitField& bits,
                              bool value,
@@ -712,6 +828,64 @@ struct Algorithm
   }
 
 
+  template <typename T, typename U, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ReduceSegmented(vtkm::cont::DeviceAdapterId devId,
+                                        const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        U initialValue)
+  {
+    vtkm::cont::TryExecuteOnDevice(
+      devId, detail::ReduceSegmentedFunctor(), input, offsets, output, initialValue);
+  }
+  template <typename T, typename U, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ReduceSegmented(const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        U initialValue)
+  {
+    ReduceSegmented(vtkm::cont::DeviceAdapterTagAny(), input, offsets, output, initialValue);
+  }
+
+
+  template <typename T,
+            typename U,
+            class CIn,
+            class COffsets,
+            class COut,
+            class BinaryFunctor>
+  VTKM_CONT static void ReduceSegmented(vtkm::cont::DeviceAdapterId devId,
+                                        const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        U initialValue,
+                                        BinaryFunctor binaryFunctor)
+  {
+    vtkm::cont::TryExecuteOnDevice(devId,
+                                   detail::ReduceSegmentedFunctor(),
+                                   input,
+                                   offsets,
+                                   output,
+                                   initialValue,
+                                   binaryFunctor);
+  }
+  template <typename T,
+            typename U,
+            class CIn,
+            class COffsets,
+            class COut,
+            class BinaryFunctor>
+  VTKM_CONT static void ReduceSegmented(const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        U initialValue,
+                                        BinaryFunctor binaryFunctor)
+  {
+    ReduceSegmented(
+      vtkm::cont::DeviceAdapterTagAny(), input, offsets, output, initialValue, binaryFunctor);
+  }
+
+
   template <typename T, class CIn, class COut>
   VTKM_CONT static T ScanInclusive(vtkm::cont::DeviceAdapterId devId,
                                    const vtkm::cont::ArrayHandle<T, CIn>& input,
@@ -882,6 +1056,56 @@ struct Algorithm
   }
 
 
+  template <typename T, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    vtkm::cont::DeviceAdapterId devId,
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output)
+  {
+    vtkm::cont::TryExecuteOnDevice(
+      devId, detail::ScanExclusiveSegmentedFunctor(), input, offsets, output);
+  }
+  template <typename T, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output)
+  {
+    ScanExclusiveSegmented(vtkm::cont::DeviceAdapterTagAny(), input, offsets, output);
+  }
+
+
+  template <typename T, class CIn, class COffsets, class COut, class BinaryFunctor>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    vtkm::cont::DeviceAdapterId devId,
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output,
+    BinaryFunctor binaryFunctor,
+    const T& initialValue)
+  {
+    vtkm::cont::TryExecuteOnDevice(devId,
+                                   detail::ScanExclusiveSegmentedFunctor(),
+                                   input,
+                                   offsets,
+                                   output,
+                                   binaryFunctor,
+                                   initialValue);
+  }
+  template <typename T, class CIn, class COffsets, class COut, class BinaryFunctor>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output,
+    BinaryFunctor binaryFunctor,
+    const T& initialValue)
+  {
+    ScanExclusiveSegmented(
+      vtkm::cont::DeviceAdapterTagAny(), input, offsets, output, binaryFunctor, initialValue);
+  }
+
+
   template <typename T, class CIn, class COut>
   VTKM_CONT static void ScanExtended(vtkm::cont::DeviceAdapterId devId,
                                      const vtkm::cont::ArrayHandle<T, CIn>& input,
@@ -1005,6 +1229,39 @@ struct Algorithm
   }
 
 
+  template <typename T, class Storage, class COffsets>
+  VTKM_CONT static void SortSegmented(vtkm::cont::DeviceAdapterId devId,
+                                      vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets)
+  {
+    vtkm::cont::TryExecuteOnDevice(devId, detail::SortSegmentedFunctor(), values, offsets);
+  }
+  template <typename T, class Storage, class COffsets>
+  VTKM_CONT static void SortSegmented(vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets)
+  {
+    SortSegmented(vtkm::cont::DeviceAdapterTagAny(), values, offsets);
+  }
+
+
+  template <typename T, class Storage, class COffsets, class BinaryCompare>
+  VTKM_CONT static void SortSegmented(vtkm::cont::DeviceAdapterId devId,
+                                      vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                      BinaryCompare binary_compare)
+  {
+    vtkm::cont::TryExecuteOnDevice(
+      devId, detail::SortSegmentedFunctor(), values, offsets, binary_compare);
+  }
+  template <typename T, class Storage, class COffsets, class BinaryCompare>
+  VTKM_CONT static void SortSegmented(vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                      BinaryCompare binary_compare)
+  {
+    SortSegmented(vtkm::cont::DeviceAdapterTagAny(), values, offsets, binary_compare);
+  }
+
+
   VTKM_CONT static void Synchronize(vtkm::cont::DeviceAdapterId devId)
   {
     vtkm::cont::TryExecuteOnDevice(devId, detail::SynchronizeFunctor());
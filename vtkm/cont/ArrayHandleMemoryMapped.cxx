@@ -0,0 +1,202 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandleMemoryMapped.h>
+
+#include <vtkm/Math.h>
+
+#include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/Logging.h>
+
+#include <cstdlib>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VTKM_HAS_MMAP
+#endif
+
+namespace
+{
+
+/// Holds either the file mapping or, when the file could not be mapped, a regular allocation
+/// with the values read from it.
+struct MappedFileContainer
+{
+  void* MapBase = nullptr;
+  std::size_t MapLength = 0;
+  void* Copy = nullptr;
+};
+
+void ReleaseMapping(MappedFileContainer* container)
+{
+#if defined(VTKM_HAS_MMAP)
+  if (container->MapBase != nullptr)
+  {
+    munmap(container->MapBase, container->MapLength);
+  }
+#endif
+  container->MapBase = nullptr;
+  container->MapLength = 0;
+}
+
+void MappedFileDeleter(void* containerPointer)
+{
+  MappedFileContainer* container = reinterpret_cast<MappedFileContainer*>(containerPointer);
+  ReleaseMapping(container);
+  std::free(container->Copy);
+  delete container;
+}
+
+vtkm::cont::internal::Buffer ReadFileToBuffer(const std::string& fileName,
+                                              vtkm::BufferSizeType offset,
+                                              vtkm::BufferSizeType numberOfBytes)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not open " + fileName + " to map into an array.");
+  }
+  const vtkm::BufferSizeType fileSize = static_cast<vtkm::BufferSizeType>(file.tellg());
+  if (numberOfBytes < 0)
+  {
+    numberOfBytes = vtkm::Max(fileSize - offset, vtkm::BufferSizeType(0));
+  }
+  if (offset + numberOfBytes > fileSize)
+  {
+    throw vtkm::cont::ErrorBadValue("File " + fileName + " is too small for the requested array.");
+  }
+
+  MappedFileContainer* container = new MappedFileContainer;
+  container->Copy =
+    std::malloc(static_cast<std::size_t>(vtkm::Max(numberOfBytes, vtkm::BufferSizeType(1))));
+  if (container->Copy == nullptr)
+  {
+    delete container;
+    throw vtkm::cont::ErrorBadAllocation("Could not allocate memory to read " + fileName);
+  }
+  file.seekg(offset);
+  file.read(reinterpret_cast<char*>(container->Copy), static_cast<std::streamsize>(numberOfBytes));
+  if (!file || (file.gcount() != static_cast<std::streamsize>(numberOfBytes)))
+  {
+    MappedFileDeleter(container);
+    throw vtkm::cont::ErrorBadValue("Could not read " + std::to_string(numberOfBytes) +
+                                    " bytes from " + fileName);
+  }
+  return vtkm::cont::internal::MakeBuffer(vtkm::cont::DeviceAdapterTagUndefined{},
+                                          container->Copy,
+                                          container,
+                                          numberOfBytes,
+                                          MappedFileDeleter,
+                                          vtkm::cont::internal::InvalidRealloc);
+}
+
+vtkm::cont::internal::Buffer MapFileToBuffer(const std::string& fileName,
+                                             vtkm::BufferSizeType offset,
+                                             vtkm::BufferSizeType numberOfBytes,
+                                             vtkm::cont::MemoryMapMode mode)
+{
+  if (offset < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Offset into memory mapped file cannot be negative.");
+  }
+
+#if defined(VTKM_HAS_MMAP)
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Could not open " + fileName + " to map into an array.");
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0)
+  {
+    close(fd);
+    throw vtkm::cont::ErrorBadValue("Could not get the size of " + fileName);
+  }
+  const vtkm::BufferSizeType fileSize = static_cast<vtkm::BufferSizeType>(fileStat.st_size);
+  if (numberOfBytes < 0)
+  {
+    numberOfBytes = vtkm::Max(fileSize - offset, vtkm::BufferSizeType(0));
+  }
+  if (offset + numberOfBytes > fileSize)
+  {
+    close(fd);
+    throw vtkm::cont::ErrorBadValue("File " + fileName + " is too small for the requested array.");
+  }
+  if (numberOfBytes == 0)
+  {
+    close(fd);
+    return vtkm::cont::internal::Buffer{};
+  }
+
+  // mmap requires the file offset to be a multiple of the page size, so map from the start of
+  // the page holding the first value.
+  const vtkm::BufferSizeType pageSize = static_cast<vtkm::BufferSizeType>(sysconf(_SC_PAGESIZE));
+  const vtkm::BufferSizeType mapOffset = (offset / pageSize) * pageSize;
+  const std::size_t mapLength = static_cast<std::size_t>(numberOfBytes + (offset - mapOffset));
+  const int protection =
+    (mode == vtkm::cont::MemoryMapMode::ReadOnly) ? PROT_READ : (PROT_READ | PROT_WRITE);
+  void* mapBase =
+    mmap(nullptr, mapLength, protection, MAP_PRIVATE, fd, static_cast<off_t>(mapOffset));
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (mapBase == MAP_FAILED)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+               "Could not memory map " << fileName << ". Reading it instead.");
+    return ReadFileToBuffer(fileName, offset, numberOfBytes);
+  }
+
+  MappedFileContainer* container = new MappedFileContainer;
+  container->MapBase = mapBase;
+  container->MapLength = mapLength;
+  void* memory = reinterpret_cast<char*>(mapBase) + (offset - mapOffset);
+  VTKM_LOG_S(vtkm::cont::LogLevel::MemCont,
+             "Memory mapped " << vtkm::cont::GetSizeString(numberOfBytes) << " of " << fileName);
+  return vtkm::cont::internal::MakeBuffer(vtkm::cont::DeviceAdapterTagUndefined{},
+                                          memory,
+                                          container,
+                                          numberOfBytes,
+                                          MappedFileDeleter,
+                                          vtkm::cont::internal::InvalidRealloc);
+#else
+  (void)mode;
+  return ReadFileToBuffer(fileName, offset, numberOfBytes);
+#endif
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+vtkm::cont::internal::Buffer MakeMemoryMappedBuffer(const std::string& fileName,
+                                                    vtkm::BufferSizeType offset,
+                                                    vtkm::BufferSizeType numberOfBytes,
+                                                    vtkm::cont::MemoryMapMode mode)
+{
+  vtkm::cont::internal::Buffer buffer = MapFileToBuffer(fileName, offset, numberOfBytes, mode);
+  // Writing to pages mapped with PROT_READ would crash, so fail early instead. The fallback
+  // that reads the file behaves the same way so the mode means the same on every platform.
+  buffer.SetReadOnly(mode == vtkm::cont::MemoryMapMode::ReadOnly);
+  return buffer;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
+
@@ -0,0 +1,107 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_ArrayHandleMemoryMapped_h
+#define vtk_m_cont_ArrayHandleMemoryMapped_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/ArrayHandleBasic.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/internal/Buffer.h>
+
+#include <string>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief How the memory of a file mapped into an `ArrayHandle` may be used.
+///
+enum class MemoryMapMode
+{
+  /// The file is mapped read-only. Requesting write access to the array (for example by passing
+  /// it as the output of a worklet or getting its `WritePortal`) throws
+  /// `vtkm::cont::ErrorBadValue`.
+  ReadOnly,
+
+  /// The file is mapped copy-on-write. The array can be written, but changes are private to the
+  /// array and never written back to the file. Only the pages that are written take extra memory.
+  CopyOnWrite
+};
+
+namespace internal
+{
+
+/// Maps a region of a file into a host `Buffer` without reading it. `numberOfBytes` of -1 maps
+/// the rest of the file after `offset`. Throws `vtkm::cont::ErrorBadValue` if the file cannot be
+/// opened, is too small, or cannot be read. In `ReadOnly` mode the buffer is marked read-only.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::Buffer MakeMemoryMappedBuffer(
+  const std::string& fileName,
+  vtkm::BufferSizeType offset,
+  vtkm::BufferSizeType numberOfBytes,
+  vtkm::cont::MemoryMapMode mode);
+
+} // namespace internal
+
+/// \brief Creates an `ArrayHandle` whose values are read directly from a file.
+///
+/// The file region starting `offset` bytes into the file is mapped into memory with `mmap`
+/// and wrapped in an `ArrayHandleBasic` without copying it. Pages are read from the file the
+/// first time they are touched, and because they are backed by the file the operating system
+/// can drop them again under memory pressure. Large fields stored as raw binary files can so
+/// be used by filters without reading them up front and without holding a second copy in
+/// memory.
+///
+/// The values in the file must be stored in the native layout of `T`. If `numberOfValues` is
+/// -1 (the default), the array covers the rest of the file. The mapping is released when the
+/// last copy of the array is destroyed. Like other arrays wrapping memory they do not own,
+/// mapped arrays cannot be resized.
+///
+/// Because the result is an `ArrayHandleBasic`, it can be used anywhere an array of basic
+/// storage can, including `vtkm::cont::UnknownArrayHandle` and `vtkm::cont::DataSet`:
+///
+/// \code{cpp}
+/// auto pressure = vtkm::cont::make_ArrayHandleMemoryMapped<vtkm::Float32>("pressure.raw");
+/// dataSet.AddPointField("pressure", pressure);
+/// \endcode
+///
+/// On platforms without `mmap`, the file region is read into memory instead.
+///
+template <typename T>
+VTKM_CONT vtkm::cont::ArrayHandleBasic<T> make_ArrayHandleMemoryMapped(
+  const std::string& fileName,
+  vtkm::Id numberOfValues = -1,
+  vtkm::BufferSizeType offset = 0,
+  vtkm::cont::MemoryMapMode mode = vtkm::cont::MemoryMapMode::ReadOnly)
+{
+  if ((offset % static_cast<vtkm::BufferSizeType>(alignof(T))) != 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Offset into memory mapped file " + fileName +
+                                    " is not aligned for the value type.");
+  }
+  const vtkm::BufferSizeType numberOfBytes = (numberOfValues < 0)
+    ? -1
+    : vtkm::internal::NumberOfValuesToNumberOfBytes<T>(numberOfValues);
+  vtkm::cont::internal::Buffer buffer =
+    vtkm::cont::internal::MakeMemoryMappedBuffer(fileName, offset, numberOfBytes, mode);
+  if ((buffer.GetNumberOfBytes() % static_cast<vtkm::BufferSizeType>(sizeof(T))) != 0)
+  {
+    throw vtkm::cont::ErrorBadValue("Size of memory mapped file " + fileName +
+                                    " is not a multiple of the value size.");
+  }
+  return vtkm::cont::ArrayHandle<T, vtkm::cont::StorageTagBasic>(
+    std::vector<vtkm::cont::internal::Buffer>{ buffer });
+}
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ArrayHandleMemoryMapped_h
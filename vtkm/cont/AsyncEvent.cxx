@@ -0,0 +1,226 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/AsyncEvent.h>
+
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/openmp/internal/DeviceAdapterTagOpenMP.h>
+#include <vtkm/cont/serial/internal/DeviceAdapterTagSerial.h>
+#include <vtkm/cont/tbb/internal/DeviceAdapterTagTBB.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#ifdef VTKM_ENABLE_TBB
+#include <tbb/task_arena.h>
+#endif
+
+namespace vtkm
+{
+namespace cont
+{
+namespace detail
+{
+
+struct AsyncEventState
+{
+  std::mutex Mutex;
+  std::condition_variable CompleteCondition;
+  bool Complete = false;
+  std::exception_ptr Error;
+
+  vtkm::cont::Token Token;
+  std::function<void()> Task;
+
+  AsyncEventState(vtkm::cont::Token&& token, std::function<void()>&& task)
+    : Token(std::move(token))
+    , Task(std::move(task))
+  {
+  }
+
+  void Run()
+  {
+    std::exception_ptr error;
+    try
+    {
+      this->Task();
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    // Release the execution objects and then the arrays so that anything waiting on the
+    // arrays can proceed as soon as the event is complete.
+    this->Task = nullptr;
+    this->Token.DetachFromAll();
+
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Error = error;
+    this->Complete = true;
+    this->CompleteCondition.notify_all();
+  }
+};
+
+} // namespace detail
+} // namespace vtkm::cont
+} // namespace vtkm
+
+namespace
+{
+
+// A simple pool of threads used to run asynchronous tasks for the host devices that do not
+// have their own task scheduler.
+class HostThreadPool
+{
+public:
+  HostThreadPool()
+  {
+    const unsigned int numThreads = std::max(2u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+      this->Threads.emplace_back([this]() { this->Work(); });
+    }
+  }
+
+  void Enqueue(std::function<void()>&& task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Queue.push_back(std::move(task));
+    }
+    this->QueueCondition.notify_one();
+  }
+
+private:
+  void Work()
+  {
+    while (true)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->QueueCondition.wait(lock, [this]() { return !this->Queue.empty(); });
+        task = std::move(this->Queue.front());
+        this->Queue.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex Mutex;
+  std::condition_variable QueueCondition;
+  std::deque<std::function<void()>> Queue;
+  std::vector<std::thread> Threads;
+};
+
+HostThreadPool& GetHostThreadPool()
+{
+  // The pool is intentionally never destroyed. Its threads are idle (or the program is
+  // exiting with work outstanding) by the time static objects are destroyed.
+  static HostThreadPool* pool = new HostThreadPool;
+  return *pool;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+AsyncEvent::AsyncEvent() = default;
+
+bool AsyncEvent::IsComplete() const
+{
+  if (!this->State)
+  {
+    return true;
+  }
+  std::lock_guard<std::mutex> lock(this->State->Mutex);
+  return this->State->Complete;
+}
+
+void AsyncEvent::Wait() const
+{
+  if (!this->State)
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(this->State->Mutex);
+  this->State->CompleteCondition.wait(lock, [this]() { return this->State->Complete; });
+  if (this->State->Error)
+  {
+    std::rethrow_exception(this->State->Error);
+  }
+}
+
+void WaitAll(const std::vector<vtkm::cont::AsyncEvent>& events)
+{
+  std::exception_ptr firstError;
+  for (const vtkm::cont::AsyncEvent& event : events)
+  {
+    try
+    {
+      event.Wait();
+    }
+    catch (...)
+    {
+      if (!firstError)
+      {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  if (firstError)
+  {
+    std::rethrow_exception(firstError);
+  }
+}
+
+vtkm::cont::AsyncEvent LaunchAsync(vtkm::cont::DeviceAdapterId device,
+                                   vtkm::cont::Token&& token,
+                                   std::function<void()>&& task)
+{
+  vtkm::cont::AsyncEvent event;
+  event.State = std::make_shared<detail::AsyncEventState>(std::move(token), std::move(task));
+  std::shared_ptr<detail::AsyncEventState> state = event.State;
+
+#ifdef VTKM_ENABLE_TBB
+  if (device == vtkm::cont::DeviceAdapterTagTBB{})
+  {
+    // Enqueued tasks are guaranteed to be picked up by a worker thread even if the calling
+    // thread later blocks waiting on one of the arrays the task holds.
+    static ::tbb::task_arena* arena = new ::tbb::task_arena;
+    arena->enqueue([state]() { state->Run(); });
+    return event;
+  }
+#endif
+
+  if ((device == vtkm::cont::DeviceAdapterTagSerial{}) ||
+      (device == vtkm::cont::DeviceAdapterTagOpenMP{}))
+  {
+    GetHostThreadPool().Enqueue([state]() { state->Run(); });
+    return event;
+  }
+
+  // Devices with their own execution streams are run on the calling thread.
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "Running asynchronous task synchronously on " << device.GetName());
+  state->Run();
+  return event;
+}
+
+}
+} // namespace vtkm::cont
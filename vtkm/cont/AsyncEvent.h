@@ -0,0 +1,91 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_AsyncEvent_h
+#define vtk_m_cont_AsyncEvent_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/DeviceAdapterTag.h>
+#include <vtkm/cont/Token.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct AsyncEventState;
+
+} // namespace detail
+
+class AsyncEvent;
+
+/// \brief Runs a task asynchronously.
+///
+/// This is used by the dispatchers to implement `Invoker::Async` and should rarely be needed
+/// elsewhere. The token is held until `task` returns. Tasks for the TBB device are enqueued
+/// in a TBB task arena. Tasks for the serial and OpenMP devices are run by a pool of host
+/// threads. Tasks for any other device are run immediately on the calling thread.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::AsyncEvent LaunchAsync(vtkm::cont::DeviceAdapterId device,
+                                                            vtkm::cont::Token&& token,
+                                                            std::function<void()>&& task);
+
+/// \brief Tracks the completion of an asynchronous invocation.
+///
+/// An `AsyncEvent` is returned from `vtkm::cont::Invoker::Async`. The event owns the
+/// `vtkm::cont::Token` that the arguments of the invocation were prepared with, so the
+/// `ArrayHandle`s read and written by the invocation stay attached until the invocation finishes.
+/// This provides the dependency tracking between invocations: any later access to an array
+/// written by the invocation (from another invocation or from a portal in the control
+/// environment) blocks until the invocation completes, whereas invocations that only share
+/// arrays for reading run concurrently.
+///
+/// Errors raised while the worklet runs are rethrown from `Wait`. Dropping an `AsyncEvent`
+/// without waiting on it is allowed; the invocation still runs to completion.
+///
+/// A default constructed `AsyncEvent` is already complete.
+///
+class VTKM_CONT_EXPORT AsyncEvent
+{
+public:
+  VTKM_CONT AsyncEvent();
+
+  /// Returns true if the invocation has finished (successfully or not).
+  ///
+  VTKM_CONT bool IsComplete() const;
+
+  /// Blocks until the invocation finishes. If the invocation raised an error, it is rethrown.
+  ///
+  VTKM_CONT void Wait() const;
+
+private:
+  friend vtkm::cont::AsyncEvent LaunchAsync(vtkm::cont::DeviceAdapterId,
+                                            vtkm::cont::Token&&,
+                                            std::function<void()>&&);
+
+  std::shared_ptr<detail::AsyncEventState> State;
+};
+
+/// Waits for all of the given events. If any of them raised an error, the first error is
+/// rethrown after all of the events are complete.
+///
+VTKM_CONT_EXPORT VTKM_CONT void WaitAll(const std::vector<vtkm::cont::AsyncEvent>& events);
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_AsyncEvent_h
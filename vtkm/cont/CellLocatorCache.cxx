@@ -0,0 +1,172 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/CellLocatorCache.h>
+
+#include <vtkm/cont/internal/MeshKey.h>
+
+#include <list>
+#include <mutex>
+
+namespace
+{
+
+using MeshKey = vtkm::cont::internal::MeshKey;
+
+MeshKey MakeKey(std::type_index locatorType,
+                const vtkm::cont::DynamicCellSet& cellSet,
+                const vtkm::cont::CoordinateSystem& coords)
+{
+  MeshKey key;
+  key.AddType(locatorType);
+  key.AddCellSet(cellSet);
+  key.AddCoordinates(coords);
+  return key;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+struct CellLocatorCache::InternalsStruct
+{
+  struct Entry
+  {
+    MeshKey Key;
+    std::shared_ptr<void> Locator;
+  };
+
+  std::mutex Mutex;
+  // Ordered from the most to the least recently used.
+  std::list<Entry> Entries;
+  vtkm::Id Capacity = 0;
+  vtkm::Id NumberOfHits = 0;
+  vtkm::Id NumberOfMisses = 0;
+
+  void Trim()
+  {
+    while (static_cast<vtkm::Id>(this->Entries.size()) > this->Capacity)
+    {
+      this->Entries.pop_back();
+    }
+  }
+};
+
+CellLocatorCache::CellLocatorCache(vtkm::Id capacity)
+  : Internals(new InternalsStruct)
+{
+  this->Internals->Capacity = vtkm::Max(capacity, vtkm::Id(0));
+}
+
+CellLocatorCache::~CellLocatorCache() = default;
+
+std::shared_ptr<void> CellLocatorCache::Find(std::type_index locatorType,
+                                             const vtkm::cont::DynamicCellSet& cellSet,
+                                             const vtkm::cont::CoordinateSystem& coords)
+{
+  MeshKey key = MakeKey(locatorType, cellSet, coords);
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  auto& entries = this->Internals->Entries;
+  if (key.IsCacheable())
+  {
+    for (auto entry = entries.begin(); entry != entries.end(); ++entry)
+    {
+      if (!entry->Key.IsSameMesh(key))
+      {
+        continue;
+      }
+      if (entry->Key.IsModified(key))
+      {
+        // The mesh changed since the locator was built. The locator will not be used again.
+        entries.erase(entry);
+        break;
+      }
+      entries.splice(entries.begin(), entries, entry);
+      ++this->Internals->NumberOfHits;
+      return entry->Locator;
+    }
+  }
+  ++this->Internals->NumberOfMisses;
+  return nullptr;
+}
+
+void CellLocatorCache::Add(std::type_index locatorType,
+                           const vtkm::cont::DynamicCellSet& cellSet,
+                           const vtkm::cont::CoordinateSystem& coords,
+                           const std::shared_ptr<void>& locator)
+{
+  InternalsStruct::Entry entry;
+  entry.Key = MakeKey(locatorType, cellSet, coords);
+  if (!entry.Key.IsCacheable())
+  {
+    return;
+  }
+  entry.Locator = locator;
+
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  if (this->Internals->Capacity < 1)
+  {
+    return;
+  }
+  this->Internals->Entries.push_front(std::move(entry));
+  this->Internals->Trim();
+}
+
+void CellLocatorCache::SetCapacity(vtkm::Id capacity)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Capacity = vtkm::Max(capacity, vtkm::Id(0));
+  this->Internals->Trim();
+}
+
+vtkm::Id CellLocatorCache::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->Capacity;
+}
+
+vtkm::Id CellLocatorCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkm::Id>(this->Internals->Entries.size());
+}
+
+vtkm::Id CellLocatorCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfHits;
+}
+
+vtkm::Id CellLocatorCache::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumberOfMisses;
+}
+
+void CellLocatorCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Entries.clear();
+  this->Internals->NumberOfHits = 0;
+  this->Internals->NumberOfMisses = 0;
+}
+
+vtkm::cont::CellLocatorCache& GetCellLocatorCache()
+{
+  static vtkm::cont::CellLocatorCache cache(0);
+  return cache;
+}
+
+}
+} // namespace vtkm::cont
@@ -0,0 +1,120 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_CellLocatorCache_h
+#define vtk_m_cont_CellLocatorCache_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/DynamicCellSet.h>
+
+#include <memory>
+#include <typeindex>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief Keeps built cell locators so that they can be reused for the same mesh.
+///
+/// Building a cell locator such as `CellLocatorTwoLevel` can cost more than the search it is
+/// built for. When a mesh stays the same over several time steps and only its fields change,
+/// filters like `Probe`, `ParticleAdvection` and `Streamline` would otherwise build the same
+/// locator on every execution.
+///
+/// `GetLocator` returns a built locator for a cell set and coordinate system. A locator is
+/// reused when it was built for the same type of locator, the same arrays of the cell set and
+/// coordinates (compared by identity, not by value) and the same point dimensions for
+/// structured cell sets. A locator is rebuilt when one of those arrays was modified since it
+/// was built, as reported by `Buffer::GetModifiedCount`. Cell sets and coordinates of types
+/// that are not in `VTKM_DEFAULT_CELL_SET_LIST` or the coordinate system's type lists are not
+/// cached.
+///
+/// Each cached locator keeps its mesh alive, along with the search structures of the locator,
+/// until it is evicted or `Clear` is called. The cache holds at most `GetCapacity` locators and
+/// evicts the one used least recently. A capacity of 0 disables caching.
+///
+/// The filters consult the cache returned by `vtkm::cont::GetCellLocatorCache()`. That cache
+/// starts with a capacity of 0 so that no mesh is kept without asking for it. Give it a capacity
+/// to reuse locators across filter executions, and call `Clear` (or set the capacity back to 0)
+/// to release the meshes it holds.
+///
+class VTKM_CONT_EXPORT CellLocatorCache
+{
+public:
+  /// Creates a cache that holds up to `capacity` locators.
+  ///
+  VTKM_CONT explicit CellLocatorCache(vtkm::Id capacity = 4);
+  VTKM_CONT ~CellLocatorCache();
+
+  CellLocatorCache(const CellLocatorCache&) = delete;
+  CellLocatorCache& operator=(const CellLocatorCache&) = delete;
+
+  /// Returns a locator of type `LocatorType` for the given mesh. The locator is built (or
+  /// taken from the cache) before it is returned.
+  ///
+  template <typename LocatorType>
+  VTKM_CONT LocatorType GetLocator(const vtkm::cont::DynamicCellSet& cellSet,
+                                   const vtkm::cont::CoordinateSystem& coords)
+  {
+    std::shared_ptr<void> cached = this->Find(typeid(LocatorType), cellSet, coords);
+    if (cached)
+    {
+      return *static_cast<LocatorType*>(cached.get());
+    }
+
+    auto locator = std::make_shared<LocatorType>();
+    locator->SetCellSet(cellSet);
+    locator->SetCoordinates(coords);
+    locator->Update();
+    this->Add(typeid(LocatorType), cellSet, coords, locator);
+    return *locator;
+  }
+
+  /// The largest number of locators held. Lowering the capacity evicts locators.
+  ///
+  VTKM_CONT void SetCapacity(vtkm::Id capacity);
+  VTKM_CONT vtkm::Id GetCapacity() const;
+
+  VTKM_CONT vtkm::Id GetNumberOfEntries() const;
+
+  /// The number of times `GetLocator` returned a cached locator or had to build one.
+  ///
+  VTKM_CONT vtkm::Id GetNumberOfHits() const;
+  VTKM_CONT vtkm::Id GetNumberOfMisses() const;
+
+  /// Removes all locators and resets the hit and miss counts.
+  ///
+  VTKM_CONT void Clear();
+
+private:
+  struct InternalsStruct;
+  std::unique_ptr<InternalsStruct> Internals;
+
+  VTKM_CONT std::shared_ptr<void> Find(std::type_index locatorType,
+                                       const vtkm::cont::DynamicCellSet& cellSet,
+                                       const vtkm::cont::CoordinateSystem& coords);
+  VTKM_CONT void Add(std::type_index locatorType,
+                     const vtkm::cont::DynamicCellSet& cellSet,
+                     const vtkm::cont::CoordinateSystem& coords,
+                     const std::shared_ptr<void>& locator);
+};
+
+/// \brief Returns the cell locator cache shared by the filters.
+///
+/// The cache is disabled (has a capacity of 0) until its capacity is set.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::CellLocatorCache& GetCellLocatorCache();
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_CellLocatorCache_h
@@ -11,6 +11,7 @@
 #define vtk_m_cont_CellLocatorChooser_h
 
 #include <vtkm/cont/CastAndCall.h>
+#include <vtkm/cont/CellLocatorCache.h>
 #include <vtkm/cont/CellLocatorRectilinearGrid.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 #include <vtkm/cont/CellLocatorUniformGrid.h>
@@ -74,9 +75,9 @@ struct CastAndCallCellLocatorChooserFunctor
                               Functor&& functor,
                               Args&&... args) const
   {
-    CellLocatorType locator;
-    locator.SetCellSet(cellSet);
-    locator.SetCoordinates(coordinateSystem);
+    // The locator is reused if it was already built for this mesh.
+    CellLocatorType locator =
+      vtkm::cont::GetCellLocatorCache().GetLocator<CellLocatorType>(cellSet, coordinateSystem);
 
     functor(locator, std::forward<Args>(args)...);
   }
@@ -122,7 +123,8 @@ struct CastAndCallCellLocatorChooserFunctor
 ///
 /// Given a cell set and a coordinate system of unknown types, calls a functor with an appropriate
 /// CellLocator of the given type. The CellLocator is populated with the provided cell set and
-/// coordinate system.
+/// coordinate system and built, or taken from `vtkm::cont::GetCellLocatorCache()` if that cache
+/// is enabled and the locator was already built for the same mesh.
 ///
 /// Any additional args are passed to the functor.
 ///
@@ -121,6 +121,30 @@ struct DeviceAdapterAlgorithm
   /// \brief Returns the total number of "1" bits in BitField.
   VTKM_CONT static vtkm::Id CountSetBits(const vtkm::cont::BitField& bits);
 
+  /// \brief Stable sort of integer keys known to be in the range [0, \c keyRange).
+  ///
+  /// Sorts the keys (and moves the values with them) with a counting sort, which takes time
+  /// linear in the number of keys and \c keyRange rather than comparing keys. Equal keys keep
+  /// their original order. When \c keyOffsets is given, it is filled with \c keyRange + 1
+  /// values where entry \c k is the index of the first sorted key equal to \c k (the last
+  /// entry is the number of keys). A key outside the range is an execution error.
+  ///
+  /// This is faster than \c Sort or \c SortByKey when the range of the keys is dense and
+  /// known up front, such as cell shapes, point ids, or histogram bins.
+  /// @{
+  template <typename T, class Storage>
+  VTKM_CONT static void CountingSort(vtkm::cont::ArrayHandle<T, Storage>& keys, vtkm::Id keyRange);
+  template <typename T, typename U, class StorageT, class StorageU>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange);
+  template <typename T, typename U, class StorageT, class StorageU, class StorageO>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange,
+                                          vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets);
+  /// @}
+
   /// \brief Fill the BitField with a specific pattern of bits.
   /// For boolean values, all bits are set to 1 if value is true, or 0 if value
   /// is false.
@@ -236,6 +260,29 @@ struct DeviceAdapterAlgorithm
                                     vtkm::cont::ArrayHandle<U, CValOut>& values_output,
                                     BinaryFunctor binary_functor);
 
+  /// \brief Reduce each segment of the input to a single value.
+  ///
+  /// The segments are given by \c offsets, which has one more entry than there are
+  /// segments: segment \c s holds the values in [offsets[s], offsets[s+1]). The
+  /// \c output is resized to the number of segments, and each entry is the
+  /// reduction of its segment with \c binaryFunctor (vtkm::Add when not given)
+  /// starting from \c initialValue. Empty segments reduce to \c initialValue.
+  ///
+  /// Unlike \c ReduceByKey, no per-value keys are needed. The segments are
+  /// processed in parallel, so this works best when there are many segments.
+  ///
+  template <typename T,
+            typename U,
+            class CIn,
+            class COffsets,
+            class COut,
+            class BinaryFunctor>
+  VTKM_CONT static void ReduceSegmented(const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        const U& initialValue,
+                                        BinaryFunctor binaryFunctor);
+
   /// \brief Compute an inclusive prefix sum operation on the input ArrayHandle.
   ///
   /// Computes an inclusive prefix sum operation on the \c input ArrayHandle,
@@ -367,6 +414,25 @@ struct DeviceAdapterAlgorithm
                                            const vtkm::cont::ArrayHandle<U, VIn>& values,
                                            vtkm::cont::ArrayHandle<U, VOut>& output);
 
+  /// \brief Compute an exclusive prefix sum within each segment of the input.
+  ///
+  /// The segments are given by \c offsets, which has one more entry than there are
+  /// segments: segment \c s holds the values in [offsets[s], offsets[s+1]). Each
+  /// segment is scanned independently with \c binaryFunctor (vtkm::Sum when not
+  /// given), starting from \c initialValue (zero when not given). The \c output
+  /// has the same size as the \c input, and the two may be the same array.
+  ///
+  /// This gives the same result as \c ScanExclusiveByKey without needing a key
+  /// for every value. The segments are processed in parallel.
+  ///
+  template <typename T, class CIn, class COffsets, class COut, class BinaryFunctor>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output,
+    BinaryFunctor binaryFunctor,
+    const T& initialValue);
+
   /// \brief Compute an extended prefix sum operation on the input ArrayHandle.
   ///
   /// Computes an extended prefix sum operation on the \c input ArrayHandle,
@@ -501,6 +567,22 @@ struct DeviceAdapterAlgorithm
                                   vtkm::cont::ArrayHandle<U, StorageU>& values,
                                   BinaryCompare binary_compare)
 
+  /// \brief Unstable sort of each segment of an array.
+  ///
+  /// Sorts the values of each segment of \c values in place, leaving the segments
+  /// where they are. The segments are given by \c offsets as in \c ReduceSegmented.
+  /// The order is ascending or given by \c binary_compare, which should be a
+  /// strict weak ordering comparison operator.
+  ///
+  /// The segments are processed in parallel, each by a single thread, which suits
+  /// many short segments such as the neighbors of each point or the values in each
+  /// bin. To sort a few long segments, use \c SortByKey instead.
+  ///
+  template <typename T, class Storage, class COffsets, class BinaryCompare>
+  VTKM_CONT static void SortSegmented(vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                      BinaryCompare binary_compare);
+
     /// \brief Completes any asynchronous operations running on the device.
     ///
     /// Waits for any asynchronous operations running on the device to complete.
@@ -11,14 +11,19 @@
 #include <vtkm/cont/Initialize.h>
 
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/MemoryTracker.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/WorkletProfiler.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/cont/internal/OptionParserArguments.h>
+#include <vtkm/cont/internal/RuntimeDeviceOption.h>
 
 #if defined(VTKM_ENABLE_KOKKOS)
 #include <vtkm/cont/kokkos/internal/Initialize.h>
 #endif
 
+#include <cstdlib>
 #include <memory>
 #include <sstream>
 
@@ -27,6 +32,19 @@ namespace opt = vtkm::cont::internal::option;
 namespace
 {
 
+void PrintMemoryReportAtExit()
+{
+  vtkm::cont::GetMemoryTracker().PrintReport(std::cerr);
+}
+
+// Never destroyed so that it is still valid when the exit handler runs.
+std::string* WorkletTraceFileName = nullptr;
+
+void WriteWorkletTraceAtExit()
+{
+  vtkm::cont::GetWorkletProfiler().WriteChromeTrace(*WorkletTraceFileName);
+}
+
 struct VtkmDeviceArg : public opt::Arg
 {
   static opt::ArgStatus IsDevice(const opt::Option& option, bool msg)
@@ -183,6 +201,35 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
     // Bring in extra args used by the runtime device configuration options
     vtkm::cont::internal::RuntimeDeviceConfigurationOptions runtimeDeviceOptions(usage);
 
+    usage.push_back({ opt::OptionIndex::HOST_POOL_MAX_CACHED_MB,
+                      0,
+                      "",
+                      "vtkm-host-pool-max-cached-mb",
+                      opt::VtkmArg::Required,
+                      "  --vtkm-host-pool-max-cached-mb <#> \tSets the maximum number of megabytes "
+                      "the host memory pool keeps cached for reuse (0 disables caching)" });
+    usage.push_back({ opt::OptionIndex::HOST_POOL_TRIM_ON_IDLE,
+                      0,
+                      "",
+                      "vtkm-host-pool-trim-on-idle",
+                      opt::VtkmArg::Required,
+                      "  --vtkm-host-pool-trim-on-idle <0|1> \tRelease the host memory pool cache "
+                      "whenever no host arrays are allocated" });
+    usage.push_back({ opt::OptionIndex::MEMORY_REPORT,
+                      0,
+                      "",
+                      "vtkm-memory-report",
+                      opt::Arg::None,
+                      "  --vtkm-memory-report \tPrint the peak memory used by each device and "
+                      "filter when the program exits" });
+    usage.push_back({ opt::OptionIndex::PROFILE_WORKLETS,
+                      0,
+                      "",
+                      "vtkm-profile-worklets",
+                      opt::VtkmArg::Required,
+                      "  --vtkm-profile-worklets <file> \tRecord every worklet invocation and "
+                      "write a Chrome trace of them to the file when the program exits" });
+
     // Required to collect unknown arguments when help is off.
     usage.push_back({ opt::OptionIndex::UNKNOWN, 0, "", "", opt::VtkmArg::UnknownOption, "" });
     usage.push_back({ 0, 0, 0, 0, 0, 0 });
@@ -356,6 +403,60 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
       vtkm::cont::RuntimeDeviceInformation runtimeDevice;
       runtimeDevice.GetRuntimeConfiguration(config.Device, runtimeDeviceOptions, argc, argv);
     }
+
+    {
+      vtkm::cont::internal::RuntimeDeviceOption maxCachedMB(
+        opt::OptionIndex::HOST_POOL_MAX_CACHED_MB, "VTKM_HOST_POOL_MAX_CACHED_MB");
+      vtkm::cont::internal::RuntimeDeviceOption trimOnIdle(opt::OptionIndex::HOST_POOL_TRIM_ON_IDLE,
+                                                           "VTKM_HOST_POOL_TRIM_ON_IDLE");
+      maxCachedMB.Initialize(options.get());
+      trimOnIdle.Initialize(options.get());
+
+      vtkm::cont::internal::HostMemoryPool& pool = vtkm::cont::internal::GetHostMemoryPool();
+      if (maxCachedMB.IsSet())
+      {
+        pool.SetMaxCachedBytes(static_cast<vtkm::BufferSizeType>(maxCachedMB.GetValue()) << 20);
+      }
+      if (trimOnIdle.IsSet())
+      {
+        pool.SetTrimOnIdle(trimOnIdle.GetValue() != 0);
+      }
+    }
+
+    {
+      const char* reportEnv = std::getenv("VTKM_MEMORY_REPORT");
+      if (options[opt::OptionIndex::MEMORY_REPORT] ||
+          ((reportEnv != nullptr) && (std::string(reportEnv) != "0")))
+      {
+        std::atexit(PrintMemoryReportAtExit);
+      }
+    }
+
+    {
+      const char* profileEnv = std::getenv("VTKM_PROFILE_WORKLETS");
+      std::string traceFile;
+      if (options[opt::OptionIndex::PROFILE_WORKLETS])
+      {
+        traceFile = options[opt::OptionIndex::PROFILE_WORKLETS].arg;
+      }
+      else if ((profileEnv != nullptr) && (profileEnv[0] != '\0'))
+      {
+        traceFile = profileEnv;
+      }
+      if (!traceFile.empty())
+      {
+        vtkm::cont::GetWorkletProfiler().SetEnabled(true);
+        if (WorkletTraceFileName == nullptr)
+        {
+          WorkletTraceFileName = new std::string(traceFile);
+          std::atexit(WriteWorkletTraceAtExit);
+        }
+        else
+        {
+          *WorkletTraceFileName = traceFile;
+        }
+      }
+    }
   }
 
   return config;
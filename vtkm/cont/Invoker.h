@@ -13,6 +13,7 @@
 #include <vtkm/worklet/internal/MaskBase.h>
 #include <vtkm/worklet/internal/ScatterBase.h>
 
+#include <vtkm/cont/AsyncEvent.h>
 #include <vtkm/cont/TryExecute.h>
 
 namespace vtkm
@@ -118,6 +119,72 @@ struct Invoker
     dispatcher.Invoke(std::forward<T>(t), std::forward<Args>(args)...);
   }
 
+  /// Launch the worklet that is provided as the first parameter without waiting for it to
+  /// finish. The arguments are the same as for `operator()`.
+  ///
+  /// The arguments are prepared for the device before `Async` returns, and the returned
+  /// `AsyncEvent` holds them until the worklet finishes. Later invocations (asynchronous or
+  /// not) and portals block only if they access an array this worklet writes (or write an
+  /// array this worklet reads). Arguments that are not arrays, such as execution objects,
+  /// must remain valid until the event completes.
+  ///
+  template <typename Worklet,
+            typename T,
+            typename... Args,
+            typename std::enable_if<detail::scatter_or_mask<T>::value, int>::type* = nullptr>
+  inline vtkm::cont::AsyncEvent Async(Worklet&& worklet, T&& scatterOrMask, Args&&... args) const
+  {
+    using WorkletType = vtkm::internal::remove_cvref<Worklet>;
+    using DispatcherType = typename WorkletType::template Dispatcher<WorkletType>;
+
+    vtkm::cont::AsyncEvent event;
+    DispatcherType dispatcher(worklet, scatterOrMask);
+    dispatcher.SetDevice(this->DeviceId);
+    dispatcher.SetAsyncEvent(&event);
+    dispatcher.Invoke(std::forward<Args>(args)...);
+    return event;
+  }
+
+  template <
+    typename Worklet,
+    typename T,
+    typename U,
+    typename... Args,
+    typename std::enable_if<detail::scatter_or_mask<T>::value && detail::scatter_or_mask<U>::value,
+                            int>::type* = nullptr>
+  inline vtkm::cont::AsyncEvent Async(Worklet&& worklet,
+                                      T&& scatterOrMaskA,
+                                      U&& scatterOrMaskB,
+                                      Args&&... args) const
+  {
+    using WorkletType = vtkm::internal::remove_cvref<Worklet>;
+    using DispatcherType = typename WorkletType::template Dispatcher<WorkletType>;
+
+    vtkm::cont::AsyncEvent event;
+    DispatcherType dispatcher(worklet, scatterOrMaskA, scatterOrMaskB);
+    dispatcher.SetDevice(this->DeviceId);
+    dispatcher.SetAsyncEvent(&event);
+    dispatcher.Invoke(std::forward<Args>(args)...);
+    return event;
+  }
+
+  template <typename Worklet,
+            typename T,
+            typename... Args,
+            typename std::enable_if<!detail::scatter_or_mask<T>::value, int>::type* = nullptr>
+  inline vtkm::cont::AsyncEvent Async(Worklet&& worklet, T&& t, Args&&... args) const
+  {
+    using WorkletType = vtkm::internal::remove_cvref<Worklet>;
+    using DispatcherType = typename WorkletType::template Dispatcher<WorkletType>;
+
+    vtkm::cont::AsyncEvent event;
+    DispatcherType dispatcher(worklet);
+    dispatcher.SetDevice(this->DeviceId);
+    dispatcher.SetAsyncEvent(&event);
+    dispatcher.Invoke(std::forward<T>(t), std::forward<Args>(args)...);
+    return event;
+  }
+
   /// Get the device adapter that this Invoker is bound too
   ///
   vtkm::cont::DeviceAdapterId GetDevice() const { return DeviceId; }
@@ -0,0 +1,280 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/MemoryTracker.h>
+
+#include <atomic>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+
+// Slot 0 of the device counters is used for the host (DeviceAdapterTagUndefined).
+constexpr vtkm::Int32 NumDeviceSlots = VTKM_MAX_DEVICE_ADAPTER_ID;
+
+// Tag 0 is reserved for memory allocated outside of any MemoryTrackerScope. The number of
+// tags is fixed so that the counters can be updated without locking.
+constexpr vtkm::Int32 MaxTags = 256;
+constexpr vtkm::Int32 UntaggedId = 0;
+
+thread_local vtkm::Int32 CurrentTag = UntaggedId;
+
+vtkm::Int32 DeviceSlot(vtkm::cont::DeviceAdapterId device)
+{
+  return device.IsValueValid() ? device.GetValue() : 0;
+}
+
+struct UsageCounters
+{
+  std::atomic<vtkm::BufferSizeType> LiveBytes{ 0 };
+  std::atomic<vtkm::BufferSizeType> PeakBytes{ 0 };
+  std::atomic<vtkm::UInt64> NumAllocations{ 0 };
+  std::atomic<vtkm::UInt64> NumFrees{ 0 };
+
+  void UpdatePeak(vtkm::BufferSizeType liveBytes)
+  {
+    vtkm::BufferSizeType peak = this->PeakBytes.load(std::memory_order_relaxed);
+    while ((liveBytes > peak) && !this->PeakBytes.compare_exchange_weak(peak, liveBytes))
+    {
+    }
+  }
+
+  void Allocate(vtkm::BufferSizeType numBytes)
+  {
+    this->NumAllocations.fetch_add(1, std::memory_order_relaxed);
+    this->UpdatePeak(this->LiveBytes.fetch_add(numBytes) + numBytes);
+  }
+
+  void Resize(vtkm::BufferSizeType delta)
+  {
+    this->UpdatePeak(this->LiveBytes.fetch_add(delta) + delta);
+  }
+
+  void Free(vtkm::BufferSizeType numBytes)
+  {
+    this->NumFrees.fetch_add(1, std::memory_order_relaxed);
+    this->LiveBytes.fetch_sub(numBytes);
+  }
+
+  void ResetPeak() { this->PeakBytes.store(this->LiveBytes.load()); }
+
+  vtkm::cont::MemoryUsage Get() const
+  {
+    vtkm::cont::MemoryUsage usage;
+    usage.LiveBytes = this->LiveBytes.load();
+    usage.PeakBytes = this->PeakBytes.load();
+    usage.NumAllocations = this->NumAllocations.load();
+    usage.NumFrees = this->NumFrees.load();
+    return usage;
+  }
+};
+
+void PrintUsageRow(std::ostream& out, const std::string& name, const vtkm::cont::MemoryUsage& usage)
+{
+  out << "  " << std::left << std::setw(32) << name << std::right << std::setw(14)
+      << vtkm::cont::GetHumanReadableSize(usage.LiveBytes) << std::setw(14)
+      << vtkm::cont::GetHumanReadableSize(usage.PeakBytes) << std::setw(14)
+      << usage.NumAllocations << std::setw(14) << usage.NumFrees << "\n";
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct MemoryTrackerInternals
+{
+  UsageCounters Devices[NumDeviceSlots];
+  UsageCounters Total;
+  UsageCounters Tags[MaxTags];
+
+  mutable std::mutex TagMutex;
+  std::map<std::string, vtkm::Int32> TagIds;
+  std::vector<std::string> TagNames;
+
+  MemoryTrackerInternals() { this->TagNames.push_back(""); }
+
+  vtkm::Int32 GetTagId(const std::string& tag)
+  {
+    std::lock_guard<std::mutex> lock(this->TagMutex);
+    auto entry = this->TagIds.find(tag);
+    if (entry != this->TagIds.end())
+    {
+      return entry->second;
+    }
+    if (static_cast<vtkm::Int32>(this->TagNames.size()) >= MaxTags)
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+                 "Too many memory tracker tags. Memory for '" << tag << "' will be untagged.");
+      return UntaggedId;
+    }
+    vtkm::Int32 id = static_cast<vtkm::Int32>(this->TagNames.size());
+    this->TagNames.push_back(tag);
+    this->TagIds[tag] = id;
+    return id;
+  }
+};
+
+} // namespace detail
+
+MemoryTracker::MemoryTracker()
+  : Internals(new detail::MemoryTrackerInternals)
+{
+}
+
+MemoryTracker::~MemoryTracker() = default;
+
+vtkm::cont::MemoryUsage MemoryTracker::GetUsage(vtkm::cont::DeviceAdapterId device) const
+{
+  return this->Internals->Devices[DeviceSlot(device)].Get();
+}
+
+vtkm::cont::MemoryUsage MemoryTracker::GetUsage(const std::string& tag) const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->TagMutex);
+  auto entry = this->Internals->TagIds.find(tag);
+  if (entry == this->Internals->TagIds.end())
+  {
+    return vtkm::cont::MemoryUsage{};
+  }
+  return this->Internals->Tags[entry->second].Get();
+}
+
+vtkm::cont::MemoryUsage MemoryTracker::GetTotalUsage() const
+{
+  return this->Internals->Total.Get();
+}
+
+std::vector<std::string> MemoryTracker::GetTags() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->TagMutex);
+  return std::vector<std::string>(this->Internals->TagNames.begin() + 1,
+                                  this->Internals->TagNames.end());
+}
+
+void MemoryTracker::ResetPeaks()
+{
+  for (auto& counters : this->Internals->Devices)
+  {
+    counters.ResetPeak();
+  }
+  for (auto& counters : this->Internals->Tags)
+  {
+    counters.ResetPeak();
+  }
+  this->Internals->Total.ResetPeak();
+}
+
+void MemoryTracker::PrintReport(std::ostream& out) const
+{
+  out << "VTK-m memory usage:\n";
+  out << "  " << std::left << std::setw(32) << "Device/Tag" << std::right << std::setw(14)
+      << "Live" << std::setw(14) << "Peak" << std::setw(14) << "Allocations" << std::setw(14)
+      << "Frees"
+      << "\n";
+
+  for (vtkm::Int32 slot = 0; slot < NumDeviceSlots; ++slot)
+  {
+    vtkm::cont::MemoryUsage usage = this->Internals->Devices[slot].Get();
+    if (usage.NumAllocations == 0)
+    {
+      continue;
+    }
+    std::string name = (slot == 0)
+      ? std::string("Host")
+      : vtkm::cont::make_DeviceAdapterId(static_cast<vtkm::Int8>(slot)).GetName();
+    PrintUsageRow(out, name, usage);
+  }
+  PrintUsageRow(out, "Total", this->GetTotalUsage());
+
+  std::vector<std::string> tagNames;
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->TagMutex);
+    tagNames = this->Internals->TagNames;
+  }
+  if (tagNames.size() > 1)
+  {
+    PrintUsageRow(out, "(untagged)", this->Internals->Tags[UntaggedId].Get());
+    for (std::size_t tagId = 1; tagId < tagNames.size(); ++tagId)
+    {
+      PrintUsageRow(out, tagNames[tagId], this->Internals->Tags[tagId].Get());
+    }
+  }
+}
+
+void MemoryTracker::LogReport(vtkm::cont::LogLevel level) const
+{
+  std::ostringstream report;
+  this->PrintReport(report);
+  VTKM_LOG_S(level, report.str());
+#ifndef VTKM_ENABLE_LOGGING
+  (void)level;
+#endif
+}
+
+vtkm::Int32 MemoryTracker::RecordAllocation(vtkm::cont::DeviceAdapterId device,
+                                            vtkm::BufferSizeType numBytes)
+{
+  vtkm::Int32 tagId = CurrentTag;
+  this->Internals->Devices[DeviceSlot(device)].Allocate(numBytes);
+  this->Internals->Tags[tagId].Allocate(numBytes);
+  this->Internals->Total.Allocate(numBytes);
+  return tagId;
+}
+
+void MemoryTracker::RecordResize(vtkm::cont::DeviceAdapterId device,
+                                 vtkm::Int32 tagId,
+                                 vtkm::BufferSizeType oldNumBytes,
+                                 vtkm::BufferSizeType newNumBytes)
+{
+  vtkm::BufferSizeType delta = newNumBytes - oldNumBytes;
+  this->Internals->Devices[DeviceSlot(device)].Resize(delta);
+  this->Internals->Tags[tagId].Resize(delta);
+  this->Internals->Total.Resize(delta);
+}
+
+void MemoryTracker::RecordFree(vtkm::cont::DeviceAdapterId device,
+                               vtkm::Int32 tagId,
+                               vtkm::BufferSizeType numBytes)
+{
+  this->Internals->Devices[DeviceSlot(device)].Free(numBytes);
+  this->Internals->Tags[tagId].Free(numBytes);
+  this->Internals->Total.Free(numBytes);
+}
+
+vtkm::cont::MemoryTracker& GetMemoryTracker()
+{
+  // The tracker is intentionally never destroyed so that buffers released during static
+  // destruction can still be recorded.
+  static vtkm::cont::MemoryTracker* tracker = new vtkm::cont::MemoryTracker;
+  return *tracker;
+}
+
+MemoryTrackerScope::MemoryTrackerScope(const std::string& tag)
+  : PreviousTag(CurrentTag)
+{
+  CurrentTag = vtkm::cont::GetMemoryTracker().Internals->GetTagId(tag);
+}
+
+MemoryTrackerScope::~MemoryTrackerScope()
+{
+  CurrentTag = this->PreviousTag;
+}
+
+}
+} // namespace vtkm::cont
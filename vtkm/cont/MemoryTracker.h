@@ -0,0 +1,159 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_MemoryTracker_h
+#define vtk_m_cont_MemoryTracker_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/DeviceAdapterTag.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct MemoryTrackerInternals;
+
+} // namespace detail
+
+/// \brief A snapshot of the memory used by a device or tag.
+///
+struct MemoryUsage
+{
+  /// The number of bytes currently allocated.
+  vtkm::BufferSizeType LiveBytes = 0;
+
+  /// The largest number of bytes allocated at any one time since the start of the program or
+  /// the last call to `MemoryTracker::ResetPeaks`.
+  vtkm::BufferSizeType PeakBytes = 0;
+
+  /// The number of allocations made.
+  vtkm::UInt64 NumAllocations = 0;
+
+  /// The number of allocations released.
+  vtkm::UInt64 NumFrees = 0;
+};
+
+/// \brief Process-wide accounting of the memory held by `vtkm::cont::internal::Buffer`s.
+///
+/// Every buffer allocation made by VTK-m (on the host or on any device) is recorded by the
+/// `MemoryTracker`. The tracker keeps the live bytes, the peak (high-water mark) bytes, and the
+/// number of allocations for each device as well as for each tag. Tags identify the code that
+/// requested the memory and are established with `MemoryTrackerScope`. Filters automatically
+/// tag the memory they allocate with the name of the filter.
+///
+/// Memory for devices that share memory with the host (such as serial, TBB, and OpenMP) is
+/// recorded against the device that requested it. Host memory requested outside of a device
+/// (for example by writing to an `ArrayHandle` portal in the control environment) is recorded
+/// against `vtkm::cont::DeviceAdapterTagUndefined`, which is reported as "Host".
+///
+/// Use `vtkm::cont::GetMemoryTracker()` to get the global instance. The tracker can print a
+/// report when the program exits by passing `--vtkm-memory-report` to
+/// `vtkm::cont::Initialize` (or setting the `VTKM_MEMORY_REPORT` environment variable to 1).
+///
+class VTKM_CONT_EXPORT MemoryTracker
+{
+public:
+  VTKM_CONT MemoryTracker();
+  VTKM_CONT ~MemoryTracker();
+
+  MemoryTracker(const MemoryTracker&) = delete;
+  void operator=(const MemoryTracker&) = delete;
+
+  /// Returns the memory used on the given device. Use `DeviceAdapterTagUndefined` to get the
+  /// memory allocated on the host outside of any device.
+  ///
+  VTKM_CONT vtkm::cont::MemoryUsage GetUsage(vtkm::cont::DeviceAdapterId device) const;
+
+  /// Returns the memory allocated while the given tag was active.
+  ///
+  VTKM_CONT vtkm::cont::MemoryUsage GetUsage(const std::string& tag) const;
+
+  /// Returns the memory used across all devices.
+  ///
+  VTKM_CONT vtkm::cont::MemoryUsage GetTotalUsage() const;
+
+  /// Returns the names of all tags that have been used.
+  ///
+  VTKM_CONT std::vector<std::string> GetTags() const;
+
+  /// Resets the peak bytes of every device and tag to their current live bytes.
+  ///
+  VTKM_CONT void ResetPeaks();
+
+  /// Writes a table of the memory usage of every device and tag.
+  ///
+  VTKM_CONT void PrintReport(std::ostream& out = std::cout) const;
+
+  /// Writes the memory usage report to the log.
+  ///
+  VTKM_CONT void LogReport(vtkm::cont::LogLevel level = vtkm::cont::LogLevel::MemCont) const;
+
+  /// \brief Records an allocation.
+  ///
+  /// These record methods are called by VTK-m's buffer management and should not be needed
+  /// elsewhere. `RecordAllocation` returns an identifier for the tag active during the
+  /// allocation that must be passed to the matching `RecordFree`.
+  ///
+  VTKM_CONT vtkm::Int32 RecordAllocation(vtkm::cont::DeviceAdapterId device,
+                                         vtkm::BufferSizeType numBytes);
+  VTKM_CONT void RecordResize(vtkm::cont::DeviceAdapterId device,
+                              vtkm::Int32 tagId,
+                              vtkm::BufferSizeType oldNumBytes,
+                              vtkm::BufferSizeType newNumBytes);
+  VTKM_CONT void RecordFree(vtkm::cont::DeviceAdapterId device,
+                            vtkm::Int32 tagId,
+                            vtkm::BufferSizeType numBytes);
+
+private:
+  friend class MemoryTrackerScope;
+
+  std::unique_ptr<detail::MemoryTrackerInternals> Internals;
+};
+
+/// Returns the global memory tracker.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::MemoryTracker& GetMemoryTracker();
+
+/// \brief Tags the memory allocated by the calling thread.
+///
+/// While a `MemoryTrackerScope` exists, all allocations made by the calling thread are recorded
+/// in the `MemoryTracker` under the given tag. Scopes can be nested; the innermost scope is the
+/// one that is used.
+///
+class VTKM_CONT_EXPORT MemoryTrackerScope
+{
+public:
+  VTKM_CONT MemoryTrackerScope(const std::string& tag);
+  VTKM_CONT ~MemoryTrackerScope();
+
+  MemoryTrackerScope(const MemoryTrackerScope&) = delete;
+  void operator=(const MemoryTrackerScope&) = delete;
+
+private:
+  vtkm::Int32 PreviousTag;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_MemoryTracker_h
@@ -0,0 +1,315 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/WorkletProfiler.h>
+
+#include <vtkm/Math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace
+{
+
+constexpr vtkm::Id DefaultCapacity = 65536;
+
+// Bytes copied between the host and a device by this thread. Events take the difference
+// before and after the arguments are prepared.
+thread_local vtkm::BufferSizeType ThreadBytesTransferred = 0;
+
+std::atomic<vtkm::Id> NextThreadId{ 0 };
+
+vtkm::Id GetThreadId()
+{
+  thread_local vtkm::Id threadId = NextThreadId.fetch_add(1);
+  return threadId;
+}
+
+void WriteJsonString(std::ostream& out, const std::string& str)
+{
+  out << '"';
+  for (char c : str)
+  {
+    switch (c)
+    {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        out << c;
+    }
+  }
+  out << '"';
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct WorkletProfilerInternals
+{
+  std::atomic<bool> Enabled{ false };
+  const std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+
+  mutable std::mutex Mutex;
+  std::vector<vtkm::cont::WorkletProfileEvent> Events;
+  std::size_t Capacity = static_cast<std::size_t>(DefaultCapacity);
+  // The index where the next event will be written.
+  std::size_t Next = 0;
+  vtkm::UInt64 NumDropped = 0;
+
+  vtkm::Float64 Now() const
+  {
+    return std::chrono::duration<vtkm::Float64>(std::chrono::steady_clock::now() - this->Epoch)
+      .count();
+  }
+};
+
+} // namespace detail
+
+WorkletProfiler::WorkletProfiler()
+  : Internals(new detail::WorkletProfilerInternals)
+{
+}
+
+WorkletProfiler::~WorkletProfiler() = default;
+
+void WorkletProfiler::SetEnabled(bool enabled)
+{
+  this->Internals->Enabled.store(enabled);
+}
+
+bool WorkletProfiler::GetEnabled() const
+{
+  return this->Internals->Enabled.load(std::memory_order_relaxed);
+}
+
+void WorkletProfiler::SetCapacity(vtkm::Id capacity)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Capacity = static_cast<std::size_t>(vtkm::Max(capacity, vtkm::Id(1)));
+  this->Internals->Events.clear();
+  this->Internals->Events.shrink_to_fit();
+  this->Internals->Next = 0;
+  this->Internals->NumDropped = 0;
+}
+
+vtkm::Id WorkletProfiler::GetCapacity() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkm::Id>(this->Internals->Capacity);
+}
+
+void WorkletProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->Events.clear();
+  this->Internals->Next = 0;
+  this->Internals->NumDropped = 0;
+}
+
+std::vector<vtkm::cont::WorkletProfileEvent> WorkletProfiler::GetEvents() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  const std::vector<vtkm::cont::WorkletProfileEvent>& events = this->Internals->Events;
+  if (events.size() < this->Internals->Capacity)
+  {
+    return events;
+  }
+  // The buffer is full, so the oldest event is the one that will be overwritten next.
+  std::vector<vtkm::cont::WorkletProfileEvent> ordered;
+  ordered.reserve(events.size());
+  ordered.insert(ordered.end(),
+                 events.begin() + static_cast<std::ptrdiff_t>(this->Internals->Next),
+                 events.end());
+  ordered.insert(ordered.end(),
+                 events.begin(),
+                 events.begin() + static_cast<std::ptrdiff_t>(this->Internals->Next));
+  return ordered;
+}
+
+vtkm::UInt64 WorkletProfiler::GetNumberOfDroppedEvents() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->NumDropped;
+}
+
+std::vector<vtkm::cont::WorkletProfileSummary> WorkletProfiler::GetSummary() const
+{
+  std::map<std::string, vtkm::cont::WorkletProfileSummary> byName;
+  for (const vtkm::cont::WorkletProfileEvent& event : this->GetEvents())
+  {
+    vtkm::cont::WorkletProfileSummary& summary = byName[event.WorkletName];
+    summary.WorkletName = event.WorkletName;
+    ++summary.NumInvocations;
+    summary.TotalTime += event.ElapsedTime;
+    summary.MaxTime = vtkm::Max(summary.MaxTime, event.ElapsedTime);
+    summary.TotalInputDomainSize += event.InputDomainSize;
+    summary.TotalBytesTransferred += event.BytesTransferred;
+  }
+
+  std::vector<vtkm::cont::WorkletProfileSummary> summaries;
+  summaries.reserve(byName.size());
+  for (auto&& entry : byName)
+  {
+    summaries.push_back(entry.second);
+  }
+  std::sort(summaries.begin(),
+            summaries.end(),
+            [](const vtkm::cont::WorkletProfileSummary& a,
+               const vtkm::cont::WorkletProfileSummary& b) { return a.TotalTime > b.TotalTime; });
+  return summaries;
+}
+
+void WorkletProfiler::PrintSummary(std::ostream& stream) const
+{
+  // Format into a separate stream so that the state of the given stream is not changed.
+  std::ostringstream out;
+  out << "VTK-m worklet profile:\n";
+  out << "  " << std::right << std::setw(12) << "Total (s)" << std::setw(12) << "Max (s)"
+      << std::setw(10) << "Calls" << std::setw(14) << "Values" << std::setw(14) << "Transferred"
+      << "  Worklet\n";
+  for (const vtkm::cont::WorkletProfileSummary& summary : this->GetSummary())
+  {
+    out << "  " << std::setw(12) << std::fixed << std::setprecision(6) << summary.TotalTime
+        << std::setw(12) << summary.MaxTime << std::setw(10) << summary.NumInvocations
+        << std::setw(14) << summary.TotalInputDomainSize << std::setw(14)
+        << vtkm::cont::GetHumanReadableSize(summary.TotalBytesTransferred) << "  "
+        << summary.WorkletName << "\n";
+  }
+  vtkm::UInt64 numDropped = this->GetNumberOfDroppedEvents();
+  if (numDropped > 0)
+  {
+    out << "  (" << numDropped << " older events dropped)\n";
+  }
+  stream << out.str();
+}
+
+void WorkletProfiler::WriteChromeTrace(std::ostream& out) const
+{
+  const std::ios_base::fmtflags oldFlags = out.flags();
+  const std::streamsize oldPrecision = out.precision();
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const vtkm::cont::WorkletProfileEvent& event : this->GetEvents())
+  {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    out << "{\"name\":";
+    WriteJsonString(out, event.WorkletName);
+    out << ",\"cat\":\"worklet\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.ThreadId
+        << std::fixed << std::setprecision(3) << ",\"ts\":" << event.StartTime * 1e6
+        << ",\"dur\":" << event.ElapsedTime * 1e6 << ",\"args\":{\"device\":";
+    WriteJsonString(out, event.Device.GetName());
+    out << ",\"size\":" << event.InputDomainSize << ",\"bytes\":" << event.BytesTransferred
+        << ",\"async\":" << (event.Async ? "true" : "false") << "}}";
+  }
+  out << "\n]}\n";
+  out.flags(oldFlags);
+  out.precision(oldPrecision);
+}
+
+bool WorkletProfiler::WriteChromeTrace(const std::string& fileName) const
+{
+  std::ofstream file(fileName);
+  if (!file)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Error, "Could not open " << fileName << " for worklet trace.");
+    return false;
+  }
+  this->WriteChromeTrace(file);
+  return static_cast<bool>(file);
+}
+
+vtkm::cont::WorkletProfileEvent WorkletProfiler::StartEvent(const std::string& workletName,
+                                                           vtkm::cont::DeviceAdapterId device,
+                                                           vtkm::Id inputDomainSize) const
+{
+  vtkm::cont::WorkletProfileEvent event;
+  event.WorkletName = workletName;
+  event.Device = device;
+  event.InputDomainSize = inputDomainSize;
+  event.ThreadId = GetThreadId();
+  // Holds the starting count until FinishTransfer replaces it with the difference.
+  event.BytesTransferred = ThreadBytesTransferred;
+  event.StartTime = this->Internals->Now();
+  return event;
+}
+
+vtkm::cont::WorkletProfileEvent WorkletProfiler::StartEvent(const std::string& workletName,
+                                                           vtkm::cont::DeviceAdapterId device,
+                                                           vtkm::Id3 inputDomainSize) const
+{
+  return this->StartEvent(
+    workletName, device, inputDomainSize[0] * inputDomainSize[1] * inputDomainSize[2]);
+}
+
+void WorkletProfiler::FinishTransfer(vtkm::cont::WorkletProfileEvent& event) const
+{
+  event.BytesTransferred = ThreadBytesTransferred - event.BytesTransferred;
+}
+
+void WorkletProfiler::FinishEvent(vtkm::cont::WorkletProfileEvent event)
+{
+  event.ElapsedTime = this->Internals->Now() - event.StartTime;
+  this->Record(event);
+}
+
+void WorkletProfiler::Record(const vtkm::cont::WorkletProfileEvent& event)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  std::vector<vtkm::cont::WorkletProfileEvent>& events = this->Internals->Events;
+  if (events.size() < this->Internals->Capacity)
+  {
+    events.push_back(event);
+  }
+  else
+  {
+    events[this->Internals->Next] = event;
+    ++this->Internals->NumDropped;
+  }
+  this->Internals->Next = (this->Internals->Next + 1) % this->Internals->Capacity;
+}
+
+void WorkletProfiler::RecordTransfer(vtkm::BufferSizeType numBytes)
+{
+  ThreadBytesTransferred += numBytes;
+}
+
+vtkm::cont::WorkletProfiler& GetWorkletProfiler()
+{
+  // Never destroyed so that events can still be recorded and written while the program exits.
+  static vtkm::cont::WorkletProfiler* profiler = new vtkm::cont::WorkletProfiler;
+  return *profiler;
+}
+
+}
+} // namespace vtkm::cont
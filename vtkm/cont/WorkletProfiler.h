@@ -0,0 +1,186 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_WorkletProfiler_h
+#define vtk_m_cont_WorkletProfiler_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/DeviceAdapterTag.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace detail
+{
+
+struct WorkletProfilerInternals;
+
+} // namespace detail
+
+/// \brief The record of one worklet invocation kept by the `WorkletProfiler`.
+///
+struct WorkletProfileEvent
+{
+  /// The name of the worklet type.
+  std::string WorkletName;
+
+  /// The device the worklet ran on.
+  vtkm::cont::DeviceAdapterId Device = vtkm::cont::DeviceAdapterTagUndefined{};
+
+  /// The number of values in the input domain of the worklet.
+  vtkm::Id InputDomainSize = 0;
+
+  /// The time the invocation started, in seconds since the profiler was created.
+  vtkm::Float64 StartTime = 0.0;
+
+  /// The time taken by the invocation, in seconds. This includes preparing the arguments for
+  /// the device. For an asynchronous invocation it also includes the time spent waiting to run.
+  vtkm::Float64 ElapsedTime = 0.0;
+
+  /// The number of bytes copied between the host and the device while the arguments were
+  /// prepared.
+  vtkm::BufferSizeType BytesTransferred = 0;
+
+  /// A small number identifying the control thread that invoked the worklet.
+  vtkm::Id ThreadId = 0;
+
+  /// Whether the worklet was invoked with `vtkm::cont::Invoker::Async`.
+  bool Async = false;
+};
+
+/// \brief The totals of all recorded invocations of one worklet.
+///
+struct WorkletProfileSummary
+{
+  std::string WorkletName;
+  vtkm::UInt64 NumInvocations = 0;
+  vtkm::Float64 TotalTime = 0.0;
+  vtkm::Float64 MaxTime = 0.0;
+  vtkm::Id TotalInputDomainSize = 0;
+  vtkm::BufferSizeType TotalBytesTransferred = 0;
+};
+
+/// \brief An opt-in record of every worklet invocation.
+///
+/// When enabled, each worklet invoked through a dispatcher (and therefore through
+/// `vtkm::cont::Invoker`) adds a `WorkletProfileEvent` with the worklet type, device, size of the
+/// input domain, elapsed time, and bytes transferred. The events are kept in a ring buffer of
+/// fixed capacity, so a long running program keeps only the most recent events. When the
+/// profiler is disabled (the default), the only cost to an invocation is checking a flag.
+///
+/// While enabled, invocations wait for the device to finish so that the elapsed time is
+/// accurate.
+///
+/// The events can be written as a Chrome trace (viewable in `chrome://tracing` or Perfetto) with
+/// `WriteChromeTrace` or summarized per worklet with `GetSummary` and `PrintSummary`.
+///
+/// Use `vtkm::cont::GetWorkletProfiler()` to get the global instance. Passing
+/// `--vtkm-profile-worklets <file>` to `vtkm::cont::Initialize` (or setting the
+/// `VTKM_PROFILE_WORKLETS` environment variable to a file name) enables the profiler and writes
+/// a Chrome trace to the file when the program exits.
+///
+class VTKM_CONT_EXPORT WorkletProfiler
+{
+public:
+  VTKM_CONT WorkletProfiler();
+  VTKM_CONT ~WorkletProfiler();
+
+  WorkletProfiler(const WorkletProfiler&) = delete;
+  void operator=(const WorkletProfiler&) = delete;
+
+  /// Turns recording on or off. The profiler is off by default.
+  ///
+  VTKM_CONT void SetEnabled(bool enabled);
+  VTKM_CONT bool GetEnabled() const;
+
+  /// Sets the maximum number of events kept. When more events are recorded, the oldest are
+  /// dropped. Changing the capacity clears the recorded events. The default is 65536.
+  ///
+  VTKM_CONT void SetCapacity(vtkm::Id capacity);
+  VTKM_CONT vtkm::Id GetCapacity() const;
+
+  /// Removes all recorded events.
+  ///
+  VTKM_CONT void Clear();
+
+  /// Returns the recorded events, oldest first.
+  ///
+  VTKM_CONT std::vector<vtkm::cont::WorkletProfileEvent> GetEvents() const;
+
+  /// Returns the number of events dropped because the ring buffer was full.
+  ///
+  VTKM_CONT vtkm::UInt64 GetNumberOfDroppedEvents() const;
+
+  /// Returns the totals of the recorded events for each worklet, sorted by decreasing total
+  /// time.
+  ///
+  VTKM_CONT std::vector<vtkm::cont::WorkletProfileSummary> GetSummary() const;
+
+  /// Writes a table of the totals of each worklet.
+  ///
+  VTKM_CONT void PrintSummary(std::ostream& out = std::cout) const;
+
+  /// Writes the recorded events in the Chrome trace event JSON format.
+  ///
+  VTKM_CONT void WriteChromeTrace(std::ostream& out) const;
+
+  /// Writes the recorded events in the Chrome trace event JSON format to the named file.
+  /// Returns false if the file cannot be written.
+  ///
+  VTKM_CONT bool WriteChromeTrace(const std::string& fileName) const;
+
+  /// \brief Starts an event.
+  ///
+  /// These methods are called by the dispatcher and should not be needed elsewhere.
+  /// `StartEvent` fills in the start of the event, `FinishTransfer` records the bytes copied
+  /// by the calling thread since `StartEvent`, and `FinishEvent` records the elapsed time and
+  /// adds the event to the ring buffer.
+  ///
+  VTKM_CONT vtkm::cont::WorkletProfileEvent StartEvent(const std::string& workletName,
+                                                      vtkm::cont::DeviceAdapterId device,
+                                                      vtkm::Id inputDomainSize) const;
+  VTKM_CONT vtkm::cont::WorkletProfileEvent StartEvent(const std::string& workletName,
+                                                      vtkm::cont::DeviceAdapterId device,
+                                                      vtkm::Id3 inputDomainSize) const;
+  VTKM_CONT void FinishTransfer(vtkm::cont::WorkletProfileEvent& event) const;
+  VTKM_CONT void FinishEvent(vtkm::cont::WorkletProfileEvent event);
+
+  /// Adds an event to the ring buffer.
+  ///
+  VTKM_CONT void Record(const vtkm::cont::WorkletProfileEvent& event);
+
+  /// Counts bytes copied between the host and a device by the calling thread. Called by
+  /// `vtkm::cont::internal::Buffer`.
+  ///
+  VTKM_CONT static void RecordTransfer(vtkm::BufferSizeType numBytes);
+
+private:
+  std::unique_ptr<detail::WorkletProfilerInternals> Internals;
+};
+
+/// Returns the global worklet profiler.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::WorkletProfiler& GetWorkletProfiler();
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_WorkletProfiler_h
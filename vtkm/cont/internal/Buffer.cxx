@@ -13,7 +13,9 @@
 #include <vtkm/cont/ErrorBadAllocation.h>
 #include <vtkm/cont/ErrorBadDevice.h>
 #include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/RuntimeDeviceInformation.h>
+#include <vtkm/cont/WorkletProfiler.h>
 
 #include <vtkm/cont/internal/Buffer.h>
 #include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
@@ -186,6 +188,10 @@ private:
   // data preserved.
   vtkm::BufferSizeType NumberOfBytes = 0;
 
+  vtkm::UInt64 ModifiedCount = 0;
+
+  bool ReadOnly = false;
+
   DeviceBufferMap DeviceBuffers;
   BufferState HostBuffer;
 
@@ -236,6 +242,28 @@ public:
     this->CheckLock(lock);
     this->NumberOfBytes = numberOfBytes;
   }
+
+  VTKM_CONT vtkm::UInt64 GetModifiedCount(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    return this->ModifiedCount;
+  }
+  VTKM_CONT void Modified(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    ++this->ModifiedCount;
+  }
+
+  VTKM_CONT bool IsReadOnly(const LockType& lock)
+  {
+    this->CheckLock(lock);
+    return this->ReadOnly;
+  }
+  VTKM_CONT void SetReadOnly(const LockType& lock, bool readOnly)
+  {
+    this->CheckLock(lock);
+    this->ReadOnly = readOnly;
+  }
 };
 
 namespace detail
@@ -341,6 +369,17 @@ struct VTKM_NEVER_EXPORT BufferHelper
   static void WaitToWrite(const std::shared_ptr<Buffer::InternalsStruct>& internals,
                           LockType& lock,
                           vtkm::cont::Token& token)
+  {
+    if (internals->IsReadOnly(lock))
+    {
+      throw vtkm::cont::ErrorBadValue("Cannot write to a read-only buffer.");
+    }
+    WaitForExclusiveAccess(internals, lock, token);
+  }
+
+  static void WaitForExclusiveAccess(const std::shared_ptr<Buffer::InternalsStruct>& internals,
+                                     LockType& lock,
+                                     vtkm::cont::Token& token)
   {
     Enqueue(internals, lock, token);
 
@@ -353,6 +392,9 @@ struct VTKM_NEVER_EXPORT BufferHelper
 
     token.Attach(internals, internals->GetWriteCount(lock), lock, &internals->ConditionVariable);
 
+    // Whoever gets write access may change the data.
+    internals->Modified(lock);
+
     // We successfully attached the token. Pop it off the queue.
     auto& queue = internals->GetQueue(lock);
     if (!queue.empty() && queue.front() == token)
@@ -457,6 +499,10 @@ struct VTKM_NEVER_EXPORT BufferHelper
         hostBuffer.Reallocate(targetSize);
         memoryManager.CopyDeviceToHost(deviceBuffer.second, hostBuffer);
       }
+      if (hostBuffer.GetPointer() != deviceBuffer.second.GetPointer())
+      {
+        vtkm::cont::WorkletProfiler::RecordTransfer(targetSize);
+      }
 
       if (hostBuffer.GetSize() != targetSize)
       {
@@ -538,6 +584,10 @@ struct VTKM_NEVER_EXPORT BufferHelper
         deviceBuffers[device].Reallocate(targetSize);
         memoryManager.CopyHostToDevice(hostBuffer, deviceBuffers[device]);
       }
+      if (deviceBuffers[device].GetPointer() != hostBuffer.GetPointer())
+      {
+        vtkm::cont::WorkletProfiler::RecordTransfer(targetSize);
+      }
 
       if (deviceBuffers[device].GetSize() != targetSize)
       {
@@ -686,6 +736,24 @@ void Buffer::SetNumberOfBytes(vtkm::BufferSizeType numberOfBytes,
   detail::BufferHelper::SetNumberOfBytes(this->Internals, lock, numberOfBytes, preserve, token);
 }
 
+vtkm::UInt64 Buffer::GetModifiedCount() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->GetModifiedCount(lock);
+}
+
+void Buffer::SetReadOnly(bool readOnly) const
+{
+  LockType lock = this->Internals->GetLock();
+  this->Internals->SetReadOnly(lock, readOnly);
+}
+
+bool Buffer::IsReadOnly() const
+{
+  LockType lock = this->Internals->GetLock();
+  return this->Internals->IsReadOnly(lock);
+}
+
 bool Buffer::HasMetaData() const
 {
   return (this->Internals->MetaData.Data != nullptr);
@@ -917,12 +985,27 @@ void Buffer::Reset(const vtkm::cont::internal::BufferInfo& bufferInfo)
   }
 
   this->Internals->SetNumberOfBytes(lock, bufferInfo.GetSize());
+  this->Internals->SetReadOnly(lock, false);
+  this->Internals->Modified(lock);
 }
 
 void Buffer::ReleaseDeviceResources() const
 {
   vtkm::cont::Token token;
 
+  if (this->IsReadOnly())
+  {
+    // A read-only buffer is never written, so the data on the host is always up to date. Only
+    // wait until no one is using the device buffers before releasing them.
+    LockType lock = this->Internals->GetLock();
+    detail::BufferHelper::WaitForExclusiveAccess(this->Internals, lock, token);
+    for (auto&& deviceBuffer : this->Internals->GetDeviceBuffers(lock))
+    {
+      deviceBuffer.second.Release();
+    }
+    return;
+  }
+
   // Getting a write host buffer will invalidate any device arrays and preserve data
   // on the host (copying if necessary).
   this->WritePointerHost(token);
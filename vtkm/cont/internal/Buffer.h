@@ -125,6 +125,24 @@ public:
                                   vtkm::CopyFlag preserve,
                                   vtkm::cont::Token& token);
 
+  /// \brief Returns a count that changes whenever the buffer may have been modified.
+  ///
+  /// The count increases every time write access to the buffer is granted (for example with
+  /// `WritePointerHost`, `WritePointerDevice` or a resize) and when the buffer is `Reset`. Objects
+  /// derived from the data in the buffer (such as cell locators) can compare the count with the
+  /// one they saw when they were built to find out whether they are out of date.
+  ///
+  VTKM_CONT vtkm::UInt64 GetModifiedCount() const;
+
+  /// \brief Marks the buffer as read-only or writable.
+  ///
+  /// Write access to a read-only buffer (with `WritePointerHost`, `WritePointerDevice`, a resize,
+  /// or a copy into it) throws `vtkm::cont::ErrorBadValue`. This protects memory that cannot be
+  /// written, such as a file mapped read-only. `Reset` makes the buffer writable again.
+  ///
+  VTKM_CONT void SetReadOnly(bool readOnly) const;
+  VTKM_CONT bool IsReadOnly() const;
+
 private:
   VTKM_CONT bool MetaDataIsType(const std::string& type) const;
   VTKM_CONT void SetMetaData(void* data,
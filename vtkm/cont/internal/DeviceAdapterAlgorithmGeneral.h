@@ -12,6 +12,7 @@
 #define vtk_m_cont_internal_DeviceAdapterAlgorithmGeneral_h
 
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCast.h>
 #include <vtkm/cont/ArrayHandleDecorator.h>
 #include <vtkm/cont/ArrayHandleDiscard.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
@@ -313,6 +314,384 @@ public:
     return static_cast<vtkm::Id>(popCount.load(std::memory_order_seq_cst));
   }
 
+  //--------------------------------------------------------------------------
+  // Counting Sort
+  template <typename T, class Storage>
+  VTKM_CONT static void CountingSort(vtkm::cont::ArrayHandle<T, Storage>& keys, vtkm::Id keyRange)
+  {
+    VTKM_LOG_SCOPE_FUNCTION(vtkm::cont::LogLevel::Perf);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> keyOffsets;
+    CountingSortImpl(
+      keys, CountingSortNoValuesPortal{}, CountingSortNoValuesPortal{}, keyRange, keyOffsets);
+  }
+
+  template <typename T, typename U, class StorageT, class StorageU, class StorageO>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange,
+                                          vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets)
+  {
+    VTKM_LOG_SCOPE_FUNCTION(vtkm::cont::LogLevel::Perf);
+
+    VTKM_ASSERT(keys.GetNumberOfValues() == values.GetNumberOfValues());
+    vtkm::cont::ArrayHandle<U> sortedValues;
+    {
+      vtkm::cont::Token token;
+      auto valuesInPortal = values.PrepareForInput(DeviceAdapterTag(), token);
+      auto valuesOutPortal =
+        sortedValues.PrepareForOutput(keys.GetNumberOfValues(), DeviceAdapterTag(), token);
+      CountingSortImpl(keys, valuesInPortal, valuesOutPortal, keyRange, keyOffsets);
+    }
+    DerivedAlgorithm::Copy(sortedValues, values);
+  }
+
+  template <typename T, typename U, class StorageT, class StorageU>
+  VTKM_CONT static void CountingSortByKey(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                          vtkm::cont::ArrayHandle<U, StorageU>& values,
+                                          vtkm::Id keyRange)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> keyOffsets;
+    CountingSortByKey(keys, values, keyRange, keyOffsets);
+  }
+
+private:
+  template <typename T,
+            class StorageT,
+            typename ValuesInPortal,
+            typename ValuesOutPortal,
+            class StorageO>
+  VTKM_CONT static void CountingSortImpl(vtkm::cont::ArrayHandle<T, StorageT>& keys,
+                                         const ValuesInPortal& valuesInPortal,
+                                         const ValuesOutPortal& valuesOutPortal,
+                                         vtkm::Id keyRange,
+                                         vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets)
+  {
+    VTKM_STATIC_ASSERT_MSG(std::is_integral<T>::value, "CountingSort requires integer keys.");
+
+    keyRange = vtkm::Max(keyRange, vtkm::Id(0));
+    const vtkm::Id numValues = keys.GetNumberOfValues();
+
+    // Each block is counted and scattered serially. Use enough blocks to keep the device busy,
+    // but keep the counts of all the blocks within the size of the input. When there are too
+    // many keys for that, count and scatter each value in parallel with atomics instead.
+    constexpr vtkm::Id minBlockSize = 1024;
+    constexpr vtkm::Id maxBlocks = 4096;
+    vtkm::Id numBlocks = vtkm::Min((numValues + minBlockSize - 1) / minBlockSize, maxBlocks);
+    if ((keyRange > 0) && (numValues / keyRange < numBlocks))
+    {
+      CountingSortAtomicImpl(keys, valuesInPortal, valuesOutPortal, keyRange, keyOffsets);
+      return;
+    }
+    numBlocks = vtkm::Max(numBlocks, vtkm::Id(1));
+    const vtkm::Id blockSize = vtkm::Max((numValues + numBlocks - 1) / numBlocks, vtkm::Id(1));
+
+    vtkm::cont::ArrayHandle<vtkm::Id> positions;
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> counts;
+      DerivedAlgorithm::Fill(counts, vtkm::Id(0), keyRange * numBlocks);
+      {
+        vtkm::cont::Token token;
+        auto keysPortal = keys.PrepareForInput(DeviceAdapterTag(), token);
+        auto countsPortal = counts.PrepareForInPlace(DeviceAdapterTag(), token);
+        CountingSortCountKernel<decltype(keysPortal), decltype(countsPortal)> kernel(
+          keysPortal, countsPortal, keyRange, blockSize, numBlocks);
+        DerivedAlgorithm::Schedule(kernel, numBlocks);
+      }
+      DerivedAlgorithm::ScanExtended(counts, positions);
+    }
+
+    {
+      vtkm::cont::Token token;
+      auto positionsPortal = positions.PrepareForInput(DeviceAdapterTag(), token);
+      auto offsetsPortal = keyOffsets.PrepareForOutput(keyRange + 1, DeviceAdapterTag(), token);
+      CountingSortOffsetsKernel<decltype(positionsPortal), decltype(offsetsPortal)> kernel(
+        positionsPortal, offsetsPortal, keyRange, numBlocks);
+      DerivedAlgorithm::Schedule(kernel, keyRange + 1);
+    }
+
+    vtkm::cont::ArrayHandle<T> sortedKeys;
+    {
+      vtkm::cont::Token token;
+      auto keysInPortal = keys.PrepareForInput(DeviceAdapterTag(), token);
+      auto positionsPortal = positions.PrepareForInPlace(DeviceAdapterTag(), token);
+      auto keysOutPortal = sortedKeys.PrepareForOutput(numValues, DeviceAdapterTag(), token);
+      CountingSortScatterKernel<decltype(keysInPortal),
+                                ValuesInPortal,
+                                decltype(positionsPortal),
+                                decltype(keysOutPortal),
+                                ValuesOutPortal>
+        kernel(keysInPortal,
+               valuesInPortal,
+               positionsPortal,
+               keysOutPortal,
+               valuesOutPortal,
+               blockSize,
+               numBlocks);
+      DerivedAlgorithm::Schedule(kernel, numBlocks);
+    }
+    DerivedAlgorithm::Copy(sortedKeys, keys);
+  }
+
+  template <typename T,
+            class StorageT,
+            typename ValuesInPortal,
+            typename ValuesOutPortal,
+            class StorageO>
+  VTKM_CONT static void CountingSortAtomicImpl(
+    vtkm::cont::ArrayHandle<T, StorageT>& keys,
+    const ValuesInPortal& valuesInPortal,
+    const ValuesOutPortal& valuesOutPortal,
+    vtkm::Id keyRange,
+    vtkm::cont::ArrayHandle<vtkm::Id, StorageO>& keyOffsets)
+  {
+    const vtkm::Id numValues = keys.GetNumberOfValues();
+
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> counts;
+      DerivedAlgorithm::Fill(counts, vtkm::Id(0), keyRange);
+      {
+        vtkm::cont::Token token;
+        auto keysPortal = keys.PrepareForInput(DeviceAdapterTag(), token);
+        auto countsPortal = counts.PrepareForInPlace(DeviceAdapterTag(), token);
+        CountingSortAtomicCountKernel<decltype(keysPortal)> kernel(
+          keysPortal, countsPortal.GetArray(), keyRange);
+        DerivedAlgorithm::Schedule(kernel, numValues);
+      }
+      DerivedAlgorithm::ScanExtended(counts, keyOffsets);
+    }
+
+    // The input index of each value in sorted order.
+    vtkm::cont::ArrayHandle<vtkm::Id> permutation;
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> positions;
+      DerivedAlgorithm::Copy(keyOffsets, positions);
+      vtkm::cont::Token token;
+      auto keysPortal = keys.PrepareForInput(DeviceAdapterTag(), token);
+      auto positionsPortal = positions.PrepareForInPlace(DeviceAdapterTag(), token);
+      auto permutationPortal = permutation.PrepareForOutput(numValues, DeviceAdapterTag(), token);
+      CountingSortAtomicScatterKernel<decltype(keysPortal), decltype(permutationPortal)> kernel(
+        keysPortal, positionsPortal.GetArray(), permutationPortal);
+      DerivedAlgorithm::Schedule(kernel, numValues);
+    }
+
+    {
+      vtkm::cont::Token token;
+      auto offsetsPortal = keyOffsets.PrepareForInput(DeviceAdapterTag(), token);
+      auto permutationPortal = permutation.PrepareForInPlace(DeviceAdapterTag(), token);
+      CountingSortRestoreOrderKernel<decltype(offsetsPortal), decltype(permutationPortal)> kernel(
+        offsetsPortal, permutationPortal);
+      DerivedAlgorithm::Schedule(kernel, keyRange);
+    }
+
+    vtkm::cont::ArrayHandle<T> sortedKeys;
+    {
+      vtkm::cont::Token token;
+      auto keysInPortal = keys.PrepareForInput(DeviceAdapterTag(), token);
+      auto permutationPortal = permutation.PrepareForInput(DeviceAdapterTag(), token);
+      auto keysOutPortal = sortedKeys.PrepareForOutput(numValues, DeviceAdapterTag(), token);
+      CountingSortGatherKernel<decltype(keysInPortal),
+                               ValuesInPortal,
+                               decltype(permutationPortal),
+                               decltype(keysOutPortal),
+                               ValuesOutPortal>
+        kernel(keysInPortal, valuesInPortal, permutationPortal, keysOutPortal, valuesOutPortal);
+      DerivedAlgorithm::Schedule(kernel, numValues);
+    }
+    DerivedAlgorithm::Copy(sortedKeys, keys);
+  }
+
+public:
+  //--------------------------------------------------------------------------
+  // Scan Exclusive Segmented
+  template <typename T, class CIn, class COffsets, class COut, class BinaryFunctor>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output,
+    BinaryFunctor binaryFunctor,
+    const T& initialValue)
+  {
+    VTKM_LOG_SCOPE_FUNCTION(vtkm::cont::LogLevel::Perf);
+
+    const vtkm::Id numValues = input.GetNumberOfValues();
+    const vtkm::Id numSegments = vtkm::Max(offsets.GetNumberOfValues() - 1, vtkm::Id(0));
+
+    if (HasLongSegment(offsets, numValues))
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> keys;
+      SegmentKeys(offsets, numValues, keys);
+      DerivedAlgorithm::ScanExclusiveByKey(keys, input, output, initialValue, binaryFunctor);
+      return;
+    }
+
+    vtkm::cont::Token token;
+    auto offsetsPortal = offsets.PrepareForInput(DeviceAdapterTag(), token);
+    if (ArrayHandlesAreSame(input, output))
+    {
+      auto portal = output.PrepareForInPlace(DeviceAdapterTag(), token);
+      ScanExclusiveSegmentedKernel<decltype(portal),
+                                   decltype(offsetsPortal),
+                                   decltype(portal),
+                                   BinaryFunctor>
+        kernel(portal, offsetsPortal, portal, binaryFunctor, initialValue);
+      DerivedAlgorithm::Schedule(kernel, numSegments);
+    }
+    else
+    {
+      auto inputPortal = input.PrepareForInput(DeviceAdapterTag(), token);
+      auto outputPortal = output.PrepareForOutput(numValues, DeviceAdapterTag(), token);
+      ScanExclusiveSegmentedKernel<decltype(inputPortal),
+                                   decltype(offsetsPortal),
+                                   decltype(outputPortal),
+                                   BinaryFunctor>
+        kernel(inputPortal, offsetsPortal, outputPortal, binaryFunctor, initialValue);
+      DerivedAlgorithm::Schedule(kernel, numSegments);
+    }
+  }
+
+  template <typename T, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ScanExclusiveSegmented(
+    const vtkm::cont::ArrayHandle<T, CIn>& input,
+    const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+    vtkm::cont::ArrayHandle<T, COut>& output)
+  {
+    DerivedAlgorithm::ScanExclusiveSegmented(
+      input, offsets, output, vtkm::Sum(), vtkm::TypeTraits<T>::ZeroInitialization());
+  }
+
+  //--------------------------------------------------------------------------
+  // Reduce Segmented
+  template <typename T,
+            typename U,
+            class CIn,
+            class COffsets,
+            class COut,
+            class BinaryFunctor>
+  VTKM_CONT static void ReduceSegmented(const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        const U& initialValue,
+                                        BinaryFunctor binaryFunctor)
+  {
+    VTKM_LOG_SCOPE_FUNCTION(vtkm::cont::LogLevel::Perf);
+
+    const vtkm::Id numValues = input.GetNumberOfValues();
+    const vtkm::Id numSegments = vtkm::Max(offsets.GetNumberOfValues() - 1, vtkm::Id(0));
+
+    if (HasLongSegment(offsets, numValues))
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> keys;
+      SegmentKeys(offsets, numValues, keys);
+      vtkm::cont::ArrayHandle<U> scan;
+      DerivedAlgorithm::ScanInclusiveByKey(
+        keys, vtkm::cont::make_ArrayHandleCast<U>(input), scan, binaryFunctor);
+
+      vtkm::cont::Token token;
+      auto scanPortal = scan.PrepareForInput(DeviceAdapterTag(), token);
+      auto offsetsPortal = offsets.PrepareForInput(DeviceAdapterTag(), token);
+      auto outputPortal = output.PrepareForOutput(numSegments, DeviceAdapterTag(), token);
+      ReduceSegmentedGatherKernel<decltype(scanPortal),
+                                  decltype(offsetsPortal),
+                                  decltype(outputPortal),
+                                  BinaryFunctor>
+        kernel(scanPortal, offsetsPortal, outputPortal, binaryFunctor, initialValue);
+      DerivedAlgorithm::Schedule(kernel, numSegments);
+      return;
+    }
+
+    vtkm::cont::Token token;
+    auto inputPortal = input.PrepareForInput(DeviceAdapterTag(), token);
+    auto offsetsPortal = offsets.PrepareForInput(DeviceAdapterTag(), token);
+    auto outputPortal = output.PrepareForOutput(numSegments, DeviceAdapterTag(), token);
+    ReduceSegmentedKernel<decltype(inputPortal),
+                          decltype(offsetsPortal),
+                          decltype(outputPortal),
+                          BinaryFunctor>
+      kernel(inputPortal, offsetsPortal, outputPortal, binaryFunctor, initialValue);
+    DerivedAlgorithm::Schedule(kernel, numSegments);
+  }
+
+  template <typename T, typename U, class CIn, class COffsets, class COut>
+  VTKM_CONT static void ReduceSegmented(const vtkm::cont::ArrayHandle<T, CIn>& input,
+                                        const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                        vtkm::cont::ArrayHandle<U, COut>& output,
+                                        const U& initialValue)
+  {
+    DerivedAlgorithm::ReduceSegmented(input, offsets, output, initialValue, vtkm::Add());
+  }
+
+  //--------------------------------------------------------------------------
+  // Sort Segmented
+  template <typename T, class Storage, class COffsets, class BinaryCompare>
+  VTKM_CONT static void SortSegmented(vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                      BinaryCompare binary_compare)
+  {
+    VTKM_LOG_SCOPE_FUNCTION(vtkm::cont::LogLevel::Perf);
+
+    const vtkm::Id numValues = values.GetNumberOfValues();
+    const vtkm::Id numSegments = vtkm::Max(offsets.GetNumberOfValues() - 1, vtkm::Id(0));
+
+    if (HasLongSegment(offsets, numValues))
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> keys;
+      SegmentKeys(offsets, numValues, keys);
+      auto zipHandle = vtkm::cont::make_ArrayHandleZip(keys, values);
+      DerivedAlgorithm::Sort(zipHandle, SegmentedValueCompare<T, BinaryCompare>(binary_compare));
+      return;
+    }
+
+    vtkm::cont::Token token;
+    auto portal = values.PrepareForInPlace(DeviceAdapterTag(), token);
+    auto offsetsPortal = offsets.PrepareForInput(DeviceAdapterTag(), token);
+    SortSegmentedKernel<decltype(portal), decltype(offsetsPortal), BinaryCompare> kernel(
+      portal, offsetsPortal, binary_compare);
+    DerivedAlgorithm::Schedule(kernel, numSegments);
+  }
+
+  template <typename T, class Storage, class COffsets>
+  VTKM_CONT static void SortSegmented(vtkm::cont::ArrayHandle<T, Storage>& values,
+                                      const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets)
+  {
+    DerivedAlgorithm::SortSegmented(values, offsets, vtkm::SortLess());
+  }
+
+private:
+  // The segmented algorithms handle each segment serially, so that a long segment would hold up
+  // the whole algorithm. When a segment is longer than this, the values are keyed by their
+  // segment instead and handed to the keyed algorithms, which split the segments.
+  static constexpr vtkm::Id SegmentedSerialMaxSize = 1024;
+
+  template <class COffsets>
+  VTKM_CONT static bool HasLongSegment(const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                       vtkm::Id numValues)
+  {
+    const vtkm::Id numSegments = offsets.GetNumberOfValues() - 1;
+    if ((numValues <= SegmentedSerialMaxSize) || (numSegments < 1))
+    {
+      return false;
+    }
+    vtkm::cont::ArrayHandle<vtkm::Id> sizes;
+    DerivedAlgorithm::Transform(vtkm::cont::make_ArrayHandleView(offsets, 1, numSegments),
+                                vtkm::cont::make_ArrayHandleView(offsets, 0, numSegments),
+                                sizes,
+                                vtkm::Subtract());
+    return DerivedAlgorithm::Reduce(sizes, vtkm::Id(0), vtkm::Maximum()) > SegmentedSerialMaxSize;
+  }
+
+  // Gives the values of segment `s` the key `s + 1`. Values outside of all segments get keys
+  // of their own, so they do not change the results of the segments.
+  template <class COffsets>
+  VTKM_CONT static void SegmentKeys(const vtkm::cont::ArrayHandle<vtkm::Id, COffsets>& offsets,
+                                    vtkm::Id numValues,
+                                    vtkm::cont::ArrayHandle<vtkm::Id>& keys)
+  {
+    DerivedAlgorithm::UpperBounds(offsets, vtkm::cont::ArrayHandleIndex(numValues), keys);
+  }
+
+public:
+
   //--------------------------------------------------------------------------
   // Fill Bit Field (bool, resize)
   VTKM_CONT static void Fill(vtkm::cont::BitField& bits, bool value, vtkm::Id numBits)
@@ -9,89 +9,29 @@
 //============================================================================
 
 #include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/MemoryTracker.h>
 #include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
 
 #include <vtkm/Math.h>
 
 #include <atomic>
 #include <cstring>
 
-//----------------------------------------------------------------------------------------
-// Special allocation/deallocation code
-
-#if defined(VTKM_POSIX)
-#define VTKM_MEMALIGN_POSIX
-#elif defined(_WIN32)
-#define VTKM_MEMALIGN_WIN
-#elif defined(__SSE__)
-#define VTKM_MEMALIGN_SSE
-#else
-#define VTKM_MEMALIGN_NONE
-#endif
-
-#if defined(VTKM_MEMALIGN_POSIX)
-#include <stdlib.h>
-#elif defined(VTKM_MEMALIGN_WIN)
-#include <malloc.h>
-#elif defined(VTKM_MEMALIGN_SSE)
-#include <xmmintrin.h>
-#else
-#include <malloc.h>
-#endif
-
-#include <cstddef>
-#include <cstdlib>
-
 namespace
 {
 
 /// A deleter object that can be used with our aligned mallocs
 void HostDeleter(void* memory)
 {
-  if (memory == nullptr)
-  {
-    return;
-  }
-
-#if defined(VTKM_MEMALIGN_POSIX)
-  free(memory);
-#elif defined(VTKM_MEMALIGN_WIN)
-  _aligned_free(memory);
-#elif defined(VTKM_MEMALIGN_SSE)
-  _mm_free(memory);
-#else
-  free(memory);
-#endif
+  vtkm::cont::internal::GetHostMemoryPool().Free(memory);
 }
 
 /// Allocates a buffer of a specified size using VTK-m's preferred memory alignment.
 /// Returns a void* pointer that should be deleted with `HostDeleter`.
 void* HostAllocate(vtkm::BufferSizeType numBytes)
 {
-  VTKM_ASSERT(numBytes >= 0);
-  if (numBytes <= 0)
-  {
-    return nullptr;
-  }
-
-  const std::size_t size = static_cast<std::size_t>(numBytes);
-  constexpr std::size_t align = VTKM_ALLOCATION_ALIGNMENT;
-
-#if defined(VTKM_MEMALIGN_POSIX)
-  void* memory = nullptr;
-  if (posix_memalign(&memory, align, size) != 0)
-  {
-    memory = nullptr;
-  }
-#elif defined(VTKM_MEMALIGN_WIN)
-  void* memory = _aligned_malloc(size, align);
-#elif defined(VTKM_MEMALIGN_SSE)
-  void* memory = _mm_malloc(size, align);
-#else
-  void* memory = malloc(size);
-#endif
-
-  return memory;
+  return vtkm::cont::internal::GetHostMemoryPool().Allocate(numBytes);
 }
 
 /// Reallocates a buffer on the host.
@@ -102,9 +42,10 @@ void HostReallocate(void*& memory,
 {
   VTKM_ASSERT(memory == container);
 
-  // If the new size is not much smaller than the old size, just reuse the buffer (and waste a
-  // little memory).
-  if ((newSize > ((3 * oldSize) / 4)) && (newSize <= oldSize))
+  // If the new size fits in the block already allocated and is not much smaller than the old
+  // size, just reuse the buffer (and waste a little memory).
+  if ((newSize > ((3 * oldSize) / 4)) &&
+      (newSize <= vtkm::cont::internal::HostMemoryPool::GetCapacity(memory)))
   {
     return;
   }
@@ -149,6 +90,11 @@ struct BufferInfoInternals
   BufferInfo::Reallocater* Reallocate;
   vtkm::BufferSizeType Size;
 
+  // The bytes, device, and tag this memory is recorded against in the `MemoryTracker`.
+  vtkm::BufferSizeType TrackedSize;
+  vtkm::cont::DeviceAdapterId TrackedDevice;
+  vtkm::Int32 TrackedTag;
+
   using CountType = vtkm::IdComponent;
   std::atomic<CountType> Count;
 
@@ -156,14 +102,40 @@ struct BufferInfoInternals
                                 void* container,
                                 vtkm::BufferSizeType size,
                                 BufferInfo::Deleter deleter,
-                                BufferInfo::Reallocater reallocater)
+                                BufferInfo::Reallocater reallocater,
+                                vtkm::cont::DeviceAdapterId trackedDevice)
     : Memory(memory)
     , Container(container)
     , Delete(deleter)
     , Reallocate(reallocater)
     , Size(size)
+    , TrackedSize(0)
+    , TrackedDevice(trackedDevice)
+    , TrackedTag(0)
     , Count(1)
   {
+    this->Track(size);
+  }
+
+  VTKM_CONT ~BufferInfoInternals() { this->Track(0); }
+
+  // Updates the `MemoryTracker` to record that this buffer now holds `newSize` bytes.
+  VTKM_CONT void Track(vtkm::BufferSizeType newSize)
+  {
+    vtkm::cont::MemoryTracker& tracker = vtkm::cont::GetMemoryTracker();
+    if ((this->TrackedSize <= 0) && (newSize > 0))
+    {
+      this->TrackedTag = tracker.RecordAllocation(this->TrackedDevice, newSize);
+    }
+    else if ((this->TrackedSize > 0) && (newSize <= 0))
+    {
+      tracker.RecordFree(this->TrackedDevice, this->TrackedTag, this->TrackedSize);
+    }
+    else if (this->TrackedSize != newSize)
+    {
+      tracker.RecordResize(this->TrackedDevice, this->TrackedTag, this->TrackedSize, newSize);
+    }
+    this->TrackedSize = newSize;
   }
 
   BufferInfoInternals(const BufferInfoInternals&) = delete;
@@ -188,7 +160,12 @@ vtkm::cont::DeviceAdapterId BufferInfo::GetDevice() const
 }
 
 BufferInfo::BufferInfo()
-  : Internals(new detail::BufferInfoInternals(nullptr, nullptr, 0, HostDeleter, HostReallocate))
+  : Internals(new detail::BufferInfoInternals(nullptr,
+                                              nullptr,
+                                              0,
+                                              HostDeleter,
+                                              HostReallocate,
+                                              vtkm::cont::DeviceAdapterTagUndefined{}))
   , Device(vtkm::cont::DeviceAdapterTagUndefined{})
 {
 }
@@ -283,7 +260,8 @@ BufferInfo::BufferInfo(vtkm::cont::DeviceAdapterId device,
                        vtkm::BufferSizeType size,
                        Deleter deleter,
                        Reallocater reallocater)
-  : Internals(new detail::BufferInfoInternals(memory, container, size, deleter, reallocater))
+  : Internals(
+      new detail::BufferInfoInternals(memory, container, size, deleter, reallocater, device))
   , Device(device)
 {
 }
@@ -293,6 +271,7 @@ void BufferInfo::Reallocate(vtkm::BufferSizeType newSize)
   this->Internals->Reallocate(
     this->Internals->Memory, this->Internals->Container, this->Internals->Size, newSize);
   this->Internals->Size = newSize;
+  this->Internals->Track(newSize);
 }
 
 TransferredBuffer BufferInfo::TransferOwnership()
@@ -306,6 +285,9 @@ TransferredBuffer BufferInfo::TransferOwnership()
   this->Internals->Delete = [](void*) {};
   this->Internals->Reallocate = vtkm::cont::internal::InvalidRealloc;
 
+  // The memory no longer belongs to VTK-m.
+  this->Internals->Track(0);
+
   return tbufffer;
 }
 
@@ -313,11 +295,17 @@ TransferredBuffer BufferInfo::TransferOwnership()
 
 //----------------------------------------------------------------------------------------
 vtkm::cont::internal::BufferInfo AllocateOnHost(vtkm::BufferSizeType size)
+{
+  return AllocateOnHost(size, vtkm::cont::DeviceAdapterTagUndefined{});
+}
+
+vtkm::cont::internal::BufferInfo AllocateOnHost(vtkm::BufferSizeType size,
+                                                vtkm::cont::DeviceAdapterId device)
 {
   void* memory = HostAllocate(size);
 
   return vtkm::cont::internal::BufferInfo(
-    vtkm::cont::DeviceAdapterTagUndefined{}, memory, memory, size, HostDeleter, HostReallocate);
+    device, memory, memory, size, HostDeleter, HostReallocate);
 }
 
 //----------------------------------------------------------------------------------------
@@ -138,6 +138,14 @@ struct TransferredBuffer
 VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::BufferInfo AllocateOnHost(
   vtkm::BufferSizeType size);
 
+/// Allocates a `BufferInfo` object for the host to be used by a device that shares memory with
+/// the host. The returned `BufferInfo` is associated with the given device, and its memory is
+/// recorded against that device in the `vtkm::cont::MemoryTracker`.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::BufferInfo AllocateOnHost(
+  vtkm::BufferSizeType size,
+  vtkm::cont::DeviceAdapterId device);
+
 /// \brief The base class for device adapter memory managers.
 ///
 /// Every device adapter is expected to define a specialization of `DeviceAdapterMemoryManager`,
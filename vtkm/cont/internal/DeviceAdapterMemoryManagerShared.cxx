@@ -22,8 +22,7 @@ namespace internal
 vtkm::cont::internal::BufferInfo DeviceAdapterMemoryManagerShared::Allocate(
   vtkm::BufferSizeType size) const
 {
-  return vtkm::cont::internal::BufferInfo(vtkm::cont::internal::AllocateOnHost(size),
-                                          this->GetDevice());
+  return vtkm::cont::internal::AllocateOnHost(size, this->GetDevice());
 }
 
 vtkm::cont::internal::BufferInfo DeviceAdapterMemoryManagerShared::CopyHostToDevice(
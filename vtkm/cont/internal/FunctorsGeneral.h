@@ -10,6 +10,7 @@
 #ifndef vtk_m_cont_internal_FunctorsGeneral_h
 #define vtk_m_cont_internal_FunctorsGeneral_h
 
+#include <vtkm/Atomic.h>
 #include <vtkm/BinaryOperators.h>
 #include <vtkm/BinaryPredicates.h>
 #include <vtkm/LowerBound.h>
@@ -23,6 +24,7 @@
 #include <algorithm>
 #include <atomic>
 #include <iterator>
+#include <type_traits>
 
 namespace vtkm
 {
@@ -582,6 +584,317 @@ private:
   WordType FinalWordMask{ 0 };
 };
 
+// The counting sort splits the keys into contiguous blocks. Each block is counted and then
+// scattered serially, so no atomics are needed and equal keys keep their order. The counts are
+// stored key-major (`Counts[key * NumBlocks + block]`), so an exclusive scan of them gives the
+// position where each block writes its first value with each key.
+template <typename KeysPortalType, typename CountsPortalType>
+struct CountingSortCountKernel : vtkm::exec::FunctorBase
+{
+  KeysPortalType Keys;
+  CountsPortalType Counts;
+  vtkm::Id KeyRange;
+  vtkm::Id BlockSize;
+  vtkm::Id NumBlocks;
+
+  VTKM_CONT
+  CountingSortCountKernel(const KeysPortalType& keys,
+                          const CountsPortalType& counts,
+                          vtkm::Id keyRange,
+                          vtkm::Id blockSize,
+                          vtkm::Id numBlocks)
+    : Keys(keys)
+    , Counts(counts)
+    , KeyRange(keyRange)
+    , BlockSize(blockSize)
+    , NumBlocks(numBlocks)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id block) const
+  {
+    const vtkm::Id begin = block * this->BlockSize;
+    const vtkm::Id end = vtkm::Min(begin + this->BlockSize, this->Keys.GetNumberOfValues());
+    for (vtkm::Id index = begin; index < end; ++index)
+    {
+      const vtkm::Id key = static_cast<vtkm::Id>(this->Keys.Get(index));
+      if ((key < 0) || (key >= this->KeyRange))
+      {
+        this->RaiseError("Key passed to CountingSort is outside of the key range.");
+        return;
+      }
+      const vtkm::Id countIndex = key * this->NumBlocks + block;
+      this->Counts.Set(countIndex, this->Counts.Get(countIndex) + 1);
+    }
+  }
+};
+
+// Stands in for the values of a CountingSort without values.
+struct CountingSortNoValuesPortal
+{
+  using ValueType = vtkm::UInt8;
+  VTKM_EXEC_CONT vtkm::UInt8 Get(vtkm::Id) const { return 0; }
+  VTKM_EXEC_CONT void Set(vtkm::Id, vtkm::UInt8) const {}
+};
+
+template <typename PositionsPortalType, typename OffsetsPortalType>
+struct CountingSortOffsetsKernel : vtkm::exec::FunctorBase
+{
+  PositionsPortalType Positions;
+  OffsetsPortalType Offsets;
+  vtkm::Id KeyRange;
+  vtkm::Id NumBlocks;
+
+  VTKM_CONT
+  CountingSortOffsetsKernel(const PositionsPortalType& positions,
+                            const OffsetsPortalType& offsets,
+                            vtkm::Id keyRange,
+                            vtkm::Id numBlocks)
+    : Positions(positions)
+    , Offsets(offsets)
+    , KeyRange(keyRange)
+    , NumBlocks(numBlocks)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id key) const
+  {
+    // The positions have one extra entry at the end holding the total.
+    this->Offsets.Set(key,
+                      (key < this->KeyRange)
+                        ? this->Positions.Get(key * this->NumBlocks)
+                        : this->Positions.Get(this->KeyRange * this->NumBlocks));
+  }
+};
+
+template <typename KeysInPortalType,
+          typename ValuesInPortalType,
+          typename PositionsPortalType,
+          typename KeysOutPortalType,
+          typename ValuesOutPortalType>
+struct CountingSortScatterKernel : vtkm::exec::FunctorBase
+{
+  KeysInPortalType KeysIn;
+  ValuesInPortalType ValuesIn;
+  PositionsPortalType Positions;
+  KeysOutPortalType KeysOut;
+  ValuesOutPortalType ValuesOut;
+  vtkm::Id BlockSize;
+  vtkm::Id NumBlocks;
+
+  VTKM_CONT
+  CountingSortScatterKernel(const KeysInPortalType& keysIn,
+                            const ValuesInPortalType& valuesIn,
+                            const PositionsPortalType& positions,
+                            const KeysOutPortalType& keysOut,
+                            const ValuesOutPortalType& valuesOut,
+                            vtkm::Id blockSize,
+                            vtkm::Id numBlocks)
+    : KeysIn(keysIn)
+    , ValuesIn(valuesIn)
+    , Positions(positions)
+    , KeysOut(keysOut)
+    , ValuesOut(valuesOut)
+    , BlockSize(blockSize)
+    , NumBlocks(numBlocks)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id block) const
+  {
+    const vtkm::Id begin = block * this->BlockSize;
+    const vtkm::Id end = vtkm::Min(begin + this->BlockSize, this->KeysIn.GetNumberOfValues());
+    for (vtkm::Id index = begin; index < end; ++index)
+    {
+      const auto key = this->KeysIn.Get(index);
+      const vtkm::Id positionIndex = static_cast<vtkm::Id>(key) * this->NumBlocks + block;
+      const vtkm::Id position = this->Positions.Get(positionIndex);
+      this->Positions.Set(positionIndex, position + 1);
+      this->KeysOut.Set(position, key);
+      this->ValuesOut.Set(position, this->ValuesIn.Get(index));
+    }
+  }
+};
+
+// When there are too many keys for each block to have its own counts, the counting sort counts
+// the keys and places the input indices with atomics. That loses the input order of equal keys,
+// so the indices with each key are then sorted to restore it before the values are gathered.
+VTKM_EXEC inline vtkm::Id CountingSortAtomicIncrement(vtkm::Id* counter)
+{
+  using APIType = typename std::make_unsigned<vtkm::Id>::type;
+  return static_cast<vtkm::Id>(vtkm::AtomicAdd(reinterpret_cast<APIType*>(counter), APIType(1)));
+}
+
+template <typename KeysPortalType>
+struct CountingSortAtomicCountKernel : vtkm::exec::FunctorBase
+{
+  KeysPortalType Keys;
+  vtkm::Id* Counts;
+  vtkm::Id KeyRange;
+
+  VTKM_CONT
+  CountingSortAtomicCountKernel(const KeysPortalType& keys, vtkm::Id* counts, vtkm::Id keyRange)
+    : Keys(keys)
+    , Counts(counts)
+    , KeyRange(keyRange)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id index) const
+  {
+    const vtkm::Id key = static_cast<vtkm::Id>(this->Keys.Get(index));
+    if ((key < 0) || (key >= this->KeyRange))
+    {
+      this->RaiseError("Key passed to CountingSort is outside of the key range.");
+      return;
+    }
+    CountingSortAtomicIncrement(this->Counts + key);
+  }
+};
+
+template <typename KeysPortalType, typename PermutationPortalType>
+struct CountingSortAtomicScatterKernel : vtkm::exec::FunctorBase
+{
+  KeysPortalType Keys;
+  vtkm::Id* Positions;
+  PermutationPortalType Permutation;
+
+  VTKM_CONT
+  CountingSortAtomicScatterKernel(const KeysPortalType& keys,
+                                  vtkm::Id* positions,
+                                  const PermutationPortalType& permutation)
+    : Keys(keys)
+    , Positions(positions)
+    , Permutation(permutation)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id index) const
+  {
+    const vtkm::Id key = static_cast<vtkm::Id>(this->Keys.Get(index));
+    this->Permutation.Set(CountingSortAtomicIncrement(this->Positions + key), index);
+  }
+};
+
+template <typename OffsetsPortalType, typename PermutationPortalType>
+struct CountingSortRestoreOrderKernel : vtkm::exec::FunctorBase
+{
+  OffsetsPortalType Offsets;
+  PermutationPortalType Permutation;
+
+  VTKM_CONT
+  CountingSortRestoreOrderKernel(const OffsetsPortalType& offsets,
+                                 const PermutationPortalType& permutation)
+    : Offsets(offsets)
+    , Permutation(permutation)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id key) const
+  {
+    const vtkm::Id begin = this->Offsets.Get(key);
+    const vtkm::Id count = this->Offsets.Get(key + 1) - begin;
+    if (count <= 16)
+    {
+      // Most keys only have a few values.
+      for (vtkm::Id i = 1; i < count; ++i)
+      {
+        const vtkm::Id index = this->Permutation.Get(begin + i);
+        vtkm::Id j = i;
+        for (; (j > 0) && (this->Permutation.Get(begin + j - 1) > index); --j)
+        {
+          this->Permutation.Set(begin + j, this->Permutation.Get(begin + j - 1));
+        }
+        this->Permutation.Set(begin + j, index);
+      }
+    }
+    else
+    {
+      // Heap sort keeps a heavily shared key from taking quadratic time.
+      for (vtkm::Id root = count / 2 - 1; root >= 0; --root)
+      {
+        this->SiftDown(begin, root, count);
+      }
+      for (vtkm::Id last = count - 1; last > 0; --last)
+      {
+        const vtkm::Id largest = this->Permutation.Get(begin);
+        this->Permutation.Set(begin, this->Permutation.Get(begin + last));
+        this->Permutation.Set(begin + last, largest);
+        this->SiftDown(begin, 0, last);
+      }
+    }
+  }
+
+private:
+  VTKM_EXEC
+  void SiftDown(vtkm::Id begin, vtkm::Id root, vtkm::Id count) const
+  {
+    const vtkm::Id index = this->Permutation.Get(begin + root);
+    for (vtkm::Id child = 2 * root + 1; child < count; child = 2 * root + 1)
+    {
+      vtkm::Id childIndex = this->Permutation.Get(begin + child);
+      if (child + 1 < count)
+      {
+        const vtkm::Id rightIndex = this->Permutation.Get(begin + child + 1);
+        if (rightIndex > childIndex)
+        {
+          ++child;
+          childIndex = rightIndex;
+        }
+      }
+      if (childIndex <= index)
+      {
+        break;
+      }
+      this->Permutation.Set(begin + root, childIndex);
+      root = child;
+    }
+    this->Permutation.Set(begin + root, index);
+  }
+};
+
+template <typename KeysInPortalType,
+          typename ValuesInPortalType,
+          typename PermutationPortalType,
+          typename KeysOutPortalType,
+          typename ValuesOutPortalType>
+struct CountingSortGatherKernel : vtkm::exec::FunctorBase
+{
+  KeysInPortalType KeysIn;
+  ValuesInPortalType ValuesIn;
+  PermutationPortalType Permutation;
+  KeysOutPortalType KeysOut;
+  ValuesOutPortalType ValuesOut;
+
+  VTKM_CONT
+  CountingSortGatherKernel(const KeysInPortalType& keysIn,
+                           const ValuesInPortalType& valuesIn,
+                           const PermutationPortalType& permutation,
+                           const KeysOutPortalType& keysOut,
+                           const ValuesOutPortalType& valuesOut)
+    : KeysIn(keysIn)
+    , ValuesIn(valuesIn)
+    , Permutation(permutation)
+    , KeysOut(keysOut)
+    , ValuesOut(valuesOut)
+  {
+  }
+
+  VTKM_EXEC
+  void operator()(vtkm::Id position) const
+  {
+    const vtkm::Id index = this->Permutation.Get(position);
+    this->KeysOut.Set(position, this->KeysIn.Get(index));
+    this->ValuesOut.Set(position, this->ValuesIn.Get(index));
+  }
+};
+
 // For a given unsigned integer less than 32 bits, repeat its bits until we
 // have a 32 bit pattern. This is used to make all fill patterns at least
 // 32 bits in size, since concurrently writing to adjacent locations smaller
@@ -1273,6 +1586,240 @@ struct BinaryTransformKernel : vtkm::exec::FunctorBase
       index, this->BinaryOperator(this->InPortal1.Get(index), this->InPortal2.Get(index)));
   }
 };
+
+// The segmented algorithms run one instance per segment, where segment `s` holds the values in
+// [Offsets[s], Offsets[s + 1]), unless a segment is too long to handle serially.
+template <typename InPortalType,
+          typename OffsetsPortalType,
+          typename OutPortalType,
+          typename BinaryFunctor>
+struct ScanExclusiveSegmentedKernel : vtkm::exec::FunctorBase
+{
+  using ValueType = typename OutPortalType::ValueType;
+
+  InPortalType InPortal;
+  OffsetsPortalType OffsetsPortal;
+  OutPortalType OutPortal;
+  BinaryFunctor BinaryOperator;
+  ValueType InitialValue;
+
+  VTKM_CONT
+  ScanExclusiveSegmentedKernel(const InPortalType& inPortal,
+                               const OffsetsPortalType& offsetsPortal,
+                               const OutPortalType& outPortal,
+                               BinaryFunctor binaryOperator,
+                               const ValueType& initialValue)
+    : InPortal(inPortal)
+    , OffsetsPortal(offsetsPortal)
+    , OutPortal(outPortal)
+    , BinaryOperator(binaryOperator)
+    , InitialValue(initialValue)
+  {
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC
+  void operator()(vtkm::Id segment) const
+  {
+    const vtkm::Id begin = this->OffsetsPortal.Get(segment);
+    const vtkm::Id end = this->OffsetsPortal.Get(segment + 1);
+    ValueType sum = this->InitialValue;
+    for (vtkm::Id index = begin; index < end; ++index)
+    {
+      // Get the input before setting the output in case they are the same array.
+      const ValueType value = this->InPortal.Get(index);
+      this->OutPortal.Set(index, sum);
+      sum = this->BinaryOperator(sum, value);
+    }
+  }
+};
+
+template <typename InPortalType,
+          typename OffsetsPortalType,
+          typename OutPortalType,
+          typename BinaryFunctor>
+struct ReduceSegmentedKernel : vtkm::exec::FunctorBase
+{
+  using ValueType = typename OutPortalType::ValueType;
+
+  InPortalType InPortal;
+  OffsetsPortalType OffsetsPortal;
+  OutPortalType OutPortal;
+  BinaryFunctor BinaryOperator;
+  ValueType InitialValue;
+
+  VTKM_CONT
+  ReduceSegmentedKernel(const InPortalType& inPortal,
+                        const OffsetsPortalType& offsetsPortal,
+                        const OutPortalType& outPortal,
+                        BinaryFunctor binaryOperator,
+                        const ValueType& initialValue)
+    : InPortal(inPortal)
+    , OffsetsPortal(offsetsPortal)
+    , OutPortal(outPortal)
+    , BinaryOperator(binaryOperator)
+    , InitialValue(initialValue)
+  {
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC
+  void operator()(vtkm::Id segment) const
+  {
+    const vtkm::Id begin = this->OffsetsPortal.Get(segment);
+    const vtkm::Id end = this->OffsetsPortal.Get(segment + 1);
+    ValueType result = this->InitialValue;
+    for (vtkm::Id index = begin; index < end; ++index)
+    {
+      result = this->BinaryOperator(result, this->InPortal.Get(index));
+    }
+    this->OutPortal.Set(segment, result);
+  }
+};
+
+// Picks the result of each segment from an inclusive scan by segment of the values.
+template <typename ScanPortalType,
+          typename OffsetsPortalType,
+          typename OutPortalType,
+          typename BinaryFunctor>
+struct ReduceSegmentedGatherKernel : vtkm::exec::FunctorBase
+{
+  using ValueType = typename OutPortalType::ValueType;
+
+  ScanPortalType ScanPortal;
+  OffsetsPortalType OffsetsPortal;
+  OutPortalType OutPortal;
+  BinaryFunctor BinaryOperator;
+  ValueType InitialValue;
+
+  VTKM_CONT
+  ReduceSegmentedGatherKernel(const ScanPortalType& scanPortal,
+                              const OffsetsPortalType& offsetsPortal,
+                              const OutPortalType& outPortal,
+                              BinaryFunctor binaryOperator,
+                              const ValueType& initialValue)
+    : ScanPortal(scanPortal)
+    , OffsetsPortal(offsetsPortal)
+    , OutPortal(outPortal)
+    , BinaryOperator(binaryOperator)
+    , InitialValue(initialValue)
+  {
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC
+  void operator()(vtkm::Id segment) const
+  {
+    const vtkm::Id begin = this->OffsetsPortal.Get(segment);
+    const vtkm::Id end = this->OffsetsPortal.Get(segment + 1);
+    this->OutPortal.Set(segment,
+                        (end > begin)
+                          ? this->BinaryOperator(this->InitialValue, this->ScanPortal.Get(end - 1))
+                          : this->InitialValue);
+  }
+};
+
+// Orders the (segment, value) pairs of a segmented sort by segment and then by value.
+template <typename T, class BinaryCompare>
+struct SegmentedValueCompare
+{
+  explicit SegmentedValueCompare(BinaryCompare c)
+    : CompareFunctor(c)
+  {
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC
+  bool operator()(const vtkm::Pair<vtkm::Id, T>& a, const vtkm::Pair<vtkm::Id, T>& b) const
+  {
+    if (a.first != b.first)
+    {
+      return a.first < b.first;
+    }
+    return CompareFunctor(a.second, b.second);
+  }
+
+private:
+  BinaryCompare CompareFunctor;
+};
+
+template <typename PortalType, typename OffsetsPortalType, typename BinaryCompare>
+struct SortSegmentedKernel : vtkm::exec::FunctorBase
+{
+  using ValueType = typename PortalType::ValueType;
+
+  PortalType Portal;
+  OffsetsPortalType OffsetsPortal;
+  BinaryCompare Compare;
+
+  VTKM_CONT
+  SortSegmentedKernel(const PortalType& portal,
+                      const OffsetsPortalType& offsetsPortal,
+                      BinaryCompare compare)
+    : Portal(portal)
+    , OffsetsPortal(offsetsPortal)
+    , Compare(compare)
+  {
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC
+  void operator()(vtkm::Id segment) const
+  {
+    const vtkm::Id begin = this->OffsetsPortal.Get(segment);
+    const vtkm::Id end = this->OffsetsPortal.Get(segment + 1);
+#if defined(VTKM_CUDA) || defined(VTKM_HIP)
+    this->HeapSort(begin, end);
+#else
+    auto iterator = vtkm::cont::ArrayPortalToIteratorBegin(this->Portal);
+    std::sort(iterator + begin,
+              iterator + end,
+              internal::WrappedBinaryOperator<bool, BinaryCompare>(this->Compare));
+#endif
+  }
+
+private:
+  // A sort that needs no extra memory or recursion for devices without std::sort.
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC void HeapSort(vtkm::Id begin, vtkm::Id end) const
+  {
+    const vtkm::Id size = end - begin;
+    for (vtkm::Id root = size / 2 - 1; root >= 0; --root)
+    {
+      this->SiftDown(begin, root, size);
+    }
+    for (vtkm::Id last = size - 1; last > 0; --last)
+    {
+      const ValueType top = this->Portal.Get(begin);
+      this->Portal.Set(begin, this->Portal.Get(begin + last));
+      this->Portal.Set(begin + last, top);
+      this->SiftDown(begin, 0, last);
+    }
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC void SiftDown(vtkm::Id begin, vtkm::Id root, vtkm::Id size) const
+  {
+    const ValueType value = this->Portal.Get(begin + root);
+    vtkm::Id child = 2 * root + 1;
+    while (child < size)
+    {
+      if ((child + 1 < size) &&
+          this->Compare(this->Portal.Get(begin + child), this->Portal.Get(begin + child + 1)))
+      {
+        ++child;
+      }
+      if (!this->Compare(value, this->Portal.Get(begin + child)))
+      {
+        break;
+      }
+      this->Portal.Set(begin + root, this->Portal.Get(begin + child));
+      root = child;
+      child = 2 * root + 1;
+    }
+    this->Portal.Set(begin + root, value);
+  }
+};
 }
 }
 } // namespace vtkm::cont::internal
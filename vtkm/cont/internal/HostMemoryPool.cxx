@@ -0,0 +1,606 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
+#include <vtkm/Assert.h>
+#include <vtkm/Math.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+//----------------------------------------------------------------------------------------
+// Special allocation/deallocation code
+
+#if defined(VTKM_POSIX)
+#define VTKM_MEMALIGN_POSIX
+#elif defined(_WIN32)
+#define VTKM_MEMALIGN_WIN
+#elif defined(__SSE__)
+#define VTKM_MEMALIGN_SSE
+#else
+#define VTKM_MEMALIGN_NONE
+#endif
+
+#if defined(VTKM_MEMALIGN_POSIX)
+#include <stdlib.h>
+#elif defined(VTKM_MEMALIGN_WIN)
+#include <malloc.h>
+#elif defined(VTKM_MEMALIGN_SSE)
+#include <xmmintrin.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define VTKM_HOST_MMAP
+#if defined(MADV_HUGEPAGE)
+#define VTKM_HOST_HUGE_PAGES
+#endif
+#endif
+
+namespace
+{
+
+constexpr std::size_t Alignment = VTKM_ALLOCATION_ALIGNMENT;
+
+/// How the memory of a block was obtained from the system.
+enum BlockSource : vtkm::Int32
+{
+  SourceMalloc = 0,
+  SourceHugePages = 1,
+  SourceMapped = 2
+};
+
+/// Every block handed out by the pool is preceded by a header recording its capacity, size
+/// class, and how it was obtained from the system. The header occupies a full alignment unit
+/// so that the memory returned stays aligned.
+struct BlockHeader
+{
+  vtkm::BufferSizeType Capacity;
+  vtkm::Int32 SizeClass;
+  vtkm::Int32 Source;
+};
+static_assert(sizeof(BlockHeader) <= Alignment,
+              "VTKM_ALLOCATION_ALIGNMENT too small to hold host memory pool header.");
+
+/// Size class used for blocks that are too large to be cached.
+constexpr vtkm::Int32 UnpooledSizeClass = -1;
+
+/// All allocations of this many bytes or fewer are placed in the smallest size class.
+constexpr vtkm::Int32 MinBlockShift = 8;
+constexpr vtkm::BufferSizeType MinBlockSize = vtkm::BufferSizeType(1) << MinBlockShift;
+
+/// Blocks larger than this are never cached.
+constexpr vtkm::Int32 MaxBlockShift = 26;
+constexpr vtkm::BufferSizeType MaxBlockSize = vtkm::BufferSizeType(1) << MaxBlockShift;
+
+/// Each power of two is divided into this many size classes.
+constexpr vtkm::Int32 ClassesPerPowerOfTwo = 4;
+
+constexpr vtkm::Int32 NumSizeClasses = 1 + (MaxBlockShift - MinBlockShift) * ClassesPerPowerOfTwo;
+
+constexpr vtkm::BufferSizeType DefaultMaxCachedBytes = vtkm::BufferSizeType(256) << 20;
+
+vtkm::Int32 HighestBit(vtkm::UInt64 value)
+{
+  vtkm::Int32 bit = -1;
+  while (value != 0)
+  {
+    value >>= 1;
+    ++bit;
+  }
+  return bit;
+}
+
+/// Finds the size class for a request and the capacity of blocks of that class.
+void FindSizeClass(vtkm::BufferSizeType numBytes,
+                   vtkm::Int32& sizeClass,
+                   vtkm::BufferSizeType& capacity)
+{
+  if (numBytes <= MinBlockSize)
+  {
+    sizeClass = 0;
+    capacity = MinBlockSize;
+    return;
+  }
+  if (numBytes > MaxBlockSize)
+  {
+    sizeClass = UnpooledSizeClass;
+    capacity = numBytes;
+    return;
+  }
+
+  // numBytes is in the range (2^shift, 2^(shift+1)]. That range is split into
+  // ClassesPerPowerOfTwo evenly spaced capacities.
+  const vtkm::UInt64 value = static_cast<vtkm::UInt64>(numBytes - 1);
+  const vtkm::Int32 shift = HighestBit(value);
+  const vtkm::Int32 stepShift = shift - 2;
+  const vtkm::Int32 subClass = static_cast<vtkm::Int32>((value >> stepShift) & 3);
+
+  sizeClass = 1 + (shift - MinBlockShift) * ClassesPerPowerOfTwo + subClass;
+  capacity = static_cast<vtkm::BufferSizeType>(ClassesPerPowerOfTwo + subClass + 1) << stepShift;
+}
+
+void* SystemAllocate(std::size_t size)
+{
+  constexpr std::size_t align = VTKM_ALLOCATION_ALIGNMENT;
+
+#if defined(VTKM_MEMALIGN_POSIX)
+  void* memory = nullptr;
+  if (posix_memalign(&memory, align, size) != 0)
+  {
+    memory = nullptr;
+  }
+#elif defined(VTKM_MEMALIGN_WIN)
+  void* memory = _aligned_malloc(size, align);
+#elif defined(VTKM_MEMALIGN_SSE)
+  void* memory = _mm_malloc(size, align);
+#else
+  void* memory = malloc(size);
+#endif
+
+  return memory;
+}
+
+void SystemFree(void* memory)
+{
+#if defined(VTKM_MEMALIGN_POSIX)
+  free(memory);
+#elif defined(VTKM_MEMALIGN_WIN)
+  _aligned_free(memory);
+#elif defined(VTKM_MEMALIGN_SSE)
+  _mm_free(memory);
+#else
+  free(memory);
+#endif
+}
+
+#if defined(VTKM_HOST_HUGE_PAGES)
+constexpr std::size_t HugePageSize = std::size_t(2) << 20;
+
+/// The number of bytes mapped for a block (including its header) backed by huge pages.
+std::size_t HugePageMappedLength(vtkm::BufferSizeType capacity)
+{
+  const std::size_t length = static_cast<std::size_t>(capacity) + Alignment;
+  return ((length + HugePageSize - 1) / HugePageSize) * HugePageSize;
+}
+
+void* HugePageAllocate(std::size_t length)
+{
+  // Explicit huge pages are only available if they have been reserved by the administrator
+  // (vm.nr_hugepages). Otherwise this fails right away.
+  void* memory = mmap(
+    nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (memory != MAP_FAILED)
+  {
+    return memory;
+  }
+
+  // Fall back to transparent huge pages. The kernel can only back a range with huge pages
+  // where it is aligned to the huge page size, so map a larger region and trim it to an
+  // aligned range.
+  const std::size_t paddedLength = length + HugePageSize;
+  char* region = reinterpret_cast<char*>(
+    mmap(nullptr, paddedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (region == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  const std::uintptr_t regionStart = reinterpret_cast<std::uintptr_t>(region);
+  const std::uintptr_t alignedStart = (regionStart + HugePageSize - 1) & ~(HugePageSize - 1);
+  const std::size_t leading = static_cast<std::size_t>(alignedStart - regionStart);
+  const std::size_t trailing = paddedLength - leading - length;
+  if (leading > 0)
+  {
+    munmap(region, leading);
+  }
+  if (trailing > 0)
+  {
+    munmap(region + leading + length, trailing);
+  }
+  // This is only a hint. If transparent huge pages are disabled, the memory is still usable.
+  madvise(region + leading, length, MADV_HUGEPAGE);
+  return region + leading;
+}
+
+void HugePageFree(void* memory, std::size_t length)
+{
+  munmap(memory, length);
+}
+#endif
+
+#if defined(VTKM_HOST_MMAP)
+/// Maps pages for a block (including its header) that no one has touched yet.
+void* MappedAllocate(vtkm::BufferSizeType capacity)
+{
+  void* memory = mmap(nullptr,
+                      static_cast<std::size_t>(capacity) + Alignment,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1,
+                      0);
+  return (memory != MAP_FAILED) ? memory : nullptr;
+}
+
+void MappedFree(void* memory, vtkm::BufferSizeType capacity)
+{
+  munmap(memory, static_cast<std::size_t>(capacity) + Alignment);
+}
+#endif
+
+BlockHeader* GetHeader(const void* memory)
+{
+  return reinterpret_cast<BlockHeader*>(
+    const_cast<char*>(reinterpret_cast<const char*>(memory) - Alignment));
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+namespace detail
+{
+
+struct HostMemoryPoolInternals
+{
+  struct Bin
+  {
+    std::mutex Mutex;
+    std::vector<void*> FreeBlocks;
+  };
+
+  Bin Bins[NumSizeClasses];
+
+  std::atomic<vtkm::BufferSizeType> MaxCachedBytes{ DefaultMaxCachedBytes };
+  std::atomic<bool> TrimOnIdle{ false };
+  std::atomic<vtkm::BufferSizeType> HugePageThreshold{ 0 };
+
+  std::atomic<vtkm::BufferSizeType> CachedBytes{ 0 };
+  std::atomic<vtkm::BufferSizeType> LiveBytes{ 0 };
+  std::atomic<vtkm::Id> LiveBlocks{ 0 };
+
+  std::atomic<vtkm::UInt64> NumAllocations{ 0 };
+  std::atomic<vtkm::UInt64> NumCacheHits{ 0 };
+  std::atomic<vtkm::UInt64> NumSystemAllocations{ 0 };
+  std::atomic<vtkm::UInt64> NumSystemFrees{ 0 };
+  std::atomic<vtkm::UInt64> NumHugePageAllocations{ 0 };
+
+  // Gets memory for a block with the given capacity plus its header from the system. When
+  // `fresh` is set, the pages are newly mapped where the platform allows it, so they have not
+  // been touched by any thread.
+  char* SystemAllocateBlock(vtkm::BufferSizeType capacity, bool fresh, BlockSource& source)
+  {
+#if defined(VTKM_HOST_HUGE_PAGES)
+    const vtkm::BufferSizeType threshold = this->HugePageThreshold.load();
+    if ((threshold > 0) && (capacity >= threshold))
+    {
+      char* base = reinterpret_cast<char*>(HugePageAllocate(HugePageMappedLength(capacity)));
+      if (base != nullptr)
+      {
+        source = SourceHugePages;
+        return base;
+      }
+    }
+#endif
+#if defined(VTKM_HOST_MMAP)
+    if (fresh)
+    {
+      char* base = reinterpret_cast<char*>(MappedAllocate(capacity));
+      if (base != nullptr)
+      {
+        source = SourceMapped;
+        return base;
+      }
+    }
+#else
+    (void)fresh;
+#endif
+    source = SourceMalloc;
+    return reinterpret_cast<char*>(SystemAllocate(static_cast<std::size_t>(capacity) + Alignment));
+  }
+
+  void* NewBlock(vtkm::BufferSizeType capacity, vtkm::Int32 sizeClass, bool fresh)
+  {
+    BlockSource source;
+    char* base = this->SystemAllocateBlock(capacity, fresh, source);
+    if (base == nullptr)
+    {
+      // We might be holding memory that would let the allocation succeed.
+      this->TrimBins(0);
+      base = this->SystemAllocateBlock(capacity, fresh, source);
+      if (base == nullptr)
+      {
+        return nullptr;
+      }
+    }
+    this->NumSystemAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (source == SourceHugePages)
+    {
+      this->NumHugePageAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    BlockHeader* header = reinterpret_cast<BlockHeader*>(base);
+    header->Capacity = capacity;
+    header->SizeClass = sizeClass;
+    header->Source = source;
+    return base + Alignment;
+  }
+
+  void DeleteBlock(void* memory)
+  {
+    BlockHeader* header = GetHeader(memory);
+    switch (header->Source)
+    {
+#if defined(VTKM_HOST_HUGE_PAGES)
+      case SourceHugePages:
+        HugePageFree(header, HugePageMappedLength(header->Capacity));
+        break;
+#endif
+#if defined(VTKM_HOST_MMAP)
+      case SourceMapped:
+        MappedFree(header, header->Capacity);
+        break;
+#endif
+      default:
+        SystemFree(header);
+        break;
+    }
+    this->NumSystemFrees.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Releases cached blocks until at most `targetBytes` remain in the cache. Larger size
+  // classes are released first as they return the most memory per system call.
+  void TrimBins(vtkm::BufferSizeType targetBytes)
+  {
+    for (vtkm::Int32 sizeClass = NumSizeClasses - 1;
+         (sizeClass >= 0) && (this->CachedBytes.load() > targetBytes);
+         --sizeClass)
+    {
+      std::vector<void*> release;
+      {
+        Bin& bin = this->Bins[sizeClass];
+        std::lock_guard<std::mutex> lock(bin.Mutex);
+        while (!bin.FreeBlocks.empty() && (this->CachedBytes.load() > targetBytes))
+        {
+          void* memory = bin.FreeBlocks.back();
+          bin.FreeBlocks.pop_back();
+          this->CachedBytes.fetch_sub(GetHeader(memory)->Capacity);
+          release.push_back(memory);
+        }
+      }
+      for (void* memory : release)
+      {
+        this->DeleteBlock(memory);
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+HostMemoryPool::HostMemoryPool()
+  : Internals(new detail::HostMemoryPoolInternals)
+{
+}
+
+HostMemoryPool::~HostMemoryPool()
+{
+  this->Trim();
+}
+
+void* HostMemoryPool::Allocate(vtkm::BufferSizeType numBytes)
+{
+  VTKM_ASSERT(numBytes >= 0);
+  if (numBytes <= 0)
+  {
+    return nullptr;
+  }
+
+  vtkm::Int32 sizeClass;
+  vtkm::BufferSizeType capacity;
+  FindSizeClass(numBytes, sizeClass, capacity);
+
+  void* memory = nullptr;
+  if (sizeClass != UnpooledSizeClass)
+  {
+    detail::HostMemoryPoolInternals::Bin& bin = this->Internals->Bins[sizeClass];
+    std::lock_guard<std::mutex> lock(bin.Mutex);
+    if (!bin.FreeBlocks.empty())
+    {
+      memory = bin.FreeBlocks.back();
+      bin.FreeBlocks.pop_back();
+      this->Internals->CachedBytes.fetch_sub(capacity);
+    }
+  }
+
+  if (memory != nullptr)
+  {
+    this->Internals->NumCacheHits.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    memory = this->Internals->NewBlock(capacity, sizeClass, false);
+    if (memory == nullptr)
+    {
+      return nullptr;
+    }
+  }
+
+  this->Internals->NumAllocations.fetch_add(1, std::memory_order_relaxed);
+  this->Internals->LiveBytes.fetch_add(capacity);
+  this->Internals->LiveBlocks.fetch_add(1);
+  return memory;
+}
+
+void* HostMemoryPool::AllocateUncached(vtkm::BufferSizeType numBytes)
+{
+  VTKM_ASSERT(numBytes >= 0);
+  if (numBytes <= 0)
+  {
+    return nullptr;
+  }
+
+  // The unpooled size class makes `Free` return the block to the system.
+  void* memory = this->Internals->NewBlock(numBytes, UnpooledSizeClass, true);
+  if (memory == nullptr)
+  {
+    return nullptr;
+  }
+
+  this->Internals->NumAllocations.fetch_add(1, std::memory_order_relaxed);
+  this->Internals->LiveBytes.fetch_add(numBytes);
+  this->Internals->LiveBlocks.fetch_add(1);
+  return memory;
+}
+
+void HostMemoryPool::Free(void* memory)
+{
+  if (memory == nullptr)
+  {
+    return;
+  }
+
+  BlockHeader* header = GetHeader(memory);
+  const vtkm::BufferSizeType capacity = header->Capacity;
+  this->Internals->LiveBytes.fetch_sub(capacity);
+
+  bool cached = false;
+  if (header->SizeClass != UnpooledSizeClass)
+  {
+    // Reserve room in the cache before adding the block so that concurrent frees cannot
+    // push the cache over its limit.
+    const vtkm::BufferSizeType maxCached = this->Internals->MaxCachedBytes.load();
+    vtkm::BufferSizeType cachedBytes = this->Internals->CachedBytes.load();
+    while (!cached && (cachedBytes + capacity <= maxCached))
+    {
+      cached = this->Internals->CachedBytes.compare_exchange_weak(cachedBytes,
+                                                                  cachedBytes + capacity);
+    }
+    if (cached)
+    {
+      detail::HostMemoryPoolInternals::Bin& bin = this->Internals->Bins[header->SizeClass];
+      std::lock_guard<std::mutex> lock(bin.Mutex);
+      bin.FreeBlocks.push_back(memory);
+    }
+  }
+
+  if (!cached)
+  {
+    this->Internals->DeleteBlock(memory);
+  }
+
+  if ((this->Internals->LiveBlocks.fetch_sub(1) == 1) && this->Internals->TrimOnIdle.load())
+  {
+    this->Trim();
+  }
+}
+
+vtkm::BufferSizeType HostMemoryPool::GetCapacity(const void* memory)
+{
+  return (memory != nullptr) ? GetHeader(memory)->Capacity : 0;
+}
+
+void HostMemoryPool::SetMaxCachedBytes(vtkm::BufferSizeType maxBytes)
+{
+  this->Internals->MaxCachedBytes.store(vtkm::Max(maxBytes, vtkm::BufferSizeType(0)));
+  this->Internals->TrimBins(this->Internals->MaxCachedBytes.load());
+}
+
+vtkm::BufferSizeType HostMemoryPool::GetMaxCachedBytes() const
+{
+  return this->Internals->MaxCachedBytes.load();
+}
+
+void HostMemoryPool::SetTrimOnIdle(bool trim)
+{
+  this->Internals->TrimOnIdle.store(trim);
+}
+
+bool HostMemoryPool::GetTrimOnIdle() const
+{
+  return this->Internals->TrimOnIdle.load();
+}
+
+void HostMemoryPool::SetHugePageThreshold(vtkm::BufferSizeType numBytes)
+{
+  this->Internals->HugePageThreshold.store(vtkm::Max(numBytes, vtkm::BufferSizeType(0)));
+#if !defined(VTKM_HOST_HUGE_PAGES)
+  if (numBytes > 0)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+               "Huge pages for host memory are not supported on this platform.");
+  }
+#endif
+}
+
+vtkm::BufferSizeType HostMemoryPool::GetHugePageThreshold() const
+{
+  return this->Internals->HugePageThreshold.load();
+}
+
+void HostMemoryPool::Trim()
+{
+  this->Internals->TrimBins(0);
+}
+
+HostMemoryPoolStatistics HostMemoryPool::GetStatistics() const
+{
+  HostMemoryPoolStatistics stats;
+  stats.NumAllocations = this->Internals->NumAllocations.load();
+  stats.NumCacheHits = this->Internals->NumCacheHits.load();
+  stats.NumSystemAllocations = this->Internals->NumSystemAllocations.load();
+  stats.NumSystemFrees = this->Internals->NumSystemFrees.load();
+  stats.NumHugePageAllocations = this->Internals->NumHugePageAllocations.load();
+  stats.CachedBytes = this->Internals->CachedBytes.load();
+  stats.LiveBytes = this->Internals->LiveBytes.load();
+  return stats;
+}
+
+void HostMemoryPool::LogStatistics(vtkm::cont::LogLevel level) const
+{
+  HostMemoryPoolStatistics stats = this->GetStatistics();
+  VTKM_LOG_S(level,
+             "Host memory pool: " << stats.NumAllocations << " allocations, "
+                                  << stats.NumCacheHits << " cache hits, "
+                                  << stats.NumSystemAllocations << " system allocations, "
+                                  << stats.NumSystemFrees << " system frees, "
+                                  << stats.NumHugePageAllocations << " huge page allocations, "
+                                  << vtkm::cont::GetSizeString(stats.LiveBytes) << " live, "
+                                  << vtkm::cont::GetSizeString(stats.CachedBytes) << " cached (max "
+                                  << vtkm::cont::GetSizeString(this->GetMaxCachedBytes()) << ")");
+#ifndef VTKM_ENABLE_LOGGING
+  (void)level;
+  (void)stats;
+#endif
+}
+
+vtkm::cont::internal::HostMemoryPool& GetHostMemoryPool()
+{
+  // The pool is intentionally never destroyed. Arrays held in static objects may be released
+  // after a function-level static would be destructed, and those must still find the pool.
+  static vtkm::cont::internal::HostMemoryPool* pool = new vtkm::cont::internal::HostMemoryPool;
+  return *pool;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
@@ -0,0 +1,160 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_HostMemoryPool_h
+#define vtk_m_cont_internal_HostMemoryPool_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+
+#include <memory>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+namespace detail
+{
+
+struct HostMemoryPoolInternals;
+
+} // namespace detail
+
+/// \brief Counters describing the activity of the `HostMemoryPool`.
+///
+struct HostMemoryPoolStatistics
+{
+  /// The number of allocation requests served by the pool.
+  vtkm::UInt64 NumAllocations = 0;
+
+  /// The number of allocation requests served from a cached block.
+  vtkm::UInt64 NumCacheHits = 0;
+
+  /// The number of times memory was requested from the system allocator.
+  vtkm::UInt64 NumSystemAllocations = 0;
+
+  /// The number of times memory was returned to the system allocator.
+  vtkm::UInt64 NumSystemFrees = 0;
+
+  /// The number of system allocations that were backed by huge pages.
+  vtkm::UInt64 NumHugePageAllocations = 0;
+
+  /// The number of bytes currently held in the cache waiting to be reused.
+  vtkm::BufferSizeType CachedBytes = 0;
+
+  /// The number of bytes currently handed out by the pool.
+  vtkm::BufferSizeType LiveBytes = 0;
+};
+
+/// \brief A caching allocator for host memory.
+///
+/// All host allocations made through `AllocateOnHost` (and thus the memory managers of all
+/// devices that share memory with the host, such as serial, TBB, and OpenMP) are drawn from
+/// this pool. Requests are rounded up to one of a set of size classes (four classes per power
+/// of two). When a block is released, it is kept in a per-class free list so that a later
+/// allocation of a similar size can reuse it without going back to the system allocator.
+///
+/// The pool is thread safe. The amount of memory held in the cache is bounded by
+/// `SetMaxCachedBytes`; blocks released when the cache is full (and blocks too large to be
+/// pooled) are returned directly to the system. Setting the maximum cached bytes to 0
+/// effectively disables the cache.
+///
+/// The pool can be configured at startup with the `--vtkm-host-pool-max-cached-mb` and
+/// `--vtkm-host-pool-trim-on-idle` arguments to `vtkm::cont::Initialize` (or the
+/// `VTKM_HOST_POOL_MAX_CACHED_MB` and `VTKM_HOST_POOL_TRIM_ON_IDLE` environment variables).
+/// The huge page threshold is set through the `RuntimeDeviceConfiguration` of the host
+/// devices or the `--vtkm-huge-page-threshold-mb` argument.
+///
+class VTKM_CONT_EXPORT HostMemoryPool
+{
+public:
+  VTKM_CONT HostMemoryPool();
+  VTKM_CONT ~HostMemoryPool();
+
+  HostMemoryPool(const HostMemoryPool&) = delete;
+  void operator=(const HostMemoryPool&) = delete;
+
+  /// Allocates a block of at least `numBytes` aligned to `VTKM_ALLOCATION_ALIGNMENT`. Returns
+  /// `nullptr` if `numBytes` is not positive or the system is out of memory.
+  ///
+  VTKM_CONT void* Allocate(vtkm::BufferSizeType numBytes);
+
+  /// Allocates a block of at least `numBytes` that bypasses the cache. The block is never taken
+  /// from the cache, and it is returned to the system rather than cached when freed. Where the
+  /// platform allows, its pages are freshly mapped, so no thread has touched them yet. Use this
+  /// when the placement of the pages matters: a cached block keeps the pages (and so the NUMA
+  /// placement) of the first owner that touched them.
+  ///
+  VTKM_CONT void* AllocateUncached(vtkm::BufferSizeType numBytes);
+
+  /// Releases a block previously returned by `Allocate`. The block is either cached for reuse
+  /// or returned to the system.
+  ///
+  VTKM_CONT void Free(void* memory);
+
+  /// Returns the number of bytes usable in a block returned from `Allocate`. This may be larger
+  /// than the size that was requested.
+  ///
+  VTKM_CONT static vtkm::BufferSizeType GetCapacity(const void* memory);
+
+  /// Sets the maximum number of bytes that the pool holds in its cache. If the cache currently
+  /// holds more than this, it is trimmed immediately.
+  ///
+  VTKM_CONT void SetMaxCachedBytes(vtkm::BufferSizeType maxBytes);
+  VTKM_CONT vtkm::BufferSizeType GetMaxCachedBytes() const;
+
+  /// When on, the cache is emptied whenever the last block handed out by the pool is released
+  /// (that is, when no host array is alive). This keeps memory from lingering between
+  /// pipeline executions at the cost of reallocating on the next execution.
+  ///
+  VTKM_CONT void SetTrimOnIdle(bool trim);
+  VTKM_CONT bool GetTrimOnIdle() const;
+
+  /// Sets the size at which blocks are backed by huge pages. Blocks with a capacity of at least
+  /// this many bytes are mapped directly from the operating system using explicit huge pages
+  /// (`MAP_HUGETLB`) if any are reserved, or otherwise with a hint to use transparent huge pages
+  /// (`madvise(MADV_HUGEPAGE)`). This reduces TLB misses when accessing very large arrays in an
+  /// irregular order. A value of 0 (the default) disables huge pages. Huge pages are currently
+  /// only supported on Linux; elsewhere this setting is ignored.
+  ///
+  /// Blocks already allocated (including those in the cache) are not affected.
+  ///
+  VTKM_CONT void SetHugePageThreshold(vtkm::BufferSizeType numBytes);
+  VTKM_CONT vtkm::BufferSizeType GetHugePageThreshold() const;
+
+  /// Returns all cached blocks to the system.
+  ///
+  VTKM_CONT void Trim();
+
+  VTKM_CONT HostMemoryPoolStatistics GetStatistics() const;
+
+  /// Writes the current statistics to the log.
+  ///
+  VTKM_CONT void LogStatistics(vtkm::cont::LogLevel level = vtkm::cont::LogLevel::MemCont) const;
+
+private:
+  std::unique_ptr<detail::HostMemoryPoolInternals> Internals;
+};
+
+/// Returns the global pool used for host allocations.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::internal::HostMemoryPool& GetHostMemoryPool();
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_HostMemoryPool_h
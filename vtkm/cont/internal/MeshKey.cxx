@@ -0,0 +1,138 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/MeshKey.h>
+
+#include <vtkm/VecTraits.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/Error.h>
+#include <vtkm/cont/Logging.h>
+
+namespace
+{
+
+using MeshKey = vtkm::cont::internal::MeshKey;
+
+struct CellSetKeyFunctor
+{
+  template <vtkm::IdComponent Dimension>
+  void operator()(const vtkm::cont::CellSetStructured<Dimension>& cellSet, MeshKey& key) const
+  {
+    using DimensionsType = typename vtkm::cont::CellSetStructured<Dimension>::SchedulingRangeType;
+    using Traits = vtkm::VecTraits<DimensionsType>;
+    DimensionsType dims = cellSet.GetPointDimensions();
+    key.AddType(typeid(cellSet));
+    for (vtkm::IdComponent i = 0; i < Traits::GetNumberOfComponents(dims); ++i)
+    {
+      key.AddParameter(static_cast<vtkm::Float64>(Traits::GetComponent(dims, i)));
+    }
+  }
+
+  template <typename ShapesStorage, typename ConnectivityStorage, typename OffsetsStorage>
+  void operator()(
+    const vtkm::cont::CellSetExplicit<ShapesStorage, ConnectivityStorage, OffsetsStorage>& cellSet,
+    MeshKey& key) const
+  {
+    this->AddExplicit(cellSet, key);
+  }
+
+  template <typename ConnectivityStorage>
+  void operator()(const vtkm::cont::CellSetSingleType<ConnectivityStorage>& cellSet,
+                  MeshKey& key) const
+  {
+    this->AddExplicit(cellSet, key);
+  }
+
+  template <typename CellSetType>
+  void AddExplicit(const CellSetType& cellSet, MeshKey& key) const
+  {
+    using Cell = vtkm::TopologyElementTagCell;
+    using Point = vtkm::TopologyElementTagPoint;
+    key.AddType(typeid(cellSet));
+    key.AddArray(cellSet.GetShapesArray(Cell{}, Point{}));
+    key.AddArray(cellSet.GetConnectivityArray(Cell{}, Point{}));
+    key.AddArray(cellSet.GetOffsetsArray(Cell{}, Point{}));
+  }
+};
+
+struct ArrayKeyFunctor
+{
+  template <typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T, S>& array, MeshKey& key) const
+  {
+    key.AddType(typeid(array));
+    key.AddArray(array);
+  }
+};
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+void MeshKey::AddCellSet(const vtkm::cont::DynamicCellSet& cellSet)
+{
+  try
+  {
+    cellSet.CastAndCall(CellSetKeyFunctor{}, *this);
+  }
+  catch (vtkm::cont::Error& error)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Mesh not cached: " << error.GetMessage());
+    this->Cacheable = false;
+  }
+}
+
+void MeshKey::AddCoordinates(const vtkm::cont::CoordinateSystem& coords)
+{
+  try
+  {
+    coords.GetData().CastAndCall(ArrayKeyFunctor{}, *this);
+  }
+  catch (vtkm::cont::Error& error)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Mesh not cached: " << error.GetMessage());
+    this->Cacheable = false;
+  }
+}
+
+void MeshKey::AddField(const vtkm::cont::Field& field)
+{
+  try
+  {
+    vtkm::cont::CastAndCall(field, ArrayKeyFunctor{}, *this);
+  }
+  catch (vtkm::cont::Error& error)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Mesh not cached: " << error.GetMessage());
+    this->Cacheable = false;
+  }
+}
+
+bool MeshKey::IsSameMesh(const MeshKey& other) const
+{
+  return this->Cacheable && other.Cacheable && (this->Types == other.Types) &&
+    (this->Buffers == other.Buffers) && (this->Parameters == other.Parameters);
+}
+
+bool MeshKey::IsModified(const MeshKey& other) const
+{
+  return this->ModifiedCounts != other.ModifiedCounts;
+}
+
+}
+}
+} // namespace vtkm::cont::internal
@@ -0,0 +1,93 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_internal_MeshKey_h
+#define vtk_m_cont_internal_MeshKey_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/DynamicCellSet.h>
+#include <vtkm/cont/Field.h>
+#include <vtkm/cont/internal/Buffer.h>
+
+#include <typeindex>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace internal
+{
+
+/// \brief Identifies the arrays something was built from and how often they had been modified.
+///
+/// Caches of structures built from a mesh, such as cell locators or ray tracing shapes, use a
+/// `MeshKey` to decide whether a cached structure can be reused. Arrays are compared by
+/// identity, not by value, so copies of an `ArrayHandle` have the same key. The modified
+/// counts of the arrays' buffers (see `Buffer::GetModifiedCount`) tell whether they were
+/// written since the key was made. Cell sets and arrays whose types cannot be resolved make
+/// the key uncacheable.
+///
+class VTKM_CONT_EXPORT MeshKey
+{
+public:
+  /// Adds the type of the cell set and either its point dimensions (for structured cell sets)
+  /// or its shapes, connectivity, and offsets arrays.
+  ///
+  VTKM_CONT void AddCellSet(const vtkm::cont::DynamicCellSet& cellSet);
+  VTKM_CONT void AddCoordinates(const vtkm::cont::CoordinateSystem& coords);
+  VTKM_CONT void AddField(const vtkm::cont::Field& field);
+
+  template <typename T, typename S>
+  VTKM_CONT void AddArray(const vtkm::cont::ArrayHandle<T, S>& array)
+  {
+    vtkm::cont::internal::Buffer* buffers = array.GetBuffers();
+    for (vtkm::IdComponent i = 0; i < array.GetNumberOfBuffers(); ++i)
+    {
+      this->Buffers.push_back(buffers[i]);
+      this->ModifiedCounts.push_back(buffers[i].GetModifiedCount());
+    }
+  }
+
+  VTKM_CONT void AddType(std::type_index type) { this->Types.push_back(type); }
+  VTKM_CONT void AddParameter(vtkm::Float64 parameter) { this->Parameters.push_back(parameter); }
+
+  VTKM_CONT bool IsCacheable() const { return this->Cacheable; }
+
+  /// Whether both keys are cacheable and refer to the same types, arrays, and parameters,
+  /// whether or not the arrays were modified in between.
+  ///
+  VTKM_CONT bool IsSameMesh(const MeshKey& other) const;
+
+  /// Whether any array was modified between the two keys of the same mesh.
+  ///
+  VTKM_CONT bool IsModified(const MeshKey& other) const;
+
+  /// Whether a structure built for one key can be used for the other.
+  ///
+  VTKM_CONT bool operator==(const MeshKey& other) const
+  {
+    return this->IsSameMesh(other) && !this->IsModified(other);
+  }
+
+private:
+  std::vector<std::type_index> Types;
+  std::vector<vtkm::cont::internal::Buffer> Buffers;
+  std::vector<vtkm::UInt64> ModifiedCounts;
+  std::vector<vtkm::Float64> Parameters;
+  bool Cacheable = true;
+};
+
+}
+}
+} // namespace vtkm::cont::internal
+
+#endif //vtk_m_cont_internal_MeshKey_h
@@ -40,7 +40,19 @@ enum OptionIndex
   // All RuntimeDeviceConfiguration specific options
   NUM_THREADS,
   NUMA_REGIONS,
-  DEVICE_INSTANCE
+  DEVICE_INSTANCE,
+  GRAIN_SIZE,
+  HUGE_PAGE_THRESHOLD,
+
+  // Host memory pool options
+  HOST_POOL_MAX_CACHED_MB,
+  HOST_POOL_TRIM_ON_IDLE,
+
+  // Memory tracker options
+  MEMORY_REPORT,
+
+  // Worklet profiler options
+  PROFILE_WORKLETS
 };
 
 struct VtkmArg : public option::Arg
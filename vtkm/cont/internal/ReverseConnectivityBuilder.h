@@ -12,14 +12,9 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
-#include <vtkm/cont/ArrayHandleCast.h>
-#include <vtkm/cont/ArrayHandleConstant.h>
 
-#include <vtkm/cont/AtomicArray.h>
 #include <vtkm/exec/FunctorBase.h>
 
-#include <utility>
-
 namespace vtkm
 {
 namespace cont
@@ -30,83 +25,40 @@ namespace internal
 namespace rcb
 {
 
-template <typename AtomicHistogram, typename ConnInPortal, typename RConnToConnIdxCalc>
-struct BuildHistogram : public vtkm::exec::FunctorBase
-{
-  AtomicHistogram Histo;
-  ConnInPortal Conn;
-  RConnToConnIdxCalc IdxCalc;
-
-  VTKM_CONT
-  BuildHistogram(const AtomicHistogram& histo,
-                 const ConnInPortal& conn,
-                 const RConnToConnIdxCalc& idxCalc)
-    : Histo(histo)
-    , Conn(conn)
-    , IdxCalc(idxCalc)
-  {
-  }
-
-  VTKM_EXEC
-  void operator()(vtkm::Id rconnIdx) const
-  {
-    // Compute the connectivity array index (skipping cell length entries)
-    const vtkm::Id connIdx = this->IdxCalc(rconnIdx);
-    const vtkm::Id ptId = this->Conn.Get(connIdx);
-    this->Histo.Add(ptId, 1);
-  }
-};
-
-template <typename AtomicHistogram,
-          typename ConnInPortal,
-          typename ROffsetInPortal,
-          typename RConnOutPortal,
+template <typename ConnInPortal,
+          typename PointIdsOutPortal,
+          typename CellIdsOutPortal,
           typename RConnToConnIdxCalc,
           typename ConnIdxToCellIdxCalc>
-struct GenerateRConn : public vtkm::exec::FunctorBase
+struct GatherPointAndCellIds : public vtkm::exec::FunctorBase
 {
-  AtomicHistogram Histo;
   ConnInPortal Conn;
-  ROffsetInPortal ROffsets;
-  RConnOutPortal RConn;
+  PointIdsOutPortal PointIds;
+  CellIdsOutPortal CellIds;
   RConnToConnIdxCalc IdxCalc;
   ConnIdxToCellIdxCalc CellIdCalc;
 
   VTKM_CONT
-  GenerateRConn(const AtomicHistogram& histo,
-                const ConnInPortal& conn,
-                const ROffsetInPortal& rOffsets,
-                const RConnOutPortal& rconn,
-                const RConnToConnIdxCalc& idxCalc,
-                const ConnIdxToCellIdxCalc& cellIdCalc)
-    : Histo(histo)
-    , Conn(conn)
-    , ROffsets(rOffsets)
-    , RConn(rconn)
+  GatherPointAndCellIds(const ConnInPortal& conn,
+                        const PointIdsOutPortal& pointIds,
+                        const CellIdsOutPortal& cellIds,
+                        const RConnToConnIdxCalc& idxCalc,
+                        const ConnIdxToCellIdxCalc& cellIdCalc)
+    : Conn(conn)
+    , PointIds(pointIds)
+    , CellIds(cellIds)
     , IdxCalc(idxCalc)
     , CellIdCalc(cellIdCalc)
   {
   }
 
   VTKM_EXEC
-  void operator()(vtkm::Id inputIdx) const
+  void operator()(vtkm::Id rconnIdx) const
   {
     // Compute the connectivity array index (skipping cell length entries)
-    const vtkm::Id connIdx = this->IdxCalc(inputIdx);
-    const vtkm::Id ptId = this->Conn.Get(connIdx);
-
-    // Compute the cell id:
-    const vtkm::Id cellId = this->CellIdCalc(connIdx);
-
-    // Find the base offset for this point id:
-    const vtkm::Id baseOffset = this->ROffsets.Get(ptId);
-
-    // Find the next unused index for this point id
-    const vtkm::Id nextAvailable = this->Histo.Add(ptId, 1);
-
-    // Update the final location in the RConn table with the cellId
-    const vtkm::Id rconnIdx = baseOffset + nextAvailable;
-    this->RConn.Set(rconnIdx, cellId);
+    const vtkm::Id connIdx = this->IdxCalc(rconnIdx);
+    this->PointIds.Set(rconnIdx, this->Conn.Get(connIdx));
+    this->CellIds.Set(rconnIdx, this->CellIdCalc(connIdx));
   }
 };
 }
@@ -124,6 +76,8 @@ struct GenerateRConn : public vtkm::exec::FunctorBase
 /// index into conn.
 /// @param ConnTag is the StorageTag for the input connectivity array.
 ///
+/// The cells incident to each point are listed in increasing order.
+///
 /// See usages in vtkmCellSetExplicit and vtkmCellSetSingleType for examples.
 class ReverseConnectivityBuilder
 {
@@ -143,72 +97,36 @@ public:
                   vtkm::Id rConnSize,
                   vtkm::cont::DeviceAdapterId device)
   {
-    vtkm::cont::Token connToken;
-    auto connPortal = conn.PrepareForInput(device, connToken);
-    auto zeros = vtkm::cont::make_ArrayHandleConstant(vtkm::IdComponent{ 0 }, numberOfPoints);
-
-    // Compute RConn offsets by atomically building a histogram and doing an
-    // extended scan.
+    // Pair each entry of the connectivity with the cell it belongs to.
     //
     // Example:
-    // (in)  Conn:  | 3  0  1  2  |  3  0  1  3  |  3  0  3  4  |  3  3  4  5  |
-    // (out) RNumIndices:  3  2  1  3  2  1
-    // (out) RIdxOffsets:  0  3  5  6  9 11 12
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> rNumIndices;
-    { // allocate and zero the numIndices array:
-      vtkm::cont::Algorithm::Copy(device, zeros, rNumIndices);
-    }
-
-    { // Build histogram:
-      vtkm::cont::AtomicArray<vtkm::IdComponent> atomicCounter{ rNumIndices };
+    // (in)  Conn:     | 3  0  1  2  |  3  0  1  3  |  3  0  3  4  |  3  3  4  5  |
+    // (out) PointIds: 0  1  2  0  1  3  0  3  4  3  4  5
+    // (out) RConn:    0  0  0  1  1  1  2  2  2  3  3  3
+    vtkm::cont::ArrayHandle<vtkm::Id> pointIds;
+    {
       vtkm::cont::Token token;
-      auto ac = atomicCounter.PrepareForExecution(device, token);
-      using BuildHisto =
-        rcb::BuildHistogram<decltype(ac), decltype(connPortal), RConnToConnIdxCalc>;
-      BuildHisto histoGen{ ac, connPortal, rConnToConnCalc };
-
-      vtkm::cont::Algorithm::Schedule(device, histoGen, rConnSize);
-    }
+      auto connPortal = conn.PrepareForInput(device, token);
+      auto pointIdsPortal = pointIds.PrepareForOutput(rConnSize, device, token);
+      auto rConnPortal = rConn.PrepareForOutput(rConnSize, device, token);
 
-    { // Compute offsets:
-      vtkm::cont::Algorithm::ScanExtended(
-        device, vtkm::cont::make_ArrayHandleCast<vtkm::Id>(rNumIndices), rOffsets);
-    }
+      using GatherT = rcb::GatherPointAndCellIds<decltype(connPortal),
+                                                 decltype(pointIdsPortal),
+                                                 decltype(rConnPortal),
+                                                 RConnToConnIdxCalc,
+                                                 ConnIdxToCellIdxCalc>;
+      GatherT gather{ connPortal, pointIdsPortal, rConnPortal, rConnToConnCalc, cellIdCalc };
 
-    { // Reset the numIndices array to 0's:
-      vtkm::cont::Algorithm::Copy(device, zeros, rNumIndices);
+      vtkm::cont::Algorithm::Schedule(device, gather, rConnSize);
     }
 
-    // Fill the connectivity table:
-    // 1) Lookup each point idx base offset.
-    // 2) Use the atomic histogram to find the next available slot for this
-    //    pt id in RConn.
-    // 3) Compute the cell id from the connectivity index
-    // 4) Update RConn[nextSlot] = cellId
+    // Group the cell ids by point with a counting sort on the point ids, which also gives the
+    // offset of each point. The sort is stable, so the cells of each point stay in order.
     //
     // Example:
-    // (in)    Conn:  | 3  0  1  2  |  3  0  1  3  |  3  0  3  4  |  3  3  4  5  |
-    // (inout) RNumIndices:  0  0  0  0  0  0  (Initial)
-    // (inout) RNumIndices:  3  2  1  3  2  1  (Final)
-    // (in)    RIdxOffsets:  0  3  5  6  9  11
-    // (out)   RConn: | 0  1  2  |  0  1  |  0  |  1  2  3  |  2  3  |  3  |
-    {
-      vtkm::cont::AtomicArray<vtkm::IdComponent> atomicCounter{ rNumIndices };
-      vtkm::cont::Token token;
-      auto ac = atomicCounter.PrepareForExecution(device, token);
-      auto rOffsetPortal = rOffsets.PrepareForInput(device, token);
-      auto rConnPortal = rConn.PrepareForOutput(rConnSize, device, token);
-
-      using GenRConnT = rcb::GenerateRConn<decltype(ac),
-                                           decltype(connPortal),
-                                           decltype(rOffsetPortal),
-                                           decltype(rConnPortal),
-                                           RConnToConnIdxCalc,
-                                           ConnIdxToCellIdxCalc>;
-      GenRConnT rConnGen{ ac, connPortal, rOffsetPortal, rConnPortal, rConnToConnCalc, cellIdCalc };
-
-      vtkm::cont::Algorithm::Schedule(device, rConnGen, rConnSize);
-    }
+    // (out) RConn:       | 0  1  2  |  0  1  |  0  |  1  2  3  |  2  3  |  3  |
+    // (out) RIdxOffsets:  0  3  5  6  9  11  12
+    vtkm::cont::Algorithm::CountingSortByKey(device, pointIds, rConn, numberOfPoints, rOffsets);
   }
 };
 }
@@ -9,6 +9,8 @@
 //============================================================================
 #include <vtkm/cont/internal/RuntimeDeviceConfiguration.h>
 
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
 namespace vtkm
 {
 namespace cont
@@ -39,6 +41,18 @@ void RuntimeDeviceConfigurationBase::Initialize(
     auto code = this->SetDeviceInstance(value);
     this->LogReturnCode(code, "SetDeviceInstance", value);
   }
+  if (configOptions.VTKmGrainSize.IsSet())
+  {
+    auto value = configOptions.VTKmGrainSize.GetValue();
+    auto code = this->SetGrainSize(value);
+    this->LogReturnCode(code, "SetGrainSize", value);
+  }
+  if (configOptions.VTKmHugePageThreshold.IsSet())
+  {
+    auto value = configOptions.VTKmHugePageThreshold.GetValue();
+    auto code = this->SetHugePageThreshold(value);
+    this->LogReturnCode(code, "SetHugePageThreshold", value);
+  }
 }
 
 void RuntimeDeviceConfigurationBase::Initialize(
@@ -66,6 +80,17 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetGrainSize(const vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetHugePageThreshold(
+  const vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetThreads(vtkm::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -81,8 +106,39 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetGrainSize(vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetHugePageThreshold(
+  vtkm::Id&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 void RuntimeDeviceConfigurationBase::ParseExtraArguments(int&, char*[]) const {}
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetHostHugePageThreshold(
+  const vtkm::Id& value) const
+{
+  if (value < 0)
+  {
+    return RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS;
+  }
+  vtkm::cont::internal::GetHostMemoryPool().SetHugePageThreshold(
+    static_cast<vtkm::BufferSizeType>(value) << 20);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetHostHugePageThreshold(
+  vtkm::Id& value) const
+{
+  value =
+    static_cast<vtkm::Id>(vtkm::cont::internal::GetHostMemoryPool().GetHugePageThreshold() >> 20);
+  return RuntimeDeviceConfigReturnCode::SUCCESS;
+}
+
 void RuntimeDeviceConfigurationBase::LogReturnCode(const RuntimeDeviceConfigReturnCode& code,
                                                    const std::string& function,
                                                    const vtkm::Id& value) const
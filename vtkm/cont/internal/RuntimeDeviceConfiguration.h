@@ -55,10 +55,14 @@ public:
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const vtkm::Id&) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetNumaRegions(const vtkm::Id&) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetDeviceInstance(const vtkm::Id&) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetGrainSize(const vtkm::Id&) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHugePageThreshold(const vtkm::Id&) const;
 
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(vtkm::Id& value) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaRegions(vtkm::Id& value) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetDeviceInstance(vtkm::Id& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetGrainSize(vtkm::Id& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHugePageThreshold(vtkm::Id& value) const;
 
 protected:
   /// An overriden method that can be used to perform extra command line argument parsing
@@ -66,6 +70,11 @@ protected:
   /// moment Kokkos is the only device that overrides this method.
   VTKM_CONT virtual void ParseExtraArguments(int&, char*[]) const;
 
+  /// Implementations of `SetHugePageThreshold` and `GetHugePageThreshold` (in megabytes) for
+  /// devices that allocate their memory from the host memory pool.
+  VTKM_CONT RuntimeDeviceConfigReturnCode SetHostHugePageThreshold(const vtkm::Id& value) const;
+  VTKM_CONT RuntimeDeviceConfigReturnCode GetHostHugePageThreshold(vtkm::Id& value) const;
+
   /// Used during Initialize to log a warning message dependent on the return code when
   /// calling a specific `Set*` method.
   ///
@@ -20,6 +20,8 @@ RuntimeDeviceConfigurationOptions::RuntimeDeviceConfigurationOptions()
   : VTKmNumThreads(option::OptionIndex::NUM_THREADS, "VTKM_NUM_THREADS")
   , VTKmNumaRegions(option::OptionIndex::NUMA_REGIONS, "VTKM_NUMA_REGIONS")
   , VTKmDeviceInstance(option::OptionIndex::DEVICE_INSTANCE, "VTKM_DEVICE_INSTANCE")
+  , VTKmGrainSize(option::OptionIndex::GRAIN_SIZE, "VTKM_GRAIN_SIZE")
+  , VTKmHugePageThreshold(option::OptionIndex::HUGE_PAGE_THRESHOLD, "VTKM_HUGE_PAGE_THRESHOLD_MB")
   , Initialized(false)
 {
 }
@@ -51,6 +53,20 @@ RuntimeDeviceConfigurationOptions::RuntimeDeviceConfigurationOptions(
                     option::VtkmArg::Required,
                     "  --vtkm-device-instance <dev> \tSets the device instance to use when using "
                     "kokkos/cuda" });
+  usage.push_back({ option::OptionIndex::GRAIN_SIZE,
+                    0,
+                    "",
+                    "vtkm-grain-size",
+                    option::VtkmArg::Required,
+                    "  --vtkm-grain-size <#> \tSets the number of elements scheduled in each task "
+                    "when using TBB (0 selects an adaptive grain size)" });
+  usage.push_back({ option::OptionIndex::HUGE_PAGE_THRESHOLD,
+                    0,
+                    "",
+                    "vtkm-huge-page-threshold-mb",
+                    option::VtkmArg::Required,
+                    "  --vtkm-huge-page-threshold-mb <#> \tBack host allocations of at least this "
+                    "many megabytes with huge pages (0 disables huge pages)" });
 }
 
 void RuntimeDeviceConfigurationOptions::Initialize(const option::Option* options)
@@ -58,6 +74,8 @@ void RuntimeDeviceConfigurationOptions::Initialize(const option::Option* options
   this->VTKmNumThreads.Initialize(options);
   this->VTKmNumaRegions.Initialize(options);
   this->VTKmDeviceInstance.Initialize(options);
+  this->VTKmGrainSize.Initialize(options);
+  this->VTKmHugePageThreshold.Initialize(options);
   this->Initialized = true;
 }
 
@@ -47,6 +47,8 @@ public:
   RuntimeDeviceOption VTKmNumThreads;
   RuntimeDeviceOption VTKmNumaRegions;
   RuntimeDeviceOption VTKmDeviceInstance;
+  RuntimeDeviceOption VTKmGrainSize;
+  RuntimeDeviceOption VTKmHugePageThreshold;
 
 private:
   bool Initialized;
@@ -0,0 +1,237 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void TestAllocateFree()
+{
+  std::cout << "Test allocate and free" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+
+  VTKM_TEST_ASSERT(pool.Allocate(0) == nullptr);
+
+  for (vtkm::BufferSizeType size : { 1, 64, 256, 257, 1000, 4096, 100000, 3000000 })
+  {
+    void* memory = pool.Allocate(size);
+    VTKM_TEST_ASSERT(memory != nullptr);
+    VTKM_TEST_ASSERT(reinterpret_cast<std::uintptr_t>(memory) % VTKM_ALLOCATION_ALIGNMENT == 0,
+                     "Memory not aligned.");
+    vtkm::BufferSizeType capacity = vtkm::cont::internal::HostMemoryPool::GetCapacity(memory);
+    VTKM_TEST_ASSERT(capacity >= size);
+    // Size classes are at most 25% larger than the request (except for the smallest class).
+    VTKM_TEST_ASSERT((size < 256) || (capacity <= size + size / 4 + 1));
+    std::memset(memory, 0xAB, static_cast<std::size_t>(capacity));
+    pool.Free(memory);
+  }
+
+  vtkm::cont::internal::HostMemoryPoolStatistics stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.NumAllocations == 8);
+  VTKM_TEST_ASSERT(stats.LiveBytes == 0);
+}
+
+void TestReuse()
+{
+  std::cout << "Test cached blocks are reused" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+
+  void* memory1 = pool.Allocate(1000);
+  pool.Free(memory1);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes > 0);
+
+  // A request in the same size class gets the same block back.
+  void* memory2 = pool.Allocate(1010);
+  VTKM_TEST_ASSERT(memory1 == memory2);
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumCacheHits == 1);
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumSystemAllocations == 1);
+  pool.Free(memory2);
+
+  pool.Trim();
+  vtkm::cont::internal::HostMemoryPoolStatistics stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.CachedBytes == 0);
+  VTKM_TEST_ASSERT(stats.NumSystemFrees == stats.NumSystemAllocations);
+  pool.LogStatistics(vtkm::cont::LogLevel::Info);
+}
+
+void TestUncached()
+{
+  std::cout << "Test uncached blocks bypass the cache" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+
+  void* cached = pool.Allocate(100000);
+  pool.Free(cached);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes > 0);
+  const vtkm::BufferSizeType cachedBytes = pool.GetStatistics().CachedBytes;
+
+  // An uncached block of the same size does not take the cached block...
+  void* memory = pool.AllocateUncached(100000);
+  VTKM_TEST_ASSERT(memory != nullptr);
+  VTKM_TEST_ASSERT(reinterpret_cast<std::uintptr_t>(memory) % VTKM_ALLOCATION_ALIGNMENT == 0,
+                   "Memory not aligned.");
+  VTKM_TEST_ASSERT(vtkm::cont::internal::HostMemoryPool::GetCapacity(memory) >= 100000);
+  std::memset(memory, 0xAB, 100000);
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumCacheHits == 0);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == cachedBytes);
+
+  // ...and goes back to the system when freed.
+  pool.Free(memory);
+  vtkm::cont::internal::HostMemoryPoolStatistics stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.CachedBytes == cachedBytes);
+  VTKM_TEST_ASSERT(stats.NumSystemFrees == 1);
+  VTKM_TEST_ASSERT(stats.LiveBytes == 0);
+}
+
+void TestMaxCachedBytes()
+{
+  std::cout << "Test maximum cached bytes" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+  pool.SetMaxCachedBytes(4096);
+  VTKM_TEST_ASSERT(pool.GetMaxCachedBytes() == 4096);
+
+  std::vector<void*> blocks;
+  for (int i = 0; i < 10; ++i)
+  {
+    blocks.push_back(pool.Allocate(1024));
+  }
+  for (void* memory : blocks)
+  {
+    pool.Free(memory);
+  }
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == 4096);
+
+  pool.SetMaxCachedBytes(0);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == 0);
+  void* memory = pool.Allocate(1024);
+  pool.Free(memory);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == 0);
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumCacheHits == 0);
+}
+
+void TestTrimOnIdle()
+{
+  std::cout << "Test trim on idle" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+  pool.SetTrimOnIdle(true);
+  VTKM_TEST_ASSERT(pool.GetTrimOnIdle());
+
+  void* memory1 = pool.Allocate(100);
+  void* memory2 = pool.Allocate(100);
+  pool.Free(memory1);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes > 0);
+  pool.Free(memory2);
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == 0);
+}
+
+void TestHugePages()
+{
+  std::cout << "Test huge pages" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+  VTKM_TEST_ASSERT(pool.GetHugePageThreshold() == 0);
+  pool.SetHugePageThreshold(1 << 20);
+  VTKM_TEST_ASSERT(pool.GetHugePageThreshold() == (1 << 20));
+
+  // Blocks below the threshold come from the regular allocator.
+  void* small = pool.Allocate(1000);
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumHugePageAllocations == 0);
+
+  constexpr vtkm::BufferSizeType largeSize = 4 << 20;
+  void* large = pool.Allocate(largeSize);
+  VTKM_TEST_ASSERT(large != nullptr);
+  VTKM_TEST_ASSERT(reinterpret_cast<std::uintptr_t>(large) % VTKM_ALLOCATION_ALIGNMENT == 0,
+                   "Memory not aligned.");
+  VTKM_TEST_ASSERT(vtkm::cont::internal::HostMemoryPool::GetCapacity(large) >= largeSize);
+  std::memset(large, 0xCD, static_cast<std::size_t>(largeSize));
+#ifdef __linux__
+  VTKM_TEST_ASSERT(pool.GetStatistics().NumHugePageAllocations == 1);
+#endif
+  pool.Free(large);
+  pool.Free(small);
+  pool.Trim();
+
+  // A threshold of 0 turns huge pages off again.
+  pool.SetHugePageThreshold(0);
+  large = pool.Allocate(largeSize);
+  VTKM_TEST_ASSERT(large != nullptr);
+  pool.Free(large);
+  pool.Trim();
+  vtkm::cont::internal::HostMemoryPoolStatistics stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.NumHugePageAllocations <= 1);
+  VTKM_TEST_ASSERT(stats.NumSystemFrees == stats.NumSystemAllocations);
+  VTKM_TEST_ASSERT(stats.LiveBytes == 0);
+}
+
+void TestThreaded()
+{
+  std::cout << "Test concurrent use" << std::endl;
+  vtkm::cont::internal::HostMemoryPool pool;
+
+  auto worker = [&pool](int seed) {
+    std::vector<void*> blocks;
+    for (int i = 0; i < 1000; ++i)
+    {
+      vtkm::BufferSizeType size = 16 + ((i * 7919 + seed * 104729) % 20000);
+      void* memory = pool.Allocate(size);
+      VTKM_TEST_ASSERT(memory != nullptr);
+      *reinterpret_cast<char*>(memory) = static_cast<char>(i);
+      blocks.push_back(memory);
+      if (i % 3 == 0)
+      {
+        pool.Free(blocks.front());
+        blocks.erase(blocks.begin());
+      }
+    }
+    for (void* memory : blocks)
+    {
+      pool.Free(memory);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int seed = 0; seed < 4; ++seed)
+  {
+    threads.emplace_back(worker, seed);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  vtkm::cont::internal::HostMemoryPoolStatistics stats = pool.GetStatistics();
+  VTKM_TEST_ASSERT(stats.NumAllocations == 4000);
+  VTKM_TEST_ASSERT(stats.LiveBytes == 0);
+  VTKM_TEST_ASSERT(stats.CachedBytes <= pool.GetMaxCachedBytes());
+}
+
+void DoTest()
+{
+  TestAllocateFree();
+  TestReuse();
+  TestUncached();
+  TestMaxCachedBytes();
+  TestTrimOnIdle();
+  TestHugePages();
+  TestThreaded();
+}
+
+} // anonymous namespace
+
+int UnitTestHostMemoryPool(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
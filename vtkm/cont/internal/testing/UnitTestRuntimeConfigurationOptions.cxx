@@ -261,7 +261,11 @@ void TestRuntimeDeviceConfigurationOptions()
            "--vtkm-numa-regions",
            "2",
            "--vtkm-device-instance",
-           "1");
+           "1",
+           "--vtkm-grain-size",
+           "256",
+           "--vtkm-huge-page-threshold-mb",
+           "64");
   auto options = GetOptions(argc, argv, usage);
 
   VTKM_TEST_ASSERT(!configOptions.IsInitialized(),
@@ -272,10 +276,16 @@ void TestRuntimeDeviceConfigurationOptions()
   VTKM_TEST_ASSERT(configOptions.VTKmNumThreads.IsSet(), "num threads should be set");
   VTKM_TEST_ASSERT(configOptions.VTKmNumaRegions.IsSet(), "numa regions should be set");
   VTKM_TEST_ASSERT(configOptions.VTKmDeviceInstance.IsSet(), "device instance should be set");
+  VTKM_TEST_ASSERT(configOptions.VTKmGrainSize.IsSet(), "grain size should be set");
+  VTKM_TEST_ASSERT(configOptions.VTKmHugePageThreshold.IsSet(),
+                   "huge page threshold should be set");
 
   VTKM_TEST_ASSERT(configOptions.VTKmNumThreads.GetValue() == 100, "num threads should == 100");
   VTKM_TEST_ASSERT(configOptions.VTKmNumaRegions.GetValue() == 2, "numa regions should == 2");
   VTKM_TEST_ASSERT(configOptions.VTKmDeviceInstance.GetValue() == 1, "device instance should == 1");
+  VTKM_TEST_ASSERT(configOptions.VTKmGrainSize.GetValue() == 256, "grain size should == 256");
+  VTKM_TEST_ASSERT(configOptions.VTKmHugePageThreshold.GetValue() == 64,
+                   "huge page threshold should == 64");
 }
 
 void TestRuntimeConfigurationOptions()
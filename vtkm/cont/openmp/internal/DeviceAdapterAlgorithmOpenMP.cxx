@@ -10,6 +10,7 @@
 
 #include <vtkm/cont/openmp/internal/DeviceAdapterAlgorithmOpenMP.h>
 #include <vtkm/cont/openmp/internal/FunctorsOpenMP.h>
+#include <vtkm/cont/openmp/internal/NumaOpenMP.h>
 
 #include <vtkm/cont/ErrorExecution.h>
 
@@ -32,6 +33,29 @@ void DeviceAdapterAlgorithm<vtkm::cont::DeviceAdapterTagOpenMP>::ScheduleTask(
   vtkm::exec::internal::ErrorMessageBuffer errorMessage(errorString, MESSAGE_SIZE);
   functor.SetErrorMessageBuffer(errorMessage);
 
+  if (vtkm::cont::openmp::GetNumaRegions() > 0)
+  {
+    // Give each thread one contiguous block, the same blocks used to first touch the buffers
+    // allocated for this device, so that threads work on memory local to their socket.
+    vtkm::cont::openmp::PinThreads();
+    VTKM_OPENMP_DIRECTIVE(parallel)
+    {
+      vtkm::Id first, last;
+      vtkm::cont::openmp::StaticPartition(
+        size, omp_get_num_threads(), omp_get_thread_num(), first, last);
+      if (first < last)
+      {
+        functor(first, last);
+      }
+    }
+
+    if (errorMessage.IsErrorRaised())
+    {
+      throw vtkm::cont::ErrorExecution(errorString);
+    }
+    return;
+  }
+
   // Divide n by chunks and round down to nearest power of two. Result is clamped between
   // min and max:
   auto computeChunkSize = [](vtkm::Id n, vtkm::Id chunks, vtkm::Id min, vtkm::Id max) -> vtkm::Id {
@@ -11,6 +11,7 @@
 #define vtk_m_cont_openmp_internal_DeviceAdapterMemoryManagerOpenMP_h
 
 #include <vtkm/cont/openmp/internal/DeviceAdapterTagOpenMP.h>
+#include <vtkm/cont/openmp/internal/NumaOpenMP.h>
 
 #include <vtkm/cont/internal/DeviceAdapterMemoryManagerShared.h>
 
@@ -29,6 +30,13 @@ class DeviceAdapterMemoryManager<vtkm::cont::DeviceAdapterTagOpenMP>
   {
     return vtkm::cont::DeviceAdapterTagOpenMP{};
   }
+
+public:
+  VTKM_CONT vtkm::cont::internal::BufferInfo Allocate(vtkm::BufferSizeType size) const override
+  {
+    // When NUMA placement is enabled, place the pages with the threads that will use them.
+    return vtkm::cont::openmp::AllocateFirstTouched(size);
+  }
 };
 }
 }
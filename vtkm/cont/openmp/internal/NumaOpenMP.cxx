@@ -0,0 +1,328 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/openmp/internal/FunctorsOpenMP.h>
+#include <vtkm/cont/openmp/internal/NumaOpenMP.h>
+
+#include <vtkm/Assert.h>
+#include <vtkm/Math.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+std::atomic<vtkm::Id> NumaRegions{ 0 };
+
+void FirstTouchedDeleter(void* memory)
+{
+  vtkm::cont::internal::GetHostMemoryPool().Free(memory);
+}
+
+void* FirstTouchedAllocate(vtkm::BufferSizeType numBytes)
+{
+  void* memory = vtkm::cont::internal::GetHostMemoryPool().AllocateUncached(numBytes);
+  vtkm::cont::openmp::FirstTouch(memory, numBytes);
+  return memory;
+}
+
+// Follows the reallocation of `AllocateOnHost`, but a new block is placed before the data is
+// copied into it.
+void FirstTouchedReallocate(void*& memory,
+                            void*& container,
+                            vtkm::BufferSizeType oldSize,
+                            vtkm::BufferSizeType newSize)
+{
+  VTKM_ASSERT(memory == container);
+
+  if ((newSize > ((3 * oldSize) / 4)) &&
+      (newSize <= vtkm::cont::internal::HostMemoryPool::GetCapacity(memory)))
+  {
+    return;
+  }
+
+  void* newBuffer = FirstTouchedAllocate(newSize);
+  std::memcpy(newBuffer, memory, static_cast<std::size_t>(vtkm::Min(newSize, oldSize)));
+
+  if (memory != nullptr)
+  {
+    FirstTouchedDeleter(memory);
+  }
+
+  memory = container = newBuffer;
+}
+
+// The size of the thread team that is currently pinned (0 if the threads are not pinned).
+std::atomic<int> PinnedTeamSize{ 0 };
+std::mutex PinMutex;
+
+#ifdef __linux__
+
+// Parses a list of CPUs in the format used by sysfs (for example "0-7,16-23").
+std::vector<int> ParseCpuList(const std::string& cpuList)
+{
+  std::vector<int> cpus;
+  std::istringstream stream(cpuList);
+  std::string range;
+  while (std::getline(stream, range, ','))
+  {
+    if (range.empty())
+    {
+      continue;
+    }
+    const std::size_t dash = range.find('-');
+    const int first = std::stoi(range.substr(0, dash));
+    const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// The CPUs the process was allowed to run on before any threads were pinned.
+const cpu_set_t& GetProcessAffinity()
+{
+  static cpu_set_t affinity = []() {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(mask), &mask);
+    return mask;
+  }();
+  return affinity;
+}
+
+// Returns the CPUs available to the process grouped into numRegions groups. The NUMA nodes
+// reported by the kernel are used when there are enough of them. Otherwise the available CPUs
+// are split into contiguous groups, which matches the usual numbering of cores on each socket.
+std::vector<std::vector<int>> GetRegionCpus(vtkm::Id numRegions)
+{
+  const cpu_set_t& affinity = GetProcessAffinity();
+
+  std::vector<std::vector<int>> regions;
+  for (vtkm::Id node = 0; node < numRegions; ++node)
+  {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpuList;
+    if (!file || !std::getline(file, cpuList))
+    {
+      break;
+    }
+    std::vector<int> cpus;
+    for (int cpu : ParseCpuList(cpuList))
+    {
+      if (CPU_ISSET(cpu, &affinity))
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    if (cpus.empty())
+    {
+      break;
+    }
+    regions.push_back(cpus);
+  }
+  if (static_cast<vtkm::Id>(regions.size()) == numRegions)
+  {
+    return regions;
+  }
+
+  std::vector<int> available;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &affinity))
+    {
+      available.push_back(cpu);
+    }
+  }
+  const vtkm::Id numGroups =
+    std::max(vtkm::Id(1), std::min(numRegions, static_cast<vtkm::Id>(available.size())));
+  regions.assign(static_cast<std::size_t>(numGroups), std::vector<int>{});
+  for (vtkm::Id group = 0; group < numGroups; ++group)
+  {
+    vtkm::Id begin, end;
+    vtkm::cont::openmp::StaticPartition(
+      static_cast<vtkm::Id>(available.size()), numGroups, group, begin, end);
+    regions[static_cast<std::size_t>(group)].assign(available.begin() + begin,
+                                                    available.begin() + end);
+  }
+  return regions;
+}
+
+void PinTeam(vtkm::Id numRegions)
+{
+  const int numThreads = omp_get_max_threads();
+  if (numRegions <= 0)
+  {
+    // Give every thread back the CPUs the process started with.
+    const cpu_set_t& affinity = GetProcessAffinity();
+    VTKM_OPENMP_DIRECTIVE(parallel num_threads(numThreads))
+    {
+      sched_setaffinity(0, sizeof(affinity), &affinity);
+    }
+    return;
+  }
+
+  const std::vector<std::vector<int>> regions = GetRegionCpus(numRegions);
+  const vtkm::Id numGroups = static_cast<vtkm::Id>(regions.size());
+
+  VTKM_OPENMP_DIRECTIVE(parallel num_threads(numThreads))
+  {
+    // Threads are assigned to regions in contiguous blocks so that the block of data a thread
+    // gets from StaticPartition is next to the blocks of the other threads on its socket.
+    const vtkm::Id thread = omp_get_thread_num();
+    const vtkm::Id team = omp_get_num_threads();
+    const vtkm::Id region = (thread * numGroups) / team;
+    const vtkm::Id firstThread = (region * team + numGroups - 1) / numGroups;
+    const std::vector<int>& cpus = regions[static_cast<std::size_t>(region)];
+    const int cpu = cpus[static_cast<std::size_t>(thread - firstThread) % cpus.size()];
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    sched_setaffinity(0, sizeof(mask), &mask);
+  }
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+             "Pinned " << numThreads << " OpenMP threads to " << numGroups << " NUMA regions.");
+}
+
+vtkm::BufferSizeType GetPageSize()
+{
+  static const vtkm::BufferSizeType pageSize = []() {
+    long size = sysconf(_SC_PAGESIZE);
+    return (size > 0) ? static_cast<vtkm::BufferSizeType>(size) : vtkm::BufferSizeType(4096);
+  }();
+  return pageSize;
+}
+
+#else // __linux__
+
+void PinTeam(vtkm::Id numRegions)
+{
+  if (numRegions > 0)
+  {
+    VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+               "Pinning OpenMP threads is only supported on Linux. "
+               "Buffers will still be first touched in parallel.");
+  }
+}
+
+vtkm::BufferSizeType GetPageSize()
+{
+  return 4096;
+}
+
+#endif // __linux__
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace cont
+{
+namespace openmp
+{
+
+void SetNumaRegions(vtkm::Id numRegions)
+{
+  std::lock_guard<std::mutex> lock(PinMutex);
+  const vtkm::Id oldRegions = NumaRegions.exchange(numRegions);
+  if ((oldRegions > 0) && (numRegions <= 0))
+  {
+    PinTeam(0);
+  }
+  PinnedTeamSize.store(0);
+}
+
+vtkm::Id GetNumaRegions()
+{
+  return NumaRegions.load();
+}
+
+void PinThreads()
+{
+  const vtkm::Id numRegions = NumaRegions.load();
+  if ((numRegions <= 0) || (PinnedTeamSize.load() == omp_get_max_threads()))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(PinMutex);
+  if (PinnedTeamSize.load() != omp_get_max_threads())
+  {
+    PinTeam(numRegions);
+    PinnedTeamSize.store(omp_get_max_threads());
+  }
+}
+
+void FirstTouch(void* memory, vtkm::BufferSizeType numBytes)
+{
+  const vtkm::BufferSizeType pageSize = GetPageSize();
+  if ((NumaRegions.load() <= 0) || (memory == nullptr) || (numBytes < 2 * pageSize))
+  {
+    return;
+  }
+
+  PinThreads();
+
+  const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(memory);
+  const int numThreads = omp_get_max_threads();
+  VTKM_OPENMP_DIRECTIVE(parallel num_threads(numThreads))
+  {
+    vtkm::Id begin, end;
+    StaticPartition(numBytes, omp_get_num_threads(), omp_get_thread_num(), begin, end);
+
+    // Write to the first byte of every page that starts within this thread's block. The
+    // contents of a new allocation are undefined, so the values written do not matter.
+    const std::uintptr_t page = static_cast<std::uintptr_t>(pageSize);
+    std::uintptr_t address = ((base + static_cast<std::uintptr_t>(begin) + page - 1) / page) * page;
+    const std::uintptr_t last = base + static_cast<std::uintptr_t>(end);
+    for (; address < last; address += page)
+    {
+      *reinterpret_cast<volatile char*>(address) = 0;
+    }
+  }
+}
+
+vtkm::cont::internal::BufferInfo AllocateFirstTouched(vtkm::BufferSizeType size)
+{
+  vtkm::cont::DeviceAdapterTagOpenMP device;
+  if ((NumaRegions.load() <= 0) || (size < 2 * GetPageSize()))
+  {
+    return vtkm::cont::internal::AllocateOnHost(size, device);
+  }
+
+  void* memory = FirstTouchedAllocate(size);
+  return vtkm::cont::internal::BufferInfo(
+    device, memory, memory, size, FirstTouchedDeleter, FirstTouchedReallocate);
+}
+
+}
+}
+} // namespace vtkm::cont::openmp
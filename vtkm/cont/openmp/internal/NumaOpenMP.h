@@ -0,0 +1,72 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_openmp_internal_NumaOpenMP_h
+#define vtk_m_cont_openmp_internal_NumaOpenMP_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/internal/DeviceAdapterMemoryManager.h>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace openmp
+{
+
+/// \brief Enables NUMA aware placement for the OpenMP device.
+///
+/// When the number of NUMA regions is greater than 0, the OpenMP threads are pinned to cores
+/// spread evenly over that many regions, 1D worklets are scheduled with a static partition
+/// that gives each thread one contiguous block of the range, and buffers allocated for the
+/// OpenMP device are first touched in parallel with the same partition. This places the pages
+/// each thread works on in the memory attached to that thread's socket.
+///
+/// Setting the number of regions to 0 (the default) disables NUMA placement.
+///
+VTKM_CONT_EXPORT void SetNumaRegions(vtkm::Id numRegions);
+
+VTKM_CONT_EXPORT vtkm::Id GetNumaRegions();
+
+/// Pins the OpenMP threads according to the current number of NUMA regions. This does nothing
+/// if NUMA placement is disabled or the threads are already pinned for the current team size.
+VTKM_CONT_EXPORT void PinThreads();
+
+/// Writes to each page of the given memory from the thread that will work on that page
+/// under `StaticPartition`. Does nothing if NUMA placement is disabled.
+VTKM_CONT_EXPORT void FirstTouch(void* memory, vtkm::BufferSizeType numBytes);
+
+/// Allocates a buffer for the OpenMP device. When NUMA placement is enabled, the memory bypasses
+/// the cache of the `HostMemoryPool`, since a recycled block keeps the placement of its first
+/// owner, and is first touched in parallel. Growing the buffer does the same. When NUMA placement
+/// is disabled, this is the same as `AllocateOnHost`.
+VTKM_CONT_EXPORT vtkm::cont::internal::BufferInfo AllocateFirstTouched(vtkm::BufferSizeType size);
+
+/// The partition used when NUMA placement is enabled. Thread `threadId` of `numThreads`
+/// gets the contiguous range [begin, end) of [0, size).
+inline void StaticPartition(vtkm::Id size,
+                            vtkm::Id numThreads,
+                            vtkm::Id threadId,
+                            vtkm::Id& begin,
+                            vtkm::Id& end)
+{
+  const vtkm::Id chunkSize = size / numThreads;
+  const vtkm::Id remainder = size % numThreads;
+  begin = threadId * chunkSize + ((threadId < remainder) ? threadId : remainder);
+  end = begin + chunkSize + ((threadId < remainder) ? 1 : 0);
+}
+
+}
+}
+} // namespace vtkm::cont::openmp
+
+#endif //vtk_m_cont_openmp_internal_NumaOpenMP_h
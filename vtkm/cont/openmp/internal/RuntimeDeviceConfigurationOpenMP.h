@@ -12,6 +12,9 @@
 
 #include <vtkm/cont/internal/RuntimeDeviceConfiguration.h>
 #include <vtkm/cont/openmp/internal/DeviceAdapterTagOpenMP.h>
+#include <vtkm/cont/openmp/internal/NumaOpenMP.h>
+
+#include <omp.h>
 
 namespace vtkm
 {
@@ -29,30 +32,55 @@ class RuntimeDeviceConfiguration<vtkm::cont::DeviceAdapterTagOpenMP>
     return vtkm::cont::DeviceAdapterTagOpenMP{};
   }
 
-  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const vtkm::Id&) const override final
+  // OpenMP keeps the number of threads per host thread, so this only affects the parallel
+  // regions started by the calling thread.
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(
+    const vtkm::Id& value) const override final
   {
-    // TODO: Set the threads in OpenMP
+    if (value < 1)
+    {
+      return RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS;
+    }
+    omp_set_num_threads(static_cast<int>(value));
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetNumaRegions(
-    const vtkm::Id&) const override final
+    const vtkm::Id& value) const override final
   {
-    // TODO: Set the numa regions in OpenMP
+    if (value < 0)
+    {
+      return RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS;
+    }
+    vtkm::cont::openmp::SetNumaRegions(value);
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
-  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(vtkm::Id&) const override final
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(
+    vtkm::Id& value) const override final
   {
-    // TODO: Get the number of OpenMP threads
+    value = static_cast<vtkm::Id>(omp_get_max_threads());
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
-  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaRegions(vtkm::Id&) const override final
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaRegions(
+    vtkm::Id& value) const override final
   {
-    // TODO: Get the number of OpenMP NumaRegions
+    value = vtkm::cont::openmp::GetNumaRegions();
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHugePageThreshold(
+    const vtkm::Id& value) const override final
+  {
+    return this->SetHostHugePageThreshold(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHugePageThreshold(
+    vtkm::Id& value) const override final
+  {
+    return this->GetHostHugePageThreshold(value);
+  }
 };
 } // namespace vtkm::cont::internal
 } // namespace vtkm::cont
@@ -0,0 +1,148 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/openmp/DeviceAdapterOpenMP.h>
+#include <vtkm/cont/internal/HostMemoryPool.h>
+#include <vtkm/cont/openmp/internal/NumaOpenMP.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cstring>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 1 << 20;
+
+struct WriteIndex : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldOut);
+  using ExecutionSignature = void(InputIndex, _1);
+
+  VTKM_EXEC void operator()(vtkm::Id index, vtkm::Id& value) const { value = 3 * index; }
+};
+
+void TestStaticPartition()
+{
+  std::cout << "Test static partition" << std::endl;
+  for (vtkm::Id size : { 0, 1, 7, 100, 1001 })
+  {
+    for (vtkm::Id numThreads : { 1, 3, 8 })
+    {
+      vtkm::Id expectedBegin = 0;
+      for (vtkm::Id thread = 0; thread < numThreads; ++thread)
+      {
+        vtkm::Id begin, end;
+        vtkm::cont::openmp::StaticPartition(size, numThreads, thread, begin, end);
+        VTKM_TEST_ASSERT(begin == expectedBegin, "Partition is not contiguous.");
+        VTKM_TEST_ASSERT(end - begin <= (size / numThreads) + 1, "Partition is unbalanced.");
+        expectedBegin = end;
+      }
+      VTKM_TEST_ASSERT(expectedBegin == size, "Partition does not cover range.");
+    }
+  }
+}
+
+void TestNumaRegions(vtkm::Id numRegions)
+{
+  std::cout << "Test with " << numRegions << " NUMA regions" << std::endl;
+  vtkm::cont::DeviceAdapterTagOpenMP device;
+  auto& config = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+
+  VTKM_TEST_ASSERT(config.SetNumaRegions(numRegions) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+  vtkm::Id value = -1;
+  VTKM_TEST_ASSERT(config.GetNumaRegions(value) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+  VTKM_TEST_ASSERT(value == numRegions, "Wrong number of NUMA regions.");
+
+  vtkm::cont::ArrayHandle<vtkm::Id> array;
+  vtkm::cont::Invoker invoke{ device };
+  array.Allocate(ARRAY_SIZE);
+  invoke(WriteIndex{}, array);
+
+  auto portal = array.ReadPortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    VTKM_TEST_ASSERT(portal.Get(index) == 3 * index, "Bad value at ", index);
+  }
+}
+
+// A block recycled by the host memory pool keeps the pages of its first owner, so first touched
+// buffers must not come from the cache.
+void TestBypassPool()
+{
+  std::cout << "Test first touched buffers bypass the host memory pool cache" << std::endl;
+  vtkm::cont::DeviceAdapterTagOpenMP device;
+  auto& config = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+  config.SetNumaRegions(1);
+
+  vtkm::cont::internal::DeviceAdapterMemoryManager<vtkm::cont::DeviceAdapterTagOpenMP> manager;
+  vtkm::cont::internal::HostMemoryPool& pool = vtkm::cont::internal::GetHostMemoryPool();
+  constexpr vtkm::BufferSizeType numBytes = ARRAY_SIZE * sizeof(vtkm::Id);
+
+  // Leave a block of the same size in the cache.
+  pool.Free(pool.Allocate(numBytes));
+  const vtkm::cont::internal::HostMemoryPoolStatistics before = pool.GetStatistics();
+
+  {
+    vtkm::cont::internal::BufferInfo buffer = manager.Allocate(numBytes);
+    VTKM_TEST_ASSERT(buffer.GetSize() == numBytes);
+    std::memset(buffer.GetPointer(), 0xAB, static_cast<std::size_t>(numBytes));
+    VTKM_TEST_ASSERT(pool.GetStatistics().NumCacheHits == before.NumCacheHits,
+                     "First touched buffer came from the cache.");
+
+    // Growing the buffer also gets new pages, and keeps the contents.
+    manager.Reallocate(buffer, 2 * numBytes);
+    VTKM_TEST_ASSERT(buffer.GetSize() == 2 * numBytes);
+    VTKM_TEST_ASSERT(reinterpret_cast<unsigned char*>(buffer.GetPointer())[numBytes - 1] == 0xAB,
+                     "Reallocation lost the contents.");
+    VTKM_TEST_ASSERT(pool.GetStatistics().NumCacheHits == before.NumCacheHits,
+                     "Reallocated buffer came from the cache.");
+  }
+
+  // Released buffers are not added to the cache either.
+  VTKM_TEST_ASSERT(pool.GetStatistics().CachedBytes == before.CachedBytes,
+                   "First touched buffer was cached.");
+
+  config.SetNumaRegions(0);
+}
+
+void TestNuma()
+{
+  TestStaticPartition();
+
+  TestNumaRegions(0);
+  TestNumaRegions(1);
+  TestNumaRegions(2);
+  TestBypassPool();
+
+  vtkm::cont::DeviceAdapterTagOpenMP device;
+  auto& config = vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+  VTKM_TEST_ASSERT(config.SetNumaRegions(-1) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS);
+  VTKM_TEST_ASSERT(config.SetNumaRegions(0) ==
+                   vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS);
+}
+
+} // anonymous namespace
+
+int UnitTestOpenMPNuma(int argc, char* argv[])
+{
+  auto& tracker = vtkm::cont::GetRuntimeDeviceTracker();
+  tracker.ForceDevice(vtkm::cont::DeviceAdapterTagOpenMP{});
+  return vtkm::cont::testing::Testing::Run(TestNuma, argc, argv);
+}
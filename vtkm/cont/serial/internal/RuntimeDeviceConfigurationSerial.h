@@ -28,6 +28,18 @@ class RuntimeDeviceConfiguration<vtkm::cont::DeviceAdapterTagSerial>
   {
     return vtkm::cont::DeviceAdapterTagSerial{};
   }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHugePageThreshold(
+    const vtkm::Id& value) const override final
+  {
+    return this->SetHostHugePageThreshold(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHugePageThreshold(
+    vtkm::Id& value) const override final
+  {
+    return this->GetHostHugePageThreshold(value);
+  }
 };
 }
 }
@@ -9,12 +9,148 @@
 //============================================================================
 
 #include <vtkm/cont/tbb/internal/DeviceAdapterAlgorithmTBB.h>
+#include <vtkm/cont/tbb/internal/GrainSizeTBB.h>
+
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+namespace
+{
+
+std::atomic<vtkm::Id> GrainSize{ vtkm::cont::tbb::TBB_GRAIN_SIZE };
+
+// The adaptive grain size aims for each TBB task to take about this long. This is large enough
+// to amortize the overhead of spawning and stealing tasks while leaving enough tasks to balance
+// the load.
+constexpr double TargetTaskSeconds = 50e-6;
+
+// When measuring the cost of a functor, keep running a larger sample until at least this
+// much time has passed or this many elements have been run.
+constexpr double MinCalibrationSeconds = 20e-6;
+constexpr vtkm::Id MaxCalibrationSize = 4096;
+
+class AdaptiveGrainSizeCache
+{
+public:
+  bool Find(const std::type_info& functorType, double& secondsPerElement)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto entry = this->SecondsPerElement.find(std::type_index(functorType));
+    if (entry == this->SecondsPerElement.end())
+    {
+      return false;
+    }
+    secondsPerElement = entry->second;
+    return true;
+  }
+
+  void Insert(const std::type_info& functorType, double secondsPerElement)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->SecondsPerElement[std::type_index(functorType)] = secondsPerElement;
+  }
+
+private:
+  std::mutex Mutex;
+  std::unordered_map<std::type_index, double> SecondsPerElement;
+};
+
+AdaptiveGrainSizeCache& GetAdaptiveGrainSizeCache()
+{
+  static AdaptiveGrainSizeCache cache;
+  return cache;
+}
+
+// Runs the first elements of the range on the calling thread to measure the cost of each
+// element. Returns the number of elements that were run.
+vtkm::Id CalibrateFunctor(vtkm::exec::tbb::internal::TaskTiling1D& functor,
+                          vtkm::Id size,
+                          double& secondsPerElement)
+{
+  using Clock = std::chrono::steady_clock;
+
+  vtkm::Id numRun = 0;
+  vtkm::Id sampleSize = 1;
+  double elapsed = 0.0;
+  while ((numRun < size) && (numRun < MaxCalibrationSize) && (elapsed < MinCalibrationSeconds))
+  {
+    const vtkm::Id end = std::min(size, numRun + sampleSize);
+    auto start = Clock::now();
+    functor(numRun, end);
+    elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+    numRun = end;
+    sampleSize *= 2;
+  }
+
+  secondsPerElement = (numRun > 0) ? elapsed / static_cast<double>(numRun) : 0.0;
+  return numRun;
+}
+
+vtkm::Id ComputeAdaptiveGrainSize(double secondsPerElement, vtkm::Id size)
+{
+  // Never make the grain so large that there are not a few tasks for each thread.
+  const vtkm::Id numThreads = std::max(1, ::tbb::this_task_arena::max_concurrency());
+  const vtkm::Id maxGrain = std::max(vtkm::Id(1), size / (4 * numThreads));
+  if (secondsPerElement <= 0.0)
+  {
+    return maxGrain;
+  }
+  const double grain = TargetTaskSeconds / secondsPerElement;
+  if (grain >= static_cast<double>(maxGrain))
+  {
+    return maxGrain;
+  }
+  return std::max(vtkm::Id(1), static_cast<vtkm::Id>(grain));
+}
+
+} // anonymous namespace
 
 namespace vtkm
 {
 namespace cont
 {
 
+namespace tbb
+{
+
+void SetGrainSize(vtkm::Id grainSize)
+{
+  VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+             "Setting TBB grain size to "
+               << ((grainSize == TBB_GRAIN_SIZE_ADAPTIVE) ? std::string("adaptive")
+                                                          : std::to_string(grainSize)));
+  GrainSize.store(grainSize);
+}
+
+vtkm::Id GetGrainSize()
+{
+  return GrainSize.load();
+}
+
+vtkm::Id GetFixedGrainSize()
+{
+  vtkm::Id grainSize = GrainSize.load();
+  return (grainSize > 0) ? grainSize : TBB_GRAIN_SIZE;
+}
+
+vtkm::Id GetAdaptiveGrainSize(const std::type_info& functorType, vtkm::Id size)
+{
+  double secondsPerElement;
+  if (!GetAdaptiveGrainSizeCache().Find(functorType, secondsPerElement))
+  {
+    return TBB_GRAIN_SIZE_ADAPTIVE;
+  }
+  return ComputeAdaptiveGrainSize(secondsPerElement, size);
+}
+
+} // namespace tbb
+
 void DeviceAdapterAlgorithm<vtkm::cont::DeviceAdapterTagTBB>::ScheduleTask(
   vtkm::exec::tbb::internal::TaskTiling1D& functor,
   vtkm::Id size)
@@ -27,10 +163,37 @@ void DeviceAdapterAlgorithm<vtkm::cont::DeviceAdapterTagTBB>::ScheduleTask(
   vtkm::exec::internal::ErrorMessageBuffer errorMessage(errorString, MESSAGE_SIZE);
   functor.SetErrorMessageBuffer(errorMessage);
 
-  ::tbb::blocked_range<vtkm::Id> range(0, size, tbb::TBB_GRAIN_SIZE);
+  vtkm::Id begin = 0;
+  vtkm::Id grainSize = tbb::GetGrainSize();
+  const std::type_info& functorType = functor.GetWorkletType();
+  // Without a functor type there is nothing to remember the measured cost against, so fall
+  // back to the default grain size.
+  if ((grainSize == tbb::TBB_GRAIN_SIZE_ADAPTIVE) && (functorType == typeid(void)))
+  {
+    grainSize = tbb::TBB_GRAIN_SIZE;
+  }
+  else if (grainSize == tbb::TBB_GRAIN_SIZE_ADAPTIVE)
+  {
+    AdaptiveGrainSizeCache& cache = GetAdaptiveGrainSizeCache();
+    double secondsPerElement;
+    if (!cache.Find(functorType, secondsPerElement))
+    {
+      begin = CalibrateFunctor(functor, size, secondsPerElement);
+      cache.Insert(functorType, secondsPerElement);
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+                 "Measured " << secondsPerElement * 1e9 << " ns per element for "
+                             << vtkm::cont::TypeToString(functorType));
+    }
+    grainSize = ComputeAdaptiveGrainSize(secondsPerElement, size);
+  }
 
-  ::tbb::parallel_for(
-    range, [&](const ::tbb::blocked_range<vtkm::Id>& r) { functor(r.begin(), r.end()); });
+  if (begin < size)
+  {
+    ::tbb::blocked_range<vtkm::Id> range(begin, size, grainSize);
+
+    ::tbb::parallel_for(
+      range, [&](const ::tbb::blocked_range<vtkm::Id>& r) { functor(r.begin(), r.end()); });
+  }
 
   if (errorMessage.IsErrorRaised())
   {
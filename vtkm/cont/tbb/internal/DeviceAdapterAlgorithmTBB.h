@@ -20,6 +20,7 @@
 #include <vtkm/cont/internal/IteratorFromArrayPortal.h>
 #include <vtkm/cont/tbb/internal/DeviceAdapterTagTBB.h>
 #include <vtkm/cont/tbb/internal/FunctorsTBB.h>
+#include <vtkm/cont/tbb/internal/GrainSizeTBB.h>
 #include <vtkm/cont/tbb/internal/ParallelSortTBB.h>
 
 #include <vtkm/exec/tbb/internal/TaskTiling.h>
@@ -254,6 +255,8 @@ public:
       initialValue);
   }
 
+  // When the grain size is adaptive, the worklet type of the task is used to look up the
+  // grain size measured for previous invocations of the same worklet.
   VTKM_CONT_EXPORT static void ScheduleTask(vtkm::exec::tbb::internal::TaskTiling1D& functor,
                                             vtkm::Id size);
   VTKM_CONT_EXPORT static void ScheduleTask(vtkm::exec::tbb::internal::TaskTiling3D& functor,
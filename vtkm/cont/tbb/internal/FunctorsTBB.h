@@ -15,6 +15,7 @@
 #include <vtkm/cont/ArrayPortalToIterators.h>
 #include <vtkm/cont/Error.h>
 #include <vtkm/cont/internal/FunctorsGeneral.h>
+#include <vtkm/cont/tbb/internal/GrainSizeTBB.h>
 #include <vtkm/exec/internal/ErrorMessageBuffer.h>
 
 #include <algorithm>
@@ -68,10 +69,6 @@ template <typename ResultType, typename Function>
 using WrappedBinaryOperator = vtkm::cont::internal::WrappedBinaryOperator<ResultType, Function>;
 }
 
-// The "grain size" of scheduling with TBB.  Not a lot of thought has gone
-// into picking this size.
-static constexpr vtkm::Id TBB_GRAIN_SIZE = 1024;
-
 template <typename InputPortalType, typename OutputPortalType>
 struct CopyBody
 {
@@ -151,7 +148,7 @@ void CopyPortals(const InputPortalType& inPortal,
 {
   using Kernel = CopyBody<InputPortalType, OutputPortalType>;
   Kernel kernel(inPortal, outPortal, inOffset, outOffset);
-  ::tbb::blocked_range<vtkm::Id> range(0, numValues, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, numValues, GetFixedGrainSize());
   ::tbb::parallel_for(range, kernel);
 }
 
@@ -359,7 +356,7 @@ VTKM_CONT vtkm::Id CopyIfPortals(InputPortalType inputPortal,
 
   CopyIfBody<InputPortalType, StencilPortalType, OutputPortalType, UnaryPredicateType> body(
     inputPortal, stencilPortal, outputPortal, unaryPredicate);
-  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, GetFixedGrainSize());
 
   ::tbb::parallel_reduce(range, body);
 
@@ -467,7 +464,7 @@ VTKM_CONT static auto ReducePortals(InputPortalType inputPortal,
 
   if (arrayLength > 1)
   {
-    ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, TBB_GRAIN_SIZE);
+    ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, GetFixedGrainSize());
     ::tbb::parallel_reduce(range, body);
     return body.Sum;
   }
@@ -808,7 +805,7 @@ VTKM_CONT vtkm::Id ReduceByKeyPortals(KeysInPortalType keysInPortal,
                   ValuesOutPortalType,
                   WrappedBinaryOp>
     body(keysInPortal, valuesInPortal, keysOutPortal, valuesOutPortal, wrappedBinaryOp);
-  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, GetFixedGrainSize());
 
 #ifdef VTKM_DEBUG_TBB_RBK
   std::cerr << "\n\nTBB ReduceByKey:\n";
@@ -1044,7 +1041,7 @@ ScanInclusivePortals(InputPortalType inputPortal,
     inputPortal, outputPortal, wrappedBinaryOp);
   vtkm::Id arrayLength = inputPortal.GetNumberOfValues();
 
-  ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, GetFixedGrainSize());
   ::tbb::parallel_scan(range, body);
   return body.Sum;
 }
@@ -1067,7 +1064,7 @@ ScanExclusivePortals(
     inputPortal, outputPortal, wrappedBinaryOp, initialValue);
   vtkm::Id arrayLength = inputPortal.GetNumberOfValues();
 
-  ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, arrayLength, GetFixedGrainSize());
   ::tbb::parallel_scan(range, body);
 
   // Seems a little weird to me that we would return the last value in the
@@ -1135,7 +1132,7 @@ VTKM_CONT static void ScatterPortal(InputPortalType inputPortal,
   ScatterKernel<InputPortalType, IndexPortalType, OutputPortalType> scatter(
     inputPortal, indexPortal, outputPortal);
 
-  ::tbb::blocked_range<vtkm::Id> range(0, size, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, size, GetFixedGrainSize());
   ::tbb::parallel_for(range, scatter);
 }
 
@@ -1373,7 +1370,7 @@ VTKM_CONT vtkm::Id UniquePortals(PortalType portal, BinaryOperationType binaryOp
   WrappedBinaryOp wrappedBinaryOp(binaryOperation);
 
   UniqueBody<PortalType, WrappedBinaryOp> body(portal, wrappedBinaryOp);
-  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, TBB_GRAIN_SIZE);
+  ::tbb::blocked_range<vtkm::Id> range(0, inputLength, GetFixedGrainSize());
 
   ::tbb::parallel_reduce(range, body);
 
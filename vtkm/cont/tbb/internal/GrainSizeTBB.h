@@ -0,0 +1,56 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_tbb_internal_GrainSizeTBB_h
+#define vtk_m_cont_tbb_internal_GrainSizeTBB_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <typeinfo>
+
+namespace vtkm
+{
+namespace cont
+{
+namespace tbb
+{
+
+// The default "grain size" of scheduling with TBB.  Not a lot of thought has gone
+// into picking this size.
+static constexpr vtkm::Id TBB_GRAIN_SIZE = 1024;
+
+// Setting the grain size to this value selects the adaptive grain size. In adaptive mode,
+// the first time a worklet type is scheduled its cost per element is measured, and the grain
+// size of that and all later invocations of that worklet type is chosen so that each TBB task
+// does a reasonable amount of work.
+static constexpr vtkm::Id TBB_GRAIN_SIZE_ADAPTIVE = 0;
+
+/// Sets the grain size used to partition the ranges of TBB algorithms and scheduled
+/// worklets. Use `TBB_GRAIN_SIZE_ADAPTIVE` to select the adaptive grain size.
+VTKM_CONT_EXPORT void SetGrainSize(vtkm::Id grainSize);
+
+/// Returns the grain size set with `SetGrainSize`, which may be `TBB_GRAIN_SIZE_ADAPTIVE`.
+VTKM_CONT_EXPORT vtkm::Id GetGrainSize();
+
+/// Returns the grain size to use for algorithms that do not support the adaptive grain size
+/// (such as copy, reduce, and scan). This is the grain size set with `SetGrainSize` or
+/// `TBB_GRAIN_SIZE` if the grain size is adaptive.
+VTKM_CONT_EXPORT vtkm::Id GetFixedGrainSize();
+
+/// Returns the grain size the adaptive mode uses to schedule `size` elements of the worklet or
+/// functor `functorType`, or `TBB_GRAIN_SIZE_ADAPTIVE` if its cost has not been measured yet.
+VTKM_CONT_EXPORT vtkm::Id GetAdaptiveGrainSize(const std::type_info& functorType, vtkm::Id size);
+
+}
+}
+} // namespace vtkm::cont::tbb
+
+#endif //vtk_m_cont_tbb_internal_GrainSizeTBB_h
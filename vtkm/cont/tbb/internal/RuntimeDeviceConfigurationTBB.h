@@ -12,6 +12,7 @@
 
 #include <vtkm/cont/internal/RuntimeDeviceConfiguration.h>
 #include <vtkm/cont/tbb/internal/DeviceAdapterTagTBB.h>
+#include <vtkm/cont/tbb/internal/GrainSizeTBB.h>
 
 namespace vtkm
 {
@@ -40,6 +41,35 @@ class RuntimeDeviceConfiguration<vtkm::cont::DeviceAdapterTagTBB>
     // TODO: Get number of TBB threads here (essentially just threads supported by architecture)
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetGrainSize(
+    const vtkm::Id& value) const override final
+  {
+    if (value < 0)
+    {
+      return RuntimeDeviceConfigReturnCode::OUT_OF_BOUNDS;
+    }
+    vtkm::cont::tbb::SetGrainSize(value);
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetGrainSize(vtkm::Id& value) const override final
+  {
+    value = vtkm::cont::tbb::GetGrainSize();
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetHugePageThreshold(
+    const vtkm::Id& value) const override final
+  {
+    return this->SetHostHugePageThreshold(value);
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetHugePageThreshold(
+    vtkm::Id& value) const override final
+  {
+    return this->GetHostHugePageThreshold(value);
+  }
 };
 } // namespace vktm::cont::internal
 } // namespace vtkm::cont
@@ -0,0 +1,100 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/tbb/DeviceAdapterTBB.h>
+#include <vtkm/cont/tbb/internal/GrainSizeTBB.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <typeinfo>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 1 << 20;
+
+struct Square : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_EXEC void operator()(vtkm::Id in, vtkm::Id& out) const { out = in * in; }
+};
+
+struct Triple : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_EXEC void operator()(vtkm::Id in, vtkm::Id& out) const { out = 3 * in; }
+};
+
+template <typename ExpectedFunctor>
+void CheckOutput(const vtkm::cont::ArrayHandle<vtkm::Id>& output, ExpectedFunctor expected)
+{
+  auto portal = output.ReadPortal();
+  VTKM_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE, "Wrong output size.");
+  for (vtkm::Id i = 0; i < ARRAY_SIZE; ++i)
+  {
+    VTKM_TEST_ASSERT(portal.Get(i) == expected(i), "Wrong value at ", i);
+  }
+}
+
+void TestAdaptiveGrainSize()
+{
+  const vtkm::Id oldGrainSize = vtkm::cont::tbb::GetGrainSize();
+  vtkm::cont::Invoker invoke{ vtkm::cont::DeviceAdapterTagTBB{} };
+  vtkm::cont::ArrayHandleIndex input(ARRAY_SIZE);
+  vtkm::cont::ArrayHandle<vtkm::Id> output;
+
+  std::cout << "Dispatch with a fixed grain size" << std::endl;
+  vtkm::cont::tbb::SetGrainSize(256);
+  invoke(Triple{}, input, output);
+  CheckOutput(output, [](vtkm::Id i) { return 3 * i; });
+  VTKM_TEST_ASSERT(vtkm::cont::tbb::GetAdaptiveGrainSize(typeid(Triple), ARRAY_SIZE) ==
+                     vtkm::cont::tbb::TBB_GRAIN_SIZE_ADAPTIVE,
+                   "A fixed grain size measured the worklet.");
+
+  std::cout << "Dispatch with the adaptive grain size" << std::endl;
+  vtkm::cont::tbb::SetGrainSize(vtkm::cont::tbb::TBB_GRAIN_SIZE_ADAPTIVE);
+  VTKM_TEST_ASSERT(vtkm::cont::tbb::GetAdaptiveGrainSize(typeid(Square), ARRAY_SIZE) ==
+                     vtkm::cont::tbb::TBB_GRAIN_SIZE_ADAPTIVE,
+                   "Worklet measured before it was dispatched.");
+  invoke(Square{}, input, output);
+  // The first elements are run while measuring the worklet, so check all of them.
+  CheckOutput(output, [](vtkm::Id i) { return i * i; });
+  const vtkm::Id grainSize = vtkm::cont::tbb::GetAdaptiveGrainSize(typeid(Square), ARRAY_SIZE);
+  std::cout << "  adaptive grain size: " << grainSize << std::endl;
+  VTKM_TEST_ASSERT(grainSize > 0, "Dispatched worklet did not get an adaptive grain size.");
+
+  std::cout << "Dispatch again with the measured grain size" << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Id> output2;
+  invoke(Square{}, input, output2);
+  CheckOutput(output2, [](vtkm::Id i) { return i * i; });
+  VTKM_TEST_ASSERT(vtkm::cont::tbb::GetAdaptiveGrainSize(typeid(Square), ARRAY_SIZE) ==
+                     grainSize,
+                   "Measured grain size changed between invocations.");
+
+  vtkm::cont::tbb::SetGrainSize(oldGrainSize);
+}
+
+} // anonymous namespace
+
+int UnitTestTBBGrainSize(int argc, char* argv[])
+{
+  auto& tracker = vtkm::cont::GetRuntimeDeviceTracker();
+  tracker.ForceDevice(vtkm::cont::DeviceAdapterTagTBB{});
+  return vtkm::cont::testing::Testing::Run(TestAdaptiveGrainSize, argc, argv);
+}
@@ -11,6 +11,7 @@
 #define vtk_m_cont_testing_TestingCellLocatorTwoLevel_h
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -181,6 +182,50 @@ public:
   }
 };
 
+// Finds the cells of a run of points in order, passing the last cell found from one query to
+// the next. Each point is queried twice so that the second query is answered by the hint.
+class FindCellWithHintWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn start,
+                                WholeArrayIn points,
+                                ExecObject locator,
+                                WholeArrayOut cellIds,
+                                WholeArrayOut pcoords);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  static constexpr vtkm::Id RunLength = 16;
+
+  template <typename PointsPortal,
+            typename LocatorType,
+            typename CellIdsPortal,
+            typename PCoordsPortal>
+  VTKM_EXEC void operator()(vtkm::Id start,
+                            const PointsPortal& points,
+                            const LocatorType& locator,
+                            const CellIdsPortal& cellIds,
+                            const PCoordsPortal& pcoords) const
+  {
+    typename LocatorType::LastCell lastCell;
+    const vtkm::Id end = vtkm::Min(start + RunLength, points.GetNumberOfValues());
+    for (vtkm::Id i = start; i < end; ++i)
+    {
+      for (int query = 0; query < 2; ++query)
+      {
+        vtkm::Id cellId;
+        vtkm::Vec3f pc;
+        vtkm::ErrorCode status = locator.FindCell(points.Get(i), cellId, pc, lastCell);
+        if (status != vtkm::ErrorCode::Success)
+        {
+          this->RaiseError(vtkm::ErrorString(status));
+        }
+        cellIds.Set(i, cellId);
+        pcoords.Set(i, pc);
+      }
+    }
+  }
+};
+
 template <vtkm::IdComponent DIMENSIONS>
 void TestCellLocator(const vtkm::Vec<vtkm::Id, DIMENSIONS>& dim, vtkm::Id numberOfPoints)
 {
@@ -217,6 +262,28 @@ void TestCellLocator(const vtkm::Vec<vtkm::Id, DIMENSIONS>& dim, vtkm::Id number
     VTKM_TEST_ASSERT(test_equal(pcoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
                      "Incorrect parameteric coordinates");
   }
+
+  std::cout << "Finding cells with the last cell as a hint\n";
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> starts(
+    0,
+    FindCellWithHintWorklet::RunLength,
+    (numberOfPoints + FindCellWithHintWorklet::RunLength - 1) / FindCellWithHintWorklet::RunLength);
+  vtkm::cont::ArrayHandle<vtkm::Id> hintCellIds;
+  vtkm::cont::ArrayHandle<PointType> hintPCoords;
+  hintCellIds.Allocate(numberOfPoints);
+  hintPCoords.Allocate(numberOfPoints);
+  vtkm::worklet::DispatcherMapField<FindCellWithHintWorklet> hintDispatcher;
+  hintDispatcher.Invoke(starts, points, locator, hintCellIds, hintPCoords);
+
+  auto hintCellIdsPortal = hintCellIds.ReadPortal();
+  auto hintPCoordsPortal = hintPCoords.ReadPortal();
+  for (vtkm::Id i = 0; i < numberOfPoints; ++i)
+  {
+    VTKM_TEST_ASSERT(hintCellIdsPortal.Get(i) == expCellIdsPortal.Get(i),
+                     "Incorrect cell ids with hint");
+    VTKM_TEST_ASSERT(test_equal(hintPCoordsPortal.Get(i), expPCoordsPortal.Get(i), 1e-3),
+                     "Incorrect parameteric coordinates with hint");
+  }
 }
 
 } // anonymous
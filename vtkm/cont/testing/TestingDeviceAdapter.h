@@ -43,6 +43,7 @@
 #include <chrono>
 #include <cmath>
 #include <ctime>
+#include <functional>
 #include <random>
 #include <thread>
 #include <utility>
@@ -1211,6 +1212,160 @@ private:
     }
   }
 
+  static VTKM_CONT void TestCountingSort()
+  {
+    std::cout << "-------------------------------------------------" << std::endl;
+    std::cout << "Counting sort" << std::endl;
+
+    // Large enough to be split into several blocks. The key ranges close to the number of values
+    // are counted with atomics, and key 0 is shared by many values to check that they stay in
+    // order.
+    constexpr vtkm::Id numValues = 10000;
+    for (vtkm::Id keyRange : { vtkm::Id(1),
+                               vtkm::Id(37),
+                               vtkm::Id(numValues / 6),
+                               vtkm::Id(numValues),
+                               vtkm::Id(3 * numValues) })
+    {
+      std::cout << "  Key range " << keyRange << std::endl;
+      std::vector<vtkm::Id> testKeys(static_cast<std::size_t>(numValues));
+      for (vtkm::Id i = 0; i < numValues; ++i)
+      {
+        testKeys[static_cast<std::size_t>(i)] = ((i % 5) == 0) ? 0 : (i * 7919) % keyRange;
+      }
+
+      IdArrayHandle keys = vtkm::cont::make_ArrayHandle(testKeys, vtkm::CopyFlag::On);
+      IdArrayHandle values;
+      Algorithm::Copy(vtkm::cont::ArrayHandleIndex(numValues), values);
+      IdArrayHandle offsets;
+      Algorithm::CountingSortByKey(keys, values, keyRange, offsets);
+
+      VTKM_TEST_ASSERT(offsets.GetNumberOfValues() == keyRange + 1, "Bad number of offsets.");
+      auto keysPortal = keys.ReadPortal();
+      auto valuesPortal = values.ReadPortal();
+      auto offsetsPortal = offsets.ReadPortal();
+      VTKM_TEST_ASSERT(offsetsPortal.Get(keyRange) == numValues, "Bad last offset.");
+      for (vtkm::Id i = 0; i < numValues; ++i)
+      {
+        const vtkm::Id key = keysPortal.Get(i);
+        const vtkm::Id value = valuesPortal.Get(i);
+        VTKM_TEST_ASSERT(testKeys[static_cast<std::size_t>(value)] == key,
+                         "Value did not move with its key.");
+        VTKM_TEST_ASSERT((offsetsPortal.Get(key) <= i) && (i < offsetsPortal.Get(key + 1)),
+                         "Bad offset for key.");
+        if (i > 0)
+        {
+          const vtkm::Id prevKey = keysPortal.Get(i - 1);
+          VTKM_TEST_ASSERT((prevKey < key) ||
+                             ((prevKey == key) && (valuesPortal.Get(i - 1) < value)),
+                           "Counting sort is not sorted or not stable.");
+        }
+      }
+
+      IdArrayHandle keysOnly = vtkm::cont::make_ArrayHandle(testKeys, vtkm::CopyFlag::On);
+      Algorithm::CountingSort(keysOnly, keyRange);
+      VTKM_TEST_ASSERT(test_equal_portals(keysOnly.ReadPortal(), keys.ReadPortal()),
+                       "CountingSort does not match CountingSortByKey.");
+    }
+
+    std::cout << "  Key out of range" << std::endl;
+    bool threw = false;
+    try
+    {
+      IdArrayHandle keys = vtkm::cont::make_ArrayHandle<vtkm::Id>({ 0, 1, 5, 2 });
+      Algorithm::CountingSort(keys, 5);
+    }
+    catch (vtkm::cont::ErrorExecution&)
+    {
+      threw = true;
+    }
+    VTKM_TEST_ASSERT(threw, "Key out of range not reported.");
+  }
+
+  static VTKM_CONT void TestSegmented()
+  {
+    std::cout << "-------------------------------------------------" << std::endl;
+    std::cout << "Segmented scan, reduce and sort" << std::endl;
+
+    // Segments of varying size, including empty ones.
+    constexpr vtkm::Id numSegments = 500;
+    std::vector<vtkm::Id> testOffsets(static_cast<std::size_t>(numSegments + 1));
+    testOffsets[0] = 0;
+    for (vtkm::Id s = 0; s < numSegments; ++s)
+    {
+      testOffsets[static_cast<std::size_t>(s + 1)] =
+        testOffsets[static_cast<std::size_t>(s)] + ((s * 13) % 23);
+    }
+    TestSegmented(testOffsets);
+
+    std::cout << "Segmented with a long segment" << std::endl;
+    // A segment too long to be handled serially.
+    for (vtkm::Id s = 100; s < numSegments; ++s)
+    {
+      testOffsets[static_cast<std::size_t>(s + 1)] += 5000;
+    }
+    TestSegmented(testOffsets);
+  }
+
+  static VTKM_CONT void TestSegmented(const std::vector<vtkm::Id>& testOffsets)
+  {
+    const vtkm::Id numSegments = static_cast<vtkm::Id>(testOffsets.size()) - 1;
+    const vtkm::Id numValues = testOffsets.back();
+    std::vector<vtkm::Id> testValues(static_cast<std::size_t>(numValues));
+    for (vtkm::Id i = 0; i < numValues; ++i)
+    {
+      testValues[static_cast<std::size_t>(i)] = (i * 7919) % 1000;
+    }
+    IdArrayHandle offsets = vtkm::cont::make_ArrayHandle(testOffsets, vtkm::CopyFlag::On);
+    IdArrayHandle values = vtkm::cont::make_ArrayHandle(testValues, vtkm::CopyFlag::On);
+
+    IdArrayHandle scan;
+    Algorithm::ScanExclusiveSegmented(values, offsets, scan);
+    IdArrayHandle sums;
+    Algorithm::ReduceSegmented(values, offsets, sums, vtkm::Id(0));
+    IdArrayHandle maxima;
+    Algorithm::ReduceSegmented(values, offsets, maxima, vtkm::Id(-1), vtkm::Maximum());
+    IdArrayHandle inPlace = vtkm::cont::make_ArrayHandle(testValues, vtkm::CopyFlag::On);
+    Algorithm::ScanExclusiveSegmented(inPlace, offsets, inPlace, vtkm::Sum(), vtkm::Id(5));
+    IdArrayHandle sorted = vtkm::cont::make_ArrayHandle(testValues, vtkm::CopyFlag::On);
+    Algorithm::SortSegmented(sorted, offsets, vtkm::SortGreater());
+
+    VTKM_TEST_ASSERT(scan.GetNumberOfValues() == numValues, "Bad segmented scan size.");
+    VTKM_TEST_ASSERT(sums.GetNumberOfValues() == numSegments, "Bad segmented reduce size.");
+    auto scanPortal = scan.ReadPortal();
+    auto sumsPortal = sums.ReadPortal();
+    auto maximaPortal = maxima.ReadPortal();
+    auto inPlacePortal = inPlace.ReadPortal();
+    auto sortedPortal = sorted.ReadPortal();
+    for (vtkm::Id s = 0; s < numSegments; ++s)
+    {
+      const std::size_t begin = static_cast<std::size_t>(testOffsets[static_cast<std::size_t>(s)]);
+      const std::size_t end =
+        static_cast<std::size_t>(testOffsets[static_cast<std::size_t>(s + 1)]);
+      vtkm::Id sum = 0;
+      vtkm::Id maximum = -1;
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        const vtkm::Id index = static_cast<vtkm::Id>(i);
+        VTKM_TEST_ASSERT(scanPortal.Get(index) == sum, "Bad segmented scan value.");
+        VTKM_TEST_ASSERT(inPlacePortal.Get(index) == sum + 5, "Bad in place segmented scan.");
+        sum += testValues[i];
+        maximum = vtkm::Max(maximum, testValues[i]);
+      }
+      VTKM_TEST_ASSERT(sumsPortal.Get(s) == sum, "Bad segmented sum.");
+      VTKM_TEST_ASSERT(maximaPortal.Get(s) == maximum, "Bad segmented maximum.");
+
+      std::vector<vtkm::Id> expected(testValues.begin() + static_cast<std::ptrdiff_t>(begin),
+                                     testValues.begin() + static_cast<std::ptrdiff_t>(end));
+      std::sort(expected.begin(), expected.end(), std::greater<vtkm::Id>());
+      for (std::size_t i = begin; i < end; ++i)
+      {
+        VTKM_TEST_ASSERT(sortedPortal.Get(static_cast<vtkm::Id>(i)) == expected[i - begin],
+                         "Bad segmented sort.");
+      }
+    }
+  }
+
   static VTKM_CONT void TestLowerBoundsWithComparisonObject()
   {
     std::cout << "-------------------------------------------------" << std::endl;
@@ -3065,6 +3220,8 @@ private:
       TestSortWithComparisonObject();
       TestSortWithFancyArrays();
       TestSortByKey();
+      TestCountingSort();
+      TestSegmented();
 
       TestLowerBoundsWithComparisonObject();
 
@@ -0,0 +1,201 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandleMemoryMapped.h>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
+#include <vtkm/cont/serial/DeviceAdapterSerial.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id DIM = 64;
+constexpr vtkm::Id ARRAY_SIZE = DIM * DIM;
+const std::string FILE_NAME = "UnitTestArrayHandleMemoryMapped.raw";
+
+using ValueType = vtkm::Float32;
+
+void WriteFile()
+{
+  std::vector<ValueType> values(static_cast<std::size_t>(ARRAY_SIZE));
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    values[static_cast<std::size_t>(index)] = TestValue(index, ValueType{});
+  }
+  std::ofstream file(FILE_NAME, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(values.data()),
+             static_cast<std::streamsize>(values.size() * sizeof(ValueType)));
+  VTKM_TEST_ASSERT(file.good(), "Could not write test file.");
+}
+
+template <typename PortalType>
+void CheckPortal(const PortalType& portal, vtkm::Id startIndex)
+{
+  for (vtkm::Id index = 0; index < portal.GetNumberOfValues(); ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(portal.Get(index), TestValue(index + startIndex, ValueType{})),
+                     "Bad value at ",
+                     index);
+  }
+}
+
+void TestReadOnly()
+{
+  std::cout << "Test read-only mapping" << std::endl;
+  auto array = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(FILE_NAME);
+  VTKM_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE);
+  CheckPortal(array.ReadPortal(), 0);
+
+  // Run an algorithm on the device with the mapped array as input.
+  vtkm::cont::ArrayHandle<ValueType> copy;
+  vtkm::cont::Algorithm::Copy(array, copy);
+  CheckPortal(copy.ReadPortal(), 0);
+  array.ReleaseResourcesExecution();
+  CheckPortal(array.ReadPortal(), 0);
+
+  // Writing to the read-only pages would crash, so asking for write access is an error.
+  bool threw = false;
+  try
+  {
+    array.WritePortal();
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Writing to a read-only mapping did not fail.");
+
+  threw = false;
+  try
+  {
+    vtkm::cont::Token token;
+    array.PrepareForInPlace(vtkm::cont::DeviceAdapterTagSerial{}, token);
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Preparing a read-only mapping for writing did not fail.");
+  CheckPortal(array.ReadPortal(), 0);
+}
+
+void TestOffset()
+{
+  std::cout << "Test mapping part of a file" << std::endl;
+  // An offset that is not a multiple of the page size.
+  constexpr vtkm::Id startIndex = 100;
+  constexpr vtkm::Id numValues = 1000;
+  auto array = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(
+    FILE_NAME, numValues, startIndex * static_cast<vtkm::BufferSizeType>(sizeof(ValueType)));
+  VTKM_TEST_ASSERT(array.GetNumberOfValues() == numValues);
+  CheckPortal(array.ReadPortal(), startIndex);
+
+  auto rest = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(
+    FILE_NAME, -1, startIndex * static_cast<vtkm::BufferSizeType>(sizeof(ValueType)));
+  VTKM_TEST_ASSERT(rest.GetNumberOfValues() == ARRAY_SIZE - startIndex);
+  CheckPortal(rest.ReadPortal(), startIndex);
+}
+
+void TestCopyOnWrite()
+{
+  std::cout << "Test copy-on-write mapping" << std::endl;
+  auto array = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(
+    FILE_NAME, -1, 0, vtkm::cont::MemoryMapMode::CopyOnWrite);
+  array.WritePortal().Set(0, ValueType(-1));
+  VTKM_TEST_ASSERT(array.ReadPortal().Get(0) == ValueType(-1));
+
+  // The file is unchanged.
+  auto original = vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(FILE_NAME);
+  CheckPortal(original.ReadPortal(), 0);
+
+  // The mapping cannot grow. The error comes when the resized array is next accessed.
+  bool threw = false;
+  try
+  {
+    array.Allocate(ARRAY_SIZE * 2, vtkm::CopyFlag::On);
+    array.WritePortal();
+  }
+  catch (vtkm::cont::ErrorBadAllocation& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Resizing a memory mapped array did not fail.");
+}
+
+void TestDataSet()
+{
+  std::cout << "Test mapped array in a data set" << std::endl;
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id2(DIM, DIM));
+  dataSet.AddPointField("mapped", vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(FILE_NAME));
+
+  vtkm::cont::UnknownArrayHandle unknown = dataSet.GetPointField("mapped").GetData();
+  VTKM_TEST_ASSERT(unknown.IsType<vtkm::cont::ArrayHandle<ValueType>>());
+  VTKM_TEST_ASSERT(unknown.GetNumberOfValues() == ARRAY_SIZE);
+  CheckPortal(unknown.AsArrayHandle<vtkm::cont::ArrayHandle<ValueType>>().ReadPortal(), 0);
+}
+
+void TestErrors()
+{
+  std::cout << "Test errors" << std::endl;
+  bool threw = false;
+  try
+  {
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>("no_such_file.raw");
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Missing file not reported.");
+
+  threw = false;
+  try
+  {
+    vtkm::cont::make_ArrayHandleMemoryMapped<ValueType>(FILE_NAME, ARRAY_SIZE + 1);
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Reading past the end of the file not reported.");
+}
+
+void DoTest()
+{
+  WriteFile();
+  TestReadOnly();
+  TestOffset();
+  TestCopyOnWrite();
+  TestDataSet();
+  TestErrors();
+  std::remove(FILE_NAME.c_str());
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleMemoryMapped(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
@@ -0,0 +1,217 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/CellLocatorCache.h>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/CellLocatorChooser.h>
+#include <vtkm/cont/CellLocatorGeneral.h>
+#include <vtkm/cont/CellLocatorTwoLevel.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace
+{
+
+using PointType = vtkm::Vec3f;
+
+constexpr vtkm::Id DIM = 8;
+
+// A curvilinear grid, which uses a `CellLocatorTwoLevel`.
+vtkm::cont::DataSet MakeTestDataSet()
+{
+  auto uniform = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(DIM));
+  vtkm::cont::ArrayHandle<PointType> coords;
+  vtkm::cont::ArrayCopy(uniform.GetCoordinateSystem().GetDataAsMultiplexer(), coords);
+
+  vtkm::cont::DataSet dataSet;
+  dataSet.SetCellSet(uniform.GetCellSet());
+  dataSet.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coords", coords));
+  return dataSet;
+}
+
+class FindCellWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn points, ExecObject locator, FieldOut cellIds);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename LocatorType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& point,
+                            const LocatorType& locator,
+                            vtkm::Id& cellId) const
+  {
+    vtkm::Vec3f pcoords;
+    locator.FindCell(point, cellId, pcoords);
+  }
+};
+
+template <typename LocatorType>
+vtkm::Id FindCell(const LocatorType& locator, const PointType& point)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+  vtkm::cont::Invoker invoke;
+  invoke(FindCellWorklet{}, vtkm::cont::make_ArrayHandle({ point }), locator, cellIds);
+  return cellIds.ReadPortal().Get(0);
+}
+
+void TestReuse()
+{
+  std::cout << "Test reusing locators" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  vtkm::cont::DataSet dataSet = MakeTestDataSet();
+
+  auto locator = cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 1);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1);
+  VTKM_TEST_ASSERT(FindCell(locator, PointType(0.5f)) == 0);
+
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(),
+                                                    dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1);
+
+  // A copy of the data set shares its arrays, so it has the same mesh.
+  vtkm::cont::DataSet copy = dataSet;
+  copy.AddPointField("field", vtkm::cont::make_ArrayHandleConstant(1.0f, DIM * DIM * DIM));
+  vtkm::cont::CoordinateSystem coords("other", copy.GetCoordinateSystem().GetData());
+  auto cached = cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(copy.GetCellSet(), coords);
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 2);
+  VTKM_TEST_ASSERT(FindCell(cached, PointType(0.5f)) == 0);
+
+  // Each type of locator is cached on its own.
+  cache.GetLocator<vtkm::cont::CellLocatorGeneral>(dataSet.GetCellSet(),
+                                                   dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 2);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 2);
+
+  // Equal values in different arrays are a different mesh.
+  vtkm::cont::DataSet other = MakeTestDataSet();
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(other.GetCellSet(),
+                                                    other.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 3);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 3);
+}
+
+void TestModified()
+{
+  std::cout << "Test modifying the mesh" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  vtkm::cont::DataSet dataSet = MakeTestDataSet();
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(),
+                                                    dataSet.GetCoordinateSystem());
+
+  // Move the points. The cached locator must not be used anymore.
+  vtkm::cont::ArrayHandle<PointType> coords;
+  dataSet.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  {
+    auto portal = coords.WritePortal();
+    for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+    {
+      portal.Set(i, portal.Get(i) + PointType(100));
+    }
+  }
+
+  auto locator = cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(
+    dataSet.GetCellSet(), dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 2);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1, "Out of date locator not removed.");
+  VTKM_TEST_ASSERT(FindCell(locator, PointType(100.5f)) == 0);
+
+  // Reading the points does not invalidate the locator.
+  coords.ReadPortal();
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet.GetCellSet(),
+                                                    dataSet.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1);
+}
+
+void TestCapacity()
+{
+  std::cout << "Test capacity" << std::endl;
+  vtkm::cont::CellLocatorCache cache;
+  vtkm::cont::DataSet dataSet1 = MakeTestDataSet();
+  vtkm::cont::DataSet dataSet2 = MakeTestDataSet();
+
+  cache.SetCapacity(1);
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet1.GetCellSet(),
+                                                    dataSet1.GetCoordinateSystem());
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet2.GetCellSet(),
+                                                    dataSet2.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1);
+  // The first locator was evicted.
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet1.GetCellSet(),
+                                                    dataSet1.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 3);
+
+  cache.SetCapacity(0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0);
+  cache.GetLocator<vtkm::cont::CellLocatorTwoLevel>(dataSet1.GetCellSet(),
+                                                    dataSet1.GetCoordinateSystem());
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 4);
+
+  cache.Clear();
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 0);
+}
+
+struct CheckLocatorFunctor
+{
+  template <typename LocatorType>
+  void operator()(const LocatorType& locator, const PointType& point, vtkm::Id expected) const
+  {
+    VTKM_TEST_ASSERT(FindCell(locator, point) == expected);
+  }
+};
+
+void TestChooser()
+{
+  std::cout << "Test CastAndCallCellLocatorChooser" << std::endl;
+  vtkm::cont::CellLocatorCache& cache = vtkm::cont::GetCellLocatorCache();
+  cache.Clear();
+  vtkm::cont::DataSet dataSet = MakeTestDataSet();
+
+  // The cache used by the filters keeps nothing until it is enabled.
+  const vtkm::Id cellId = 1 + (DIM - 1) + (DIM - 1) * (DIM - 1);
+  VTKM_TEST_ASSERT(cache.GetCapacity() == 0, "Filters cache locators by default.");
+  vtkm::cont::CastAndCallCellLocatorChooser(
+    dataSet, CheckLocatorFunctor{}, PointType(1.5f), cellId);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0);
+
+  cache.SetCapacity(4);
+  cache.Clear();
+  vtkm::cont::CastAndCallCellLocatorChooser(
+    dataSet, CheckLocatorFunctor{}, PointType(1.5f), cellId);
+  vtkm::cont::CastAndCallCellLocatorChooser(dataSet, CheckLocatorFunctor{}, PointType(0.5f), 0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfMisses() == 1);
+  VTKM_TEST_ASSERT(cache.GetNumberOfHits() == 1);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 1);
+
+  cache.SetCapacity(0);
+  VTKM_TEST_ASSERT(cache.GetNumberOfEntries() == 0);
+  cache.Clear();
+}
+
+void DoTest()
+{
+  TestReuse();
+  TestModified();
+  TestCapacity();
+  TestChooser();
+}
+
+} // anonymous namespace
+
+int UnitTestCellLocatorCache(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
@@ -0,0 +1,155 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/AsyncEvent.h>
+#include <vtkm/cont/ErrorExecution.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 100000;
+constexpr vtkm::IdComponent NUM_CHAINS = 8;
+
+struct Scale : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+
+  vtkm::Id Factor;
+  VTKM_CONT Scale(vtkm::Id factor)
+    : Factor(factor)
+  {
+  }
+
+  VTKM_EXEC void operator()(vtkm::Id in, vtkm::Id& out) const { out = this->Factor * in; }
+};
+
+struct Add : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldIn, FieldOut);
+
+  VTKM_EXEC void operator()(vtkm::Id a, vtkm::Id b, vtkm::Id& out) const { out = a + b; }
+};
+
+struct RaiseAnError : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn);
+
+  VTKM_EXEC void operator()(vtkm::Id index) const
+  {
+    if (index == ARRAY_SIZE / 2)
+    {
+      this->RaiseError("Expected error.");
+    }
+  }
+};
+
+void TestDefaultEvent()
+{
+  std::cout << "Test default event" << std::endl;
+  vtkm::cont::AsyncEvent event;
+  VTKM_TEST_ASSERT(event.IsComplete());
+  event.Wait();
+}
+
+void TestDependentChain()
+{
+  std::cout << "Test dependent invocations" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandleIndex input(ARRAY_SIZE);
+  vtkm::cont::ArrayHandle<vtkm::Id> doubled;
+  vtkm::cont::ArrayHandle<vtkm::Id> tripled;
+  vtkm::cont::ArrayHandle<vtkm::Id> sum;
+
+  // The first two invocations only share an input and can run together. The third reads the
+  // outputs of both and so waits for them when its arguments are prepared.
+  vtkm::cont::AsyncEvent event1 = invoke.Async(Scale{ 2 }, input, doubled);
+  vtkm::cont::AsyncEvent event2 = invoke.Async(Scale{ 3 }, input, tripled);
+  vtkm::cont::AsyncEvent event3 = invoke.Async(Add{}, doubled, tripled, sum);
+
+  // Reading the output in the control environment waits for the last invocation.
+  auto portal = sum.ReadPortal();
+  event1.Wait();
+  event2.Wait();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    VTKM_TEST_ASSERT(portal.Get(index) == 5 * index, "Bad value at ", index);
+  }
+  event3.Wait();
+  VTKM_TEST_ASSERT(event3.IsComplete());
+}
+
+void TestIndependentChains()
+{
+  std::cout << "Test independent invocations" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandleIndex input(ARRAY_SIZE);
+
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Id>> outputs(static_cast<std::size_t>(NUM_CHAINS));
+  std::vector<vtkm::cont::AsyncEvent> events;
+  for (vtkm::IdComponent chain = 0; chain < NUM_CHAINS; ++chain)
+  {
+    events.push_back(
+      invoke.Async(Scale{ chain }, input, outputs[static_cast<std::size_t>(chain)]));
+  }
+  vtkm::cont::WaitAll(events);
+
+  for (vtkm::IdComponent chain = 0; chain < NUM_CHAINS; ++chain)
+  {
+    VTKM_TEST_ASSERT(events[static_cast<std::size_t>(chain)].IsComplete());
+    auto portal = outputs[static_cast<std::size_t>(chain)].ReadPortal();
+    VTKM_TEST_ASSERT(portal.GetNumberOfValues() == ARRAY_SIZE);
+    VTKM_TEST_ASSERT(portal.Get(ARRAY_SIZE - 1) == chain * (ARRAY_SIZE - 1));
+  }
+}
+
+void TestError()
+{
+  std::cout << "Test error in asynchronous invocation" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandleIndex input(ARRAY_SIZE);
+
+  vtkm::cont::AsyncEvent event = invoke.Async(RaiseAnError{}, input);
+  bool threw = false;
+  try
+  {
+    event.Wait();
+  }
+  catch (vtkm::cont::ErrorExecution& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Error was not rethrown from Wait.");
+  VTKM_TEST_ASSERT(event.IsComplete());
+}
+
+void DoTest()
+{
+  TestDefaultEvent();
+  TestDependentChain();
+  TestIndependentChains();
+  TestError();
+}
+
+} // anonymous namespace
+
+int UnitTestInvokerAsync(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
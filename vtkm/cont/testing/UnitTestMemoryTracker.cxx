@@ -0,0 +1,128 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/MemoryTracker.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/DeviceAdapterTag.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 1000;
+constexpr vtkm::BufferSizeType ARRAY_BYTES =
+  static_cast<vtkm::BufferSizeType>(ARRAY_SIZE * sizeof(vtkm::Id));
+
+void TestHostAllocation()
+{
+  std::cout << "Test host allocation" << std::endl;
+  vtkm::cont::MemoryTracker& tracker = vtkm::cont::GetMemoryTracker();
+  vtkm::cont::DeviceAdapterTagUndefined host;
+
+  vtkm::cont::MemoryUsage before = tracker.GetUsage(host);
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> array;
+    array.Allocate(ARRAY_SIZE);
+    array.WritePortal().Set(0, 0);
+
+    vtkm::cont::MemoryUsage during = tracker.GetUsage(host);
+    VTKM_TEST_ASSERT(during.LiveBytes - before.LiveBytes == ARRAY_BYTES);
+    VTKM_TEST_ASSERT(during.NumAllocations == before.NumAllocations + 1);
+    VTKM_TEST_ASSERT(during.PeakBytes >= during.LiveBytes);
+  }
+  vtkm::cont::MemoryUsage after = tracker.GetUsage(host);
+  VTKM_TEST_ASSERT(after.LiveBytes == before.LiveBytes);
+  VTKM_TEST_ASSERT(after.NumFrees == before.NumFrees + 1);
+  VTKM_TEST_ASSERT(after.PeakBytes >= before.LiveBytes + ARRAY_BYTES);
+}
+
+void TestTags()
+{
+  std::cout << "Test tags" << std::endl;
+  vtkm::cont::MemoryTracker& tracker = vtkm::cont::GetMemoryTracker();
+
+  {
+    vtkm::cont::MemoryTrackerScope outerScope("TestOuter");
+    vtkm::cont::ArrayHandle<vtkm::Id> outerArray;
+    outerArray.Allocate(ARRAY_SIZE);
+    outerArray.WritePortal();
+
+    {
+      vtkm::cont::MemoryTrackerScope innerScope("TestInner");
+      vtkm::cont::ArrayHandle<vtkm::Id> innerArray;
+      innerArray.Allocate(2 * ARRAY_SIZE);
+      innerArray.WritePortal();
+      VTKM_TEST_ASSERT(tracker.GetUsage("TestInner").LiveBytes == 2 * ARRAY_BYTES);
+    }
+
+    // The inner array is freed, but its peak is remembered.
+    VTKM_TEST_ASSERT(tracker.GetUsage("TestInner").LiveBytes == 0);
+    VTKM_TEST_ASSERT(tracker.GetUsage("TestInner").PeakBytes == 2 * ARRAY_BYTES);
+    VTKM_TEST_ASSERT(tracker.GetUsage("TestOuter").LiveBytes == ARRAY_BYTES);
+
+    // Resizing an array is recorded against the tag it was allocated with.
+    vtkm::cont::MemoryTrackerScope otherScope("TestOther");
+    outerArray.Allocate(3 * ARRAY_SIZE, vtkm::CopyFlag::On);
+    outerArray.WritePortal();
+    VTKM_TEST_ASSERT(tracker.GetUsage("TestOuter").PeakBytes >= 3 * ARRAY_BYTES);
+    VTKM_TEST_ASSERT(tracker.GetUsage("TestOther").PeakBytes == 0);
+  }
+
+  VTKM_TEST_ASSERT(tracker.GetUsage("TestOuter").LiveBytes == 0);
+  VTKM_TEST_ASSERT(tracker.GetUsage("NotATag").NumAllocations == 0);
+
+  std::vector<std::string> tags = tracker.GetTags();
+  VTKM_TEST_ASSERT(std::find(tags.begin(), tags.end(), "TestInner") != tags.end());
+  VTKM_TEST_ASSERT(std::find(tags.begin(), tags.end(), "TestOuter") != tags.end());
+
+  tracker.ResetPeaks();
+  VTKM_TEST_ASSERT(tracker.GetUsage("TestInner").PeakBytes == 0);
+}
+
+void TestDevice()
+{
+  std::cout << "Test device allocation" << std::endl;
+  vtkm::cont::MemoryTracker& tracker = vtkm::cont::GetMemoryTracker();
+  vtkm::cont::DeviceAdapterTagSerial serial;
+
+  vtkm::cont::MemoryUsage before = tracker.GetUsage(serial);
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> array;
+    vtkm::cont::Token token;
+    array.PrepareForOutput(ARRAY_SIZE, serial, token);
+    VTKM_TEST_ASSERT(tracker.GetUsage(serial).LiveBytes - before.LiveBytes == ARRAY_BYTES);
+  }
+  VTKM_TEST_ASSERT(tracker.GetUsage(serial).LiveBytes == before.LiveBytes);
+
+  std::stringstream report;
+  tracker.PrintReport(report);
+  std::cout << report.str();
+  VTKM_TEST_ASSERT(report.str().find("Serial") != std::string::npos);
+  VTKM_TEST_ASSERT(report.str().find("TestOuter") != std::string::npos);
+}
+
+void DoTest()
+{
+  TestHostAllocation();
+  TestTags();
+  TestDevice();
+}
+
+} // anonymous namespace
+
+int UnitTestMemoryTracker(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
@@ -0,0 +1,162 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/WorkletProfiler.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <sstream>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 1000;
+
+struct ProfiledWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+
+  VTKM_EXEC void operator()(vtkm::Id in, vtkm::Id& out) const { out = 2 * in; }
+};
+
+void TestDisabled()
+{
+  std::cout << "Test disabled profiler records nothing" << std::endl;
+  vtkm::cont::WorkletProfiler& profiler = vtkm::cont::GetWorkletProfiler();
+  profiler.Clear();
+  VTKM_TEST_ASSERT(!profiler.GetEnabled());
+
+  vtkm::cont::ArrayHandle<vtkm::Id> output;
+  vtkm::cont::Invoker{}(ProfiledWorklet{}, vtkm::cont::ArrayHandleIndex(ARRAY_SIZE), output);
+  VTKM_TEST_ASSERT(profiler.GetEvents().empty());
+}
+
+void TestRecord()
+{
+  std::cout << "Test invocations are recorded" << std::endl;
+  vtkm::cont::WorkletProfiler& profiler = vtkm::cont::GetWorkletProfiler();
+  profiler.Clear();
+  profiler.SetEnabled(true);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> input;
+  input.Allocate(ARRAY_SIZE);
+  auto portal = input.WritePortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    portal.Set(index, index);
+  }
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id> output;
+  invoke(ProfiledWorklet{}, input, output);
+  invoke.Async(ProfiledWorklet{}, vtkm::cont::ArrayHandleIndex(ARRAY_SIZE / 2), output).Wait();
+  profiler.SetEnabled(false);
+
+  std::vector<vtkm::cont::WorkletProfileEvent> events = profiler.GetEvents();
+  VTKM_TEST_ASSERT(events.size() == 2, "Expected 2 events, got ", events.size());
+  for (const vtkm::cont::WorkletProfileEvent& event : events)
+  {
+    std::cout << "  " << event.WorkletName << " on " << event.Device.GetName() << ": "
+              << event.InputDomainSize << " values, " << event.ElapsedTime << " s, "
+              << event.BytesTransferred << " bytes" << std::endl;
+    VTKM_TEST_ASSERT(event.WorkletName.find("ProfiledWorklet") != std::string::npos);
+    VTKM_TEST_ASSERT(event.Device.IsValueValid());
+    VTKM_TEST_ASSERT(event.ElapsedTime >= 0.0);
+    VTKM_TEST_ASSERT(event.BytesTransferred >= 0);
+  }
+  VTKM_TEST_ASSERT(events[0].InputDomainSize == ARRAY_SIZE);
+  VTKM_TEST_ASSERT(!events[0].Async);
+  VTKM_TEST_ASSERT(events[1].InputDomainSize == ARRAY_SIZE / 2);
+  VTKM_TEST_ASSERT(events[1].Async);
+  VTKM_TEST_ASSERT(events[1].StartTime >= events[0].StartTime);
+
+  std::vector<vtkm::cont::WorkletProfileSummary> summary = profiler.GetSummary();
+  VTKM_TEST_ASSERT(summary.size() == 1);
+  VTKM_TEST_ASSERT(summary[0].NumInvocations == 2);
+  VTKM_TEST_ASSERT(summary[0].TotalInputDomainSize == ARRAY_SIZE + ARRAY_SIZE / 2);
+  profiler.PrintSummary(std::cout);
+}
+
+void TestRingBuffer()
+{
+  std::cout << "Test ring buffer keeps the newest events" << std::endl;
+  vtkm::cont::WorkletProfiler& profiler = vtkm::cont::GetWorkletProfiler();
+  vtkm::Id oldCapacity = profiler.GetCapacity();
+  profiler.SetCapacity(4);
+
+  for (vtkm::Id index = 0; index < 10; ++index)
+  {
+    vtkm::cont::WorkletProfileEvent event;
+    event.WorkletName = "Event";
+    event.InputDomainSize = index;
+    profiler.Record(event);
+  }
+
+  std::vector<vtkm::cont::WorkletProfileEvent> events = profiler.GetEvents();
+  VTKM_TEST_ASSERT(events.size() == 4);
+  for (std::size_t index = 0; index < events.size(); ++index)
+  {
+    VTKM_TEST_ASSERT(events[index].InputDomainSize == static_cast<vtkm::Id>(6 + index));
+  }
+  VTKM_TEST_ASSERT(profiler.GetNumberOfDroppedEvents() == 6);
+
+  profiler.SetCapacity(oldCapacity);
+  VTKM_TEST_ASSERT(profiler.GetEvents().empty());
+}
+
+void TestChromeTrace()
+{
+  std::cout << "Test Chrome trace output" << std::endl;
+  vtkm::cont::WorkletProfiler& profiler = vtkm::cont::GetWorkletProfiler();
+  profiler.Clear();
+
+  vtkm::cont::WorkletProfileEvent event;
+  event.WorkletName = "Worklet<\"quoted\">";
+  event.Device = vtkm::cont::DeviceAdapterTagSerial{};
+  event.InputDomainSize = 42;
+  event.StartTime = 0.5;
+  event.ElapsedTime = 0.25;
+  event.BytesTransferred = 1024;
+  profiler.Record(event);
+
+  std::ostringstream trace;
+  profiler.WriteChromeTrace(trace);
+  std::string traceString = trace.str();
+  std::cout << traceString;
+  VTKM_TEST_ASSERT(traceString.find("\"traceEvents\"") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"name\":\"Worklet<\\\"quoted\\\">\"") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"ph\":\"X\"") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"ts\":500000.000") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"dur\":250000.000") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"device\":\"Serial\"") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"size\":42") != std::string::npos);
+  VTKM_TEST_ASSERT(traceString.find("\"bytes\":1024") != std::string::npos);
+  profiler.Clear();
+}
+
+void DoTest()
+{
+  TestDisabled();
+  TestRecord();
+  TestRingBuffer();
+  TestChromeTrace();
+}
+
+} // anonymous namespace
+
+int UnitTestWorkletProfiler(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
@@ -84,10 +84,79 @@ public:
   }
 
 
+  /// The state kept between calls to `FindCell` for a stream of nearby points, such as the
+  /// positions along a streamline. It holds the cell and leaf node of the last point found.
+  struct LastCell
+  {
+    vtkm::Id CellId = -1;
+    vtkm::Id NodeIdx = -1;
+  };
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
                            vtkm::Id& cellId,
                            vtkm::Vec3f& parametric) const
+  {
+    LastCell lastCell;
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  /// Finds the cell containing `point`, checking the cell and then the leaf node of the last
+  /// point found before searching the whole hierarchy. `lastCell` is updated with the cell
+  /// found.
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& lastCell) const
+  {
+    if (lastCell.CellId >= 0)
+    {
+      using IndicesType = typename CellSetPortal::IndicesType;
+      IndicesType cellPointIndices = this->CellSet.GetIndices(lastCell.CellId);
+      vtkm::VecFromPortalPermute<IndicesType, CoordsPortal> cellPoints(&cellPointIndices,
+                                                                       this->Coords);
+      bool found;
+      VTKM_RETURN_ON_ERROR(this->IsPointInCell(
+        point, parametric, this->CellSet.GetCellShape(lastCell.CellId), cellPoints, found));
+      if (found)
+      {
+        cellId = lastCell.CellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+    if (lastCell.NodeIdx >= 0)
+    {
+      VTKM_RETURN_ON_ERROR(
+        this->FindInLeaf(point, parametric, this->Nodes.Get(lastCell.NodeIdx), cellId));
+      if (cellId >= 0)
+      {
+        lastCell.CellId = cellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC CellLocatorBoundingIntervalHierarchy* operator->() { return this; }
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC const CellLocatorBoundingIntervalHierarchy* operator->() const { return this; }
+
+private:
+  enum struct FindCellState
+  {
+    EnterNode,
+    AscendFromNode,
+    DescendLeftChild,
+    DescendRightChild
+  };
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCellImpl(const vtkm::Vec3f& point,
+                               vtkm::Id& cellId,
+                               vtkm::Vec3f& parametric,
+                               LastCell& lastCell) const
   {
     cellId = -1;
     vtkm::Id nodeIndex = 0;
@@ -114,6 +183,9 @@ public:
 
     if (cellId >= 0)
     {
+      // The search stops in the leaf holding the cell.
+      lastCell.CellId = cellId;
+      lastCell.NodeIdx = nodeIndex;
       return vtkm::ErrorCode::Success;
     }
     else
@@ -122,20 +194,6 @@ public:
     }
   }
 
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC CellLocatorBoundingIntervalHierarchy* operator->() { return this; }
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC const CellLocatorBoundingIntervalHierarchy* operator->() const { return this; }
-
-private:
-  enum struct FindCellState
-  {
-    EnterNode,
-    AscendFromNode,
-    DescendLeftChild,
-    DescendRightChild
-  };
-
   VTKM_EXEC
   vtkm::ErrorCode EnterNode(FindCellState& state,
                             const vtkm::Vec3f& point,
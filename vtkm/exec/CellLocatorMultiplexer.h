@@ -15,6 +15,8 @@
 
 #include <vtkm/exec/internal/Variant.h>
 
+#include <type_traits>
+
 namespace vtkm
 {
 namespace exec
@@ -33,6 +35,22 @@ struct FindCellFunctor
   {
     return locator.FindCell(point, cellId, parametric);
   }
+
+  template <typename Locator, typename LastCellVariant>
+  VTKM_EXEC vtkm::ErrorCode operator()(Locator&& locator,
+                                       const vtkm::Vec3f& point,
+                                       vtkm::Id& cellId,
+                                       vtkm::Vec3f& parametric,
+                                       LastCellVariant& lastCell) const
+  {
+    using ConcreteLastCell = typename std::decay<Locator>::type::LastCell;
+    if (lastCell.GetIndex() != lastCell.template GetIndexOf<ConcreteLastCell>())
+    {
+      lastCell = ConcreteLastCell{};
+    }
+    return locator.FindCell(
+      point, cellId, parametric, lastCell.template Get<ConcreteLastCell>());
+  }
 };
 
 } // namespace detail
@@ -43,6 +61,21 @@ class VTKM_ALWAYS_EXPORT CellLocatorMultiplexer
   vtkm::exec::internal::Variant<LocatorTypes...> Locators;
 
 public:
+  /// The state kept between calls to `FindCell` for a stream of nearby points. It holds the
+  /// `LastCell` of whichever locator is in use.
+  class LastCell
+  {
+    vtkm::exec::internal::Variant<typename LocatorTypes::LastCell...> Cell;
+
+    friend CellLocatorMultiplexer;
+
+  public:
+    VTKM_EXEC LastCell()
+      : Cell(vtkm::ListAt<vtkm::List<typename LocatorTypes::LastCell...>, 0>{})
+    {
+    }
+  };
+
   CellLocatorMultiplexer() = default;
 
   template <typename Locator>
@@ -58,6 +91,15 @@ public:
     return this->Locators.CastAndCall(detail::FindCellFunctor{}, point, cellId, parametric);
   }
 
+  VTKM_EXEC vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                                     vtkm::Id& cellId,
+                                     vtkm::Vec3f& parametric,
+                                     LastCell& lastCell) const
+  {
+    return this->Locators.CastAndCall(
+      detail::FindCellFunctor{}, point, cellId, parametric, lastCell.Cell);
+  }
+
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
   VTKM_EXEC CellLocatorMultiplexer* operator->() { return this; }
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
@@ -42,6 +42,11 @@ private:
   VTKM_CONT static vtkm::Id3 ToId3(vtkm::Id&& src) { return vtkm::Id3(src, 1, 1); }
 
 public:
+  /// The state kept between calls to `FindCell` for a stream of nearby points.
+  struct LastCell
+  {
+  };
+
   template <vtkm::IdComponent dimensions>
   VTKM_CONT CellLocatorRectilinearGrid(const vtkm::Id planeSize,
                                        const vtkm::Id rowSize,
@@ -144,6 +149,17 @@ public:
     return vtkm::ErrorCode::Success;
   }
 
+  /// Finding a cell in a structured grid is direct, so the hint is not used. The overload
+  /// exists so that all locators can be called the same way.
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& vtkmNotUsed(lastCell)) const
+  {
+    return this->FindCell(point, cellId, parametric);
+  }
+
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
   VTKM_EXEC CellLocatorRectilinearGrid* operator->() { return this; }
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
@@ -153,8 +153,100 @@ public:
   {
   }
 
+  /// The state kept between calls to `FindCell` for a stream of nearby points, such as the
+  /// positions along a streamline. It holds the cell and leaf bin of the last point found.
+  struct LastCell
+  {
+    vtkm::Id CellId = -1;
+    vtkm::Id LeafIdx = -1;
+  };
+
   VTKM_EXEC
   vtkm::ErrorCode FindCell(const FloatVec3& point, vtkm::Id& cellId, FloatVec3& parametric) const
+  {
+    LastCell lastCell;
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  /// Finds the cell containing `point`, checking the cell and then the leaf bin of the last
+  /// point found before searching the whole locator. When the points given are close to each
+  /// other, they are usually in the same cell or in a cell of the same bin. `lastCell` is
+  /// updated with the cell found.
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const FloatVec3& point,
+                           vtkm::Id& cellId,
+                           FloatVec3& parametric,
+                           LastCell& lastCell) const
+  {
+    if (lastCell.CellId >= 0)
+    {
+      bool inside;
+      VTKM_RETURN_ON_ERROR(this->PointInsideCellId(point, lastCell.CellId, parametric, inside));
+      if (inside)
+      {
+        cellId = lastCell.CellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+    if (lastCell.LeafIdx >= 0)
+    {
+      VTKM_RETURN_ON_ERROR(this->FindInLeaf(point, lastCell.LeafIdx, cellId, parametric));
+      if (cellId >= 0)
+      {
+        lastCell.CellId = cellId;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+    return this->FindCellImpl(point, cellId, parametric, lastCell);
+  }
+
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC CellLocatorTwoLevel* operator->() { return this; }
+  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
+  VTKM_EXEC const CellLocatorTwoLevel* operator->() const { return this; }
+
+private:
+  VTKM_EXEC
+  vtkm::ErrorCode PointInsideCellId(const FloatVec3& point,
+                                    vtkm::Id cellId,
+                                    FloatVec3& parametric,
+                                    bool& inside) const
+  {
+    auto indices = this->CellSet.GetIndices(cellId);
+    auto pts = vtkm::make_VecFromPortalPermute(&indices, this->Coords);
+    return PointInsideCell(point, this->CellSet.GetCellShape(cellId), pts, parametric, inside);
+  }
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindInLeaf(const FloatVec3& point,
+                             vtkm::Id leafId,
+                             vtkm::Id& cellId,
+                             FloatVec3& parametric) const
+  {
+    cellId = -1;
+    vtkm::Id start = this->CellStartIndex.Get(leafId);
+    vtkm::Id end = start + this->CellCount.Get(leafId);
+    for (vtkm::Id i = start; i < end; ++i)
+    {
+      vtkm::Id cid = this->CellIds.Get(i);
+      FloatVec3 pc;
+      bool inside;
+      VTKM_RETURN_ON_ERROR(this->PointInsideCellId(point, cid, pc, inside));
+      if (inside)
+      {
+        cellId = cid;
+        parametric = pc;
+        return vtkm::ErrorCode::Success;
+      }
+    }
+    return vtkm::ErrorCode::Success;
+  }
+
+  VTKM_EXEC
+  vtkm::ErrorCode FindCellImpl(const FloatVec3& point,
+                               vtkm::Id& cellId,
+                               FloatVec3& parametric,
+                               LastCell& lastCell) const
   {
     using namespace vtkm::internal::cl_uniform_bins;
 
@@ -182,35 +274,18 @@ public:
       vtkm::Id leafStart = this->LeafStartIndex.Get(binId);
       vtkm::Id leafId = leafStart + ComputeFlatIndex(leafId3, leafGrid.Dimensions);
 
-      vtkm::Id start = this->CellStartIndex.Get(leafId);
-      vtkm::Id end = start + this->CellCount.Get(leafId);
-      for (vtkm::Id i = start; i < end; ++i)
+      VTKM_RETURN_ON_ERROR(this->FindInLeaf(point, leafId, cellId, parametric));
+      if (cellId >= 0)
       {
-        vtkm::Id cid = this->CellIds.Get(i);
-        auto indices = this->CellSet.GetIndices(cid);
-        auto pts = vtkm::make_VecFromPortalPermute(&indices, this->Coords);
-        FloatVec3 pc;
-        bool inside;
-        VTKM_RETURN_ON_ERROR(
-          PointInsideCell(point, this->CellSet.GetCellShape(cid), pts, pc, inside));
-        if (inside)
-        {
-          cellId = cid;
-          parametric = pc;
-          return vtkm::ErrorCode::Success;
-        }
+        lastCell.CellId = cellId;
+        lastCell.LeafIdx = leafId;
+        return vtkm::ErrorCode::Success;
       }
     }
 
     return vtkm::ErrorCode::CellNotFound;
   }
 
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC CellLocatorTwoLevel* operator->() { return this; }
-  VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
-  VTKM_EXEC const CellLocatorTwoLevel* operator->() const { return this; }
-
-private:
   vtkm::internal::cl_uniform_bins::Grid TopLevel;
 
   ReadPortal<DimVec3> LeafDimensions;
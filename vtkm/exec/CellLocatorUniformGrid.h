@@ -30,6 +30,11 @@ namespace exec
 class VTKM_ALWAYS_EXPORT CellLocatorUniformGrid
 {
 public:
+  /// The state kept between calls to `FindCell` for a stream of nearby points.
+  struct LastCell
+  {
+  };
+
   VTKM_CONT
   CellLocatorUniformGrid(const vtkm::Id3 cellDims,
                          const vtkm::Vec3f origin,
@@ -82,6 +87,17 @@ public:
     return vtkm::ErrorCode::Success;
   }
 
+  /// Finding a cell in a structured grid is direct, so the hint is not used. The overload
+  /// exists so that all locators can be called the same way.
+  VTKM_EXEC
+  vtkm::ErrorCode FindCell(const vtkm::Vec3f& point,
+                           vtkm::Id& cellId,
+                           vtkm::Vec3f& parametric,
+                           LastCell& vtkmNotUsed(lastCell)) const
+  {
+    return this->FindCell(point, cellId, parametric);
+  }
+
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
   VTKM_EXEC CellLocatorUniformGrid* operator->() { return this; }
   VTKM_DEPRECATED(1.6, "Locators are no longer pointers. Use . operator.")
@@ -16,6 +16,8 @@
 //Todo: rename this header to TaskInvokeWorkletDetail.h
 #include <vtkm/exec/internal/WorkletInvokeFunctorDetail.h>
 
+#include <typeinfo>
+
 namespace vtkm
 {
 namespace exec
@@ -136,6 +138,7 @@ public:
   TaskTiling1D()
     : Worklet(nullptr)
     , Invocation(nullptr)
+    , WorkletTypeInfo(&typeid(void))
   {
   }
 
@@ -148,6 +151,7 @@ public:
     , Invocation(nullptr)
     , ExecuteFunction(nullptr)
     , SetErrorBufferFunction(nullptr)
+    , WorkletTypeInfo(&typeid(FunctorType))
   {
     //Setup the execute and set error buffer function pointers
     this->ExecuteFunction = &FunctorTiling1DExecute<FunctorType>;
@@ -165,6 +169,7 @@ public:
     , Invocation(nullptr)
     , ExecuteFunction(nullptr)
     , SetErrorBufferFunction(nullptr)
+    , WorkletTypeInfo(&typeid(WorkletType))
   {
     //Setup the execute and set error buffer function pointers
     this->ExecuteFunction = &TaskTiling1DExecute<WorkletType, InvocationType>;
@@ -183,6 +188,7 @@ public:
     , Invocation(task.Invocation)
     , ExecuteFunction(task.ExecuteFunction)
     , SetErrorBufferFunction(task.SetErrorBufferFunction)
+    , WorkletTypeInfo(task.WorkletTypeInfo)
   {
   }
 
@@ -198,6 +204,10 @@ public:
     this->ExecuteFunction(this->Worklet, this->Invocation, start, end);
   }
 
+  /// The type of the worklet or functor run by this task. Devices can use it to remember
+  /// properties of the worklet across invocations.
+  const std::type_info& GetWorkletType() const { return *this->WorkletTypeInfo; }
+
 protected:
   void* Worklet;
   void* Invocation;
@@ -207,6 +217,8 @@ protected:
 
   using SetErrorBufferSignature = void (*)(void*, const vtkm::exec::internal::ErrorMessageBuffer&);
   SetErrorBufferSignature SetErrorBufferFunction;
+
+  const std::type_info* WorkletTypeInfo;
 };
 
 // TaskTiling3D represents an execution pattern for a worklet
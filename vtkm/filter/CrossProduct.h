@@ -122,6 +122,8 @@ public:
   }
   //@}
 
+  VTKM_CONT bool CanThread() const { return true; }
+
   template <typename T, typename StorageType, typename DerivedPolicy>
   VTKM_CONT vtkm::cont::DataSet DoExecute(
     const vtkm::cont::DataSet& input,
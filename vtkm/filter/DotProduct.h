@@ -119,6 +119,8 @@ public:
   }
   //@}
 
+  VTKM_CONT bool CanThread() const { return true; }
+
   template <typename T, typename StorageType, typename DerivedPolicy>
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input,
                                           const vtkm::cont::ArrayHandle<T, StorageType>& field,
@@ -295,11 +295,54 @@ public:
   /// which device adapters a filter uses.
   void SetInvoker(vtkm::cont::Invoker inv) { this->Invoke = inv; }
 
+  //@{
+  /// \brief Specify whether the partitions of a PartitionedDataSet are executed concurrently.
+  ///
+  /// By default, executing the filter on a `PartitionedDataSet` runs it on one partition after
+  /// another. When the input has many small partitions, the worklets for each partition are too
+  /// small to use the whole device. When this is on, several partitions are executed at the same
+  /// time, each from its own host thread. The partitions of the output are in the same order as
+  /// the input regardless.
+  ///
+  /// This only has an effect on filters whose `CanThread` returns true.
+  ///
+  VTKM_CONT void SetRunMultiThreadedFilter(bool value) { this->RunMultiThreadedFilter = value; }
+  VTKM_CONT bool GetRunMultiThreadedFilter() const { return this->RunMultiThreadedFilter; }
+  //@}
+
+  //@{
+  /// \brief Specify how many partitions are executed at the same time.
+  ///
+  /// Used when `RunMultiThreadedFilter` is on. A value of 0 (the default) uses one thread per
+  /// core of the host. The threads used by the device for each partition are divided among the
+  /// partitions running at the same time, so that the total does not oversubscribe the host.
+  ///
+  VTKM_CONT void SetNumberOfConcurrentPartitions(vtkm::Id value)
+  {
+    this->NumberOfConcurrentPartitions = value;
+  }
+  VTKM_CONT vtkm::Id GetNumberOfConcurrentPartitions() const
+  {
+    return this->NumberOfConcurrentPartitions;
+  }
+  //@}
+
+  /// \brief Returns whether this filter can execute several partitions at the same time.
+  ///
+  /// Most filters store state in the filter object while executing a partition (for example to
+  /// later map fields onto the output), so running them on several partitions at once is not
+  /// safe. Subclasses that do not modify themselves while executing a `DataSet` hide this
+  /// method and return true.
+  ///
+  VTKM_CONT bool CanThread() const { return false; }
+
 protected:
   vtkm::cont::Invoker Invoke;
 
 private:
   vtkm::filter::FieldSelection FieldsToPass;
+  bool RunMultiThreadedFilter = false;
+  vtkm::Id NumberOfConcurrentPartitions = 0;
 };
 }
 } // namespace vtkm::filter
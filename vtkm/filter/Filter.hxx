@@ -17,6 +17,16 @@
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/Field.h>
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/MemoryTracker.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace vtkm
 {
@@ -170,6 +180,102 @@ InputType CallPrepareForExecutionInternal(std::true_type,
   return self->PrepareForExecution(input, policy);
 }
 
+//--------------------------------------------------------------------------------
+// Returns the number of host threads used to execute `numPartitions` partitions when
+// partitions are executed concurrently.
+inline vtkm::Id NumberOfPartitionThreads(vtkm::Id requested, vtkm::Id numPartitions)
+{
+  vtkm::Id numThreads = requested;
+  if (numThreads <= 0)
+  {
+    numThreads =
+      std::max(vtkm::Id{ 1 }, static_cast<vtkm::Id>(std::thread::hardware_concurrency()));
+  }
+  return std::min(numThreads, numPartitions);
+}
+
+//--------------------------------------------------------------------------------
+// Calls `functor(index)` for every index in [0, numPartitions) from `numThreads` host threads.
+// The worker threads get the device restrictions of the calling thread's
+// `RuntimeDeviceTracker`, record their allocations in the memory tracker under `tag`, and
+// divide the threads of the host devices among themselves. The first error raised by
+// `functor` is rethrown once all threads have finished.
+template <typename Functor>
+void RunPartitionsConcurrently(vtkm::Id numThreads,
+                               vtkm::Id numPartitions,
+                               const std::string& tag,
+                               Functor&& functor)
+{
+  const vtkm::cont::RuntimeDeviceTracker& callerTracker = vtkm::cont::GetRuntimeDeviceTracker();
+  vtkm::cont::RuntimeDeviceInformation deviceInfo;
+
+  std::atomic<vtkm::Id> nextPartition(0);
+  std::mutex errorMutex;
+  std::exception_ptr firstError;
+
+  auto worker = [&]() {
+    // The device tracker is per thread, so copy over the devices disabled on the caller.
+    vtkm::cont::RuntimeDeviceTracker& tracker = vtkm::cont::GetRuntimeDeviceTracker();
+    for (vtkm::Int8 deviceIndex = 1; deviceIndex < VTKM_MAX_DEVICE_ADAPTER_ID; ++deviceIndex)
+    {
+      vtkm::cont::DeviceAdapterId device = vtkm::cont::make_DeviceAdapterId(deviceIndex);
+      if (!deviceInfo.Exists(device))
+      {
+        continue;
+      }
+      if (!callerTracker.CanRunOn(device))
+      {
+        tracker.DisableDevice(device);
+        continue;
+      }
+      // Devices that run on host threads would otherwise start a full team per partition.
+      auto& config = deviceInfo.GetRuntimeConfiguration(device);
+      vtkm::Id deviceThreads = 0;
+      if ((config.GetThreads(deviceThreads) ==
+           vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS) &&
+          (deviceThreads > numThreads))
+      {
+        config.SetThreads(deviceThreads / numThreads);
+      }
+    }
+
+    vtkm::cont::MemoryTrackerScope memoryScope(tag);
+    for (vtkm::Id index = nextPartition++; index < numPartitions; index = nextPartition++)
+    {
+      try
+      {
+        functor(index);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!firstError)
+        {
+          firstError = std::current_exception();
+        }
+        // Skip the remaining partitions.
+        nextPartition = numPartitions;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<std::size_t>(numThreads));
+  for (vtkm::Id i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  if (firstError)
+  {
+    std::rethrow_exception(firstError);
+  }
+}
+
 //--------------------------------------------------------------------------------
 // specialization for PartitionedDataSet input when `PrepareForExecution` is not provided
 // by the subclass. we iterate over blocks and execute for each block
@@ -181,13 +287,34 @@ vtkm::cont::PartitionedDataSet CallPrepareForExecutionInternal(
   const vtkm::cont::PartitionedDataSet& input,
   const vtkm::filter::PolicyBase<DerivedPolicy>& policy)
 {
+  const vtkm::Id numPartitions = input.GetNumberOfPartitions();
+  const vtkm::Id numThreads = self->GetRunMultiThreadedFilter() && self->CanThread()
+    ? NumberOfPartitionThreads(self->GetNumberOfConcurrentPartitions(), numPartitions)
+    : 1;
+
   vtkm::cont::PartitionedDataSet output;
-  for (const auto& inBlock : input)
+  if (numThreads <= 1)
   {
-    vtkm::cont::DataSet outBlock = CallPrepareForExecution(self, inBlock, policy);
-    CallMapFieldOntoOutput(self, inBlock, outBlock, policy);
-    output.AppendPartition(outBlock);
+    for (const auto& inBlock : input)
+    {
+      vtkm::cont::DataSet outBlock = CallPrepareForExecution(self, inBlock, policy);
+      CallMapFieldOntoOutput(self, inBlock, outBlock, policy);
+      output.AppendPartition(outBlock);
+    }
+    return output;
   }
+
+  // Each result is written to the slot of its input partition so that the output order does
+  // not depend on which thread finished first.
+  std::vector<vtkm::cont::DataSet> outBlocks(static_cast<std::size_t>(numPartitions));
+  RunPartitionsConcurrently(
+    numThreads, numPartitions, vtkm::cont::TypeToString<Derived>(), [&](vtkm::Id index) {
+      const vtkm::cont::DataSet& inBlock = input.GetPartition(index);
+      vtkm::cont::DataSet outBlock = CallPrepareForExecution(self, inBlock, policy);
+      CallMapFieldOntoOutput(self, inBlock, outBlock, policy);
+      outBlocks[static_cast<std::size_t>(index)] = outBlock;
+    });
+  output.AppendPartitions(outBlocks);
   return output;
 }
 
@@ -267,6 +394,7 @@ inline VTKM_CONT vtkm::cont::PartitionedDataSet Filter<Derived>::Execute(
                  "Filter (%d partitions): '%s'",
                  (int)input.GetNumberOfPartitions(),
                  vtkm::cont::TypeToString<Derived>().c_str());
+  vtkm::cont::MemoryTrackerScope memoryScope(vtkm::cont::TypeToString<Derived>());
 
   Derived* self = static_cast<Derived*>(this);
 
@@ -314,6 +442,7 @@ VTKM_CONT vtkm::cont::PartitionedDataSet Filter<Derived>::Execute(
                  "Filter (%d partitions): '%s'",
                  (int)input.GetNumberOfPartitions(),
                  vtkm::cont::TypeToString<Derived>().c_str());
+  vtkm::cont::MemoryTrackerScope memoryScope(vtkm::cont::TypeToString<Derived>());
 
   Derived* self = static_cast<Derived*>(this);
 
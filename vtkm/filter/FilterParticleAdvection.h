@@ -13,6 +13,7 @@
 
 #include <vtkm/Particle.h>
 #include <vtkm/filter/FilterDataSetWithField.h>
+#include <vtkm/filter/particleadvection/AdvectorBaseThreadedAlgorithm.h>
 #include <vtkm/filter/particleadvection/BoundsMap.h>
 #include <vtkm/filter/particleadvection/DataSetIntegrator.h>
 
@@ -50,12 +51,65 @@ public:
   VTKM_CONT
   void SetSeeds(vtkm::cont::ArrayHandle<vtkm::Particle>& seeds) { this->Seeds = seeds; }
 
+  /// Select the integrator. With `IntegrationMethod::RK45` each step of `StepSize` is split
+  /// into substeps whose length adapts to the field, so a much larger step size can be used
+  /// than with the default `IntegrationMethod::RK4`.
+  ///
+  VTKM_CONT
+  void SetIntegrationMethod(vtkm::filter::particleadvection::IntegrationMethod method)
+  {
+    this->IntegrationMethod = method;
+  }
+
+  VTKM_CONT
+  vtkm::filter::particleadvection::IntegrationMethod GetIntegrationMethod() const
+  {
+    return this->IntegrationMethod;
+  }
+
+  /// The largest error allowed for a substep of `IntegrationMethod::RK45`, relative to the
+  /// distance it moves the particle. The default is 1e-5.
+  ///
+  VTKM_CONT
+  void SetTolerance(vtkm::FloatDefault tolerance) { this->Tolerance = tolerance; }
+
+  /// The shortest and longest substeps of `IntegrationMethod::RK45`. A minimum of 0 (the
+  /// default) uses a thousandth of the maximum. A maximum of 0 (the default) uses `StepSize`.
+  ///
+  VTKM_CONT
+  void SetMinimumStepSize(vtkm::FloatDefault size) { this->MinimumStepSize = size; }
+
+  VTKM_CONT
+  void SetMaximumStepSize(vtkm::FloatDefault size) { this->MaximumStepSize = size; }
+
   VTKM_CONT
   bool GetUseThreadedAlgorithm() { return this->UseThreadedAlgorithm; }
 
   VTKM_CONT
   void SetUseThreadedAlgorithm(bool val) { this->UseThreadedAlgorithm = val; }
 
+  /// Specify how many threads advect particles when `UseThreadedAlgorithm` is on. A value of 0
+  /// (the default) uses one thread per core of the host when only the serial device is enabled,
+  /// and one thread otherwise, since the device already advects each batch in parallel. Each
+  /// thread has its own queue of particle batches and takes batches from the others when its
+  /// queue is empty.
+  ///
+  VTKM_CONT
+  void SetNumberOfWorkerThreads(vtkm::Id numThreads) { this->NumberOfWorkerThreads = numThreads; }
+
+  VTKM_CONT
+  vtkm::Id GetNumberOfWorkerThreads() const { return this->NumberOfWorkerThreads; }
+
+  /// Returns what each worker thread did during the last execution with
+  /// `UseThreadedAlgorithm` on.
+  ///
+  VTKM_CONT
+  const std::vector<vtkm::filter::particleadvection::AdvectorWorkerStatistics>&
+  GetWorkerStatistics() const
+  {
+    return this->WorkerStatistics;
+  }
+
   template <typename DerivedPolicy>
   VTKM_CONT vtkm::cont::DataSet PrepareForExecution(const vtkm::cont::DataSet& input,
                                                     vtkm::filter::PolicyBase<DerivedPolicy> policy);
@@ -80,6 +134,13 @@ protected:
   vtkm::FloatDefault StepSize;
   vtkm::cont::ArrayHandle<vtkm::Particle> Seeds;
   bool UseThreadedAlgorithm;
+  vtkm::Id NumberOfWorkerThreads = 0;
+  vtkm::filter::particleadvection::IntegrationMethod IntegrationMethod =
+    vtkm::filter::particleadvection::IntegrationMethod::RK4;
+  vtkm::FloatDefault Tolerance = static_cast<vtkm::FloatDefault>(1e-5);
+  vtkm::FloatDefault MinimumStepSize = 0;
+  vtkm::FloatDefault MaximumStepSize = 0;
+  std::vector<vtkm::filter::particleadvection::AdvectorWorkerStatistics> WorkerStatistics;
 
 private:
 };
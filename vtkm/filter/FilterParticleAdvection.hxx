@@ -60,6 +60,8 @@ FilterParticleAdvection<Derived>::CreateDataSetIntegrators(
     if (!ds.HasPointField(activeField))
       throw vtkm::cont::ErrorFilterExecution("Unsupported field assocation");
     dsi.push_back(DSIType(ds, blockId, activeField));
+    dsi.back().SetIntegrationMethod(
+      this->IntegrationMethod, this->Tolerance, this->MinimumStepSize, this->MaximumStepSize);
   }
 
   return dsi;
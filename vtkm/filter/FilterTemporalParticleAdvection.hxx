@@ -59,6 +59,8 @@ FilterTemporalParticleAdvection<Derived>::CreateDataSetIntegrators(
       throw vtkm::cont::ErrorFilterExecution("Unsupported field assocation");
     dsi.push_back(
       DSIType(dsPrev, this->PreviousTime, dsNext, this->NextTime, blockId, activeField));
+    dsi.back().SetIntegrationMethod(
+      this->IntegrationMethod, this->Tolerance, this->MinimumStepSize, this->MaximumStepSize);
   }
 
   return dsi;
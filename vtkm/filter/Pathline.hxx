@@ -43,8 +43,14 @@ inline VTKM_CONT vtkm::cont::PartitionedDataSet Pathline::PrepareForExecution(
   auto dsi = this->CreateDataSetIntegrators(input, boundsMap);
 
   if (this->GetUseThreadedAlgorithm())
-    return vtkm::filter::particleadvection::RunAlgo<DSIType, ThreadedAlgorithmType>(
-      boundsMap, dsi, this->NumberOfSteps, this->StepSize, this->Seeds);
+    return vtkm::filter::particleadvection::RunThreadedAlgo<DSIType, ThreadedAlgorithmType>(
+      boundsMap,
+      dsi,
+      this->NumberOfSteps,
+      this->StepSize,
+      this->Seeds,
+      this->NumberOfWorkerThreads,
+      this->WorkerStatistics);
   else
     return vtkm::filter::particleadvection::RunAlgo<DSIType, AlgorithmType>(
       boundsMap, dsi, this->NumberOfSteps, this->StepSize, this->Seeds);
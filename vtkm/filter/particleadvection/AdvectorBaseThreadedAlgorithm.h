@@ -11,8 +11,17 @@
 #ifndef vtk_m_filter_particleadvection_AdvectorBaseThreadedAlgorithm_h
 #define vtk_m_filter_particleadvection_AdvectorBaseThreadedAlgorithm_h
 
+#include <vtkm/cont/DeviceAdapterList.h>
+#include <vtkm/cont/Logging.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/filter/particleadvection/AdvectorBaseAlgorithm.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 namespace vtkm
@@ -22,6 +31,27 @@ namespace filter
 namespace particleadvection
 {
 
+/// \brief What one worker thread of a threaded advection algorithm did.
+///
+struct AdvectorWorkerStatistics
+{
+  /// Seconds spent advecting particles.
+  vtkm::Float64 BusyTime = 0;
+
+  /// Seconds spent waiting for particles to advect.
+  vtkm::Float64 IdleTime = 0;
+
+  /// The number of batches of particles advected.
+  vtkm::Id NumberOfBatches = 0;
+
+  /// The number of those batches taken from the queue of another worker.
+  vtkm::Id NumberOfStolenBatches = 0;
+
+  /// The number of particles advected. A particle advected in several blocks is counted once
+  /// for each.
+  vtkm::Id NumberOfParticles = 0;
+};
+
 template <typename DataSetIntegratorType, typename ResultType>
 class VTKM_ALWAYS_EXPORT AdvectorBaseThreadedAlgorithm
   : public AdvectorBaseAlgorithm<DataSetIntegratorType, ResultType>
@@ -31,7 +61,8 @@ public:
                                 const std::vector<DataSetIntegratorType>& blocks)
     : AdvectorBaseAlgorithm<DataSetIntegratorType, ResultType>(bm, blocks)
     , Done(false)
-    , WorkerActivate(false)
+    , NumberOfPendingBatches(0)
+    , NumberOfQueuedBatches(0)
   {
     //For threaded algorithm, the particles go out of scope in the Work method.
     //When this happens, they are destructed by the time the Manage thread gets them.
@@ -40,47 +71,204 @@ public:
       block.SetCopySeedFlag(true);
   }
 
+  /// Sets the number of threads advecting particles. A value of 0 (the default) uses one thread
+  /// per core of the host when only the serial device can run. Otherwise each batch already
+  /// runs in parallel on the device, so one worker per local block is used, up to the number
+  /// of cores, and workers that run out of work take batches of the other blocks. The thread
+  /// calling `Go` manages the workers and communicates with other ranks in addition.
+  ///
+  void SetNumberOfWorkers(vtkm::Id numWorkers) { this->NumberOfWorkers = numWorkers; }
+  vtkm::Id GetNumberOfWorkers() const { return this->NumberOfWorkers; }
+
+  /// Returns what each worker did during the last call to `Go`.
+  ///
+  const std::vector<AdvectorWorkerStatistics>& GetWorkerStatistics() const
+  {
+    return this->WorkerStatistics;
+  }
+
   void Go() override
   {
     vtkm::Id nLocal = static_cast<vtkm::Id>(this->Active.size() + this->Inactive.size());
     this->ComputeTotalNumParticles(nLocal);
+    this->TotalNumTerminatedParticles = 0;
+
+    std::size_t numWorkers = static_cast<std::size_t>(this->NumberOfWorkers);
+    if (numWorkers == 0)
+      numWorkers = this->DefaultNumberOfWorkers();
+    numWorkers = std::max(numWorkers, std::size_t(1));
+
+    this->Done = false;
+    this->Queues.clear();
+    for (std::size_t i = 0; i < numWorkers; i++)
+      this->Queues.emplace_back(new WorkerQueue);
+    this->WorkerStatistics.assign(numWorkers, AdvectorWorkerStatistics{});
+
+    //Hand out the seeds before the workers start.
+    this->QueueActiveParticles();
 
     std::vector<std::thread> workerThreads;
-    workerThreads.push_back(std::thread(AdvectorBaseThreadedAlgorithm::Worker, this));
+    for (std::size_t i = 0; i < numWorkers; i++)
+      workerThreads.push_back(std::thread(AdvectorBaseThreadedAlgorithm::Worker, this, i));
     this->Manage();
     for (auto& t : workerThreads)
       t.join();
+
+    for (std::size_t i = 0; i < numWorkers; i++)
+    {
+      const auto& stats = this->WorkerStatistics[i];
+      VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+                 "Advection worker " << i << ": busy " << stats.BusyTime << " s, idle "
+                                     << stats.IdleTime << " s, " << stats.NumberOfBatches
+                                     << " batches (" << stats.NumberOfStolenBatches
+                                     << " stolen), " << stats.NumberOfParticles << " particles");
+    }
   }
 
 protected:
-  bool GetActiveParticles(std::vector<vtkm::Particle>& particles, vtkm::Id& blockId) override
+  std::size_t DefaultNumberOfWorkers() const
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    bool val = this->AdvectorBaseAlgorithm<DataSetIntegratorType, ResultType>::GetActiveParticles(
-      particles, blockId);
-    this->WorkerActivate = val;
-    return val;
+    const std::size_t numCores =
+      std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t(1));
+    auto& tracker = vtkm::cont::GetRuntimeDeviceTracker();
+    if (tracker.CanRunOn(vtkm::cont::DeviceAdapterTagCuda{}) ||
+        tracker.CanRunOn(vtkm::cont::DeviceAdapterTagKokkos{}) ||
+        tracker.CanRunOn(vtkm::cont::DeviceAdapterTagTBB{}) ||
+        tracker.CanRunOn(vtkm::cont::DeviceAdapterTagOpenMP{}))
+      return std::min(this->Blocks.size(), numCores);
+    return numCores;
   }
 
+  //A group of particles in the same block that one worker advects at a time.
+  struct Batch
+  {
+    vtkm::Id BlockId = -1;
+    std::vector<vtkm::Particle> Particles;
+  };
+
+  //Only the manager thread adds batches to a queue. Its worker and idle workers stealing from
+  //it take batches from the head of a linked list with a compare-and-swap, so the workers never
+  //wait for each other. The nodes are only freed with the queue, so a node that a worker still
+  //reads cannot be reused.
+  class WorkerQueue
+  {
+  public:
+    WorkerQueue()
+    {
+      this->Nodes.emplace_back(new Node);
+      this->Tail = this->Nodes.back().get();
+      this->Head = this->Tail;
+    }
+
+    void Push(Batch&& batch)
+    {
+      this->Nodes.emplace_back(new Node);
+      Node* node = this->Nodes.back().get();
+      node->Value = std::move(batch);
+      this->Tail->Next.store(node, std::memory_order_release);
+      this->Tail = node;
+    }
+
+    bool Pop(Batch& batch)
+    {
+      //The head is a node whose batch was already taken.
+      Node* head = this->Head.load(std::memory_order_acquire);
+      Node* next;
+      do
+      {
+        next = head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+          return false;
+      } while (!this->Head.compare_exchange_weak(
+        head, next, std::memory_order_acq_rel, std::memory_order_acquire));
+      batch = std::move(next->Value);
+      return true;
+    }
+
+  private:
+    struct Node
+    {
+      Batch Value;
+      std::atomic<Node*> Next{ nullptr };
+    };
+
+    std::atomic<Node*> Head;
+    Node* Tail;
+    std::vector<std::unique_ptr<Node>> Nodes;
+  };
+
+  //Only the manager thread changes the active particles, so the base class needs no locking.
+  //New active particles are split into batches and queued for the workers right away.
   void UpdateActive(const std::vector<vtkm::Particle>& particles,
                     const std::unordered_map<vtkm::Id, std::vector<vtkm::Id>>& idsMap) override
   {
     if (!particles.empty())
     {
-      std::lock_guard<std::mutex> lock(this->Mutex);
       this->AdvectorBaseAlgorithm<DataSetIntegratorType, ResultType>::UpdateActive(particles,
                                                                                    idsMap);
+      this->QueueActiveParticles();
+    }
+  }
+
+  void QueueActiveParticles()
+  {
+    const std::size_t numWorkers = this->Queues.size();
+    // With several workers, split the particles of a block so that idle workers can steal part
+    // of them.
+    const std::size_t batchesPerBlock = (numWorkers > 1) ? numWorkers * 4 : 1;
+
+    if (this->Active.empty())
+      return;
+
+    std::map<vtkm::Id, std::vector<vtkm::Particle>> blockParticles;
+    for (const auto& p : this->Active)
+      blockParticles[this->ParticleBlockIDsMap[p.ID][0]].push_back(p);
+    this->Active.clear();
+
+    for (const auto& it : blockParticles)
+    {
+      const vtkm::Id blockId = it.first;
+      const std::vector<vtkm::Particle>& particles = it.second;
+      const std::size_t batchSize = std::max(
+        (particles.size() + batchesPerBlock - 1) / batchesPerBlock, std::size_t(MinBatchSize));
+      // Keep the batches of a block on one worker so that it reuses the same data.
+      auto& queue = *this->Queues[static_cast<std::size_t>(blockId) % numWorkers];
+      for (std::size_t start = 0; start < particles.size(); start += batchSize)
+      {
+        Batch batch;
+        batch.BlockId = blockId;
+        auto first = particles.begin() + static_cast<std::ptrdiff_t>(start);
+        auto last = particles.begin() +
+          static_cast<std::ptrdiff_t>(std::min(start + batchSize, particles.size()));
+        batch.Particles.assign(first, last);
+
+        this->NumberOfPendingBatches++;
+        this->NumberOfQueuedBatches++;
+        queue.Push(std::move(batch));
+      }
+    }
 
-      //Let workers know there is new work
-      this->WorkerActivateCondition.notify_all();
-      this->WorkerActivate = true;
+    //Let workers know there is new work. Taking the lock makes sure that a worker checking
+    //for work does not miss the notification.
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
     }
+    this->WorkerActivateCondition.notify_all();
   }
 
-  bool CheckDone()
+  bool PopBatch(std::size_t workerIdx, Batch& batch, bool& stolen)
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
-    return this->Done;
+    const std::size_t numWorkers = this->Queues.size();
+    for (std::size_t i = 0; i < numWorkers; i++)
+    {
+      if (this->Queues[(workerIdx + i) % numWorkers]->Pop(batch))
+      {
+        this->NumberOfQueuedBatches--;
+        stolen = (i != 0);
+        return true;
+      }
+    }
+    return false;
   }
 
   void SetDone()
@@ -90,29 +278,47 @@ protected:
     this->WorkerActivateCondition.notify_all();
   }
 
-  static void Worker(AdvectorBaseThreadedAlgorithm* algo) { algo->Work(); }
+  static void Worker(AdvectorBaseThreadedAlgorithm* algo, std::size_t workerIdx)
+  {
+    algo->Work(workerIdx);
+  }
 
   void WorkerWait()
   {
     std::unique_lock<std::mutex> lock(this->Mutex);
-    this->WorkerActivateCondition.wait(lock, [this] { return WorkerActivate || Done; });
+    this->WorkerActivateCondition.wait(
+      lock, [this] { return this->NumberOfQueuedBatches > 0 || this->Done; });
   }
 
-  void Work()
+  void Work(std::size_t workerIdx)
   {
-    while (!this->CheckDone())
+    using Clock = std::chrono::steady_clock;
+    AdvectorWorkerStatistics& stats = this->WorkerStatistics[workerIdx];
+
+    while (!this->Done)
     {
-      std::vector<vtkm::Particle> v;
-      vtkm::Id blockId = -1;
-      if (this->GetActiveParticles(v, blockId))
+      Batch batch;
+      bool stolen = false;
+      if (this->PopBatch(workerIdx, batch, stolen))
       {
-        const auto& block = this->GetDataSet(blockId);
+        auto start = Clock::now();
+        const auto& block = this->GetDataSet(batch.BlockId);
         ResultType r;
-        block.Advect(v, this->StepSize, this->NumberOfSteps, r);
-        this->UpdateWorkerResult(blockId, r);
+        block.Advect(batch.Particles, this->StepSize, this->NumberOfSteps, r);
+        this->UpdateWorkerResult(batch.BlockId, r);
+
+        stats.BusyTime += std::chrono::duration<vtkm::Float64>(Clock::now() - start).count();
+        stats.NumberOfBatches++;
+        stats.NumberOfParticles += static_cast<vtkm::Id>(batch.Particles.size());
+        if (stolen)
+          stats.NumberOfStolenBatches++;
       }
       else
+      {
+        auto start = Clock::now();
         this->WorkerWait();
+        stats.IdleTime += std::chrono::duration<vtkm::Float64>(Clock::now() - start).count();
+      }
     }
   }
 
@@ -148,40 +354,82 @@ protected:
 
   bool GetBlockAndWait(const vtkm::Id& numLocalTerm) override
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::lock_guard<std::mutex> lock(this->ResultsMutex);
 
     return (this->AdvectorBaseAlgorithm<DataSetIntegratorType, ResultType>::GetBlockAndWait(
               numLocalTerm) &&
-            !this->WorkerActivate && this->WorkerResults.empty());
+            this->NumberOfPendingBatches == 0 && this->WorkerResults.empty());
   }
 
   void GetWorkerResults(std::unordered_map<vtkm::Id, std::vector<ResultType>>& results)
   {
     results.clear();
 
-    std::lock_guard<std::mutex> lock(this->Mutex);
+    std::unique_lock<std::mutex> lock(this->ResultsMutex);
+    //With a single rank there are no messages to check for, so wait for the workers instead
+    //of polling.
+    if (this->NumRanks == 1)
+      this->ResultsCondition.wait(lock, [this] {
+        return !this->WorkerResults.empty() || this->NumberOfPendingBatches == 0;
+      });
+
     if (!this->WorkerResults.empty())
     {
-      results = this->WorkerResults;
+      results = std::move(this->WorkerResults);
       this->WorkerResults.clear();
     }
   }
 
   void UpdateWorkerResult(vtkm::Id blockId, const ResultType& result)
   {
-    std::lock_guard<std::mutex> lock(this->Mutex);
+    {
+      std::lock_guard<std::mutex> lock(this->ResultsMutex);
 
-    auto& it = this->WorkerResults[blockId];
-    it.push_back(result);
+      auto& it = this->WorkerResults[blockId];
+      it.push_back(result);
+      this->NumberOfPendingBatches--;
+    }
+    this->ResultsCondition.notify_one();
   }
 
+  // Batches smaller than this are not split further.
+  static constexpr std::size_t MinBatchSize = 64;
+
   std::atomic<bool> Done;
   std::mutex Mutex;
-  bool WorkerActivate;
+  vtkm::Id NumberOfWorkers = 0;
+  //Batches queued or being advected, and batches waiting in a queue.
+  std::atomic<vtkm::Id> NumberOfPendingBatches;
+  std::atomic<vtkm::Id> NumberOfQueuedBatches;
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+  std::condition_variable ResultsCondition;
+  std::mutex ResultsMutex;
   std::condition_variable WorkerActivateCondition;
   std::unordered_map<vtkm::Id, std::vector<ResultType>> WorkerResults;
+  std::vector<AdvectorWorkerStatistics> WorkerStatistics;
 };
 
+template <typename DataSetIntegratorType, typename AlgorithmType>
+vtkm::cont::PartitionedDataSet RunThreadedAlgo(
+  const vtkm::filter::particleadvection::BoundsMap& boundsMap,
+  const std::vector<DataSetIntegratorType>& dsi,
+  vtkm::Id numSteps,
+  vtkm::FloatDefault stepSize,
+  const vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
+  vtkm::Id numWorkers,
+  std::vector<AdvectorWorkerStatistics>& workerStatistics)
+{
+  AlgorithmType algo(boundsMap, dsi);
+
+  algo.SetNumberOfSteps(numSteps);
+  algo.SetStepSize(stepSize);
+  algo.SetSeeds(seeds);
+  algo.SetNumberOfWorkers(numWorkers);
+  algo.Go();
+  workerStatistics = algo.GetWorkerStatistics();
+  return algo.GetOutput();
+}
+
 }
 }
 } // namespace vtkm::filter::particleadvection
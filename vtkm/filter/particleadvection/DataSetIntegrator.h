@@ -14,6 +14,7 @@
 #include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/worklet/ParticleAdvection.h>
+#include <vtkm/worklet/particleadvection/RK45Integrator.h>
 #include <vtkm/worklet/particleadvection/RK4Integrator.h>
 #include <vtkm/worklet/particleadvection/Stepper.h>
 #include <vtkm/worklet/particleadvection/TemporalGridEvaluators.h>
@@ -28,6 +29,15 @@ namespace filter
 namespace particleadvection
 {
 
+/// The integrator that advects particles through a block.
+enum class IntegrationMethod
+{
+  /// Fourth order Runge-Kutta with a fixed step size.
+  RK4,
+  /// Dormand-Prince 5(4), which splits each step into substeps of adaptive length.
+  RK45
+};
+
 template <typename GridEvalType>
 class VTKM_ALWAYS_EXPORT DataSetIntegratorBase
 {
@@ -44,6 +54,19 @@ public:
   vtkm::Id GetID() const { return this->ID; }
   void SetCopySeedFlag(bool val) { this->CopySeedArray = val; }
 
+  /// Selects the integrator. The tolerance and step size limits are only used by
+  /// `IntegrationMethod::RK45`, see `vtkm::worklet::particleadvection::RK45Integrator`.
+  void SetIntegrationMethod(IntegrationMethod method,
+                            vtkm::FloatDefault tolerance,
+                            vtkm::FloatDefault minimumStepSize,
+                            vtkm::FloatDefault maximumStepSize)
+  {
+    this->Method = method;
+    this->Tolerance = tolerance;
+    this->MinimumStepSize = minimumStepSize;
+    this->MaximumStepSize = maximumStepSize;
+  }
+
   template <typename ResultType>
   void Advect(std::vector<vtkm::Particle>& v,
               vtkm::FloatDefault stepSize,
@@ -52,20 +75,37 @@ public:
   {
     auto copyFlag = (this->CopySeedArray ? vtkm::CopyFlag::On : vtkm::CopyFlag::Off);
     auto seedArray = vtkm::cont::make_ArrayHandle(v, copyFlag);
-    Stepper rk4(*this->Eval, stepSize);
-    this->DoAdvect(seedArray, rk4, maxSteps, result);
+    if (this->Method == IntegrationMethod::RK45)
+    {
+      RK45Type rk45(*this->Eval, this->Tolerance, this->MinimumStepSize, this->MaximumStepSize);
+      RK45Stepper stepper(rk45, *this->Eval, stepSize);
+      this->DoAdvect(seedArray, stepper, maxSteps, result);
+    }
+    else
+    {
+      Stepper rk4(*this->Eval, stepSize);
+      this->DoAdvect(seedArray, rk4, maxSteps, result);
+    }
   }
 
 protected:
   using RK4Type = vtkm::worklet::particleadvection::RK4Integrator<GridEvalType>;
   using Stepper = vtkm::worklet::particleadvection::Stepper<RK4Type, GridEvalType>;
+  using RK45Type = vtkm::worklet::particleadvection::RK45Integrator<GridEvalType>;
+  using RK45Stepper = vtkm::worklet::particleadvection::Stepper<RK45Type, GridEvalType>;
   using FieldHandleType = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
 
-  template <typename ResultType>
+  template <typename StepperType>
+  inline void DoAdvect(vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
+                       const StepperType& stepper,
+                       vtkm::Id maxSteps,
+                       vtkm::worklet::ParticleAdvectionResult<vtkm::Particle>& result) const;
+
+  template <typename StepperType>
   inline void DoAdvect(vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
-                       const Stepper& rk4,
+                       const StepperType& stepper,
                        vtkm::Id maxSteps,
-                       ResultType& result) const;
+                       vtkm::worklet::StreamlineResult<vtkm::Particle>& result) const;
 
   FieldHandleType GetFieldHandle(const vtkm::cont::DataSet& ds, const std::string& fieldNm)
   {
@@ -86,6 +126,10 @@ protected:
   bool CopySeedArray;
   std::shared_ptr<GridEvalType> Eval;
   vtkm::Id ID;
+  IntegrationMethod Method = IntegrationMethod::RK4;
+  vtkm::FloatDefault Tolerance = 0;
+  vtkm::FloatDefault MinimumStepSize = 0;
+  vtkm::FloatDefault MaximumStepSize = 0;
 };
 
 class VTKM_ALWAYS_EXPORT DataSetIntegrator
@@ -18,23 +18,13 @@ namespace filter
 namespace particleadvection
 {
 
-using GridEvalType = vtkm::worklet::particleadvection::GridEvaluator<
-  vtkm::worklet::particleadvection::VelocityField<vtkm::cont::ArrayHandle<vtkm::Vec3f>>>;
-using TemporalGridEvalType = vtkm::worklet::particleadvection::TemporalGridEvaluator<
-  vtkm::worklet::particleadvection::VelocityField<vtkm::cont::ArrayHandle<vtkm::Vec3f>>>;
-using RK4Type = vtkm::worklet::particleadvection::RK4Integrator<GridEvalType>;
-using Stepper = vtkm::worklet::particleadvection::Stepper<RK4Type, GridEvalType>;
-using TemporalRK4Type = vtkm::worklet::particleadvection::RK4Integrator<TemporalGridEvalType>;
-using TemporalStepper =
-  vtkm::worklet::particleadvection::Stepper<TemporalRK4Type, TemporalGridEvalType>;
-
 //-----
-// Specialization for ParticleAdvection worklet
-template <>
-template <>
+// Advection with the ParticleAdvection worklet
+template <typename GridEvalType>
+template <typename StepperType>
 inline void DataSetIntegratorBase<GridEvalType>::DoAdvect(
   vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
-  const Stepper& stepper,
+  const StepperType& stepper,
   vtkm::Id maxSteps,
   vtkm::worklet::ParticleAdvectionResult<vtkm::Particle>& result) const
 {
@@ -43,40 +33,12 @@ inline void DataSetIntegratorBase<GridEvalType>::DoAdvect(
 }
 
 //-----
-// Specialization for Streamline worklet
-template <>
-template <>
+// Advection with the Streamline worklet
+template <typename GridEvalType>
+template <typename StepperType>
 inline void DataSetIntegratorBase<GridEvalType>::DoAdvect(
   vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
-  const Stepper& stepper,
-  vtkm::Id maxSteps,
-  vtkm::worklet::StreamlineResult<vtkm::Particle>& result) const
-{
-  vtkm::worklet::Streamline Worklet;
-  result = Worklet.Run(stepper, seeds, maxSteps);
-}
-
-//-----
-// Specialization for PathParticle worklet
-template <>
-template <>
-inline void DataSetIntegratorBase<TemporalGridEvalType>::DoAdvect(
-  vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
-  const TemporalStepper& stepper,
-  vtkm::Id maxSteps,
-  vtkm::worklet::ParticleAdvectionResult<vtkm::Particle>& result) const
-{
-  vtkm::worklet::ParticleAdvection Worklet;
-  result = Worklet.Run(stepper, seeds, maxSteps);
-}
-
-//-----
-// Specialization for Pathline worklet
-template <>
-template <>
-inline void DataSetIntegratorBase<TemporalGridEvalType>::DoAdvect(
-  vtkm::cont::ArrayHandle<vtkm::Particle>& seeds,
-  const TemporalStepper& stepper,
+  const StepperType& stepper,
   vtkm::Id maxSteps,
   vtkm::worklet::StreamlineResult<vtkm::Particle>& result) const
 {
@@ -261,6 +261,56 @@ void Messenger::SendData(int dst, int tag, const vtkmdiy::MemoryBuffer& buff)
     RequestTagPair entry(req, tag);
     this->SendBuffers[entry] = b;
   }
+
+  this->NumberOfMessagesSent++;
+  this->NumberOfBytesSent += buff.size();
+}
+
+char* Messenger::NewSendPacket(int tag, std::size_t dataSz, char*& data)
+{
+  auto it = this->MessageTagInfo.find(tag);
+  if (it == this->MessageTagInfo.end())
+  {
+    std::stringstream msg;
+    msg << "Message tag not found: " << tag << std::endl;
+    throw vtkm::cont::ErrorFilterExecution(msg.str());
+  }
+  if (dataSz > it->second.second)
+    return nullptr;
+
+  Messenger::Header header;
+  header.tag = tag;
+  header.rank = this->Rank;
+  header.id = this->GetMsgID();
+  header.numPackets = 1;
+  header.packet = 0;
+  header.dataSz = dataSz;
+  header.packetSz = dataSz + sizeof(header);
+
+  char* packet = new char[header.packetSz];
+  memcpy(packet, &header, sizeof(header));
+  data = packet + sizeof(header);
+  return packet;
+}
+
+void Messenger::SendPacket(int dst, int tag, char* packet)
+{
+  Messenger::Header header;
+  memcpy(&header, packet, sizeof(header));
+
+  MPI_Request req;
+  int err = MPI_Isend(packet, header.packetSz, MPI_BYTE, dst, tag, this->MPIComm, &req);
+  if (err != MPI_SUCCESS)
+  {
+    delete[] packet;
+    throw vtkm::cont::ErrorFilterExecution("Error in MPI_Isend inside Messenger::SendPacket");
+  }
+
+  RequestTagPair entry(req, tag);
+  this->SendBuffers[entry] = packet;
+
+  this->NumberOfMessagesSent++;
+  this->NumberOfBytesSent += header.dataSz;
 }
 
 bool Messenger::RecvData(int tag, std::vector<vtkmdiy::MemoryBuffer>& buffers, bool blockAndWait)
@@ -329,6 +379,8 @@ void Messenger::ProcessReceivedBuffers(std::vector<char*>& incomingBuffers,
       entry.first = header.tag;
       entry.second.save_binary((char*)(buff + sizeof(header)), header.dataSz);
       entry.second.reset();
+      this->NumberOfMessagesReceived++;
+      this->NumberOfBytesReceived += header.dataSz;
       buffers.push_back(std::move(entry));
 
       delete[] buff;
@@ -370,6 +422,8 @@ void Messenger::ProcessReceivedBuffers(std::vector<char*>& incomingBuffers,
           }
 
           entry.second.reset();
+          this->NumberOfMessagesReceived++;
+          this->NumberOfBytesReceived += entry.second.size();
           buffers.push_back(std::move(entry));
           this->RecvPackets.erase(i2);
         }
@@ -47,6 +47,13 @@ public:
   int GetRank() const { return this->Rank; }
   int GetNumRanks() const { return this->NumRanks; }
 
+  /// Counts of the messages and payload bytes sent and received since construction. Messages
+  /// split into several packets count once.
+  std::size_t GetNumberOfMessagesSent() const { return this->NumberOfMessagesSent; }
+  std::size_t GetNumberOfBytesSent() const { return this->NumberOfBytesSent; }
+  std::size_t GetNumberOfMessagesReceived() const { return this->NumberOfMessagesReceived; }
+  std::size_t GetNumberOfBytesReceived() const { return this->NumberOfBytesReceived; }
+
 #ifdef VTKM_ENABLE_MPI
   VTKM_CONT void RegisterTag(int tag, std::size_t numRecvs, std::size_t size);
 
@@ -57,6 +64,13 @@ protected:
   void CheckPendingSendRequests();
   void CleanupRequests(int tag = TAG_ANY);
   void SendData(int dst, int tag, const vtkmdiy::MemoryBuffer& buff);
+
+  // Allocates a send buffer for a message of `dataSz` bytes that fits in a single packet of
+  // `tag`, so the message can be written in place instead of through a MemoryBuffer. `data`
+  // is set to where the message starts. Returns nullptr if the message needs several packets.
+  char* NewSendPacket(int tag, std::size_t dataSz, char*& data);
+  // Sends a buffer from NewSendPacket and takes ownership of it.
+  void SendPacket(int dst, int tag, char* packet);
   bool RecvData(const std::set<int>& tags,
                 std::vector<std::pair<int, vtkmdiy::MemoryBuffer>>& buffers,
                 bool blockAndWait = false);
@@ -105,6 +119,11 @@ protected:
   static constexpr int NumRanks = 1;
   static constexpr int Rank = 0;
 #endif
+
+  std::size_t NumberOfMessagesSent = 0;
+  std::size_t NumberOfBytesSent = 0;
+  std::size_t NumberOfMessagesReceived = 0;
+  std::size_t NumberOfBytesReceived = 0;
 };
 }
 }
@@ -29,6 +29,7 @@ ParticleMessenger::ParticleMessenger(vtkmdiy::mpi::communicator& comm,
                                      int numParticles,
                                      int numBlockIds)
   : Messenger(comm)
+  , FlushThreshold(numParticles)
 #ifdef VTKM_ENABLE_MPI
   , BoundsMap(boundsMap)
 #endif
@@ -112,20 +113,25 @@ void ParticleMessenger::Exchange(
 
 #ifdef VTKM_ENABLE_MPI
 
-  //dstRank, vector of (particles,blockIDs)
-  std::unordered_map<int, std::vector<ParticleCommType>> sendData;
-
+  auto now = std::chrono::steady_clock::now();
   for (const auto& p : outData)
   {
     const auto& bids = outBlockIDsMap.find(p.ID)->second;
     int dstRank = this->BoundsMap.FindRank(bids[0]);
-    sendData[dstRank].push_back(std::make_pair(p, bids));
+    auto& pending = this->PendingSends[dstRank];
+    if (pending.Particles.empty())
+      pending.FirstQueued = now;
+    pending.Particles.push_back(std::make_pair(p, bids));
   }
 
-  //Do all the sends first.
+  //Do all the sends first. Termination counts are never held back since other ranks
+  //may be waiting on them to finish.
   if (numLocalTerm > 0)
     this->SendAllMsg({ MSG_TERMINATE, static_cast<int>(numLocalTerm) });
-  this->SendParticles(sendData);
+
+  //Nothing may be left waiting if we are going to block, or the destination could
+  //be waiting on us.
+  this->FlushParticles(blockAndWait);
   this->CheckPendingSendRequests();
 
   //Check if we have anything coming in.
@@ -151,8 +157,37 @@ void ParticleMessenger::Exchange(
 #endif
 }
 
+VTKM_CONT
+void ParticleMessenger::Flush()
+{
+#ifdef VTKM_ENABLE_MPI
+  this->FlushParticles(true);
+#endif
+}
+
 #ifdef VTKM_ENABLE_MPI
 
+VTKM_CONT
+void ParticleMessenger::FlushParticles(bool flushAll)
+{
+  auto now = std::chrono::steady_clock::now();
+  for (auto& it : this->PendingSends)
+  {
+    auto& pending = it.second;
+    if (pending.Particles.empty())
+      continue;
+
+    vtkm::Float64 waited =
+      std::chrono::duration<vtkm::Float64>(now - pending.FirstQueued).count();
+    if (flushAll || static_cast<vtkm::Id>(pending.Particles.size()) >= this->FlushThreshold ||
+        waited >= this->FlushTimeout)
+    {
+      this->SendParticles(it.first, pending.Particles);
+      pending.Particles.clear();
+    }
+  }
+}
+
 VTKM_CONT
 void ParticleMessenger::RegisterMessages(int msgSz, int nParticles, int numBlockIds)
 {
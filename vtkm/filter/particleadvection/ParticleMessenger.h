@@ -18,9 +18,12 @@
 #include <vtkm/filter/particleadvection/BoundsMap.h>
 #include <vtkm/filter/particleadvection/Messenger.h>
 
+#include <chrono>
+#include <cstring>
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 namespace vtkm
@@ -57,7 +60,26 @@ public:
                           vtkm::Id& numTerminateMessages,
                           bool blockAndWait = false);
 
+  /// Particles that `Exchange` sends to another rank are collected per destination rank and
+  /// sent as one message once this many are waiting. The default is the `numParticles` given to
+  /// the constructor, which is the largest message that fits in one receive buffer. A
+  /// threshold of 1 sends particles as soon as they leave this rank.
+  VTKM_CONT void SetFlushThreshold(vtkm::Id numParticles) { this->FlushThreshold = numParticles; }
+  VTKM_CONT vtkm::Id GetFlushThreshold() const { return this->FlushThreshold; }
+
+  /// The longest time, in seconds, that particles wait to be aggregated before `Exchange`
+  /// sends them regardless of the threshold. Everything waiting is also sent before `Exchange`
+  /// blocks for incoming data.
+  VTKM_CONT void SetFlushTimeout(vtkm::Float64 seconds) { this->FlushTimeout = seconds; }
+  VTKM_CONT vtkm::Float64 GetFlushTimeout() const { return this->FlushTimeout; }
+
+  /// Sends all particles waiting to be aggregated.
+  VTKM_CONT void Flush();
+
 protected:
+  vtkm::Id FlushThreshold;
+  vtkm::Float64 FlushTimeout = 0.01;
+
 #ifdef VTKM_ENABLE_MPI
   static constexpr int MSG_TERMINATE = 1;
 
@@ -69,6 +91,17 @@ protected:
 
   VTKM_CONT void RegisterMessages(int msgSz, int nParticles, int numBlockIds);
 
+  // Particles waiting to be sent to one rank.
+  struct PendingParticles
+  {
+    std::vector<ParticleCommType> Particles;
+    std::chrono::steady_clock::time_point FirstQueued;
+  };
+
+  // Sends the particles of every rank that has reached the threshold or timeout, or all of
+  // them if `flushAll` is set.
+  VTKM_CONT void FlushParticles(bool flushAll);
+
   // Send/Recv particles
   VTKM_CONT
   template <typename P,
@@ -94,6 +127,7 @@ protected:
                          std::vector<ParticleRecvCommType>* recvParticles,
                          bool blockAndWait);
   const vtkm::filter::particleadvection::BoundsMap& BoundsMap;
+  std::unordered_map<int, PendingParticles> PendingSends;
 
 #endif
 
@@ -106,8 +140,58 @@ protected:
     bool blockAndWait) const;
 
   static std::size_t CalcParticleBufferSize(std::size_t nParticles, std::size_t numBlockIds = 2);
+
+  // Particles are written straight into the send buffer in the same format as
+  // `vtkmdiy::save(rank)` followed by `vtkmdiy::save(particles)`, so they can be read with
+  // `vtkmdiy::load` but are not first serialized into a `vtkmdiy::MemoryBuffer` value by value.
+  template <typename Container>
+  static std::size_t CalcPackedParticlesSize(const Container& c);
+  template <typename Container>
+  static void PackParticles(char* data, int rank, const Container& c);
+
+private:
+  template <typename T>
+  static char* PackValue(char* data, const T& value)
+  {
+    std::memcpy(data, &value, sizeof(T));
+    return data + sizeof(T);
+  }
 };
 
+template <typename Container>
+inline std::size_t ParticleMessenger::CalcPackedParticlesSize(const Container& c)
+{
+  std::size_t numBlockIds = 0;
+  for (const auto& pc : c)
+    numBlockIds += pc.second.size();
+
+  return CalcParticleBufferSize(c.size(), 0) + numBlockIds * sizeof(vtkm::Id);
+}
+
+template <typename Container>
+inline void ParticleMessenger::PackParticles(char* data, int rank, const Container& c)
+{
+  data = PackValue(data, rank);
+  data = PackValue(data, static_cast<std::size_t>(c.size()));
+  for (const auto& pc : c)
+  {
+    const vtkm::Particle& p = pc.first;
+    data = PackValue(data, p.Pos);
+    data = PackValue(data, p.ID);
+    data = PackValue(data, p.NumSteps);
+    data = PackValue(data, p.Status);
+    data = PackValue(data, p.Time);
+
+    const auto& blockIds = pc.second;
+    data = PackValue(data, static_cast<std::size_t>(blockIds.size()));
+    if (!blockIds.empty())
+    {
+      std::memcpy(data, blockIds.data(), blockIds.size() * sizeof(vtkm::Id));
+      data += blockIds.size() * sizeof(vtkm::Id);
+    }
+  }
+}
+
 
 #ifdef VTKM_ENABLE_MPI
 VTKM_CONT
@@ -122,10 +206,22 @@ inline void ParticleMessenger::SendParticles(int dst, const Container<P, Allocat
   if (c.empty())
     return;
 
-  vtkmdiy::MemoryBuffer bb;
-  vtkmdiy::save(bb, this->GetRank());
-  vtkmdiy::save(bb, c);
-  this->SendData(dst, ParticleMessenger::PARTICLE_TAG, bb);
+  std::size_t size = CalcPackedParticlesSize(c);
+  char* data = nullptr;
+  char* packet = this->NewSendPacket(ParticleMessenger::PARTICLE_TAG, size, data);
+  if (packet != nullptr)
+  {
+    PackParticles(data, this->GetRank(), c);
+    this->SendPacket(dst, ParticleMessenger::PARTICLE_TAG, packet);
+  }
+  else
+  {
+    //Too large for one packet, let SendData split it.
+    vtkmdiy::MemoryBuffer bb;
+    bb.buffer.resize(size);
+    PackParticles(bb.buffer.data(), this->GetRank(), c);
+    this->SendData(dst, ParticleMessenger::PARTICLE_TAG, bb);
+  }
 }
 
 VTKM_CONT
@@ -8,12 +8,15 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/Serialization.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/particleadvection/ParticleMessenger.h>
 
 #include <vtkm/thirdparty/diy/diy.h>
 
+#include <chrono>
+#include <cstring>
 #include <random>
 
 namespace
@@ -45,6 +48,16 @@ public:
     mBuffSize = this->CalcMessageBufferSize(msgSz);
   }
 
+  std::size_t GetPackedSize(const std::vector<PCommType>& data)
+  {
+    return this->CalcPackedParticlesSize(data);
+  }
+
+  void Pack(char* buffer, int rank, const std::vector<PCommType>& data)
+  {
+    this->PackParticles(buffer, rank, data);
+  }
+
   void SendP(int dst,
              const std::vector<vtkm::Particle>& p,
              const std::vector<std::vector<vtkm::Id>>& bids)
@@ -280,13 +293,112 @@ void TestBufferSizes()
         vtkmdiy::save(mbP, rank);
         vtkmdiy::save(mbP, particleData);
         VTKM_TEST_ASSERT(mbP.size() == pSize, "Particle buffer sizes not equal");
+
+        //Make sure packed particles are what vtkmdiy::load expects.
+        VTKM_TEST_ASSERT(messenger.GetPackedSize(particleData) == pSize,
+                         "Packed particle size not equal");
+        std::vector<char> packed(pSize);
+        messenger.Pack(packed.data(), rank, particleData);
+        VTKM_TEST_ASSERT(std::memcmp(packed.data(), mbP.buffer.data(), pSize) == 0,
+                         "Packed particles differ from serialized particles");
       }
 }
 
+// Each rank sends particles to the next rank through Exchange, a few at a time as if they
+// were leaving a block during advection, and reports the message and byte rates.
+std::size_t TestAggregatedExchange(vtkm::Id flushThreshold, vtkm::Float64 flushTimeout)
+{
+  //Use a separate communicator so messages left over from other tests are not received.
+  vtkmdiy::mpi::communicator comm;
+  comm.duplicate(vtkm::cont::EnvironmentTracker::GetCommunicator());
+
+  //One block per rank, so block i is on rank i.
+  auto dataSet = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(2, 2, 2));
+  vtkm::filter::particleadvection::BoundsMap boundsMap(dataSet);
+
+  constexpr vtkm::Id numParticles = 4096;
+  constexpr vtkm::Id particlesPerRound = 4;
+
+  vtkm::filter::particleadvection::ParticleMessenger messenger(comm, boundsMap, 1, 128);
+  messenger.SetFlushThreshold(flushThreshold);
+  messenger.SetFlushTimeout(flushTimeout);
+
+  vtkm::Id dstBlock = static_cast<vtkm::Id>((comm.rank() + 1) % comm.size());
+  vtkm::Id srcBlock = static_cast<vtkm::Id>((comm.rank() + comm.size() - 1) % comm.size());
+
+  comm.barrier();
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<vtkm::Particle> inData;
+  std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> inBlockIDs;
+  vtkm::Id numTermMessages = 0;
+  vtkm::Id numReceived = 0;
+  auto checkReceived = [&]() {
+    for (const auto& p : inData)
+    {
+      VTKM_TEST_ASSERT(p.ID / numParticles == srcBlock, "Particle received from wrong rank");
+      VTKM_TEST_ASSERT(inBlockIDs[p.ID].size() == 1 && inBlockIDs[p.ID][0] == comm.rank(),
+                       "Wrong block ids received");
+    }
+    numReceived += static_cast<vtkm::Id>(inData.size());
+    inData.clear();
+  };
+
+  for (vtkm::Id i = 0; i < numParticles; i += particlesPerRound)
+  {
+    std::vector<vtkm::Particle> outData;
+    std::unordered_map<vtkm::Id, std::vector<vtkm::Id>> outBlockIDs;
+    for (vtkm::Id j = i; j < i + particlesPerRound; j++)
+    {
+      vtkm::Particle p(vtkm::Vec3f(0.5f), comm.rank() * numParticles + j);
+      outData.push_back(p);
+      outBlockIDs[p.ID] = { dstBlock };
+    }
+
+    messenger.Exchange(outData, outBlockIDs, 0, inData, inBlockIDs, numTermMessages);
+    checkReceived();
+  }
+  messenger.Flush();
+
+  while (numReceived < numParticles)
+  {
+    messenger.Exchange({}, {}, 0, inData, inBlockIDs, numTermMessages, true);
+    checkReceived();
+  }
+  VTKM_TEST_ASSERT(numReceived == numParticles, "Wrong number of particles received");
+
+  comm.barrier();
+  vtkm::Float64 seconds =
+    std::chrono::duration<vtkm::Float64>(std::chrono::steady_clock::now() - start).count();
+
+  std::size_t numMessages = messenger.GetNumberOfMessagesSent();
+  std::size_t numBytes = messenger.GetNumberOfBytesSent();
+  if (comm.rank() == 0)
+  {
+    std::cout << "Flush threshold " << flushThreshold << ": " << numMessages << " messages, "
+              << static_cast<vtkm::Float64>(numMessages) / seconds << " messages/sec, "
+              << static_cast<vtkm::Float64>(numBytes) / seconds << " bytes/sec" << std::endl;
+  }
+
+  return numMessages;
+}
+
+void TestAggregation()
+{
+  auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  if (comm.size() == 1)
+    return;
+
+  std::size_t numUnaggregated = TestAggregatedExchange(1, 0);
+  std::size_t numAggregated = TestAggregatedExchange(128, 1.0);
+  VTKM_TEST_ASSERT(numAggregated < numUnaggregated, "Aggregation did not reduce messages");
+}
+
 void TestParticleMessengerMPI()
 {
   TestBufferSizes();
   TestParticleMessenger();
+  TestAggregation();
 }
 }
 
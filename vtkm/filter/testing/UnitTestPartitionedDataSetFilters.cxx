@@ -21,6 +21,7 @@
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/CellAverage.h>
+#include <vtkm/filter/PointAverage.h>
 
 
 template <typename T>
@@ -115,6 +116,25 @@ void TestPartitionedDataSetFilters()
   cellAverage.SetActiveField("pointvar");
   result = cellAverage.Execute(partitions);
   Result_Verify<vtkm::FloatDefault>(result, cellAverage, partitions, std::string("pointvar"));
+
+  std::cout << "Test running partitions concurrently" << std::endl;
+  partitions = PartitionedDataSetBuilder<vtkm::FloatDefault>(partitionNum, "cellvar");
+  vtkm::filter::PointAverage pointAverage;
+  pointAverage.SetOutputFieldName("average");
+  pointAverage.SetActiveField("cellvar");
+  pointAverage.SetRunMultiThreadedFilter(true);
+  for (vtkm::Id numThreads : { 0, 1, 3 })
+  {
+    pointAverage.SetNumberOfConcurrentPartitions(numThreads);
+    result = pointAverage.Execute(partitions);
+    Result_Verify<vtkm::FloatDefault>(result, pointAverage, partitions, std::string("cellvar"));
+    for (vtkm::Id j = 0; j < result.GetNumberOfPartitions(); j++)
+    {
+      VTKM_TEST_ASSERT(result.GetPartition(j).GetNumberOfPoints() ==
+                         partitions.GetPartition(j).GetNumberOfPoints(),
+                       "result partitions out of order");
+    }
+  }
 }
 
 int UnitTestPartitionedDataSetFilters(int argc, char* argv[])
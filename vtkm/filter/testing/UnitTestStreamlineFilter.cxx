@@ -322,7 +322,7 @@ void TestAMRStreamline(bool useSL)
   }
 }
 
-void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
+void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType, bool useThreaded)
 {
   vtkm::Id numDims = 5;
   vtkm::FloatDefault x0 = 0;
@@ -378,6 +378,8 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         streamline.SetStepSize(0.1f);
         streamline.SetNumberOfSteps(100000);
         streamline.SetSeeds(seedArray);
+        streamline.SetUseThreadedAlgorithm(useThreaded);
+        streamline.SetNumberOfWorkerThreads(2);
 
         streamline.SetActiveField(fieldName);
         out = streamline.Execute(pds);
@@ -394,6 +396,8 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         pathline.SetStepSize(0.1f);
         pathline.SetNumberOfSteps(100000);
         pathline.SetSeeds(seedArray);
+        pathline.SetUseThreadedAlgorithm(useThreaded);
+        pathline.SetNumberOfWorkerThreads(2);
 
         pathline.SetActiveField(fieldName);
         out = pathline.Execute(pds);
@@ -443,6 +447,8 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         particleAdvection.SetStepSize(0.1f);
         particleAdvection.SetNumberOfSteps(100000);
         particleAdvection.SetSeeds(seedArray);
+        particleAdvection.SetUseThreadedAlgorithm(useThreaded);
+        particleAdvection.SetNumberOfWorkerThreads(2);
 
         particleAdvection.SetActiveField(fieldName);
         out = particleAdvection.Execute(pds);
@@ -459,6 +465,8 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
         pathParticle.SetStepSize(0.1f);
         pathParticle.SetNumberOfSteps(100000);
         pathParticle.SetSeeds(seedArray);
+        pathParticle.SetUseThreadedAlgorithm(useThreaded);
+        pathParticle.SetNumberOfWorkerThreads(2);
 
         pathParticle.SetActiveField(fieldName);
         out = pathParticle.Execute(pds);
@@ -487,6 +495,72 @@ void TestPartitionedDataSet(vtkm::Id num, bool useGhost, FilterType fType)
   }
 }
 
+// Seeds the first block with many particles so that the workers have to take batches from
+// each other. With a single block, the workers advect batches of the same block at once.
+// A worker count of 0 uses the default.
+void TestThreadedWorkers(vtkm::Id numBlocks, vtkm::Id numWorkers)
+{
+  const vtkm::Id numSeeds = 1000;
+
+  std::vector<vtkm::Bounds> bounds;
+  for (vtkm::Id i = 0; i < numBlocks; i++)
+  {
+    vtkm::Float64 x0 = static_cast<vtkm::Float64>(i * 4);
+    bounds.push_back(vtkm::Bounds(x0, x0 + 4, 0, 4, 0, 4));
+  }
+  auto allPDs = vtkm::worklet::testing::CreateAllDataSets(bounds, vtkm::Id3(5, 5, 5), false);
+
+  std::vector<vtkm::Particle> seeds;
+  for (vtkm::Id i = 0; i < numSeeds; i++)
+  {
+    vtkm::FloatDefault t =
+      static_cast<vtkm::FloatDefault>(i) / static_cast<vtkm::FloatDefault>(numSeeds);
+    seeds.push_back(vtkm::Particle(vtkm::Vec3f(.2f, .1f + 3.8f * t, 2.0f), i));
+  }
+  auto seedArray = vtkm::cont::make_ArrayHandle(seeds, vtkm::CopyFlag::Off);
+
+  std::string fieldName = "vec";
+  vtkm::FloatDefault xMax = static_cast<vtkm::FloatDefault>(bounds.back().X.Max);
+  vtkm::Range xMaxRange(xMax, xMax + static_cast<vtkm::FloatDefault>(.5));
+  for (auto& pds : allPDs)
+  {
+    AddVectorFields(pds, fieldName, vtkm::Vec3f(1, 0, 0));
+
+    vtkm::filter::ParticleAdvection particleAdvection;
+    particleAdvection.SetStepSize(0.1f);
+    particleAdvection.SetNumberOfSteps(100000);
+    particleAdvection.SetSeeds(seedArray);
+    particleAdvection.SetUseThreadedAlgorithm(true);
+    particleAdvection.SetNumberOfWorkerThreads(numWorkers);
+    particleAdvection.SetActiveField(fieldName);
+    auto out = particleAdvection.Execute(pds);
+
+    VTKM_TEST_ASSERT(out.GetNumberOfPartitions() == 1, "Wrong number of partitions in output");
+    auto ds = out.GetPartition(0);
+    VTKM_TEST_ASSERT(ds.GetNumberOfPoints() == numSeeds, "Wrong number of coordinates");
+    auto ptPortal = ds.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+    for (vtkm::Id i = 0; i < numSeeds; i++)
+      VTKM_TEST_ASSERT(xMaxRange.Contains(ptPortal.Get(i)[0]), "Wrong end point for seed");
+
+    const auto& stats = particleAdvection.GetWorkerStatistics();
+    VTKM_TEST_ASSERT(numWorkers == 0 || static_cast<vtkm::Id>(stats.size()) == numWorkers,
+                     "Wrong number of worker statistics");
+    VTKM_TEST_ASSERT(!stats.empty(), "No worker statistics");
+    vtkm::Id numParticles = 0, numBatches = 0;
+    for (const auto& s : stats)
+    {
+      VTKM_TEST_ASSERT(s.BusyTime >= 0 && s.IdleTime >= 0, "Bad worker times");
+      VTKM_TEST_ASSERT(s.NumberOfStolenBatches <= s.NumberOfBatches, "Bad stolen batch count");
+      numParticles += s.NumberOfParticles;
+      numBatches += s.NumberOfBatches;
+    }
+    // Every particle passes through every block.
+    VTKM_TEST_ASSERT(numParticles >= numSeeds * numBlocks, "Wrong number of advected particles");
+    if (stats.size() > 1)
+      VTKM_TEST_ASSERT(numBatches > numBlocks, "Particles were not split into batches");
+  }
+}
+
 template <typename CellSetType, typename CoordsType>
 void ValidateEndPoints(const CellSetType& cellSet,
                        const CoordsType& coords,
@@ -588,11 +662,16 @@ void TestStreamlineFilters()
   {
     for (auto useGhost : flags)
       for (auto ft : fTypes)
-      {
-        TestPartitionedDataSet(n, useGhost, ft);
-      }
+        for (auto useThreaded : flags)
+        {
+          TestPartitionedDataSet(n, useGhost, ft, useThreaded);
+        }
   }
 
+  TestThreadedWorkers(3, 4);
+  TestThreadedWorkers(1, 4);
+  TestThreadedWorkers(3, 0);
+
   TestStreamline();
   TestPathline();
 
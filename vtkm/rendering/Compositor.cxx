@@ -0,0 +1,770 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/Compositor.h>
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Logging.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+
+// The pixels [Begin, End) of an image. While the images are swapped, each block holds a
+// shrinking region of the image, composited from a growing group of blocks.
+struct ImageRegion
+{
+  vtkm::Id Begin = 0;
+  vtkm::Id End = 0;
+  std::vector<vtkm::Float32> Colors; // RGBA of each pixel
+  std::vector<vtkm::Float32> Depths;
+};
+
+// The pixels [Begin, End) of `Region`, serialized like an ImageRegion without copying them
+// into one first.
+struct ImageRegionView
+{
+  const ImageRegion* Region;
+  vtkm::Id Begin;
+  vtkm::Id End;
+};
+
+// The partial composites of a set of pixels, one value (or NumChannels values) per partial.
+template <typename FloatType>
+struct PartialFragments
+{
+  std::vector<vtkm::Id> PixelIds;
+  std::vector<FloatType> Distances;
+  std::vector<FloatType> Buffer;
+  std::vector<FloatType> Intensities;
+  std::vector<FloatType> PathLengths;
+};
+
+} // anonymous namespace
+
+namespace mangled_diy_namespace
+{
+
+template <>
+struct Serialization<ImageRegion>
+{
+  static void save(BinaryBuffer& bb, const ImageRegion& region)
+  {
+    vtkmdiy::save(bb, region.Begin);
+    vtkmdiy::save(bb, region.End);
+    vtkmdiy::save(bb, region.Colors);
+    vtkmdiy::save(bb, region.Depths);
+  }
+
+  static void load(BinaryBuffer& bb, ImageRegion& region)
+  {
+    vtkmdiy::load(bb, region.Begin);
+    vtkmdiy::load(bb, region.End);
+    vtkmdiy::load(bb, region.Colors);
+    vtkmdiy::load(bb, region.Depths);
+  }
+};
+
+template <>
+struct Serialization<ImageRegionView>
+{
+  static void save(BinaryBuffer& bb, const ImageRegionView& view)
+  {
+    const auto first = static_cast<std::size_t>(view.Begin - view.Region->Begin);
+    const auto numPixels = static_cast<std::size_t>(view.End - view.Begin);
+    vtkmdiy::save(bb, view.Begin);
+    vtkmdiy::save(bb, view.End);
+    vtkmdiy::save(bb, 4 * numPixels);
+    vtkmdiy::save(bb, view.Region->Colors.data() + 4 * first, 4 * numPixels);
+    vtkmdiy::save(bb, numPixels);
+    vtkmdiy::save(bb, view.Region->Depths.data() + first, numPixels);
+  }
+};
+
+template <typename FloatType>
+struct Serialization<PartialFragments<FloatType>>
+{
+  static void save(BinaryBuffer& bb, const PartialFragments<FloatType>& fragments)
+  {
+    vtkmdiy::save(bb, fragments.PixelIds);
+    vtkmdiy::save(bb, fragments.Distances);
+    vtkmdiy::save(bb, fragments.Buffer);
+    vtkmdiy::save(bb, fragments.Intensities);
+    vtkmdiy::save(bb, fragments.PathLengths);
+  }
+
+  static void load(BinaryBuffer& bb, PartialFragments<FloatType>& fragments)
+  {
+    vtkmdiy::load(bb, fragments.PixelIds);
+    vtkmdiy::load(bb, fragments.Distances);
+    vtkmdiy::load(bb, fragments.Buffer);
+    vtkmdiy::load(bb, fragments.Intensities);
+    vtkmdiy::load(bb, fragments.PathLengths);
+  }
+};
+
+} // namespace mangled_diy_namespace
+
+namespace
+{
+
+// First pixel of part `part` when the pixels [begin, end) are split into `numParts` parts.
+vtkm::Id PartBegin(vtkm::Id begin, vtkm::Id end, vtkm::Id part, vtkm::Id numParts)
+{
+  return begin + (end - begin) * part / numParts;
+}
+
+// Part of [0, numPixels) split into `numParts` parts that holds `pixel`.
+int PartOfPixel(vtkm::Id pixel, vtkm::Id numPixels, vtkm::Id numParts)
+{
+  return static_cast<int>(((pixel + 1) * numParts - 1) / numPixels);
+}
+
+ImageRegion SubRegion(const ImageRegion& region, vtkm::Id begin, vtkm::Id end)
+{
+  ImageRegion sub;
+  sub.Begin = begin;
+  sub.End = end;
+  const auto first = static_cast<std::size_t>(begin - region.Begin);
+  const auto last = static_cast<std::size_t>(end - region.Begin);
+  sub.Colors.assign(region.Colors.begin() + static_cast<std::ptrdiff_t>(4 * first),
+                    region.Colors.begin() + static_cast<std::ptrdiff_t>(4 * last));
+  sub.Depths.assign(region.Depths.begin() + static_cast<std::ptrdiff_t>(first),
+                    region.Depths.begin() + static_cast<std::ptrdiff_t>(last));
+  return sub;
+}
+
+// Composites `back` behind `front`. Both cover the same pixels.
+void CompositeRegions(ImageRegion& front, const ImageRegion& back, bool blend)
+{
+  const std::size_t numPixels = front.Depths.size();
+  if (blend)
+  {
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+      const vtkm::Float32 transparency = 1.f - front.Colors[4 * i + 3];
+      for (std::size_t c = 0; c < 4; ++c)
+      {
+        front.Colors[4 * i + c] += transparency * back.Colors[4 * i + c];
+      }
+      front.Depths[i] = vtkm::Min(front.Depths[i], back.Depths[i]);
+    }
+  }
+  else
+  {
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+      if (back.Depths[i] < front.Depths[i])
+      {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+          front.Colors[4 * i + c] = back.Colors[4 * i + c];
+        }
+        front.Depths[i] = back.Depths[i];
+      }
+    }
+  }
+}
+
+// One round of binary swap or radix-k. The gid of a block is its place in the visibility
+// order, and the swap partners group blocks with contiguous gids, so the regions received
+// from the previous group are blended in gid order. A block keeps its own part of its
+// region instead of sending it to itself.
+struct SwapRegions
+{
+  bool Blend;
+
+  void operator()(ImageRegion* region,
+                  const vtkmdiy::ReduceProxy& proxy,
+                  const vtkmdiy::RegularSwapPartners&) const
+  {
+    if (proxy.in_link().size() > 0)
+    {
+      std::vector<int> gids;
+      for (int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        gids.push_back(proxy.in_link().target(i).gid);
+      }
+      std::sort(gids.begin(), gids.end());
+
+      ImageRegion own = std::move(*region);
+      for (std::size_t i = 0; i < gids.size(); ++i)
+      {
+        ImageRegion received;
+        if (gids[i] != proxy.gid())
+        {
+          proxy.dequeue(gids[i], received);
+        }
+        ImageRegion& part = (gids[i] == proxy.gid()) ? own : received;
+        if (i == 0)
+        {
+          *region = std::move(part);
+        }
+        else
+        {
+          CompositeRegions(*region, part, this->Blend);
+        }
+      }
+    }
+
+    const int numParts = proxy.out_link().size();
+    if (numParts == 0)
+    {
+      return;
+    }
+    ImageRegion own;
+    for (int part = 0; part < numParts; ++part)
+    {
+      const vtkm::Id begin = PartBegin(region->Begin, region->End, part, numParts);
+      const vtkm::Id end = PartBegin(region->Begin, region->End, part + 1, numParts);
+      const vtkmdiy::BlockID target = proxy.out_link().target(part);
+      if (target.gid == proxy.gid())
+      {
+        own = SubRegion(*region, begin, end);
+      }
+      else
+      {
+        proxy.enqueue(target, ImageRegionView{ region, begin, end });
+      }
+    }
+    *region = std::move(own);
+  }
+};
+
+// Places each block on the rank that added its image.
+class ImageAssigner : public vtkmdiy::StaticAssigner
+{
+public:
+  ImageAssigner(int size, const std::vector<int>& gidRanks)
+    : vtkmdiy::StaticAssigner(size, static_cast<int>(gidRanks.size()))
+    , GidRanks(gidRanks)
+  {
+  }
+
+  int rank(int gid) const override { return this->GidRanks[static_cast<std::size_t>(gid)]; }
+
+  void local_gids(int rank, std::vector<int>& gids) const override
+  {
+    for (std::size_t gid = 0; gid < this->GidRanks.size(); ++gid)
+    {
+      if (this->GidRanks[gid] == rank)
+      {
+        gids.push_back(static_cast<int>(gid));
+      }
+    }
+  }
+
+private:
+  std::vector<int> GidRanks;
+};
+
+template <typename FloatType>
+void AppendFragment(PartialFragments<FloatType>& dest,
+                    const PartialFragments<FloatType>& source,
+                    std::size_t index,
+                    std::size_t numChannels)
+{
+  dest.PixelIds.push_back(source.PixelIds[index]);
+  dest.Distances.push_back(source.Distances[index]);
+  const auto first = static_cast<std::ptrdiff_t>(index * numChannels);
+  const auto last = static_cast<std::ptrdiff_t>((index + 1) * numChannels);
+  dest.Buffer.insert(
+    dest.Buffer.end(), source.Buffer.begin() + first, source.Buffer.begin() + last);
+  if (!source.Intensities.empty())
+  {
+    dest.Intensities.insert(dest.Intensities.end(),
+                            source.Intensities.begin() + first,
+                            source.Intensities.begin() + last);
+  }
+  if (!source.PathLengths.empty())
+  {
+    dest.PathLengths.push_back(source.PathLengths[index]);
+  }
+}
+
+// Sends each partial to the block that owns its pixel. Block `gid` owns part `gid` of
+// the pixels.
+template <typename FloatType>
+struct ExchangeFragments
+{
+  vtkm::Id NumPixels;
+  int NumBlocks;
+  std::size_t NumChannels;
+
+  void operator()(PartialFragments<FloatType>* fragments, const vtkmdiy::ReduceProxy& proxy) const
+  {
+    if (proxy.in_link().size() == 0)
+    {
+      std::vector<PartialFragments<FloatType>> parts(static_cast<std::size_t>(this->NumBlocks));
+      for (std::size_t i = 0; i < fragments->PixelIds.size(); ++i)
+      {
+        const int part = PartOfPixel(fragments->PixelIds[i], this->NumPixels, this->NumBlocks);
+        AppendFragment(parts[static_cast<std::size_t>(part)], *fragments, i, this->NumChannels);
+      }
+      for (int i = 0; i < proxy.out_link().size(); ++i)
+      {
+        const vtkmdiy::BlockID target = proxy.out_link().target(i);
+        proxy.enqueue(target, parts[static_cast<std::size_t>(target.gid)]);
+      }
+    }
+    else
+    {
+      *fragments = PartialFragments<FloatType>{};
+      for (int i = 0; i < proxy.in_link().size(); ++i)
+      {
+        PartialFragments<FloatType> incoming;
+        proxy.dequeue(proxy.in_link().target(i).gid, incoming);
+        for (std::size_t j = 0; j < incoming.PixelIds.size(); ++j)
+        {
+          AppendFragment(*fragments, incoming, j, this->NumChannels);
+        }
+      }
+    }
+  }
+};
+
+// Composites the partials of each pixel front to back into one partial. In volume mode
+// the buffer holds premultiplied colors. In energy mode it holds the absorption of each
+// bin, and the intensities emitted behind a partial are attenuated by its absorption.
+template <typename FloatType>
+PartialFragments<FloatType> CompositeFragments(const PartialFragments<FloatType>& fragments,
+                                               std::size_t numChannels,
+                                               bool volumeMode)
+{
+  std::vector<std::size_t> order(fragments.PixelIds.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    return fragments.PixelIds[a] < fragments.PixelIds[b] ||
+      (fragments.PixelIds[a] == fragments.PixelIds[b] &&
+       fragments.Distances[a] < fragments.Distances[b]);
+  });
+
+  const bool hasIntensities = !fragments.Intensities.empty();
+  const bool hasPathLengths = !fragments.PathLengths.empty();
+  PartialFragments<FloatType> result;
+  std::size_t begin = 0;
+  while (begin < order.size())
+  {
+    const vtkm::Id pixel = fragments.PixelIds[order[begin]];
+    std::size_t end = begin;
+    std::vector<FloatType> buffer(numChannels, volumeMode ? FloatType(0) : FloatType(1));
+    std::vector<FloatType> intensities(hasIntensities ? numChannels : 0, FloatType(0));
+    FloatType pathLength = 0;
+    for (; end < order.size() && fragments.PixelIds[order[end]] == pixel; ++end)
+    {
+      const std::size_t fragment = order[end];
+      const std::size_t offset = fragment * numChannels;
+      if (volumeMode)
+      {
+        const FloatType transparency = FloatType(1) - buffer[3];
+        for (std::size_t c = 0; c < numChannels; ++c)
+        {
+          buffer[c] += transparency * fragments.Buffer[offset + c];
+        }
+      }
+      else
+      {
+        for (std::size_t c = 0; c < intensities.size(); ++c)
+        {
+          intensities[c] += buffer[c] * fragments.Intensities[offset + c];
+        }
+        for (std::size_t c = 0; c < numChannels; ++c)
+        {
+          buffer[c] *= fragments.Buffer[offset + c];
+        }
+      }
+      if (hasPathLengths)
+      {
+        pathLength += fragments.PathLengths[fragment];
+      }
+    }
+
+    result.PixelIds.push_back(pixel);
+    result.Distances.push_back(fragments.Distances[order[end - 1]]);
+    result.Buffer.insert(result.Buffer.end(), buffer.begin(), buffer.end());
+    result.Intensities.insert(result.Intensities.end(), intensities.begin(), intensities.end());
+    if (hasPathLengths)
+    {
+      result.PathLengths.push_back(pathLength);
+    }
+    begin = end;
+  }
+  return result;
+}
+
+// Gathers the blocks of all ranks on rank 0, in rank order. The blocks of the master are
+// moved from.
+template <typename BlockType>
+std::vector<BlockType> GatherBlocks(const vtkmdiy::mpi::communicator& comm,
+                                    vtkmdiy::Master& master)
+{
+  std::vector<BlockType> blocks;
+  if (comm.size() == 1)
+  {
+    for (int i = 0; i < static_cast<int>(master.size()); ++i)
+    {
+      blocks.push_back(std::move(*master.block<BlockType>(i)));
+    }
+    return blocks;
+  }
+
+  vtkmdiy::MemoryBuffer outgoing;
+  vtkmdiy::save(outgoing, static_cast<int>(master.size()));
+  for (int i = 0; i < static_cast<int>(master.size()); ++i)
+  {
+    vtkmdiy::save(outgoing, *master.block<BlockType>(i));
+  }
+
+  std::vector<std::vector<char>> incoming;
+  vtkmdiy::mpi::gather(comm, outgoing.buffer, incoming, 0);
+
+  for (auto& buffer : incoming)
+  {
+    vtkmdiy::MemoryBuffer in;
+    in.buffer.swap(buffer);
+    int numBlocks = 0;
+    vtkmdiy::load(in, numBlocks);
+    for (int i = 0; i < numBlocks; ++i)
+    {
+      blocks.emplace_back();
+      vtkmdiy::load(in, blocks.back());
+    }
+  }
+  return blocks;
+}
+
+} // anonymous namespace
+
+namespace vtkm
+{
+namespace rendering
+{
+
+Compositor::Compositor()
+  : Mode(CompositeMode::ZBuffer)
+  , SwapAlgorithm(Algorithm::RadixK)
+  , RadixK(8)
+{
+}
+
+void Compositor::SetCompositeMode(CompositeMode mode)
+{
+  this->Mode = mode;
+}
+
+Compositor::CompositeMode Compositor::GetCompositeMode() const
+{
+  return this->Mode;
+}
+
+void Compositor::SetAlgorithm(Algorithm algorithm)
+{
+  this->SwapAlgorithm = algorithm;
+}
+
+Compositor::Algorithm Compositor::GetAlgorithm() const
+{
+  return this->SwapAlgorithm;
+}
+
+void Compositor::SetRadixK(vtkm::IdComponent k)
+{
+  if (k < 2)
+  {
+    throw vtkm::cont::ErrorBadValue("Compositor: radix-k needs groups of at least 2 ranks.");
+  }
+  this->RadixK = k;
+}
+
+vtkm::IdComponent Compositor::GetRadixK() const
+{
+  return this->RadixK;
+}
+
+vtkm::IdComponent Compositor::GetSwapK() const
+{
+  return this->SwapAlgorithm == Algorithm::BinarySwap ? 2 : this->RadixK;
+}
+
+void Compositor::AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Id visibilityOrder)
+{
+  Image image;
+  image.Width = canvas.GetWidth();
+  image.Height = canvas.GetHeight();
+  image.VisibilityOrder = visibilityOrder;
+  if (!this->Images.empty() &&
+      (image.Width != this->Images[0].Width || image.Height != this->Images[0].Height))
+  {
+    throw vtkm::cont::ErrorBadValue("Compositor: all images must have the same size.");
+  }
+
+  const vtkm::Id numPixels = image.Width * image.Height;
+  image.Colors.resize(static_cast<std::size_t>(4 * numPixels));
+  image.Depths.resize(static_cast<std::size_t>(numPixels));
+  auto colors = canvas.GetColorBuffer().ReadPortal();
+  auto depths = canvas.GetDepthBuffer().ReadPortal();
+  for (vtkm::Id i = 0; i < numPixels; ++i)
+  {
+    const vtkm::Vec4f_32 color = colors.Get(i);
+    const auto pixel = static_cast<std::size_t>(i);
+    for (std::size_t c = 0; c < 4; ++c)
+    {
+      image.Colors[4 * pixel + c] = color[static_cast<vtkm::IdComponent>(c)];
+    }
+    image.Depths[pixel] = depths.Get(i);
+  }
+  this->Images.push_back(std::move(image));
+}
+
+void Compositor::ClearImages()
+{
+  this->Images.clear();
+}
+
+void Compositor::Composite(vtkm::rendering::Canvas& canvas)
+{
+  const vtkmdiy::mpi::communicator& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  const vtkm::Id numPixels = canvas.GetWidth() * canvas.GetHeight();
+  for (const Image& image : this->Images)
+  {
+    if (image.Width != canvas.GetWidth() || image.Height != canvas.GetHeight())
+    {
+      throw vtkm::cont::ErrorBadValue("Compositor: the images must have the size of the canvas.");
+    }
+  }
+  const bool blend = this->Mode == CompositeMode::Blend;
+
+  // Each image is a block. In blend mode, its gid is its place in the visibility order.
+  std::vector<int> localOrders = { static_cast<int>(this->Images.size()) };
+  for (const Image& image : this->Images)
+  {
+    localOrders.push_back(static_cast<int>(image.VisibilityOrder));
+  }
+  std::vector<std::vector<int>> orders;
+  vtkmdiy::mpi::all_gather(comm, localOrders, orders);
+
+  std::vector<int> gidRanks;
+  std::vector<int> localGids;
+  for (int rank = 0; rank < comm.size(); ++rank)
+  {
+    const auto& rankOrders = orders[static_cast<std::size_t>(rank)];
+    for (std::size_t i = 1; i < rankOrders.size(); ++i)
+    {
+      gidRanks.push_back(rank);
+      if (rank == comm.rank())
+      {
+        localGids.push_back(blend ? rankOrders[i] : static_cast<int>(gidRanks.size()) - 1);
+      }
+    }
+  }
+  const int numBlocks = static_cast<int>(gidRanks.size());
+  if (numBlocks == 0)
+  {
+    return;
+  }
+  if (blend)
+  {
+    std::fill(gidRanks.begin(), gidRanks.end(), -1);
+    for (int rank = 0; rank < comm.size(); ++rank)
+    {
+      const auto& rankOrders = orders[static_cast<std::size_t>(rank)];
+      for (std::size_t i = 1; i < rankOrders.size(); ++i)
+      {
+        const int order = rankOrders[i];
+        if (order < 0 || order >= numBlocks || gidRanks[static_cast<std::size_t>(order)] != -1)
+        {
+          throw vtkm::cont::ErrorBadValue(
+            "Compositor: the visibility orders of N images must be 0 to N-1.");
+        }
+        gidRanks[static_cast<std::size_t>(order)] = rank;
+      }
+    }
+  }
+
+  vtkmdiy::Master master(
+    comm,
+    1,
+    -1,
+    []() -> void* { return new ImageRegion(); },
+    [](void* ptr) { delete static_cast<ImageRegion*>(ptr); });
+  for (std::size_t i = 0; i < this->Images.size(); ++i)
+  {
+    auto region = new ImageRegion;
+    region->End = numPixels;
+    region->Colors = std::move(this->Images[i].Colors);
+    region->Depths = std::move(this->Images[i].Depths);
+    master.add(localGids[i], region, new vtkmdiy::Link);
+  }
+  this->Images.clear();
+
+  VTKM_LOG_S(vtkm::cont::LogLevel::Perf,
+             "Compositing " << numBlocks << " images with k = " << this->GetSwapK());
+  ImageAssigner assigner(comm.size(), gidRanks);
+  vtkmdiy::RegularDecomposer<vtkmdiy::DiscreteBounds> decomposer(
+    1, vtkmdiy::interval(0, numBlocks - 1), numBlocks);
+  vtkmdiy::RegularSwapPartners partners(decomposer, this->GetSwapK());
+  vtkmdiy::reduce(master, assigner, partners, SwapRegions{ blend });
+
+  std::vector<ImageRegion> regions = GatherBlocks<ImageRegion>(comm, master);
+  if (comm.rank() != 0)
+  {
+    return;
+  }
+  auto colors = canvas.GetColorBuffer().WritePortal();
+  auto depths = canvas.GetDepthBuffer().WritePortal();
+  for (const ImageRegion& region : regions)
+  {
+    for (vtkm::Id i = region.Begin; i < region.End; ++i)
+    {
+      const auto pixel = static_cast<std::size_t>(i - region.Begin);
+      colors.Set(i,
+                 vtkm::Vec4f_32(region.Colors[4 * pixel + 0],
+                                region.Colors[4 * pixel + 1],
+                                region.Colors[4 * pixel + 2],
+                                region.Colors[4 * pixel + 3]));
+      depths.Set(i, region.Depths[pixel]);
+    }
+  }
+}
+
+template <typename FloatType>
+raytracing::PartialComposite<FloatType> Compositor::CompositePartialsImpl(
+  const std::vector<raytracing::PartialComposite<FloatType>>& partials,
+  vtkm::Id numPixels,
+  ConnectivityProxy::RenderMode mode) const
+{
+  const vtkmdiy::mpi::communicator& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  const bool volumeMode = mode == ConnectivityProxy::VOLUME_MODE;
+
+  // Ranks that traced no partials do not know the number of channels.
+  std::vector<int> localLayout = { volumeMode ? 4 : 0, 0, 0 };
+  for (const auto& partial : partials)
+  {
+    localLayout[0] = vtkm::Max(localLayout[0], partial.Buffer.GetNumChannels());
+    localLayout[1] = vtkm::Max(localLayout[1], partial.Intensities.GetSize() > 0 ? 1 : 0);
+    localLayout[2] = vtkm::Max(localLayout[2], partial.PathLengths.GetNumberOfValues() > 0 ? 1 : 0);
+  }
+  std::vector<int> layout;
+  vtkmdiy::mpi::all_reduce(comm, localLayout, layout, vtkmdiy::mpi::maximum<int>());
+  const auto numChannels = static_cast<std::size_t>(layout[0]);
+  const bool hasIntensities = layout[1] != 0;
+  const bool hasPathLengths = layout[2] != 0;
+
+  auto local = new PartialFragments<FloatType>;
+  for (const auto& partial : partials)
+  {
+    const vtkm::Id size = partial.PixelIds.GetNumberOfValues();
+    auto pixelIds = partial.PixelIds.ReadPortal();
+    auto distances = partial.Distances.ReadPortal();
+    auto buffer = partial.Buffer.Buffer.ReadPortal();
+    auto intensities = partial.Intensities.Buffer.ReadPortal();
+    auto pathLengths = partial.PathLengths.ReadPortal();
+    const bool partialHasIntensities = partial.Intensities.GetSize() > 0;
+    const bool partialHasPathLengths = partial.PathLengths.GetNumberOfValues() > 0;
+    for (vtkm::Id i = 0; i < size; ++i)
+    {
+      local->PixelIds.push_back(pixelIds.Get(i));
+      local->Distances.push_back(distances.Get(i));
+      for (std::size_t c = 0; c < numChannels; ++c)
+      {
+        local->Buffer.push_back(buffer.Get(i * layout[0] + static_cast<vtkm::Id>(c)));
+      }
+      if (hasIntensities)
+      {
+        for (std::size_t c = 0; c < numChannels; ++c)
+        {
+          local->Intensities.push_back(
+            partialHasIntensities ? intensities.Get(i * layout[0] + static_cast<vtkm::Id>(c))
+                                  : FloatType(0));
+        }
+      }
+      if (hasPathLengths)
+      {
+        local->PathLengths.push_back(partialHasPathLengths ? pathLengths.Get(i) : FloatType(0));
+      }
+    }
+  }
+
+  vtkmdiy::Master master(
+    comm,
+    1,
+    -1,
+    []() -> void* { return new PartialFragments<FloatType>(); },
+    [](void* ptr) { delete static_cast<PartialFragments<FloatType>*>(ptr); });
+  master.add(comm.rank(), local, new vtkmdiy::Link);
+  // A single rank already holds all partials (and DIY's all_to_all does not handle a
+  // single block).
+  if (comm.size() > 1)
+  {
+    vtkmdiy::ContiguousAssigner assigner(comm.size(), comm.size());
+    vtkmdiy::all_to_all(
+      master,
+      assigner,
+      ExchangeFragments<FloatType>{ numPixels, comm.size(), numChannels },
+      this->GetSwapK());
+  }
+  *master.block<PartialFragments<FloatType>>(0) = CompositeFragments(
+    *master.block<PartialFragments<FloatType>>(0), numChannels, volumeMode);
+
+  std::vector<PartialFragments<FloatType>> blocks =
+    GatherBlocks<PartialFragments<FloatType>>(comm, master);
+  raytracing::PartialComposite<FloatType> result;
+  if (comm.rank() != 0)
+  {
+    return result;
+  }
+
+  PartialFragments<FloatType> all;
+  for (const auto& block : blocks)
+  {
+    for (std::size_t i = 0; i < block.PixelIds.size(); ++i)
+    {
+      AppendFragment(all, block, i, numChannels);
+    }
+  }
+  const auto size = static_cast<vtkm::Id>(all.PixelIds.size());
+  result.PixelIds = vtkm::cont::make_ArrayHandle(all.PixelIds, vtkm::CopyFlag::On);
+  result.Distances = vtkm::cont::make_ArrayHandle(all.Distances, vtkm::CopyFlag::On);
+  result.Buffer = raytracing::ChannelBuffer<FloatType>(layout[0], size);
+  result.Buffer.Buffer = vtkm::cont::make_ArrayHandle(all.Buffer, vtkm::CopyFlag::On);
+  if (hasIntensities)
+  {
+    result.Intensities = raytracing::ChannelBuffer<FloatType>(layout[0], size);
+    result.Intensities.Buffer = vtkm::cont::make_ArrayHandle(all.Intensities, vtkm::CopyFlag::On);
+  }
+  if (hasPathLengths)
+  {
+    result.PathLengths = vtkm::cont::make_ArrayHandle(all.PathLengths, vtkm::CopyFlag::On);
+  }
+  return result;
+}
+
+raytracing::PartialComposite<vtkm::Float32> Compositor::CompositePartials(
+  const PartialVector32& partials,
+  vtkm::Id numPixels,
+  ConnectivityProxy::RenderMode mode) const
+{
+  return this->CompositePartialsImpl(partials, numPixels, mode);
+}
+
+raytracing::PartialComposite<vtkm::Float64> Compositor::CompositePartials(
+  const PartialVector64& partials,
+  vtkm::Id numPixels,
+  ConnectivityProxy::RenderMode mode) const
+{
+  return this->CompositePartialsImpl(partials, numPixels, mode);
+}
+}
+} // namespace vtkm::rendering
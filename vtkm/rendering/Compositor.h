@@ -0,0 +1,118 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_Compositor_h
+#define vtk_m_rendering_Compositor_h
+
+#include <vtkm/rendering/Canvas.h>
+#include <vtkm/rendering/ConnectivityProxy.h>
+#include <vtkm/rendering/raytracing/PartialComposite.h>
+
+#include <vector>
+
+namespace vtkm
+{
+namespace rendering
+{
+
+/// \brief Composites the images rendered by all ranks into one image (sort-last).
+///
+/// Each rank renders its part of the data and adds the resulting images with `AddImage`.
+/// `Composite` then combines the images of all ranks of the communicator of
+/// `vtkm::cont::EnvironmentTracker` with DIY and writes the result into the canvas of rank 0.
+/// The images are exchanged with binary swap or radix-k, so each rank composites a part
+/// of the image before the parts are gathered on rank 0.
+///
+/// `CompositePartials` does the same for the partial composites of
+/// `ConnectivityProxy::PartialTrace`.
+class VTKM_RENDERING_EXPORT Compositor
+{
+public:
+  enum class CompositeMode
+  {
+    /// Keeps the color of the image nearest to the camera at each pixel.
+    ZBuffer,
+    /// Blends the images front to back in their visibility order. Colors must have
+    /// premultiplied alpha, as the volume renderers produce them.
+    Blend
+  };
+
+  enum class Algorithm
+  {
+    /// Swaps halves of the image between pairs of ranks.
+    BinarySwap,
+    /// Swaps parts of the image within groups of up to `RadixK` ranks.
+    RadixK
+  };
+
+  Compositor();
+
+  void SetCompositeMode(CompositeMode mode);
+  CompositeMode GetCompositeMode() const;
+
+  void SetAlgorithm(Algorithm algorithm);
+  Algorithm GetAlgorithm() const;
+
+  /// Sets the largest group of ranks that swap parts of the image in one round of
+  /// radix-k. The default is 8.
+  void SetRadixK(vtkm::IdComponent k);
+  vtkm::IdComponent GetRadixK() const;
+
+  /// Adds the color and depth buffers of a canvas rendered on this rank. A rank can add
+  /// any number of images, all of the same size. In `Blend` mode, `visibilityOrder` is the
+  /// place of the image in front to back order among the images of all ranks, starting
+  /// at 0. It is ignored in `ZBuffer` mode.
+  void AddImage(const vtkm::rendering::Canvas& canvas, vtkm::Id visibilityOrder = 0);
+
+  void ClearImages();
+
+  /// Composites the images added on all ranks and writes the result into `canvas` on
+  /// rank 0. Every rank must call it. The canvas of the other ranks is not changed.
+  void Composite(vtkm::rendering::Canvas& canvas);
+
+  /// Composites the partial composites traced by all ranks for an image of `numPixels`
+  /// pixels. On rank 0, returns one composite for each pixel traced by any rank, ordered by
+  /// pixel. Its distance is the end of the farthest partial. On the other ranks, returns an
+  /// empty composite. Every rank must call it.
+  raytracing::PartialComposite<vtkm::Float32> CompositePartials(
+    const PartialVector32& partials,
+    vtkm::Id numPixels,
+    ConnectivityProxy::RenderMode mode) const;
+  raytracing::PartialComposite<vtkm::Float64> CompositePartials(
+    const PartialVector64& partials,
+    vtkm::Id numPixels,
+    ConnectivityProxy::RenderMode mode) const;
+
+private:
+  struct Image
+  {
+    vtkm::Id Width;
+    vtkm::Id Height;
+    vtkm::Id VisibilityOrder;
+    std::vector<vtkm::Float32> Colors;
+    std::vector<vtkm::Float32> Depths;
+  };
+
+  template <typename FloatType>
+  raytracing::PartialComposite<FloatType> CompositePartialsImpl(
+    const std::vector<raytracing::PartialComposite<FloatType>>& partials,
+    vtkm::Id numPixels,
+    ConnectivityProxy::RenderMode mode) const;
+
+  vtkm::IdComponent GetSwapK() const;
+
+  CompositeMode Mode;
+  Algorithm SwapAlgorithm;
+  vtkm::IdComponent RadixK;
+  std::vector<Image> Images;
+};
+}
+} //namespace vtkm::rendering
+
+#endif //vtk_m_rendering_Compositor_h
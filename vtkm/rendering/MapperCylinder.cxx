@@ -15,6 +15,7 @@
 
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/Cylinderizer.h>
+#include <vtkm/rendering/internal/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/Camera.h>
 #include <vtkm/rendering/raytracing/CylinderExtractor.h>
 #include <vtkm/rendering/raytracing/CylinderIntersector.h>
@@ -54,6 +55,7 @@ struct MapperCylinder::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::internal::ShapeIntersectorCache Shapes;
   bool CompositeBackground;
   vtkm::Float32 Radius;
   vtkm::Float32 Delta;
@@ -129,8 +131,10 @@ void MapperCylinder::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
   vtkm::cont::Timer timer;
 
 
+  // make sure we start fresh
+  this->Internals->Tracer.Clear();
+
   vtkm::Bounds shapeBounds;
-  raytracing::CylinderExtractor cylExtractor;
 
   vtkm::Float32 baseRadius = this->Internals->Radius;
   if (baseRadius == -1.f)
@@ -140,7 +144,6 @@ void MapperCylinder::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
     vtkm::worklet::DispatcherMapField<CalcDistance>(CalcDistance(camera.GetPosition()))
       .Invoke(coords, dist);
 
-
     vtkm::Float32 min_dist =
       vtkm::cont::Algorithm::Reduce(dist, vtkm::Infinity<vtkm::Float32>(), vtkm::Minimum());
 
@@ -149,34 +152,55 @@ void MapperCylinder::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
       0.038697244f * vtkm::Pow(vtkm::Float32(min_dist), 4.f) +
       0.002366979f * vtkm::Pow(vtkm::Float32(min_dist), 5.f);
     baseRadius /= min_dist;
-    vtkm::worklet::DispatcherMapField<vtkm::rendering::raytracing::MemSet<vtkm::Float32>>(
-      vtkm::rendering::raytracing::MemSet<vtkm::Float32>(baseRadius))
-      .Invoke(cylExtractor.GetRadii());
   }
 
+  //
+  // Add supported shapes, reusing the ones of the last frame if the data and radii are
+  // unchanged. The default radius depends on the camera, so only explicitly set radii
+  // let the shapes be reused across camera positions.
+  //
+  vtkm::rendering::internal::ShapeIntersectorCache::Key key;
+  key.AddCellSet(cellset);
+  key.AddCoordinates(coords);
+  key.AddParameter(baseRadius);
+  key.AddParameter(this->Internals->UseVariableRadius ? 1. : 0.);
   if (this->Internals->UseVariableRadius)
   {
-    vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->Delta;
-    vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->Delta;
-
-    cylExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+    key.AddField(scalarField);
+    key.AddParameter(this->Internals->Delta);
   }
-  else
+  std::shared_ptr<raytracing::ShapeIntersector> cylIntersector;
+  bool cached = this->Internals->Shapes.Find(key, cylIntersector);
+  logger->AddLogData("cached_shapes", cached);
+  if (!cached)
   {
-    cylExtractor.ExtractCells(cellset, baseRadius);
-  }
+    raytracing::CylinderExtractor cylExtractor;
+    if (this->Internals->UseVariableRadius)
+    {
+      vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->Delta;
+      vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->Delta;
 
-  //
-  // Add supported shapes
-  //
+      cylExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+    }
+    else
+    {
+      cylExtractor.ExtractCells(cellset, baseRadius);
+    }
 
-  if (cylExtractor.GetNumberOfCylinders() > 0)
+    if (cylExtractor.GetNumberOfCylinders() > 0)
+    {
+      auto intersector = std::make_shared<raytracing::CylinderIntersector>();
+      intersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
+      cylIntersector = intersector;
+    }
+    this->Internals->Shapes.Store(key, cylIntersector);
+  }
+  if (cylIntersector)
   {
-    auto cylIntersector = std::make_shared<raytracing::CylinderIntersector>();
-    cylIntersector->SetData(coords, cylExtractor.GetCylIds(), cylExtractor.GetRadii());
     this->Internals->Tracer.AddShapeIntersector(cylIntersector);
     shapeBounds.Include(cylIntersector->GetShapeBounds());
   }
+
   //
   // Create rays
   //
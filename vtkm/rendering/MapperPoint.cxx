@@ -14,6 +14,7 @@
 
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/internal/RunTriangulator.h>
+#include <vtkm/rendering/internal/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/Camera.h>
 #include <vtkm/rendering/raytracing/Logger.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
@@ -32,6 +33,7 @@ struct MapperPoint::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::internal::ShapeIntersectorCache Shapes;
   bool CompositeBackground;
   vtkm::Float32 PointRadius;
   bool UseNodes;
@@ -139,39 +141,63 @@ void MapperPoint::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
 
   vtkm::Bounds shapeBounds;
 
-  raytracing::SphereExtractor sphereExtractor;
-
+  //
+  // Add supported shapes, reusing the ones of the last frame if the data and radii are
+  // unchanged
+  //
+  vtkm::rendering::internal::ShapeIntersectorCache::Key key;
+  key.AddCellSet(cellset);
+  key.AddCoordinates(coords);
+  key.AddParameter(baseRadius);
+  key.AddParameter(this->Internals->UseNodes ? 1. : 0.);
+  key.AddParameter(this->Internals->UseVariableRadius ? 1. : 0.);
   if (this->Internals->UseVariableRadius)
   {
-    vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->PointDelta;
-    vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->PointDelta;
-    if (this->Internals->UseNodes)
-    {
+    key.AddField(scalarField);
+    key.AddParameter(this->Internals->PointDelta);
+  }
+  std::shared_ptr<raytracing::ShapeIntersector> sphereIntersector;
+  bool cached = this->Internals->Shapes.Find(key, sphereIntersector);
+  logger->AddLogData("cached_shapes", cached);
+  if (!cached)
+  {
+    raytracing::SphereExtractor sphereExtractor;
 
-      sphereExtractor.ExtractCoordinates(coords, scalarField, minRadius, maxRadius);
+    if (this->Internals->UseVariableRadius)
+    {
+      vtkm::Float32 minRadius = baseRadius - baseRadius * this->Internals->PointDelta;
+      vtkm::Float32 maxRadius = baseRadius + baseRadius * this->Internals->PointDelta;
+      if (this->Internals->UseNodes)
+      {
+        sphereExtractor.ExtractCoordinates(coords, scalarField, minRadius, maxRadius);
+      }
+      else
+      {
+        sphereExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+      }
     }
     else
     {
-      sphereExtractor.ExtractCells(cellset, scalarField, minRadius, maxRadius);
+      if (this->Internals->UseNodes)
+      {
+        sphereExtractor.ExtractCoordinates(coords, baseRadius);
+      }
+      else
+      {
+        sphereExtractor.ExtractCells(cellset, baseRadius);
+      }
     }
-  }
-  else
-  {
-    if (this->Internals->UseNodes)
-    {
 
-      sphereExtractor.ExtractCoordinates(coords, baseRadius);
-    }
-    else
+    if (sphereExtractor.GetNumberOfSpheres() > 0)
     {
-      sphereExtractor.ExtractCells(cellset, baseRadius);
+      auto intersector = std::make_shared<raytracing::SphereIntersector>();
+      intersector->SetData(coords, sphereExtractor.GetPointIds(), sphereExtractor.GetRadii());
+      sphereIntersector = intersector;
     }
+    this->Internals->Shapes.Store(key, sphereIntersector);
   }
-
-  if (sphereExtractor.GetNumberOfSpheres() > 0)
+  if (sphereIntersector)
   {
-    auto sphereIntersector = std::make_shared<raytracing::SphereIntersector>();
-    sphereIntersector->SetData(coords, sphereExtractor.GetPointIds(), sphereExtractor.GetRadii());
     this->Internals->Tracer.AddShapeIntersector(sphereIntersector);
     shapeBounds.Include(sphereIntersector->GetShapeBounds());
   }
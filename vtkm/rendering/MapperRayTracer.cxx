@@ -15,6 +15,7 @@
 
 #include <vtkm/rendering/CanvasRayTracer.h>
 #include <vtkm/rendering/internal/RunTriangulator.h>
+#include <vtkm/rendering/internal/ShapeIntersectorCache.h>
 #include <vtkm/rendering/raytracing/Camera.h>
 #include <vtkm/rendering/raytracing/Logger.h>
 #include <vtkm/rendering/raytracing/RayOperations.h>
@@ -34,6 +35,7 @@ struct MapperRayTracer::InternalsType
   vtkm::rendering::raytracing::RayTracer Tracer;
   vtkm::rendering::raytracing::Camera RayCamera;
   vtkm::rendering::raytracing::Ray<vtkm::Float32> Rays;
+  vtkm::rendering::internal::ShapeIntersectorCache Shapes;
   bool CompositeBackground;
   bool Shade;
   VTKM_CONT
@@ -89,15 +91,29 @@ void MapperRayTracer::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
   // make sure we start fresh
   this->Internals->Tracer.Clear();
   //
-  // Add supported shapes
+  // Add supported shapes, reusing the ones of the last frame if the data is unchanged
   //
   vtkm::Bounds shapeBounds;
-  raytracing::TriangleExtractor triExtractor;
-  triExtractor.ExtractCells(cellset);
-  if (triExtractor.GetNumberOfTriangles() > 0)
+  vtkm::rendering::internal::ShapeIntersectorCache::Key key;
+  key.AddCellSet(cellset);
+  key.AddCoordinates(coords);
+  std::shared_ptr<raytracing::ShapeIntersector> triIntersector;
+  bool cached = this->Internals->Shapes.Find(key, triIntersector);
+  logger->AddLogData("cached_shapes", cached);
+  if (!cached)
+  {
+    raytracing::TriangleExtractor triExtractor;
+    triExtractor.ExtractCells(cellset);
+    if (triExtractor.GetNumberOfTriangles() > 0)
+    {
+      auto intersector = std::make_shared<raytracing::TriangleIntersector>();
+      intersector->SetData(coords, triExtractor.GetTriangles());
+      triIntersector = intersector;
+    }
+    this->Internals->Shapes.Store(key, triIntersector);
+  }
+  if (triIntersector)
   {
-    auto triIntersector = std::make_shared<raytracing::TriangleIntersector>();
-    triIntersector->SetData(coords, triExtractor.GetTriangles());
     this->Internals->Tracer.AddShapeIntersector(triIntersector);
     shapeBounds.Include(triIntersector->GetShapeBounds());
   }
@@ -33,12 +33,14 @@ struct MapperVolume::InternalsType
   vtkm::rendering::CanvasRayTracer* Canvas;
   vtkm::Float32 SampleDistance;
   bool CompositeBackground;
+  vtkm::Float32 OpacityThreshold;
 
   VTKM_CONT
   InternalsType()
     : Canvas(nullptr)
     , SampleDistance(DEFAULT_SAMPLE_DISTANCE)
     , CompositeBackground(true)
+    , OpacityThreshold(1.f)
   {
   }
 };
@@ -118,6 +120,7 @@ void MapperVolume::RenderCells(const vtkm::cont::DynamicCellSet& cellset,
     tracer.SetData(
       coords, scalarField, cellset.Cast<vtkm::cont::CellSetStructured<3>>(), scalarRange);
     tracer.SetColorMap(this->ColorMap);
+    tracer.SetOpacityThreshold(this->Internals->OpacityThreshold);
 
     tracer.Render(rays);
 
@@ -149,5 +152,14 @@ void MapperVolume::SetCompositeBackground(const bool compositeBackground)
 {
   this->Internals->CompositeBackground = compositeBackground;
 }
+
+void MapperVolume::SetOpacityThreshold(const vtkm::Float32 threshold)
+{
+  if (threshold <= 0.f || threshold > 1.f)
+  {
+    throw vtkm::cont::ErrorBadValue("Opacity threshold must be in (0, 1].");
+  }
+  this->Internals->OpacityThreshold = threshold;
+}
 }
 } // namespace vtkm::rendering
@@ -39,6 +39,8 @@ public:
   vtkm::rendering::Mapper* NewCopy() const override;
   void SetSampleDistance(const vtkm::Float32 distance);
   void SetCompositeBackground(const bool compositeBackground);
+  /// Stops each ray once its opacity reaches `threshold`, in (0, 1]. The default is 1.
+  void SetOpacityThreshold(const vtkm::Float32 threshold);
 
 private:
   struct InternalsType;
@@ -0,0 +1,54 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/rendering/internal/ShapeIntersectorCache.h>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace internal
+{
+
+bool ShapeIntersectorCache::Find(
+  const Key& key,
+  std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector>& intersector)
+{
+  if (!this->HasEntry || !(this->CachedKey == key))
+  {
+    return false;
+  }
+  intersector = this->Intersector;
+  return true;
+}
+
+void ShapeIntersectorCache::Store(
+  const Key& key,
+  const std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector>& intersector)
+{
+  if (!key.IsCacheable())
+  {
+    this->Clear();
+    return;
+  }
+  this->CachedKey = key;
+  this->Intersector = intersector;
+  this->HasEntry = true;
+}
+
+void ShapeIntersectorCache::Clear()
+{
+  this->CachedKey = Key{};
+  this->Intersector.reset();
+  this->HasEntry = false;
+}
+}
+}
+} // namespace vtkm::rendering::internal
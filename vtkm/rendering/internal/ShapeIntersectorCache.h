@@ -0,0 +1,69 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_rendering_internal_ShapeIntersectorCache_h
+#define vtk_m_rendering_internal_ShapeIntersectorCache_h
+
+#include <vtkm/rendering/vtkm_rendering_export.h>
+
+#include <vtkm/cont/internal/MeshKey.h>
+#include <vtkm/rendering/raytracing/ShapeIntersector.h>
+
+#include <memory>
+
+namespace vtkm
+{
+namespace rendering
+{
+namespace internal
+{
+
+/// \brief Keeps the shape intersector a mapper built for its last input.
+///
+/// Extracting the shapes of a data set and building their BVH usually costs more than tracing
+/// the rays of a frame. When the same data is rendered from many cameras, a mapper can reuse the
+/// intersector it built for the previous frame. The inputs the shapes were built from are
+/// described by a `Key`: the arrays of the cell set, coordinates and fields (compared by
+/// identity, not by value) and any other parameters, such as radii. An intersector is reused
+/// when the key has the same arrays and parameters, and none of the arrays was modified since
+/// the intersector was stored, as reported by `Buffer::GetModifiedCount`.
+///
+/// Each cached intersector keeps its input arrays alive.
+///
+class VTKM_RENDERING_EXPORT ShapeIntersectorCache
+{
+public:
+  /// Describes the arrays and parameters the shapes were built from.
+  ///
+  using Key = vtkm::cont::internal::MeshKey;
+
+  /// Returns true and sets `intersector` if an intersector was stored for `key`. The stored
+  /// intersector is null if the inputs had no shapes.
+  ///
+  VTKM_CONT bool Find(const Key& key,
+                      std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector>& intersector);
+
+  /// Stores `intersector` for `key`, replacing the previous one.
+  ///
+  VTKM_CONT void Store(
+    const Key& key,
+    const std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector>& intersector);
+
+  VTKM_CONT void Clear();
+
+private:
+  Key CachedKey;
+  std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector> Intersector;
+  bool HasEntry = false;
+};
+}
+}
+} // namespace vtkm::rendering::internal
+
+#endif //vtk_m_rendering_internal_ShapeIntersectorCache_h
@@ -10,6 +10,10 @@
 #ifndef vtk_m_rendering_raytracing_BVH_Traverser_h
 #define vtk_m_rendering_raytracing_BVH_Traverser_h
 
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/DeviceAdapterList.h>
+#include <vtkm/cont/TryExecute.h>
+
 #include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
 #include <vtkm/rendering/raytracing/Ray.h>
 #include <vtkm/rendering/raytracing/RayTracingTypeDefs.h>
@@ -71,9 +75,42 @@ VTKM_EXEC inline bool IntersectAABB(const BVHPortalType& bvh,
   return (min0 > min1);
 }
 
+/// A packet of rays traced together through the BVH. Each array holds one value per ray, so
+/// loops over the rays of a packet can use the SIMD units of a CPU.
+template <typename PrecisionType, vtkm::IdComponent PacketSize>
+struct RayPacket
+{
+  using Precision = PrecisionType;
+  static constexpr vtkm::IdComponent Size = PacketSize;
+
+  Precision OriginX[Size];
+  Precision OriginY[Size];
+  Precision OriginZ[Size];
+  Precision DirX[Size];
+  Precision DirY[Size];
+  Precision DirZ[Size];
+  Precision MinDistance[Size];
+  // Distance to the closest hit so far, which starts at the maximum distance of the ray.
+  Precision Distance[Size];
+  Precision U[Size];
+  Precision V[Size];
+  vtkm::Id HitIndex[Size];
+};
+
 class BVHTraverser
 {
 public:
+  /// Number of rays in a packet. This matches the tiles of rays made by `Camera`.
+  static constexpr vtkm::IdComponent PacketSize = 8;
+
+  /// Packet traversal is only worth it on devices that run each packet on a CPU core.
+  template <typename Device>
+  using UsePackets =
+    std::integral_constant<bool,
+                           std::is_same<Device, vtkm::cont::DeviceAdapterTagSerial>::value ||
+                             std::is_same<Device, vtkm::cont::DeviceAdapterTagTBB>::value ||
+                             std::is_same<Device, vtkm::cont::DeviceAdapterTagOpenMP>::value>;
+
   class Intersector : public vtkm::worklet::WorkletMapField
   {
   private:
@@ -218,6 +255,206 @@ public:
   };
 
 
+  // Traces packets of consecutive rays. A node is visited if any ray of the packet hits it,
+  // and the children are visited first in the order most of the rays prefer. The leaf
+  // intersector intersects all rays of the packet with each primitive of a leaf through its
+  // IntersectLeafPacket method.
+  template <vtkm::IdComponent Size>
+  class PacketIntersector : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    VTKM_CONT
+    PacketIntersector() {}
+    using ControlSignature = void(FieldIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayIn,
+                                  WholeArrayOut,
+                                  WholeArrayOut,
+                                  WholeArrayOut,
+                                  WholeArrayOut,
+                                  WholeArrayIn,
+                                  ExecObject leafIntersector,
+                                  WholeArrayIn,
+                                  WholeArrayIn);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13);
+
+    template <typename DirPortalType,
+              typename OriginPortalType,
+              typename PrecisionPortalType,
+              typename OutPrecisionPortalType,
+              typename HitPortalType,
+              typename PointPortalType,
+              typename LeafType,
+              typename InnerNodePortalType,
+              typename LeafPortalType>
+    VTKM_EXEC void operator()(const vtkm::Id& packetIndex,
+                              const DirPortalType& dirs,
+                              const OriginPortalType& origins,
+                              const PrecisionPortalType& minDistances,
+                              const PrecisionPortalType& maxDistances,
+                              const OutPrecisionPortalType& distances,
+                              const OutPrecisionPortalType& us,
+                              const OutPrecisionPortalType& vs,
+                              const HitPortalType& hitIndices,
+                              const PointPortalType& points,
+                              LeafType& leafIntersector,
+                              const InnerNodePortalType& flatBVH,
+                              const LeafPortalType& leafs) const
+    {
+      using Precision = typename PrecisionPortalType::ValueType;
+      const vtkm::Id first = packetIndex * Size;
+      const vtkm::IdComponent count =
+        static_cast<vtkm::IdComponent>(vtkm::Min(vtkm::Id(Size), dirs.GetNumberOfValues() - first));
+
+      RayPacket<Precision, Size> packet;
+      Precision maxDistance[Size];
+      Precision invDirX[Size], invDirY[Size], invDirZ[Size];
+      Precision originDirX[Size], originDirY[Size], originDirZ[Size];
+      for (vtkm::IdComponent lane = 0; lane < Size; ++lane)
+      {
+        vtkm::Vec<Precision, 3> dir(1.f);
+        vtkm::Vec<Precision, 3> origin(0.f);
+        packet.MinDistance[lane] = 0.f;
+        // Lanes past the last ray have a negative maximum distance, so they hit nothing.
+        maxDistance[lane] = -1.f;
+        if (lane < count)
+        {
+          dir = dirs.Get(first + lane);
+          origin = origins.Get(first + lane);
+          packet.MinDistance[lane] = minDistances.Get(first + lane);
+          maxDistance[lane] = maxDistances.Get(first + lane);
+        }
+        packet.DirX[lane] = dir[0];
+        packet.DirY[lane] = dir[1];
+        packet.DirZ[lane] = dir[2];
+        packet.OriginX[lane] = origin[0];
+        packet.OriginY[lane] = origin[1];
+        packet.OriginZ[lane] = origin[2];
+        packet.Distance[lane] = maxDistance[lane];
+        packet.U[lane] = 0.f;
+        packet.V[lane] = 0.f;
+        packet.HitIndex[lane] = -1;
+        invDirX[lane] = 1.f / ((vtkm::Abs(dir[0]) < 1e-8f) ? Precision(1e-8f) : dir[0]);
+        invDirY[lane] = 1.f / ((vtkm::Abs(dir[1]) < 1e-8f) ? Precision(1e-8f) : dir[1]);
+        invDirZ[lane] = 1.f / ((vtkm::Abs(dir[2]) < 1e-8f) ? Precision(1e-8f) : dir[2]);
+        originDirX[lane] = origin[0] * invDirX[lane];
+        originDirY[lane] = origin[1] * invDirY[lane];
+        originDirZ[lane] = origin[2] * invDirZ[lane];
+      }
+
+      vtkm::Int32 todo[64];
+      vtkm::Int32 stackptr = 0;
+      vtkm::Int32 barrier = (vtkm::Int32)END_FLAG;
+      vtkm::Int32 currentNode = 0;
+      todo[stackptr] = barrier;
+
+      while (currentNode != END_FLAG)
+      {
+        if (currentNode > -1)
+        {
+          const vtkm::Vec4f_32 first4 = flatBVH.Get(currentNode);
+          const vtkm::Vec4f_32 second4 = flatBVH.Get(currentNode + 1);
+          const vtkm::Vec4f_32 third4 = flatBVH.Get(currentNode + 2);
+
+          // Counts are used rather than bools so the loop over the lanes vectorizes.
+          vtkm::Int32 hitLeftCount = 0;
+          vtkm::Int32 hitRightCount = 0;
+          vtkm::Int32 hitBothCount = 0;
+          vtkm::Int32 rightCloserCount = 0;
+          for (vtkm::IdComponent lane = 0; lane < Size; ++lane)
+          {
+            const Precision xmin0 = first4[0] * invDirX[lane] - originDirX[lane];
+            const Precision ymin0 = first4[1] * invDirY[lane] - originDirY[lane];
+            const Precision zmin0 = first4[2] * invDirZ[lane] - originDirZ[lane];
+            const Precision xmax0 = first4[3] * invDirX[lane] - originDirX[lane];
+            const Precision ymax0 = second4[0] * invDirY[lane] - originDirY[lane];
+            const Precision zmax0 = second4[1] * invDirZ[lane] - originDirZ[lane];
+            const Precision min0 = vtkm::Max(vtkm::Max(vtkm::Max(vtkm::Min(ymin0, ymax0),
+                                                                 vtkm::Min(xmin0, xmax0)),
+                                                       vtkm::Min(zmin0, zmax0)),
+                                             packet.MinDistance[lane]);
+            const Precision max0 = vtkm::Min(vtkm::Min(vtkm::Min(vtkm::Max(ymin0, ymax0),
+                                                                 vtkm::Max(xmin0, xmax0)),
+                                                       vtkm::Max(zmin0, zmax0)),
+                                             packet.Distance[lane]);
+
+            const Precision xmin1 = second4[2] * invDirX[lane] - originDirX[lane];
+            const Precision ymin1 = second4[3] * invDirY[lane] - originDirY[lane];
+            const Precision zmin1 = third4[0] * invDirZ[lane] - originDirZ[lane];
+            const Precision xmax1 = third4[1] * invDirX[lane] - originDirX[lane];
+            const Precision ymax1 = third4[2] * invDirY[lane] - originDirY[lane];
+            const Precision zmax1 = third4[3] * invDirZ[lane] - originDirZ[lane];
+            const Precision min1 = vtkm::Max(vtkm::Max(vtkm::Max(vtkm::Min(ymin1, ymax1),
+                                                                 vtkm::Min(xmin1, xmax1)),
+                                                       vtkm::Min(zmin1, zmax1)),
+                                             packet.MinDistance[lane]);
+            const Precision max1 = vtkm::Min(vtkm::Min(vtkm::Min(vtkm::Max(ymin1, ymax1),
+                                                                 vtkm::Max(xmin1, xmax1)),
+                                                       vtkm::Max(zmin1, zmax1)),
+                                             packet.Distance[lane]);
+
+            const vtkm::Int32 hitLeft = (max0 >= min0) ? 1 : 0;
+            const vtkm::Int32 hitRight = (max1 >= min1) ? 1 : 0;
+            hitLeftCount += hitLeft;
+            hitRightCount += hitRight;
+            hitBothCount += hitLeft & hitRight;
+            rightCloserCount += hitLeft & hitRight & ((min0 > min1) ? 1 : 0);
+          }
+
+          const bool hitLeftChild = hitLeftCount > 0;
+          const bool hitRightChild = hitRightCount > 0;
+          if (!hitLeftChild && !hitRightChild)
+          {
+            currentNode = todo[stackptr];
+            stackptr--;
+          }
+          else
+          {
+            vtkm::Vec4f_32 children = flatBVH.Get(currentNode + 3);
+            vtkm::Int32 leftChild;
+            memcpy(&leftChild, &children[0], 4);
+            vtkm::Int32 rightChild;
+            memcpy(&rightChild, &children[1], 4);
+            currentNode = (hitLeftChild) ? leftChild : rightChild;
+            if (hitLeftChild && hitRightChild)
+            {
+              if (2 * rightCloserCount > hitBothCount)
+              {
+                currentNode = rightChild;
+                stackptr++;
+                todo[stackptr] = leftChild;
+              }
+              else
+              {
+                stackptr++;
+                todo[stackptr] = rightChild;
+              }
+            }
+          }
+        } // if inner node
+
+        if (currentNode < 0 && currentNode != barrier)
+        {
+          currentNode = -currentNode - 1; //swap the neg address
+          leafIntersector.IntersectLeafPacket(currentNode, packet, points, leafs);
+          currentNode = todo[stackptr];
+          stackptr--;
+        } // if leaf node
+      }   //while
+
+      for (vtkm::IdComponent lane = 0; lane < count; ++lane)
+      {
+        const vtkm::Id hitIndex = packet.HitIndex[lane];
+        distances.Set(first + lane, (hitIndex != -1) ? packet.Distance[lane] : maxDistance[lane]);
+        us.Set(first + lane, packet.U[lane]);
+        vs.Set(first + lane, packet.V[lane]);
+        hitIndices.Set(first + lane, hitIndex);
+      }
+    } // ()
+  };
+
   template <typename Precision, typename LeafIntersectorType>
   VTKM_CONT void IntersectRays(Ray<Precision>& rays,
                                LinearBVH& bvh,
@@ -238,6 +475,93 @@ public:
                              bvh.FlatBVH,
                              bvh.Leafs);
   }
+
+  /// Like `IntersectRays`, but traces packets of `PacketSize` consecutive rays on CPU devices,
+  /// where the leaf intersector must provide `IntersectLeafPacket`. Rays are traced one by one
+  /// on other devices. Packets work best when consecutive rays are coherent, as the primary
+  /// rays made by `Camera` are.
+  template <typename Precision, typename LeafIntersectorType>
+  VTKM_CONT void IntersectRayPackets(Ray<Precision>& rays,
+                                     LinearBVH& bvh,
+                                     LeafIntersectorType& leafIntersector,
+                                     vtkm::cont::CoordinateSystem& coordsHandle)
+  {
+    if (!vtkm::cont::TryExecute(
+          IntersectRayPacketsFunctor{}, rays, bvh, leafIntersector, coordsHandle))
+    {
+      this->IntersectRays(rays, bvh, leafIntersector, coordsHandle);
+    }
+  }
+
+private:
+  struct IntersectRayPacketsFunctor
+  {
+    template <typename Device, typename Precision, typename LeafIntersectorType>
+    VTKM_CONT bool operator()(Device device,
+                              Ray<Precision>& rays,
+                              LinearBVH& bvh,
+                              LeafIntersectorType& leafIntersector,
+                              vtkm::cont::CoordinateSystem& coordsHandle) const
+    {
+      this->Run(device, UsePackets<Device>{}, rays, bvh, leafIntersector, coordsHandle);
+      return true;
+    }
+
+    template <typename Device, typename Precision, typename LeafIntersectorType>
+    VTKM_CONT void Run(Device device,
+                       std::true_type,
+                       Ray<Precision>& rays,
+                       LinearBVH& bvh,
+                       LeafIntersectorType& leafIntersector,
+                       vtkm::cont::CoordinateSystem& coordsHandle) const
+    {
+      const vtkm::Id numPackets = (rays.NumRays + PacketSize - 1) / PacketSize;
+      // Whole arrays are not allocated by the dispatcher, unlike the fields of IntersectRays.
+      rays.Distance.Allocate(rays.NumRays);
+      rays.U.Allocate(rays.NumRays);
+      rays.V.Allocate(rays.NumRays);
+      rays.HitIdx.Allocate(rays.NumRays);
+      vtkm::worklet::DispatcherMapField<PacketIntersector<PacketSize>> intersectDispatch;
+      intersectDispatch.SetDevice(device);
+      intersectDispatch.Invoke(vtkm::cont::ArrayHandleIndex(numPackets),
+                               rays.Dir,
+                               rays.Origin,
+                               rays.MinDistance,
+                               rays.MaxDistance,
+                               rays.Distance,
+                               rays.U,
+                               rays.V,
+                               rays.HitIdx,
+                               coordsHandle,
+                               leafIntersector,
+                               bvh.FlatBVH,
+                               bvh.Leafs);
+    }
+
+    template <typename Device, typename Precision, typename LeafIntersectorType>
+    VTKM_CONT void Run(Device device,
+                       std::false_type,
+                       Ray<Precision>& rays,
+                       LinearBVH& bvh,
+                       LeafIntersectorType& leafIntersector,
+                       vtkm::cont::CoordinateSystem& coordsHandle) const
+    {
+      vtkm::worklet::DispatcherMapField<Intersector> intersectDispatch;
+      intersectDispatch.SetDevice(device);
+      intersectDispatch.Invoke(rays.Dir,
+                               rays.Origin,
+                               rays.Distance,
+                               rays.MinDistance,
+                               rays.MaxDistance,
+                               rays.U,
+                               rays.V,
+                               rays.HitIdx,
+                               coordsHandle,
+                               leafIntersector,
+                               bvh.FlatBVH,
+                               bvh.Leafs);
+    }
+  };
 }; // BVHTraverser
 #undef END_FLAG
 }
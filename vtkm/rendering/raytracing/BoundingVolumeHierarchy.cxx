@@ -10,6 +10,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <vtkm/Math.h>
 #include <vtkm/VectorAnalysis.h>
 
@@ -694,17 +698,311 @@ VTKM_CONT void LinearBVHBuilder::Build(LinearBVH& linearBVH)
 
   linearBVH.Leafs = bvh.leafs;
 }
+
+//
+// Top-down binned SAH builder (Wald, "On fast Construction of SAH-based
+// Bounding Volume Hierarchies", 2007). The primitives of each node are binned
+// by centroid along each axis, and the node is split at the bin boundary that
+// minimizes the surface area heuristic, or made a leaf when that is cheaper.
+// The build runs on the host and writes the same flat layout as the LBVH
+// builder, with up to MaxLeafSize primitives per leaf.
+//
+class SAHBVHBuilder
+{
+public:
+  VTKM_CONT
+  SAHBVHBuilder() {}
+
+  VTKM_CONT void Build(LinearBVH& linearBVH);
+
+private:
+  static constexpr vtkm::Int32 NumBins = 16;
+  static constexpr vtkm::Id MaxLeafSize = 4;
+  // Relative cost of visiting an inner node vs. intersecting a primitive.
+  static constexpr vtkm::Float32 TraversalCost = 1.f;
+  // Below this depth, nodes are split at the object median so that the depth
+  // of the tree fits in the 64 entry stack of the traversal.
+  static constexpr vtkm::Int32 MaxSAHDepth = 32;
+
+  struct Box
+  {
+    vtkm::Vec3f_32 Min{ vtkm::Infinity32() };
+    vtkm::Vec3f_32 Max{ vtkm::NegativeInfinity32() };
+
+    void Include(const vtkm::Vec3f_32& point)
+    {
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        this->Min[i] = vtkm::Min(this->Min[i], point[i]);
+        this->Max[i] = vtkm::Max(this->Max[i], point[i]);
+      }
+    }
+
+    // Empty boxes (e.g. of empty bins) leave this box unchanged.
+    void Include(const Box& other)
+    {
+      for (vtkm::IdComponent i = 0; i < 3; ++i)
+      {
+        this->Min[i] = vtkm::Min(this->Min[i], other.Min[i]);
+        this->Max[i] = vtkm::Max(this->Max[i], other.Max[i]);
+      }
+    }
+
+    vtkm::Float32 HalfArea() const
+    {
+      vtkm::Vec3f_32 d = this->Max - this->Min;
+      return (d[0] < 0.f) ? 0.f : d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+    }
+  };
+
+  // Returns the number of primitives in [start, end) that end up in the left
+  // child, after reordering them.
+  vtkm::Id Split(vtkm::Id start, vtkm::Id end, const Box& bounds, vtkm::Int32 depth);
+
+  // Builds the subtree for primitives [start, end) and returns the child
+  // pointer to it as stored in the flat BVH.
+  vtkm::Int32 BuildNode(vtkm::Id start, vtkm::Id end, vtkm::Int32 depth, Box& bounds);
+
+  vtkm::Int32 MakeLeaf(vtkm::Id start, vtkm::Id end);
+
+  std::vector<Box> PrimBounds;
+  std::vector<vtkm::Vec3f_32> Centroids;
+  std::vector<vtkm::Id> PrimIds;
+  std::vector<vtkm::Vec4f_32> FlatBVH;
+  std::vector<vtkm::Id> Leafs;
+}; // class SAHBVHBuilder
+
+vtkm::Id SAHBVHBuilder::Split(vtkm::Id start, vtkm::Id end, const Box& bounds, vtkm::Int32 depth)
+{
+  const vtkm::Id count = end - start;
+  auto first = this->PrimIds.begin() + start;
+  auto last = this->PrimIds.begin() + end;
+
+  Box centroidBounds;
+  for (vtkm::Id i = start; i < end; ++i)
+  {
+    centroidBounds.Include(this->Centroids[static_cast<std::size_t>(this->PrimIds[i])]);
+  }
+  vtkm::Vec3f_32 extent = centroidBounds.Max - centroidBounds.Min;
+  vtkm::IdComponent largestAxis = 0;
+  for (vtkm::IdComponent axis = 1; axis < 3; ++axis)
+  {
+    if (extent[axis] > extent[largestAxis])
+    {
+      largestAxis = axis;
+    }
+  }
+
+  auto medianSplit = [&]() {
+    vtkm::Id half = count / 2;
+    std::nth_element(first, first + half, last, [&](vtkm::Id a, vtkm::Id b) {
+      return this->Centroids[static_cast<std::size_t>(a)][largestAxis] <
+        this->Centroids[static_cast<std::size_t>(b)][largestAxis];
+    });
+    return half;
+  };
+
+  if (extent[largestAxis] <= 0.f)
+  {
+    // All centroids coincide, so no plane separates them.
+    return (count <= MaxLeafSize) ? 0 : count / 2;
+  }
+  if (depth >= MaxSAHDepth)
+  {
+    return medianSplit();
+  }
+
+  // Costs are relative to the area of the node, in units of one primitive
+  // intersection.
+  const vtkm::Float32 invArea = 1.f / vtkm::Max(bounds.HalfArea(), vtkm::Epsilon32());
+  vtkm::Float32 bestCost = vtkm::Infinity32();
+  vtkm::IdComponent bestAxis = -1;
+  vtkm::Int32 bestBin = 0;
+
+  for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+  {
+    if (extent[axis] <= 0.f)
+    {
+      continue;
+    }
+    const vtkm::Float32 scale = vtkm::Float32(NumBins) * (1.f - 1e-5f) / extent[axis];
+    Box binBounds[NumBins];
+    vtkm::Id binCounts[NumBins] = {};
+    for (vtkm::Id i = start; i < end; ++i)
+    {
+      std::size_t prim = static_cast<std::size_t>(this->PrimIds[i]);
+      vtkm::Int32 bin = static_cast<vtkm::Int32>(
+        (this->Centroids[prim][axis] - centroidBounds.Min[axis]) * scale);
+      bin = vtkm::Min(bin, NumBins - 1);
+      binBounds[bin].Include(this->PrimBounds[prim]);
+      binCounts[bin]++;
+    }
+
+    // Sweep from the right to get the cost of everything above each plane.
+    vtkm::Float32 rightCosts[NumBins];
+    Box right;
+    vtkm::Id rightCount = 0;
+    for (vtkm::Int32 bin = NumBins - 1; bin > 0; --bin)
+    {
+      right.Include(binBounds[bin]);
+      rightCount += binCounts[bin];
+      rightCosts[bin] = right.HalfArea() * vtkm::Float32(rightCount);
+    }
+
+    Box left;
+    vtkm::Id leftCount = 0;
+    for (vtkm::Int32 bin = 0; bin < NumBins - 1; ++bin)
+    {
+      left.Include(binBounds[bin]);
+      leftCount += binCounts[bin];
+      vtkm::Float32 cost = left.HalfArea() * vtkm::Float32(leftCount) + rightCosts[bin + 1];
+      if (leftCount > 0 && leftCount < count && cost < bestCost)
+      {
+        bestCost = cost;
+        bestAxis = axis;
+        bestBin = bin;
+      }
+    }
+  }
+
+  if (bestAxis < 0)
+  {
+    return medianSplit();
+  }
+
+  bestCost = TraversalCost + bestCost * invArea;
+  if (count <= MaxLeafSize && bestCost >= vtkm::Float32(count))
+  {
+    return 0;
+  }
+
+  const vtkm::Float32 scale = vtkm::Float32(NumBins) * (1.f - 1e-5f) / extent[bestAxis];
+  auto middle = std::partition(first, last, [&](vtkm::Id prim) {
+    vtkm::Int32 bin = static_cast<vtkm::Int32>(
+      (this->Centroids[static_cast<std::size_t>(prim)][bestAxis] - centroidBounds.Min[bestAxis]) *
+      scale);
+    return vtkm::Min(bin, NumBins - 1) <= bestBin;
+  });
+  return static_cast<vtkm::Id>(middle - first);
+}
+
+vtkm::Int32 SAHBVHBuilder::MakeLeaf(vtkm::Id start, vtkm::Id end)
+{
+  vtkm::Id offset = static_cast<vtkm::Id>(this->Leafs.size());
+  this->Leafs.push_back(end - start);
+  this->Leafs.insert(this->Leafs.end(), this->PrimIds.begin() + start, this->PrimIds.begin() + end);
+  return static_cast<vtkm::Int32>(-(offset + 1));
+}
+
+vtkm::Int32 SAHBVHBuilder::BuildNode(vtkm::Id start, vtkm::Id end, vtkm::Int32 depth, Box& bounds)
+{
+  for (vtkm::Id i = start; i < end; ++i)
+  {
+    bounds.Include(this->PrimBounds[static_cast<std::size_t>(this->PrimIds[i])]);
+  }
+
+  vtkm::Id leftCount = this->Split(start, end, bounds, depth);
+  if (leftCount == 0)
+  {
+    return this->MakeLeaf(start, end);
+  }
+
+  // Inner nodes are stored depth first, so the left child follows its parent.
+  std::size_t node = this->FlatBVH.size();
+  this->FlatBVH.resize(node + 4);
+
+  Box leftBounds, rightBounds;
+  vtkm::Int32 leftChild = this->BuildNode(start, start + leftCount, depth + 1, leftBounds);
+  vtkm::Int32 rightChild = this->BuildNode(start + leftCount, end, depth + 1, rightBounds);
+
+  this->FlatBVH[node] =
+    vtkm::Vec4f_32(leftBounds.Min[0], leftBounds.Min[1], leftBounds.Min[2], leftBounds.Max[0]);
+  this->FlatBVH[node + 1] =
+    vtkm::Vec4f_32(leftBounds.Max[1], leftBounds.Max[2], rightBounds.Min[0], rightBounds.Min[1]);
+  this->FlatBVH[node + 2] =
+    vtkm::Vec4f_32(rightBounds.Min[2], rightBounds.Max[0], rightBounds.Max[1], rightBounds.Max[2]);
+  vtkm::Vec4f_32 children(0.f);
+  memcpy(&children[0], &leftChild, 4);
+  memcpy(&children[1], &rightChild, 4);
+  this->FlatBVH[node + 3] = children;
+
+  return static_cast<vtkm::Int32>(node);
+}
+
+VTKM_CONT void SAHBVHBuilder::Build(LinearBVH& linearBVH)
+{
+  const vtkm::Id numberOfAABBs = linearBVH.GetNumberOfAABBs();
+  AABBs& aabbs = linearBVH.GetAABBs();
+  auto xmins = aabbs.xmins.ReadPortal();
+  auto ymins = aabbs.ymins.ReadPortal();
+  auto zmins = aabbs.zmins.ReadPortal();
+  auto xmaxs = aabbs.xmaxs.ReadPortal();
+  auto ymaxs = aabbs.ymaxs.ReadPortal();
+  auto zmaxs = aabbs.zmaxs.ReadPortal();
+
+  const std::size_t size = static_cast<std::size_t>(numberOfAABBs);
+  this->PrimBounds.resize(size);
+  this->Centroids.resize(size);
+  this->PrimIds.resize(size);
+  for (vtkm::Id i = 0; i < numberOfAABBs; ++i)
+  {
+    Box& box = this->PrimBounds[static_cast<std::size_t>(i)];
+    box.Min = vtkm::Vec3f_32(xmins.Get(i), ymins.Get(i), zmins.Get(i));
+    box.Max = vtkm::Vec3f_32(xmaxs.Get(i), ymaxs.Get(i), zmaxs.Get(i));
+    this->Centroids[static_cast<std::size_t>(i)] = (box.Min + box.Max) * 0.5f;
+    this->PrimIds[static_cast<std::size_t>(i)] = i;
+  }
+
+  Box totalBounds;
+  vtkm::Int32 root = this->BuildNode(0, numberOfAABBs, 0, totalBounds);
+  if (root < 0)
+  {
+    // The traversal starts at an inner node, so a tree that is a single leaf
+    // gets a root with that leaf as both children.
+    vtkm::Vec4f_32 children(0.f);
+    memcpy(&children[0], &root, 4);
+    memcpy(&children[1], &root, 4);
+    this->FlatBVH = { vtkm::Vec4f_32(totalBounds.Min[0],
+                                     totalBounds.Min[1],
+                                     totalBounds.Min[2],
+                                     totalBounds.Max[0]),
+                      vtkm::Vec4f_32(totalBounds.Max[1],
+                                     totalBounds.Max[2],
+                                     totalBounds.Min[0],
+                                     totalBounds.Min[1]),
+                      vtkm::Vec4f_32(totalBounds.Min[2],
+                                     totalBounds.Max[0],
+                                     totalBounds.Max[1],
+                                     totalBounds.Max[2]),
+                      children };
+  }
+
+  linearBVH.TotalBounds.X.Min = totalBounds.Min[0];
+  linearBVH.TotalBounds.X.Max = totalBounds.Max[0];
+  linearBVH.TotalBounds.Y.Min = totalBounds.Min[1];
+  linearBVH.TotalBounds.Y.Max = totalBounds.Max[1];
+  linearBVH.TotalBounds.Z.Min = totalBounds.Min[2];
+  linearBVH.TotalBounds.Z.Max = totalBounds.Max[2];
+
+  linearBVH.FlatBVH = vtkm::cont::make_ArrayHandle(this->FlatBVH, vtkm::CopyFlag::On);
+  linearBVH.Leafs = vtkm::cont::make_ArrayHandle(this->Leafs, vtkm::CopyFlag::On);
+  // A binary tree has one leaf more than inner nodes, except for the single
+  // leaf that has the added root as both children.
+  linearBVH.LeafCount = (root < 0) ? 1 : static_cast<vtkm::Id>(this->FlatBVH.size() / 4) + 1;
+}
 } //namespace detail
 
 LinearBVH::LinearBVH()
   : IsConstructed(false)
-  , CanConstruct(false){};
+  , CanConstruct(false)
+  , Builder(BVHBuilderType::LBVH){};
 
 VTKM_CONT
 LinearBVH::LinearBVH(AABBs& aabbs)
   : AABB(aabbs)
   , IsConstructed(false)
   , CanConstruct(true)
+  , Builder(BVHBuilderType::LBVH)
 {
 }
 
@@ -716,6 +1014,7 @@ LinearBVH::LinearBVH(const LinearBVH& other)
   , LeafCount(other.LeafCount)
   , IsConstructed(other.IsConstructed)
   , CanConstruct(other.CanConstruct)
+  , Builder(other.Builder)
 {
 }
 
@@ -733,8 +1032,16 @@ void LinearBVH::Construct()
     throw vtkm::cont::ErrorBadValue(
       "Linear BVH: coordinates and triangles must be set before calling construct!");
 
-  detail::LinearBVHBuilder builder;
-  builder.Build(*this);
+  if (this->Builder == BVHBuilderType::BinnedSAH)
+  {
+    detail::SAHBVHBuilder builder;
+    builder.Build(*this);
+  }
+  else
+  {
+    detail::LinearBVHBuilder builder;
+    builder.Build(*this);
+  }
 }
 
 VTKM_CONT
@@ -776,6 +1083,19 @@ AABBs& LinearBVH::GetAABBs()
 {
   return AABB;
 }
+
+VTKM_CONT
+void LinearBVH::SetBuilder(BVHBuilderType builder)
+{
+  this->Builder = builder;
+  IsConstructed = false;
+}
+
+VTKM_CONT
+BVHBuilderType LinearBVH::GetBuilder() const
+{
+  return this->Builder;
+}
 }
 }
 } // namespace vtkm::rendering::raytracing
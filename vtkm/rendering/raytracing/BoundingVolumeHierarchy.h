@@ -31,6 +31,22 @@ struct AABBs
   vtkm::cont::ArrayHandle<vtkm::Float32> zmaxs;
 };
 
+//
+// Algorithms that can build a LinearBVH. Both produce the same flat
+// layout, so the traversal does not depend on the choice.
+//
+enum class BVHBuilderType
+{
+  // Bottom-up build from the Morton codes of the AABB centroids. Fast to
+  // build on any device, but the tree follows the Morton curve rather than
+  // the geometry, which hurts traversal for very non-uniform primitives.
+  LBVH,
+  // Top-down build that splits each node at the best of a few candidate
+  // planes under the surface area heuristic. The build runs on the host and
+  // is several times slower, but produces trees that are faster to traverse.
+  BinnedSAH
+};
+
 //
 // This is the data structure that is passed to the ray tracer.
 //
@@ -48,6 +64,7 @@ public:
 protected:
   bool IsConstructed;
   bool CanConstruct;
+  BVHBuilderType Builder;
 
 public:
   LinearBVH();
@@ -69,6 +86,12 @@ public:
   VTKM_CONT
   AABBs& GetAABBs();
 
+  VTKM_CONT
+  void SetBuilder(BVHBuilderType builder);
+
+  VTKM_CONT
+  BVHBuilderType GetBuilder() const;
+
   VTKM_CONT
   bool GetIsConstructed() const;
 
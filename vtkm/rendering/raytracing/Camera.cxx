@@ -42,6 +42,7 @@ public:
   vtkm::Int32 Minx;
   vtkm::Int32 Miny;
   vtkm::Int32 SubsetWidth;
+  vtkm::Int32 SubsetHeight;
   vtkm::Vec3f_32 nlook; // normalized look
   vtkm::Vec3f_32 delta_x;
   vtkm::Vec3f_32 delta_y;
@@ -328,6 +329,7 @@ public:
   vtkm::Int32 Minx;
   vtkm::Int32 Miny;
   vtkm::Int32 SubsetWidth;
+  vtkm::Int32 SubsetHeight;
   vtkm::Vec3f_32 nlook; // normalized look
   vtkm::Vec3f_32 delta_x;
   vtkm::Vec3f_32 delta_y;
@@ -340,6 +342,7 @@ public:
                     vtkm::Vec3f_32 up,
                     vtkm::Float32 _zoom,
                     vtkm::Int32 subsetWidth,
+                    vtkm::Int32 subsetHeight,
                     vtkm::Int32 minx,
                     vtkm::Int32 miny)
     : w(width)
@@ -347,6 +350,7 @@ public:
     , Minx(minx)
     , Miny(miny)
     , SubsetWidth(subsetWidth)
+    , SubsetHeight(subsetHeight)
   {
     vtkm::Float32 thx = tanf((fovX * vtkm::Pi_180f()) * .5f);
     vtkm::Float32 thy = tanf((fovY * vtkm::Pi_180f()) * .5f);
@@ -371,6 +375,37 @@ public:
     vtkm::Normalize(nlook);
   }
 
+  // Finds the pixel of the subset that ray idx goes through. The largest part of the subset
+  // that is a whole number of tiles is covered first, tile by tile, then the pixels right of
+  // it and then the rows below it.
+  VTKM_EXEC void TiledPixel(vtkm::Int32 idx, vtkm::Int32& i, vtkm::Int32& j) const
+  {
+    constexpr vtkm::Int32 tileSize = Camera::RayTileWidth * Camera::RayTileHeight;
+    const vtkm::Int32 tiledWidth = SubsetWidth - SubsetWidth % Camera::RayTileWidth;
+    const vtkm::Int32 tiledHeight = SubsetHeight - SubsetHeight % Camera::RayTileHeight;
+    const vtkm::Int32 tiledCount = tiledWidth * tiledHeight;
+    if (idx < tiledCount)
+    {
+      const vtkm::Int32 tilesPerRow = tiledWidth / Camera::RayTileWidth;
+      const vtkm::Int32 tile = idx / tileSize;
+      const vtkm::Int32 inTile = idx % tileSize;
+      i = (tile % tilesPerRow) * Camera::RayTileWidth + inTile % Camera::RayTileWidth;
+      j = (tile / tilesPerRow) * Camera::RayTileHeight + inTile / Camera::RayTileWidth;
+      return;
+    }
+    idx -= tiledCount;
+    const vtkm::Int32 rightWidth = SubsetWidth - tiledWidth;
+    if (idx < rightWidth * tiledHeight)
+    {
+      i = tiledWidth + idx % rightWidth;
+      j = idx / rightWidth;
+      return;
+    }
+    idx -= rightWidth * tiledHeight;
+    i = idx % SubsetWidth;
+    j = tiledHeight + idx / SubsetWidth;
+  }
+
   using ControlSignature = void(FieldOut, FieldOut, FieldOut, FieldOut);
 
   using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4);
@@ -382,8 +417,8 @@ public:
                             vtkm::Id& pixelIndex) const
   {
     vtkm::Vec<Precision, 3> ray_dir(rayDirX, rayDirY, rayDirZ);
-    int i = vtkm::Int32(idx) % SubsetWidth;
-    int j = vtkm::Int32(idx) / SubsetWidth;
+    int i, j;
+    this->TiledPixel(vtkm::Int32(idx), i, j);
     i += Minx;
     j += Miny;
     // Write out the global pixelId
@@ -816,6 +851,7 @@ VTKM_CONT void Camera::CreateRaysImpl(Ray<Precision>& rays, const vtkm::Bounds b
                         this->Up,
                         this->Zoom,
                         this->SubsetWidth,
+                        this->SubsetHeight,
                         this->SubsetMinX,
                         this->SubsetMinY));
     dispatcher.Invoke(rays.DirX, rays.DirY, rays.DirZ, rays.PixelIdx); //X Y Z
@@ -52,6 +52,12 @@ public:
   VTKM_CONT
   ~Camera();
 
+  /// Perspective rays are generated in tiles of RayTileWidth x RayTileHeight pixels, so that
+  /// consecutive rays are close to each other and can be traced together as a packet. Pixels
+  /// of the subset that do not fill a whole tile follow the tiles, in scanline order.
+  static constexpr vtkm::Int32 RayTileWidth = 4;
+  static constexpr vtkm::Int32 RayTileHeight = 2;
+
   // cuda does not compile if this is private
   class PerspectiveRayGen;
   class Ortho2DRayGen;
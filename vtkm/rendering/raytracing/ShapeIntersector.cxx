@@ -82,6 +82,16 @@ void ShapeIntersector::IntersectionPointImp(Ray<Precision>& rays)
             rays.MaxDistance);
 }
 
+void ShapeIntersector::SetBVHBuilder(BVHBuilderType builder)
+{
+  this->BVH.SetBuilder(builder);
+}
+
+BVHBuilderType ShapeIntersector::GetBVHBuilder() const
+{
+  return this->BVH.GetBuilder();
+}
+
 vtkm::Bounds ShapeIntersector::GetShapeBounds() const
 {
   return ShapeBounds;
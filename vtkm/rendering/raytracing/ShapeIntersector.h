@@ -34,6 +34,13 @@ public:
   ShapeIntersector();
   virtual ~ShapeIntersector();
 
+  //
+  // Selects the algorithm that builds the BVH over the shapes. This must be
+  // set before SetData, which builds the BVH. The default is the LBVH builder.
+  //
+  void SetBVHBuilder(BVHBuilderType builder);
+  BVHBuilderType GetBVHBuilder() const;
+
   //
   //  Intersect Rays finds the nearest intersection shape contained in the derived
   //  class in between min and max distances. HitIdx will be set to the local
@@ -79,6 +79,45 @@ public:
       }
     } // for
   }
+
+  // The watertight test permutes the coordinates differently for each ray, so the rays of
+  // the packet are intersected one at a time.
+  template <typename PointPortalType, typename LeafPortalType, typename PacketType>
+  VTKM_EXEC inline void IntersectLeafPacket(const vtkm::Int32& currentNode,
+                                            PacketType& packet,
+                                            const PointPortalType& points,
+                                            LeafPortalType leafs) const
+  {
+    using Precision = typename PacketType::Precision;
+    const vtkm::Id triangleCount = leafs.Get(currentNode);
+    WaterTight intersector;
+    for (vtkm::Id i = 1; i <= triangleCount; ++i)
+    {
+      const vtkm::Id triIndex = leafs.Get(currentNode + i);
+      vtkm::Vec<Id, 4> triangle = Triangles.Get(triIndex);
+      vtkm::Vec<Precision, 3> a = vtkm::Vec<Precision, 3>(points.Get(triangle[1]));
+      vtkm::Vec<Precision, 3> b = vtkm::Vec<Precision, 3>(points.Get(triangle[2]));
+      vtkm::Vec<Precision, 3> c = vtkm::Vec<Precision, 3>(points.Get(triangle[3]));
+      for (vtkm::IdComponent lane = 0; lane < PacketType::Size; ++lane)
+      {
+        const vtkm::Vec<Precision, 3> origin(
+          packet.OriginX[lane], packet.OriginY[lane], packet.OriginZ[lane]);
+        const vtkm::Vec<Precision, 3> dir(packet.DirX[lane], packet.DirY[lane], packet.DirZ[lane]);
+        Precision distance = -1.;
+        Precision u, v;
+
+        intersector.IntersectTri(a, b, c, dir, distance, u, v, origin);
+        if (distance != -1. && distance < packet.Distance[lane] &&
+            distance > packet.MinDistance[lane])
+        {
+          packet.Distance[lane] = distance;
+          packet.U[lane] = u;
+          packet.V[lane] = v;
+          packet.HitIndex[lane] = triIndex;
+        }
+      }
+    } // for
+  }
 };
 
 template <typename Device>
@@ -133,6 +172,56 @@ public:
       }
     } // for
   }
+
+  // Same test as Moller::IntersectTri, written without branches so that the loop over the
+  // rays of the packet vectorizes.
+  template <typename PointPortalType, typename LeafPortalType, typename PacketType>
+  VTKM_EXEC inline void IntersectLeafPacket(const vtkm::Int32& currentNode,
+                                            PacketType& packet,
+                                            const PointPortalType& points,
+                                            LeafPortalType leafs) const
+  {
+    using Precision = typename PacketType::Precision;
+    const Precision EPSILON2 = 0.0001f;
+    const vtkm::Id triangleCount = leafs.Get(currentNode);
+    for (vtkm::Id i = 1; i <= triangleCount; ++i)
+    {
+      const vtkm::Id triIndex = leafs.Get(currentNode + i);
+      vtkm::Vec<Id, 4> triangle = Triangles.Get(triIndex);
+      const vtkm::Vec<Precision, 3> a = vtkm::Vec<Precision, 3>(points.Get(triangle[1]));
+      const vtkm::Vec<Precision, 3> e1 = vtkm::Vec<Precision, 3>(points.Get(triangle[2])) - a;
+      const vtkm::Vec<Precision, 3> e2 = vtkm::Vec<Precision, 3>(points.Get(triangle[3])) - a;
+
+      for (vtkm::IdComponent lane = 0; lane < PacketType::Size; ++lane)
+      {
+        const Precision px = packet.DirY[lane] * e2[2] - packet.DirZ[lane] * e2[1];
+        const Precision py = packet.DirZ[lane] * e2[0] - packet.DirX[lane] * e2[2];
+        const Precision pz = packet.DirX[lane] * e2[1] - packet.DirY[lane] * e2[0];
+        const Precision dot = e1[0] * px + e1[1] * py + e1[2] * pz;
+        const Precision invDot = 1.f / dot;
+
+        const Precision tx = packet.OriginX[lane] - a[0];
+        const Precision ty = packet.OriginY[lane] - a[1];
+        const Precision tz = packet.OriginZ[lane] - a[2];
+        const Precision u = (tx * px + ty * py + tz * pz) * invDot;
+
+        const Precision qx = ty * e1[2] - tz * e1[1];
+        const Precision qy = tz * e1[0] - tx * e1[2];
+        const Precision qz = tx * e1[1] - ty * e1[0];
+        const Precision v =
+          (packet.DirX[lane] * qx + packet.DirY[lane] * qy + packet.DirZ[lane] * qz) * invDot;
+        const Precision distance = (e2[0] * qx + e2[1] * qy + e2[2] * qz) * invDot;
+
+        const bool hit = (dot != 0.f) & (u >= (0.f - EPSILON2)) & (u <= (1.f + EPSILON2)) &
+          (v >= (0.f - EPSILON2)) & (v <= (1.f + EPSILON2)) & !(u + v > 1.f) &
+          (distance < packet.Distance[lane]) & (distance > packet.MinDistance[lane]);
+        packet.Distance[lane] = hit ? distance : packet.Distance[lane];
+        packet.U[lane] = hit ? u : packet.U[lane];
+        packet.V[lane] = hit ? v : packet.V[lane];
+        packet.HitIndex[lane] = hit ? triIndex : packet.HitIndex[lane];
+      }
+    } // for
+  }
 };
 
 class MollerExecWrapper : public vtkm::cont::ExecutionObjectBase
@@ -463,6 +552,7 @@ public:
 
 TriangleIntersector::TriangleIntersector()
   : UseWaterTight(false)
+  , UsePacketTraversal(true)
 {
 }
 
@@ -471,6 +561,16 @@ void TriangleIntersector::SetUseWaterTight(bool useIt)
   UseWaterTight = useIt;
 }
 
+void TriangleIntersector::SetUsePacketTraversal(bool useIt)
+{
+  UsePacketTraversal = useIt;
+}
+
+bool TriangleIntersector::GetUsePacketTraversal() const
+{
+  return UsePacketTraversal;
+}
+
 void TriangleIntersector::SetData(const vtkm::cont::CoordinateSystem& coords,
                                   vtkm::cont::ArrayHandle<vtkm::Id4> triangles)
 {
@@ -517,14 +617,28 @@ VTKM_CONT void TriangleIntersector::IntersectRaysImp(Ray<Precision>& rays, bool
   {
     detail::WaterTightExecWrapper leafIntersector(this->Triangles);
     BVHTraverser traverser;
-    traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    if (UsePacketTraversal)
+    {
+      traverser.IntersectRayPackets(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    }
+    else
+    {
+      traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    }
   }
   else
   {
     detail::MollerExecWrapper leafIntersector(this->Triangles);
 
     BVHTraverser traverser;
-    traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    if (UsePacketTraversal)
+    {
+      traverser.IntersectRayPackets(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    }
+    else
+    {
+      traverser.IntersectRays(rays, this->BVH, leafIntersector, this->CoordsHandle);
+    }
   }
   // Normally we return the index of the triangle hit,
   // but in some cases we are only interested in the cell
@@ -27,12 +27,18 @@ class VTKM_RENDERING_EXPORT TriangleIntersector : public ShapeIntersector
 protected:
   vtkm::cont::ArrayHandle<vtkm::Id4> Triangles;
   bool UseWaterTight;
+  bool UsePacketTraversal;
 
 public:
   TriangleIntersector();
 
   void SetUseWaterTight(bool useIt);
 
+  /// Traces packets of consecutive rays together on CPU devices (on by default). Other devices
+  /// always trace rays one by one.
+  void SetUsePacketTraversal(bool useIt);
+  bool GetUsePacketTraversal() const;
+
   void SetData(const vtkm::cont::CoordinateSystem& coords,
                vtkm::cont::ArrayHandle<vtkm::Id4> triangles);
 
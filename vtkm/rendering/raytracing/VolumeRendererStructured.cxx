@@ -14,10 +14,12 @@
 #include <stdio.h>
 #include <vtkm/cont/ArrayHandleCartesianProduct.h>
 #include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ColorTable.h>
 #include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/Timer.h>
 #include <vtkm/cont/TryExecute.h>
 #include <vtkm/rendering/raytracing/Camera.h>
@@ -180,6 +182,21 @@ public:
       (cell[2] * PointDimensions[1] + cell[1]) * PointDimensions[0] + cell[0];
     point = Coordinates.Get(pointIndex);
   }
+
+  VTKM_EXEC
+  inline void GetMacroCellBounds(const vtkm::Id3& macroCell,
+                                 const vtkm::Id& macroCellSize,
+                                 vtkm::Vec3f_32& minPoint,
+                                 vtkm::Vec3f_32& maxPoint) const
+  {
+    for (vtkm::Int32 dim = 0; dim < 3; ++dim)
+    {
+      const vtkm::Id begin = macroCell[dim] * macroCellSize;
+      const vtkm::Id end = vtkm::Min(begin + macroCellSize, PointDimensions[dim] - 1);
+      minPoint[dim] = static_cast<vtkm::Float32>(CoordPortals[dim].Get(begin));
+      maxPoint[dim] = static_cast<vtkm::Float32>(CoordPortals[dim].Get(end));
+    }
+  }
 }; // class RectilinearLocator
 
 template <typename Device>
@@ -191,6 +208,7 @@ protected:
 
   vtkm::Id3 PointDimensions;
   vtkm::Vec3f_32 Origin;
+  vtkm::Vec3f_32 Spacing;
   vtkm::Vec3f_32 InvSpacing;
   vtkm::Vec3f_32 MaxPoint;
   UniformConstPortal Coordinates;
@@ -210,6 +228,7 @@ public:
     Origin = Coordinates.GetOrigin();
     PointDimensions = Conn.GetPointDimensions();
     vtkm::Vec3f_32 spacing = Coordinates.GetSpacing();
+    Spacing = spacing;
 
     vtkm::Vec3f_32 unitLength;
     unitLength[0] = static_cast<vtkm::Float32>(PointDimensions[0] - 1);
@@ -287,11 +306,218 @@ public:
     point = Coordinates.Get(pointIndex);
   }
 
+  VTKM_EXEC
+  inline void GetMacroCellBounds(const vtkm::Id3& macroCell,
+                                 const vtkm::Id& macroCellSize,
+                                 vtkm::Vec3f_32& minPoint,
+                                 vtkm::Vec3f_32& maxPoint) const
+  {
+    for (vtkm::Int32 dim = 0; dim < 3; ++dim)
+    {
+      const vtkm::Id begin = macroCell[dim] * macroCellSize;
+      minPoint[dim] = Origin[dim] + Spacing[dim] * static_cast<vtkm::Float32>(begin);
+      maxPoint[dim] = vtkm::Min(
+        Origin[dim] + Spacing[dim] * static_cast<vtkm::Float32>(begin + macroCellSize),
+        MaxPoint[dim]);
+    }
+  }
+
 }; // class UniformLocator
 
+//
+// Flags the macro cells whose samples are all fully transparent. Macro cells group
+// MacroCellSize^3 cells of the structured grid.
+//
+template <typename Device>
+class MacroCellGrid
+{
+protected:
+  using FlagHandle = vtkm::cont::ArrayHandle<vtkm::UInt8>;
+  using FlagPortal = typename FlagHandle::ReadPortalType;
+
+  FlagPortal EmptyFlags;
+  vtkm::Id3 Dims;
+  vtkm::Id Size;
+  vtkm::Float32 InvSize;
+
+public:
+  // A size of 0 disables skipping.
+  MacroCellGrid(const FlagHandle& emptyFlags,
+                const vtkm::Id3& dims,
+                const vtkm::Id& size,
+                vtkm::cont::Token& token)
+    : EmptyFlags(emptyFlags.PrepareForInput(Device(), token))
+    , Dims(dims)
+    , Size(size)
+    , InvSize(size > 0 ? 1.f / static_cast<vtkm::Float32>(size) : 0.f)
+  {
+  }
+
+  VTKM_EXEC
+  inline bool IsEmpty(const vtkm::Id3& cell, vtkm::Id3& macroCell) const
+  {
+    if (Size == 0)
+    {
+      return false;
+    }
+    // integer division is slow on CPUs, and the half cell offset keeps the rounded
+    // quotient exact
+    macroCell[0] = static_cast<vtkm::Id>((static_cast<vtkm::Float32>(cell[0]) + 0.5f) * InvSize);
+    macroCell[1] = static_cast<vtkm::Id>((static_cast<vtkm::Float32>(cell[1]) + 0.5f) * InvSize);
+    macroCell[2] = static_cast<vtkm::Id>((static_cast<vtkm::Float32>(cell[2]) + 0.5f) * InvSize);
+    const vtkm::Id index = (macroCell[2] * Dims[1] + macroCell[1]) * Dims[0] + macroCell[0];
+    BOUNDS_CHECK(EmptyFlags, index);
+    return EmptyFlags.Get(index) != 0;
+  }
+
+  VTKM_EXEC
+  static inline vtkm::Vec3f_32 InverseDirection(const vtkm::Vec3f_32& rayDir)
+  {
+    vtkm::Vec3f_32 invDir;
+    for (vtkm::Int32 dim = 0; dim < 3; ++dim)
+    {
+      invDir[dim] = 1.f / ((vtkm::Abs(rayDir[dim]) < 1e-8f) ? 1e-8f : rayDir[dim]);
+    }
+    return invDir;
+  }
+
+  //
+  // Returns the first distance on the lattice of samples of the ray (firstDistance plus a
+  // multiple of sampleDistance) past the macro cell, and at least one step past distance.
+  //
+  template <typename LocatorType>
+  VTKM_EXEC inline vtkm::Float32 NextSampleDistance(const LocatorType& locator,
+                                                    const vtkm::Id3& macroCell,
+                                                    const vtkm::Vec3f_32& rayOrigin,
+                                                    const vtkm::Vec3f_32& invDir,
+                                                    const vtkm::Float32& firstDistance,
+                                                    const vtkm::Float32& distance,
+                                                    const vtkm::Float32& sampleDistance) const
+  {
+    vtkm::Vec3f_32 minPoint;
+    vtkm::Vec3f_32 maxPoint;
+    locator.GetMacroCellBounds(macroCell, Size, minPoint, maxPoint);
+    const vtkm::Vec3f_32 t0 = (minPoint - rayOrigin) * invDir;
+    const vtkm::Vec3f_32 t1 = (maxPoint - rayOrigin) * invDir;
+    const vtkm::Float32 exitDistance = vtkm::Min(
+      vtkm::Min(vtkm::Max(t0[0], t1[0]), vtkm::Max(t0[1], t1[1])), vtkm::Max(t0[2], t1[2]));
+    const vtkm::Float32 steps = vtkm::Ceil((exitDistance - firstDistance) / sampleDistance);
+    return vtkm::Max(firstDistance + steps * sampleDistance, distance + sampleDistance);
+  }
+}; // class MacroCellGrid
 
 } //namespace
 
+//
+// Computes the range of the scalars that can be sampled in each macro cell. With point
+// scalars, a macro cell also covers the points on its far faces.
+//
+class MacroCellRange : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Id3 ScalarDims;
+  vtkm::Id3 MacroCellDims;
+  vtkm::Id MacroCellSize;
+  vtkm::Id Overlap;
+
+public:
+  VTKM_CONT
+  MacroCellRange(const vtkm::Id3& scalarDims,
+                 const vtkm::Id3& macroCellDims,
+                 const vtkm::Id& macroCellSize,
+                 bool isAssocPoints)
+    : ScalarDims(scalarDims)
+    , MacroCellDims(macroCellDims)
+    , MacroCellSize(macroCellSize)
+    , Overlap(isAssocPoints ? 1 : 0)
+  {
+  }
+
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename ScalarPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& macroCellId,
+                            const ScalarPortalType& scalars,
+                            vtkm::Vec2f_32& range) const
+  {
+    vtkm::Id3 begin;
+    begin[0] = (macroCellId % MacroCellDims[0]) * MacroCellSize;
+    begin[1] = ((macroCellId / MacroCellDims[0]) % MacroCellDims[1]) * MacroCellSize;
+    begin[2] = (macroCellId / (MacroCellDims[0] * MacroCellDims[1])) * MacroCellSize;
+    vtkm::Id3 end;
+    for (vtkm::Int32 dim = 0; dim < 3; ++dim)
+    {
+      end[dim] = vtkm::Min(begin[dim] + MacroCellSize + Overlap, ScalarDims[dim]);
+    }
+
+    range[0] = vtkm::Infinity32();
+    range[1] = vtkm::NegativeInfinity32();
+    for (vtkm::Id z = begin[2]; z < end[2]; ++z)
+    {
+      for (vtkm::Id y = begin[1]; y < end[1]; ++y)
+      {
+        const vtkm::Id rowStart = (z * ScalarDims[1] + y) * ScalarDims[0];
+        for (vtkm::Id x = begin[0]; x < end[0]; ++x)
+        {
+          BOUNDS_CHECK(scalars, rowStart + x);
+          const vtkm::Float32 scalar = vtkm::Float32(scalars.Get(rowStart + x));
+          range[0] = vtkm::Min(range[0], scalar);
+          range[1] = vtkm::Max(range[1], scalar);
+        }
+      }
+    }
+  }
+}; //class MacroCellRange
+
+//
+// Flags a macro cell as empty when every color its scalar range maps to has zero opacity.
+// The samplers map scalars to colors the same way.
+//
+class MacroCellVisibility : public vtkm::worklet::WorkletMapField
+{
+  vtkm::Float32 MinScalar;
+  vtkm::Float32 InverseDeltaScalar;
+
+public:
+  VTKM_CONT
+  MacroCellVisibility(const vtkm::Float32& minScalar, const vtkm::Float32& inverseDeltaScalar)
+    : MinScalar(minScalar)
+    , InverseDeltaScalar(inverseDeltaScalar)
+  {
+  }
+
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename ColorPortalType>
+  VTKM_EXEC void operator()(const vtkm::Vec2f_32& range,
+                            const ColorPortalType& colorMap,
+                            vtkm::UInt8& empty) const
+  {
+    const vtkm::Id colorMapSize = colorMap.GetNumberOfValues() - 1;
+    const vtkm::Float32 size = static_cast<vtkm::Float32>(colorMapSize);
+    vtkm::Id index0 = static_cast<vtkm::Id>((range[0] - MinScalar) * InverseDeltaScalar * size);
+    vtkm::Id index1 = static_cast<vtkm::Id>((range[1] - MinScalar) * InverseDeltaScalar * size);
+    // The samplers clamp scalars outside of the scalar range to the end colors.
+    index0 = vtkm::Max(vtkm::Min(index0, colorMapSize), vtkm::Id(0));
+    index1 = vtkm::Max(vtkm::Min(index1, colorMapSize), vtkm::Id(0));
+    // Interpolated scalars can leave the range by a rounding error, so the neighboring
+    // colors are checked too.
+    const vtkm::Id first = vtkm::Max(vtkm::Min(index0, index1) - 1, vtkm::Id(0));
+    const vtkm::Id last = vtkm::Min(vtkm::Max(index0, index1) + 1, colorMapSize);
+
+    empty = 1;
+    for (vtkm::Id i = first; i <= last; ++i)
+    {
+      if (colorMap.Get(i)[3] > 0.f)
+      {
+        empty = 0;
+        break;
+      }
+    }
+  }
+}; //class MacroCellVisibility
+
 
 template <typename DeviceAdapterTag, typename LocatorType>
 class Sampler : public vtkm::worklet::WorkletMapField
@@ -305,7 +531,10 @@ private:
   vtkm::Float32 SampleDistance;
   vtkm::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  MacroCellGrid<DeviceAdapterTag> MacroCells;
   vtkm::Float32 MeshEpsilon;
+  vtkm::Float32 OpacityThreshold;
+  bool CountSamples;
 
 public:
   VTKM_CONT
@@ -314,14 +543,20 @@ public:
           const vtkm::Float32& maxScalar,
           const vtkm::Float32& sampleDistance,
           const LocatorType& locator,
+          const MacroCellGrid<DeviceAdapterTag>& macroCells,
           const vtkm::Float32& meshEpsilon,
+          const vtkm::Float32& opacityThreshold,
+          bool countSamples,
           vtkm::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
     , MinScalar(minScalar)
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , MacroCells(macroCells)
     , MeshEpsilon(meshEpsilon)
+    , OpacityThreshold(opacityThreshold)
+    , CountSamples(countSamples)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
     if ((maxScalar - minScalar) != 0.f)
@@ -330,18 +565,21 @@ public:
     }
   }
 
-  using ControlSignature = void(FieldIn, FieldIn, FieldIn, FieldIn, WholeArrayInOut, WholeArrayIn);
-  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
+  using ControlSignature =
+    void(FieldIn, FieldIn, FieldIn, FieldIn, WholeArrayInOut, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, WorkIndex);
 
-  template <typename ScalarPortalType, typename ColorBufferType>
+  template <typename ScalarPortalType, typename ColorBufferType, typename SampleCountPortalType>
   VTKM_EXEC void operator()(const vtkm::Vec3f_32& rayDir,
                             const vtkm::Vec3f_32& rayOrigin,
                             const vtkm::Float32& minDistance,
                             const vtkm::Float32& maxDistance,
                             ColorBufferType& colorBuffer,
                             ScalarPortalType& scalars,
+                            SampleCountPortalType& sampleCounts,
                             const vtkm::Id& pixelIndex) const
   {
+    vtkm::Id numSamples = 0;
     vtkm::Vec4f_32 color;
     BOUNDS_CHECK(colorBuffer, pixelIndex * 4 + 0);
     color[0] = colorBuffer.Get(pixelIndex * 4 + 0);
@@ -354,6 +592,8 @@ public:
 
     if (minDistance == -1.f)
     {
+      if (CountSamples)
+        sampleCounts.Set(pixelIndex, numSamples);
       return; //TODO: Compact? or just image subset...
     }
     //get the initial sample position;
@@ -369,6 +609,8 @@ public:
       distance += SampleDistance;
       sampleLocation = rayOrigin + distance * rayDir;
     }
+    const vtkm::Float32 firstDistance = distance;
+    const vtkm::Vec3f_32 invDir = MacroCellGrid<DeviceAdapterTag>::InverseDirection(rayDir);
     /*
             7----------6
            /|         /|
@@ -409,6 +651,15 @@ public:
 
         vtkm::Vec<vtkm::Id, 8> cellIndices;
         Locator.LocateCell(cell, sampleLocation, invSpacing);
+        vtkm::Id3 macroCell;
+        if (MacroCells.IsEmpty(cell, macroCell))
+        {
+          // no sample in the macro cell is visible, so move to the first sample past it
+          distance = MacroCells.NextSampleDistance(
+            Locator, macroCell, rayOrigin, invDir, firstDistance, distance, SampleDistance);
+          sampleLocation = rayOrigin + distance * rayDir;
+          continue;
+        }
         Locator.GetCellIndices(cell, cellIndices);
         Locator.GetPoint(cellIndices[0], bottomLeft);
 
@@ -461,6 +712,7 @@ public:
       color[1] = color[1] + sampleColor[1] * sampleColor[3];
       color[2] = color[2] + sampleColor[2] * sampleColor[3];
       color[3] = sampleColor[3] + color[3];
+      ++numSamples;
       //advance
       distance += SampleDistance;
       sampleLocation = sampleLocation + SampleDistance * rayDir;
@@ -470,7 +722,7 @@ public:
       ty = (sampleLocation[1] - bottomLeft[1]) * invSpacing[1];
       tz = (sampleLocation[2] - bottomLeft[2]) * invSpacing[2];
 
-      if (color[3] >= 1.f)
+      if (color[3] >= OpacityThreshold)
         break;
     }
 
@@ -487,6 +739,8 @@ public:
     colorBuffer.Set(pixelIndex * 4 + 2, color[2]);
     BOUNDS_CHECK(colorBuffer, pixelIndex * 4 + 3);
     colorBuffer.Set(pixelIndex * 4 + 3, color[3]);
+    if (CountSamples)
+      sampleCounts.Set(pixelIndex, numSamples);
   }
 }; //Sampler
 
@@ -502,7 +756,10 @@ private:
   vtkm::Float32 SampleDistance;
   vtkm::Float32 InverseDeltaScalar;
   LocatorType Locator;
+  MacroCellGrid<DeviceAdapterTag> MacroCells;
   vtkm::Float32 MeshEpsilon;
+  vtkm::Float32 OpacityThreshold;
+  bool CountSamples;
 
 public:
   VTKM_CONT
@@ -511,14 +768,20 @@ public:
                    const vtkm::Float32& maxScalar,
                    const vtkm::Float32& sampleDistance,
                    const LocatorType& locator,
+                   const MacroCellGrid<DeviceAdapterTag>& macroCells,
                    const vtkm::Float32& meshEpsilon,
+                   const vtkm::Float32& opacityThreshold,
+                   bool countSamples,
                    vtkm::cont::Token& token)
     : ColorMap(colorMap.PrepareForInput(DeviceAdapterTag(), token))
     , MinScalar(minScalar)
     , SampleDistance(sampleDistance)
     , InverseDeltaScalar(minScalar)
     , Locator(locator)
+    , MacroCells(macroCells)
     , MeshEpsilon(meshEpsilon)
+    , OpacityThreshold(opacityThreshold)
+    , CountSamples(countSamples)
   {
     ColorMapSize = colorMap.GetNumberOfValues() - 1;
     if ((maxScalar - minScalar) != 0.f)
@@ -526,18 +789,21 @@ public:
       InverseDeltaScalar = 1.f / (maxScalar - minScalar);
     }
   }
-  using ControlSignature = void(FieldIn, FieldIn, FieldIn, FieldIn, WholeArrayInOut, WholeArrayIn);
-  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, WorkIndex);
+  using ControlSignature =
+    void(FieldIn, FieldIn, FieldIn, FieldIn, WholeArrayInOut, WholeArrayIn, WholeArrayOut);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, WorkIndex);
 
-  template <typename ScalarPortalType, typename ColorBufferType>
+  template <typename ScalarPortalType, typename ColorBufferType, typename SampleCountPortalType>
   VTKM_EXEC void operator()(const vtkm::Vec3f_32& rayDir,
                             const vtkm::Vec3f_32& rayOrigin,
                             const vtkm::Float32& minDistance,
                             const vtkm::Float32& maxDistance,
                             ColorBufferType& colorBuffer,
                             const ScalarPortalType& scalars,
+                            SampleCountPortalType& sampleCounts,
                             const vtkm::Id& pixelIndex) const
   {
+    vtkm::Id numSamples = 0;
     vtkm::Vec4f_32 color;
     BOUNDS_CHECK(colorBuffer, pixelIndex * 4 + 0);
     color[0] = colorBuffer.Get(pixelIndex * 4 + 0);
@@ -549,7 +815,11 @@ public:
     color[3] = colorBuffer.Get(pixelIndex * 4 + 3);
 
     if (minDistance == -1.f)
+    {
+      if (CountSamples)
+        sampleCounts.Set(pixelIndex, numSamples);
       return; //TODO: Compact? or just image subset...
+    }
     //get the initial sample position;
     vtkm::Vec3f_32 sampleLocation;
     // find the distance to the first sample
@@ -563,6 +833,8 @@ public:
       distance += SampleDistance;
       sampleLocation = rayOrigin + distance * rayDir;
     }
+    const vtkm::Float32 firstDistance = distance;
+    const vtkm::Vec3f_32 invDir = MacroCellGrid<DeviceAdapterTag>::InverseDirection(rayDir);
 
     /*
             7----------6
@@ -591,6 +863,15 @@ public:
       if (newCell)
       {
         Locator.LocateCell(cell, sampleLocation, invSpacing);
+        vtkm::Id3 macroCell;
+        if (MacroCells.IsEmpty(cell, macroCell))
+        {
+          // no sample in the macro cell is visible, so move to the first sample past it
+          distance = MacroCells.NextSampleDistance(
+            Locator, macroCell, rayOrigin, invDir, firstDistance, distance, SampleDistance);
+          sampleLocation = rayOrigin + distance * rayDir;
+          continue;
+        }
         vtkm::Id cellId = Locator.GetCellIndex(cell);
 
         scalar0 = vtkm::Float32(scalars.Get(cellId));
@@ -615,11 +896,12 @@ public:
       color[1] = color[1] + sampleColor[1] * alpha;
       color[2] = color[2] + sampleColor[2] * alpha;
       color[3] = alpha + color[3];
+      ++numSamples;
       //advance
       distance += SampleDistance;
       sampleLocation = sampleLocation + SampleDistance * rayDir;
 
-      if (color[3] >= 1.f)
+      if (color[3] >= OpacityThreshold)
         break;
       tx = (sampleLocation[0] - bottomLeft[0]) * invSpacing[0];
       ty = (sampleLocation[1] - bottomLeft[1]) * invSpacing[1];
@@ -638,6 +920,8 @@ public:
     colorBuffer.Set(pixelIndex * 4 + 2, color[2]);
     BOUNDS_CHECK(colorBuffer, pixelIndex * 4 + 3);
     colorBuffer.Set(pixelIndex * 4 + 3, color[3]);
+    if (CountSamples)
+      sampleCounts.Set(pixelIndex, numSamples);
   }
 }; //SamplerCell
 
@@ -722,6 +1006,11 @@ VolumeRendererStructured::VolumeRendererStructured()
   IsSceneDirty = false;
   IsUniformDataSet = true;
   SampleDistance = -1.f;
+  EmptySpaceSkipping = true;
+  MacroCellSize = 8;
+  MacroCellDims = vtkm::Id3(0, 0, 0);
+  OpacityThreshold = 1.f;
+  CountSamples = false;
 }
 
 void VolumeRendererStructured::SetColorMap(const vtkm::cont::ArrayHandle<vtkm::Vec4f_32>& colorMap)
@@ -769,8 +1058,51 @@ public:
   }
 };
 
+void VolumeRendererStructured::BuildMacroCells()
+{
+  const bool isSupportedField = ScalarField->IsFieldCell() || ScalarField->IsFieldPoint();
+  if (!EmptySpaceSkipping || !isSupportedField)
+  {
+    return;
+  }
+
+  vtkm::cont::Invoker invoke;
+  // the scalar ranges only change with the data, but the color map can change between renders
+  if (IsSceneDirty)
+  {
+    const bool isAssocPoints = ScalarField->IsFieldPoint();
+    const vtkm::Id3 cellDims = Cellset.GetCellDimensions();
+    for (vtkm::Int32 dim = 0; dim < 3; ++dim)
+    {
+      MacroCellDims[dim] = (cellDims[dim] + MacroCellSize - 1) / MacroCellSize;
+    }
+    invoke(MacroCellRange(isAssocPoints ? Cellset.GetPointDimensions() : cellDims,
+                          MacroCellDims,
+                          MacroCellSize,
+                          isAssocPoints),
+           vtkm::cont::ArrayHandleIndex(MacroCellDims[0] * MacroCellDims[1] * MacroCellDims[2]),
+           vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+           MacroCellRanges);
+    IsSceneDirty = false;
+  }
+
+  // match the scalar normalization of the samplers
+  const vtkm::Float32 minScalar = vtkm::Float32(ScalarRange.Min);
+  const vtkm::Float32 maxScalar = vtkm::Float32(ScalarRange.Max);
+  vtkm::Float32 inverseDeltaScalar = minScalar;
+  if ((maxScalar - minScalar) != 0.f)
+  {
+    inverseDeltaScalar = 1.f / (maxScalar - minScalar);
+  }
+  invoke(MacroCellVisibility(minScalar, inverseDeltaScalar),
+         MacroCellRanges,
+         ColorMap,
+         EmptyMacroCells);
+}
+
 void VolumeRendererStructured::Render(vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays)
 {
+  BuildMacroCells();
   RenderFunctor<vtkm::Float32> functor(this, rays);
   vtkm::cont::TryExecute(functor);
 }
@@ -824,6 +1156,15 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
     throw vtkm::cont::ErrorBadValue("Field not accociated with cell set or points");
   }
   const bool isAssocPoints = ScalarField->IsFieldPoint();
+  const vtkm::Id macroCellSize = EmptySpaceSkipping ? MacroCellSize : 0;
+  if (CountSamples)
+  {
+    SampleCounts.Allocate(rays.NumRays);
+  }
+  else
+  {
+    SampleCounts.ReleaseResources();
+  }
 
   if (IsUniformDataSet)
   {
@@ -832,6 +1173,7 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
     vertices =
       Coordinates.GetData().AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
     UniformLocator<Device> locator(vertices, Cellset, token);
+    MacroCellGrid<Device> macroCells(EmptyMacroCells, MacroCellDims, macroCellSize, token);
 
     if (isAssocPoints)
     {
@@ -841,7 +1183,10 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                 vtkm::Float32(ScalarRange.Max),
                                                 SampleDistance,
                                                 locator,
+                                                macroCells,
                                                 meshEpsilon,
+                                                OpacityThreshold,
+                                                CountSamples,
                                                 token));
       samplerDispatcher.SetDevice(Device());
       samplerDispatcher.Invoke(
@@ -850,7 +1195,8 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
         rays.MinDistance,
         rays.MaxDistance,
         rays.Buffers.at(0).Buffer,
-        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField));
+        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+        this->SampleCounts);
     }
     else
     {
@@ -860,14 +1206,18 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                          vtkm::Float32(ScalarRange.Max),
                                                          SampleDistance,
                                                          locator,
+                                                         macroCells,
                                                          meshEpsilon,
+                                                         OpacityThreshold,
+                                                         CountSamples,
                                                          token))
         .Invoke(rays.Dir,
                 rays.Origin,
                 rays.MinDistance,
                 rays.MaxDistance,
                 rays.Buffers.at(0).Buffer,
-                vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField));
+                vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+                this->SampleCounts);
     }
   }
   else
@@ -876,6 +1226,7 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
     CartesianArrayHandle vertices;
     vertices = Coordinates.GetData().AsArrayHandle<CartesianArrayHandle>();
     RectilinearLocator<Device> locator(vertices, Cellset, token);
+    MacroCellGrid<Device> macroCells(EmptyMacroCells, MacroCellDims, macroCellSize, token);
     if (isAssocPoints)
     {
       vtkm::worklet::DispatcherMapField<Sampler<Device, RectilinearLocator<Device>>>
@@ -885,7 +1236,10 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                       vtkm::Float32(ScalarRange.Max),
                                                       SampleDistance,
                                                       locator,
+                                                      macroCells,
                                                       meshEpsilon,
+                                                      OpacityThreshold,
+                                                      CountSamples,
                                                       token));
       samplerDispatcher.SetDevice(Device());
       samplerDispatcher.Invoke(
@@ -894,7 +1248,8 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
         rays.MinDistance,
         rays.MaxDistance,
         rays.Buffers.at(0).Buffer,
-        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField));
+        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+        this->SampleCounts);
     }
     else
     {
@@ -905,7 +1260,10 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
                                                                vtkm::Float32(ScalarRange.Max),
                                                                SampleDistance,
                                                                locator,
+                                                               macroCells,
                                                                meshEpsilon,
+                                                               OpacityThreshold,
+                                                               CountSamples,
                                                                token));
       rectilinearLocatorDispatcher.SetDevice(Device());
       rectilinearLocatorDispatcher.Invoke(
@@ -914,7 +1272,8 @@ void VolumeRendererStructured::RenderOnDevice(vtkm::rendering::raytracing::Ray<P
         rays.MinDistance,
         rays.MaxDistance,
         rays.Buffers.at(0).Buffer,
-        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField));
+        vtkm::rendering::raytracing::GetScalarFieldArray(*this->ScalarField),
+        this->SampleCounts);
     }
   }
 
@@ -931,6 +1290,57 @@ void VolumeRendererStructured::SetSampleDistance(const vtkm::Float32& distance)
     throw vtkm::cont::ErrorBadValue("Sample distance must be positive.");
   SampleDistance = distance;
 }
+
+void VolumeRendererStructured::SetEmptySpaceSkipping(bool enabled)
+{
+  EmptySpaceSkipping = enabled;
+  IsSceneDirty = true;
+}
+
+bool VolumeRendererStructured::GetEmptySpaceSkipping() const
+{
+  return EmptySpaceSkipping;
+}
+
+void VolumeRendererStructured::SetMacroCellSize(vtkm::Id size)
+{
+  if (size <= 0)
+    throw vtkm::cont::ErrorBadValue("Macro cell size must be positive.");
+  MacroCellSize = size;
+  IsSceneDirty = true;
+}
+
+vtkm::Id VolumeRendererStructured::GetMacroCellSize() const
+{
+  return MacroCellSize;
+}
+
+void VolumeRendererStructured::SetOpacityThreshold(vtkm::Float32 threshold)
+{
+  if (threshold <= 0.f || threshold > 1.f)
+    throw vtkm::cont::ErrorBadValue("Opacity threshold must be in (0, 1].");
+  OpacityThreshold = threshold;
+}
+
+vtkm::Float32 VolumeRendererStructured::GetOpacityThreshold() const
+{
+  return OpacityThreshold;
+}
+
+void VolumeRendererStructured::SetCountSamples(bool enabled)
+{
+  CountSamples = enabled;
+}
+
+bool VolumeRendererStructured::GetCountSamples() const
+{
+  return CountSamples;
+}
+
+const vtkm::cont::ArrayHandle<vtkm::Id>& VolumeRendererStructured::GetSampleCounts() const
+{
+  return SampleCounts;
+}
 }
 }
 } //namespace vtkm::rendering::raytracing
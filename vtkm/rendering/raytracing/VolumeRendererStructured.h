@@ -57,12 +57,48 @@ public:
   VTKM_CONT
   void SetSampleDistance(const vtkm::Float32& distance);
 
+  /// Skips the parts of the volume that are fully transparent under the color map. The
+  /// volume is divided into macro cells of `GetMacroCellSize()` cells along each axis, and
+  /// the range of the scalars of each macro cell is kept. Rays step over a macro cell at
+  /// once when no color in its range has any opacity. On by default.
+  VTKM_CONT
+  void SetEmptySpaceSkipping(bool enabled);
+  VTKM_CONT
+  bool GetEmptySpaceSkipping() const;
+
+  /// Sets the number of cells along each axis of a macro cell. The default is 8.
+  VTKM_CONT
+  void SetMacroCellSize(vtkm::Id size);
+  VTKM_CONT
+  vtkm::Id GetMacroCellSize() const;
+
+  /// Stops a ray once its accumulated opacity reaches `threshold`, which must be in (0, 1].
+  /// The default of 1 stops only fully opaque rays.
+  VTKM_CONT
+  void SetOpacityThreshold(vtkm::Float32 threshold);
+  VTKM_CONT
+  vtkm::Float32 GetOpacityThreshold() const;
+
+  /// Counts the samples taken along each ray for `GetSampleCounts()`. Off by default.
+  VTKM_CONT
+  void SetCountSamples(bool enabled);
+  VTKM_CONT
+  bool GetCountSamples() const;
+
+  /// Returns the number of samples taken along each ray by the last call to `Render`, or
+  /// an empty array unless sample counting is on.
+  VTKM_CONT
+  const vtkm::cont::ArrayHandle<vtkm::Id>& GetSampleCounts() const;
+
 protected:
   template <typename Precision, typename Device>
   VTKM_CONT void RenderOnDevice(vtkm::rendering::raytracing::Ray<Precision>& rays, Device);
   template <typename Precision>
   struct RenderFunctor;
 
+  VTKM_CONT
+  void BuildMacroCells();
+
   bool IsSceneDirty;
   bool IsUniformDataSet;
   vtkm::Bounds SpatialExtent;
@@ -72,6 +108,14 @@ protected:
   vtkm::cont::ArrayHandle<vtkm::Vec4f_32> ColorMap;
   vtkm::Float32 SampleDistance;
   vtkm::Range ScalarRange;
+  bool EmptySpaceSkipping;
+  vtkm::Id MacroCellSize;
+  vtkm::Id3 MacroCellDims;
+  vtkm::cont::ArrayHandle<vtkm::Vec2f_32> MacroCellRanges;
+  vtkm::cont::ArrayHandle<vtkm::UInt8> EmptyMacroCells;
+  vtkm::Float32 OpacityThreshold;
+  bool CountSamples;
+  vtkm::cont::ArrayHandle<vtkm::Id> SampleCounts;
 };
 }
 }
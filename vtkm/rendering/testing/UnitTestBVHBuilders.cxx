@@ -0,0 +1,138 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/testing/MakeTestDataSet.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/raytracing/BoundingVolumeHierarchy.h>
+#include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+
+namespace
+{
+
+using vtkm::rendering::raytracing::BVHBuilderType;
+
+vtkm::Bounds TraceRays(const vtkm::cont::DataSet& dataset,
+                       BVHBuilderType builder,
+                       vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays)
+{
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+
+  vtkm::rendering::raytracing::TriangleExtractor triExtractor;
+  triExtractor.ExtractCells(dataset.GetCellSet());
+
+  vtkm::rendering::raytracing::TriangleIntersector triIntersector;
+  triIntersector.SetBVHBuilder(builder);
+  VTKM_TEST_ASSERT(triIntersector.GetBVHBuilder() == builder, "Builder not set.");
+  triIntersector.SetData(coords, triExtractor.GetTriangles());
+
+  vtkm::Bounds bounds = coords.GetBounds();
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(bounds);
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 64, 64);
+  rayCamera.CreateRays(rays, bounds);
+
+  triIntersector.IntersectRays(rays);
+  return triIntersector.GetShapeBounds();
+}
+
+void CompareBuilders(const vtkm::cont::DataSet& dataset)
+{
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> lbvhRays;
+  vtkm::Bounds lbvhBounds = TraceRays(dataset, BVHBuilderType::LBVH, lbvhRays);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> sahRays;
+  vtkm::Bounds sahBounds = TraceRays(dataset, BVHBuilderType::BinnedSAH, sahRays);
+  VTKM_TEST_ASSERT(test_equal(lbvhBounds, sahBounds), "Builders have different bounds.");
+
+  VTKM_TEST_ASSERT(lbvhRays.NumRays == sahRays.NumRays);
+  auto lbvhHits = lbvhRays.HitIdx.ReadPortal();
+  auto lbvhDistances = lbvhRays.Distance.ReadPortal();
+  auto sahHits = sahRays.HitIdx.ReadPortal();
+  auto sahDistances = sahRays.Distance.ReadPortal();
+  vtkm::Id numHits = 0;
+  for (vtkm::Id i = 0; i < lbvhRays.NumRays; ++i)
+  {
+    // Rays through a shared edge can hit either triangle, so only the
+    // distances are compared.
+    VTKM_TEST_ASSERT((lbvhHits.Get(i) < 0) == (sahHits.Get(i) < 0), "Builders hit differently.");
+    if (lbvhHits.Get(i) >= 0)
+    {
+      VTKM_TEST_ASSERT(test_equal(lbvhDistances.Get(i), sahDistances.Get(i)),
+                       "Builders hit at different distances.");
+      ++numHits;
+    }
+  }
+  VTKM_TEST_ASSERT(numHits > 0, "No ray hit the data set.");
+}
+
+vtkm::cont::DataSet MakeSingleTriangle()
+{
+  std::vector<vtkm::Vec3f_32> coords = { { 0.f, 0.f, 0.f }, { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.5f } };
+  std::vector<vtkm::UInt8> shapes = { vtkm::CELL_SHAPE_TRIANGLE };
+  std::vector<vtkm::IdComponent> numIndices = { 3 };
+  std::vector<vtkm::Id> connectivity = { 0, 1, 2 };
+  return vtkm::cont::DataSetBuilderExplicit::Create(coords, shapes, numIndices, connectivity);
+}
+
+void TestSinglePrimitive()
+{
+  vtkm::rendering::raytracing::AABBs aabbs;
+  aabbs.xmins = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 0.f });
+  aabbs.ymins = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 0.f });
+  aabbs.zmins = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 0.f });
+  aabbs.xmaxs = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 1.f });
+  aabbs.ymaxs = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 2.f });
+  aabbs.zmaxs = vtkm::cont::make_ArrayHandle<vtkm::Float32>({ 3.f });
+
+  vtkm::rendering::raytracing::LinearBVH bvh(aabbs);
+  bvh.SetBuilder(BVHBuilderType::BinnedSAH);
+  bvh.Construct();
+
+  // The single leaf gets a root with the leaf as both children.
+  VTKM_TEST_ASSERT(bvh.LeafCount == 1, "Wrong leaf count: ", bvh.LeafCount);
+  VTKM_TEST_ASSERT(bvh.FlatBVH.GetNumberOfValues() == 4, "Expected only the root node.");
+  auto expectedLeafs = vtkm::cont::make_ArrayHandle<vtkm::Id>({ 1, 0 });
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(bvh.Leafs, expectedLeafs), "Wrong leaf.");
+  VTKM_TEST_ASSERT(test_equal(bvh.TotalBounds, vtkm::Bounds(0., 1., 0., 2., 0., 3.)),
+                   "Wrong bounds.");
+}
+
+void TestBVHBuilders()
+{
+  std::cout << "Single primitive" << std::endl;
+  TestSinglePrimitive();
+
+  vtkm::cont::testing::MakeTestDataSet maker;
+
+  // The SAH builder makes a single leaf for a single triangle.
+  std::cout << "Single triangle" << std::endl;
+  CompareBuilders(MakeSingleTriangle());
+
+  std::cout << "Uniform grid" << std::endl;
+  CompareBuilders(maker.Make3DUniformDataSet3(vtkm::Id3(16)));
+
+  std::cout << "Triangle mesh" << std::endl;
+  CompareBuilders(maker.Make3DExplicitDataSetCowNose());
+}
+
+} //namespace
+
+int UnitTestBVHBuilders(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestBVHBuilders, argc, argv);
+}
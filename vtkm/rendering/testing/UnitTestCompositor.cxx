@@ -0,0 +1,313 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/Compositor.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+using vtkm::rendering::Compositor;
+
+// An odd size, so that the parts swapped are uneven.
+constexpr vtkm::Id Width = 37;
+constexpr vtkm::Id Height = 23;
+constexpr vtkm::Id NumPixels = Width * Height;
+constexpr int ImagesPerRank = 2;
+
+// The depths of the images differ at each pixel, so there is always one nearest image.
+vtkm::Float32 ImageDepth(int image, vtkm::Id pixel)
+{
+  return static_cast<vtkm::Float32>((pixel * 31 + image * 17) % 101) + 0.001f * image;
+}
+
+// A premultiplied color, translucent in blend mode.
+vtkm::Vec4f_32 ImageColor(int image, vtkm::Id pixel, bool blend)
+{
+  const vtkm::Float32 alpha =
+    blend ? 0.1f + 0.1f * static_cast<vtkm::Float32>((pixel + image) % 5) : 1.f;
+  return vtkm::Vec4f_32(alpha * static_cast<vtkm::Float32>(image + 1) / 16.f,
+                        alpha * 0.5f,
+                        alpha * static_cast<vtkm::Float32>(pixel % 3) / 3.f,
+                        alpha);
+}
+
+void Blend(vtkm::Vec4f_32& front, const vtkm::Vec4f_32& back)
+{
+  front = front + (1.f - front[3]) * back;
+}
+
+void TestImages(Compositor::CompositeMode mode,
+                Compositor::Algorithm algorithm,
+                vtkm::IdComponent k)
+{
+  const auto& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  const bool blend = mode == Compositor::CompositeMode::Blend;
+  const int numImages = comm.size() * ImagesPerRank;
+
+  Compositor compositor;
+  compositor.SetCompositeMode(mode);
+  compositor.SetAlgorithm(algorithm);
+  compositor.SetRadixK(k);
+
+  // Image `image` is the (image)th nearest in blend mode. The images of a rank are not
+  // contiguous in the visibility order.
+  for (int i = 0; i < ImagesPerRank; ++i)
+  {
+    const int image = i * comm.size() + comm.rank();
+    vtkm::rendering::CanvasRayTracer canvas(Width, Height);
+    auto colors = canvas.GetColorBuffer().WritePortal();
+    auto depths = canvas.GetDepthBuffer().WritePortal();
+    for (vtkm::Id pixel = 0; pixel < NumPixels; ++pixel)
+    {
+      colors.Set(pixel, ImageColor(image, pixel, blend));
+      depths.Set(pixel, ImageDepth(image, pixel));
+    }
+    compositor.AddImage(canvas, image);
+  }
+
+  vtkm::rendering::CanvasRayTracer result(Width, Height);
+  result.Clear();
+  compositor.Composite(result);
+  if (comm.rank() != 0)
+  {
+    return;
+  }
+
+  auto colors = result.GetColorBuffer().ReadPortal();
+  auto depths = result.GetDepthBuffer().ReadPortal();
+  for (vtkm::Id pixel = 0; pixel < NumPixels; ++pixel)
+  {
+    vtkm::Vec4f_32 expectedColor = ImageColor(0, pixel, blend);
+    vtkm::Float32 expectedDepth = ImageDepth(0, pixel);
+    for (int image = 1; image < numImages; ++image)
+    {
+      const vtkm::Float32 depth = ImageDepth(image, pixel);
+      if (blend)
+      {
+        Blend(expectedColor, ImageColor(image, pixel, blend));
+      }
+      else if (depth < expectedDepth)
+      {
+        expectedColor = ImageColor(image, pixel, blend);
+      }
+      expectedDepth = vtkm::Min(expectedDepth, depth);
+    }
+    VTKM_TEST_ASSERT(test_equal(colors.Get(pixel), expectedColor, 1e-4), "Wrong composited color.");
+    VTKM_TEST_ASSERT(test_equal(depths.Get(pixel), expectedDepth), "Wrong composited depth.");
+  }
+}
+
+// A rank traces the pixels that are not a multiple of its rank + 2, in two partials
+// along the ray.
+struct Fragment
+{
+  vtkm::Float32 Distance;
+  std::vector<vtkm::Float32> Buffer;
+  std::vector<vtkm::Float32> Intensities;
+  vtkm::Float32 PathLength;
+};
+
+bool Traces(int rank, vtkm::Id pixel)
+{
+  return pixel % (rank + 2) != 0;
+}
+
+Fragment MakeFragment(int rank, int partial, vtkm::Id pixel, vtkm::Int32 numChannels, bool volume)
+{
+  Fragment fragment;
+  fragment.Distance = static_cast<vtkm::Float32>(2 * ((pixel * 7 + rank * 5) % 11) + partial) +
+    0.01f * static_cast<vtkm::Float32>(rank);
+  const vtkm::Float32 alpha = 0.1f + 0.2f * static_cast<vtkm::Float32>((pixel + rank) % 4);
+  for (vtkm::Int32 c = 0; c < numChannels; ++c)
+  {
+    const vtkm::Float32 value = static_cast<vtkm::Float32>((rank + partial + c) % 5) / 5.f;
+    fragment.Buffer.push_back(volume ? (c == 3 ? alpha : alpha * value) : 1.f - alpha * value);
+    fragment.Intensities.push_back(value);
+  }
+  fragment.PathLength = 0.5f + static_cast<vtkm::Float32>(partial);
+  return fragment;
+}
+
+void TestPartials(vtkm::rendering::ConnectivityProxy::RenderMode mode,
+                  Compositor::Algorithm algorithm)
+{
+  const auto& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  const bool volume = mode == vtkm::rendering::ConnectivityProxy::VOLUME_MODE;
+  const vtkm::Int32 numChannels = volume ? 4 : 3;
+
+  vtkm::rendering::PartialVector32 partials;
+  for (int partial = 0; partial < 2; ++partial)
+  {
+    std::vector<vtkm::Id> pixelIds;
+    std::vector<vtkm::Float32> distances;
+    std::vector<vtkm::Float32> buffer;
+    std::vector<vtkm::Float32> intensities;
+    std::vector<vtkm::Float32> pathLengths;
+    for (vtkm::Id pixel = 0; pixel < NumPixels; ++pixel)
+    {
+      if (Traces(comm.rank(), pixel))
+      {
+        const Fragment fragment = MakeFragment(comm.rank(), partial, pixel, numChannels, volume);
+        pixelIds.push_back(pixel);
+        distances.push_back(fragment.Distance);
+        buffer.insert(buffer.end(), fragment.Buffer.begin(), fragment.Buffer.end());
+        intensities.insert(
+          intensities.end(), fragment.Intensities.begin(), fragment.Intensities.end());
+        pathLengths.push_back(fragment.PathLength);
+      }
+    }
+    const auto size = static_cast<vtkm::Id>(pixelIds.size());
+    vtkm::rendering::raytracing::PartialComposite<vtkm::Float32> composite;
+    composite.PixelIds = vtkm::cont::make_ArrayHandle(pixelIds, vtkm::CopyFlag::On);
+    composite.Distances = vtkm::cont::make_ArrayHandle(distances, vtkm::CopyFlag::On);
+    composite.Buffer = vtkm::rendering::raytracing::ChannelBuffer<vtkm::Float32>(numChannels, size);
+    composite.Buffer.Buffer = vtkm::cont::make_ArrayHandle(buffer, vtkm::CopyFlag::On);
+    if (!volume)
+    {
+      composite.Intensities =
+        vtkm::rendering::raytracing::ChannelBuffer<vtkm::Float32>(numChannels, size);
+      composite.Intensities.Buffer = vtkm::cont::make_ArrayHandle(intensities, vtkm::CopyFlag::On);
+      composite.PathLengths = vtkm::cont::make_ArrayHandle(pathLengths, vtkm::CopyFlag::On);
+    }
+    partials.push_back(composite);
+  }
+
+  Compositor compositor;
+  compositor.SetAlgorithm(algorithm);
+  compositor.SetRadixK(3);
+  auto result = compositor.CompositePartials(partials, NumPixels, mode);
+  if (comm.rank() != 0)
+  {
+    VTKM_TEST_ASSERT(result.PixelIds.GetNumberOfValues() == 0, "Partials left on rank.");
+    return;
+  }
+
+  auto pixelIds = result.PixelIds.ReadPortal();
+  auto distances = result.Distances.ReadPortal();
+  auto buffer = result.Buffer.Buffer.ReadPortal();
+  auto intensities = result.Intensities.Buffer.ReadPortal();
+  auto pathLengths = result.PathLengths.ReadPortal();
+  VTKM_TEST_ASSERT(result.Buffer.GetNumChannels() == numChannels, "Wrong number of channels.");
+  vtkm::Id index = 0;
+  for (vtkm::Id pixel = 0; pixel < NumPixels; ++pixel)
+  {
+    std::vector<Fragment> fragments;
+    for (int rank = 0; rank < comm.size(); ++rank)
+    {
+      for (int partial = 0; partial < 2; ++partial)
+      {
+        if (Traces(rank, pixel))
+        {
+          fragments.push_back(MakeFragment(rank, partial, pixel, numChannels, volume));
+        }
+      }
+    }
+    if (fragments.empty())
+    {
+      continue;
+    }
+    std::sort(fragments.begin(), fragments.end(), [](const Fragment& a, const Fragment& b) {
+      return a.Distance < b.Distance;
+    });
+
+    std::vector<vtkm::Float32> expected(static_cast<std::size_t>(numChannels), volume ? 0.f : 1.f);
+    std::vector<vtkm::Float32> expectedIntensities(static_cast<std::size_t>(numChannels), 0.f);
+    vtkm::Float32 expectedPathLength = 0.f;
+    for (const Fragment& fragment : fragments)
+    {
+      const vtkm::Float32 transparency = 1.f - expected[3 % expected.size()];
+      for (std::size_t c = 0; c < expected.size(); ++c)
+      {
+        if (volume)
+        {
+          expected[c] += transparency * fragment.Buffer[c];
+        }
+        else
+        {
+          expectedIntensities[c] += expected[c] * fragment.Intensities[c];
+          expected[c] *= fragment.Buffer[c];
+        }
+      }
+      expectedPathLength += fragment.PathLength;
+    }
+
+    VTKM_TEST_ASSERT(index < result.PixelIds.GetNumberOfValues(), "Too few composites.");
+    VTKM_TEST_ASSERT(pixelIds.Get(index) == pixel, "Composite of wrong pixel.");
+    VTKM_TEST_ASSERT(test_equal(distances.Get(index), fragments.back().Distance),
+                     "Wrong composite distance.");
+    for (vtkm::Int32 c = 0; c < numChannels; ++c)
+    {
+      const auto channel = static_cast<std::size_t>(c);
+      VTKM_TEST_ASSERT(test_equal(buffer.Get(index * numChannels + c), expected[channel], 1e-4),
+                       "Wrong composite buffer.");
+      if (!volume)
+      {
+        VTKM_TEST_ASSERT(
+          test_equal(intensities.Get(index * numChannels + c), expectedIntensities[channel], 1e-4),
+          "Wrong composite intensities.");
+      }
+    }
+    if (!volume)
+    {
+      VTKM_TEST_ASSERT(test_equal(pathLengths.Get(index), expectedPathLength),
+                       "Wrong composite path length.");
+    }
+    ++index;
+  }
+  VTKM_TEST_ASSERT(index == result.PixelIds.GetNumberOfValues(), "Too many composites.");
+}
+
+void TestCompositor()
+{
+  using Mode = Compositor::CompositeMode;
+  using Algorithm = Compositor::Algorithm;
+  using RenderMode = vtkm::rendering::ConnectivityProxy::RenderMode;
+  const auto& comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  std::cout << "Compositing on " << comm.size() << " ranks" << std::endl;
+
+  for (Algorithm algorithm : { Algorithm::BinarySwap, Algorithm::RadixK })
+  {
+    std::cout << (algorithm == Algorithm::BinarySwap ? "Binary swap" : "Radix-k") << std::endl;
+    TestImages(Mode::ZBuffer, algorithm, 3);
+    TestImages(Mode::Blend, algorithm, 3);
+    TestPartials(RenderMode::VOLUME_MODE, algorithm);
+    TestPartials(RenderMode::ENERGY_MODE, algorithm);
+  }
+
+  std::cout << "Visibility orders must cover all images" << std::endl;
+  Compositor compositor;
+  compositor.SetCompositeMode(Mode::Blend);
+  vtkm::rendering::CanvasRayTracer canvas(Width, Height);
+  compositor.AddImage(canvas, 1);
+  compositor.AddImage(canvas, 1);
+  bool thrown = false;
+  try
+  {
+    compositor.Composite(canvas);
+  }
+  catch (vtkm::cont::ErrorBadValue&)
+  {
+    thrown = true;
+  }
+  VTKM_TEST_ASSERT(thrown, "Repeated visibility orders not detected.");
+}
+
+} //namespace
+
+int UnitTestCompositor(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestCompositor, argc, argv);
+}
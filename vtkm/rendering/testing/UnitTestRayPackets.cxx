@@ -0,0 +1,155 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/testing/MakeTestDataSet.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/TriangleExtractor.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+
+#include <vector>
+
+namespace
+{
+
+using RayCamera = vtkm::rendering::raytracing::Camera;
+
+void MakeRays(const vtkm::Bounds& bounds,
+              vtkm::Int32 width,
+              vtkm::Int32 height,
+              vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays,
+              RayCamera& rayCamera)
+{
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(bounds);
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+  rayCamera.SetParameters(camera, width, height);
+  rayCamera.CreateRays(rays, bounds);
+}
+
+// Every pixel of the subset must get exactly one ray, with the rays of whole tiles first.
+void TestRayTiles(vtkm::Int32 width, vtkm::Int32 height)
+{
+  std::cout << "Ray tiles of a " << width << "x" << height << " image" << std::endl;
+  vtkm::cont::testing::MakeTestDataSet maker;
+  vtkm::Bounds bounds = maker.Make3DUniformDataSet3(vtkm::Id3(8)).GetCoordinateSystem().GetBounds();
+
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+  RayCamera rayCamera;
+  MakeRays(bounds, width, height, rays, rayCamera);
+
+  const vtkm::Int32 subsetWidth = rayCamera.GetSubsetWidth();
+  const vtkm::Int32 subsetHeight = rayCamera.GetSubsetHeight();
+  VTKM_TEST_ASSERT(rays.NumRays == subsetWidth * subsetHeight, "Wrong number of rays.");
+
+  std::vector<bool> covered(static_cast<std::size_t>(width * height), false);
+  auto pixels = rays.PixelIdx.ReadPortal();
+  vtkm::Id minPixel = width * height;
+  for (vtkm::Id i = 0; i < rays.NumRays; ++i)
+  {
+    const vtkm::Id pixel = pixels.Get(i);
+    VTKM_TEST_ASSERT(pixel >= 0 && pixel < width * height, "Pixel out of the image.");
+    VTKM_TEST_ASSERT(!covered[static_cast<std::size_t>(pixel)], "Pixel traced twice.");
+    covered[static_cast<std::size_t>(pixel)] = true;
+    minPixel = vtkm::Min(minPixel, pixel);
+  }
+
+  if (subsetWidth >= RayCamera::RayTileWidth && subsetHeight >= RayCamera::RayTileHeight)
+  {
+    for (vtkm::Int32 i = 0; i < RayCamera::RayTileWidth * RayCamera::RayTileHeight; ++i)
+    {
+      const vtkm::Id expected =
+        minPixel + (i / RayCamera::RayTileWidth) * width + i % RayCamera::RayTileWidth;
+      VTKM_TEST_ASSERT(pixels.Get(i) == expected, "First rays are not a tile.");
+    }
+  }
+}
+
+void TraceRays(const vtkm::cont::DataSet& dataset,
+               bool useWaterTight,
+               bool usePackets,
+               vtkm::rendering::raytracing::Ray<vtkm::Float32>& rays)
+{
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  vtkm::rendering::raytracing::TriangleExtractor triExtractor;
+  triExtractor.ExtractCells(dataset.GetCellSet());
+
+  vtkm::rendering::raytracing::TriangleIntersector triIntersector;
+  triIntersector.SetUseWaterTight(useWaterTight);
+  triIntersector.SetUsePacketTraversal(usePackets);
+  VTKM_TEST_ASSERT(triIntersector.GetUsePacketTraversal() == usePackets, "Packets not set.");
+  triIntersector.SetData(coords, triExtractor.GetTriangles());
+
+  // An odd size leaves a last packet that is not full.
+  RayCamera rayCamera;
+  MakeRays(coords.GetBounds(), 61, 37, rays, rayCamera);
+  rays.EnableIntersectionData();
+  triIntersector.IntersectRays(rays);
+}
+
+void ComparePackets(const vtkm::cont::DataSet& dataset, bool useWaterTight)
+{
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> scalarRays;
+  TraceRays(dataset, useWaterTight, false, scalarRays);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> packetRays;
+  TraceRays(dataset, useWaterTight, true, packetRays);
+
+  VTKM_TEST_ASSERT(scalarRays.NumRays == packetRays.NumRays);
+  auto scalarHits = scalarRays.HitIdx.ReadPortal();
+  auto scalarDistances = scalarRays.Distance.ReadPortal();
+  auto packetHits = packetRays.HitIdx.ReadPortal();
+  auto packetDistances = packetRays.Distance.ReadPortal();
+  auto packetU = packetRays.U.ReadPortal();
+  auto packetV = packetRays.V.ReadPortal();
+  vtkm::Id numHits = 0;
+  for (vtkm::Id i = 0; i < scalarRays.NumRays; ++i)
+  {
+    // Rays through a shared edge can hit either triangle, so only the
+    // distances are compared.
+    VTKM_TEST_ASSERT((scalarHits.Get(i) < 0) == (packetHits.Get(i) < 0),
+                     "Packets hit differently.");
+    VTKM_TEST_ASSERT(test_equal(scalarDistances.Get(i), packetDistances.Get(i)),
+                     "Packets hit at different distances.");
+    if (packetHits.Get(i) >= 0)
+    {
+      VTKM_TEST_ASSERT(packetU.Get(i) >= -0.001f && packetV.Get(i) >= -0.001f &&
+                         packetU.Get(i) + packetV.Get(i) <= 1.001f,
+                       "Hit outside of the triangle.");
+      ++numHits;
+    }
+  }
+  VTKM_TEST_ASSERT(numHits > 0, "No ray hit the data set.");
+}
+
+void TestRayPackets()
+{
+  TestRayTiles(64, 64);
+  TestRayTiles(61, 37);
+  TestRayTiles(3, 5);
+
+  vtkm::cont::testing::MakeTestDataSet maker;
+  for (bool useWaterTight : { false, true })
+  {
+    std::cout << "Packets " << (useWaterTight ? "with" : "without") << " watertight test"
+              << std::endl;
+    ComparePackets(maker.Make3DUniformDataSet3(vtkm::Id3(16)), useWaterTight);
+    ComparePackets(maker.Make3DExplicitDataSetCowNose(), useWaterTight);
+  }
+}
+
+} //namespace
+
+int UnitTestRayPackets(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestRayPackets, argc, argv);
+}
@@ -0,0 +1,181 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/CanvasRayTracer.h>
+#include <vtkm/rendering/MapperCylinder.h>
+#include <vtkm/rendering/MapperPoint.h>
+#include <vtkm/rendering/MapperRayTracer.h>
+#include <vtkm/rendering/internal/ShapeIntersectorCache.h>
+#include <vtkm/rendering/raytracing/TriangleIntersector.h>
+
+namespace
+{
+
+using Cache = vtkm::rendering::internal::ShapeIntersectorCache;
+
+vtkm::cont::DataSet MakeTriangles()
+{
+  std::vector<vtkm::Vec3f_32> coords = { { 0.f, 0.f, 0.f },
+                                         { 1.f, 0.f, 0.f },
+                                         { 1.f, 1.f, 0.2f },
+                                         { 0.f, 1.f, 0.4f },
+                                         { 0.5f, 0.5f, 1.f } };
+  std::vector<vtkm::UInt8> shapes(4, vtkm::CELL_SHAPE_TRIANGLE);
+  std::vector<vtkm::IdComponent> numIndices(4, 3);
+  std::vector<vtkm::Id> connectivity = { 0, 1, 4, 1, 2, 4, 2, 3, 4, 3, 0, 4 };
+  vtkm::cont::DataSet dataset =
+    vtkm::cont::DataSetBuilderExplicit::Create(coords, shapes, numIndices, connectivity);
+  std::vector<vtkm::Float32> values = { 0.f, 1.f, 2.f, 3.f, 4.f };
+  dataset.AddPointField("pointvar", values);
+  return dataset;
+}
+
+// Moves the apex of the pyramid in place, which keeps the buffers of the coordinates.
+void MoveApex(vtkm::cont::DataSet& dataset)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> coords;
+  dataset.GetCoordinateSystem().GetData().AsArrayHandle(coords);
+  coords.WritePortal().Set(4, vtkm::Vec3f_32(0.2f, 0.7f, 0.6f));
+}
+
+Cache::Key MakeKey(const vtkm::cont::DataSet& dataset, vtkm::Float64 parameter)
+{
+  Cache::Key key;
+  key.AddCellSet(dataset.GetCellSet());
+  key.AddCoordinates(dataset.GetCoordinateSystem());
+  key.AddField(dataset.GetField("pointvar"));
+  key.AddParameter(parameter);
+  return key;
+}
+
+void TestKeys()
+{
+  std::cout << "Testing cache keys" << std::endl;
+  vtkm::cont::DataSet dataset = MakeTriangles();
+
+  Cache cache;
+  std::shared_ptr<vtkm::rendering::raytracing::ShapeIntersector> intersector;
+  VTKM_TEST_ASSERT(!cache.Find(MakeKey(dataset, 1.), intersector), "Empty cache has an entry.");
+
+  auto stored = std::make_shared<vtkm::rendering::raytracing::TriangleIntersector>();
+  cache.Store(MakeKey(dataset, 1.), stored);
+  VTKM_TEST_ASSERT(MakeKey(dataset, 1.).IsCacheable(), "Key should be cacheable.");
+  VTKM_TEST_ASSERT(cache.Find(MakeKey(dataset, 1.), intersector), "Same inputs not found.");
+  VTKM_TEST_ASSERT(intersector == stored, "Wrong intersector found.");
+  VTKM_TEST_ASSERT(!cache.Find(MakeKey(dataset, 2.), intersector), "Different parameter found.");
+
+  // A copy of the data set shares its arrays.
+  vtkm::cont::DataSet copy = dataset;
+  VTKM_TEST_ASSERT(cache.Find(MakeKey(copy, 1.), intersector), "Shared arrays not found.");
+
+  // The same values in different arrays are a different input.
+  VTKM_TEST_ASSERT(!cache.Find(MakeKey(MakeTriangles(), 1.), intersector),
+                   "Different arrays found.");
+
+  MoveApex(dataset);
+  VTKM_TEST_ASSERT(!cache.Find(MakeKey(dataset, 1.), intersector), "Modified arrays found.");
+
+  // Inputs without shapes are cached as a null intersector.
+  cache.Store(MakeKey(dataset, 1.), nullptr);
+  VTKM_TEST_ASSERT(cache.Find(MakeKey(dataset, 1.), intersector), "Null intersector not found.");
+  VTKM_TEST_ASSERT(!intersector, "Null intersector not returned.");
+
+  cache.Clear();
+  VTKM_TEST_ASSERT(!cache.Find(MakeKey(dataset, 1.), intersector), "Cleared cache has an entry.");
+}
+
+vtkm::cont::ArrayHandle<vtkm::Vec4f_32> RenderFrame(vtkm::rendering::Mapper& mapper,
+                                                    const vtkm::cont::DataSet& dataset,
+                                                    vtkm::Float32 azimuth)
+{
+  vtkm::rendering::CanvasRayTracer canvas(64, 64);
+  canvas.Clear();
+  mapper.SetCanvas(&canvas);
+  vtkm::cont::ColorTable colorTable("inferno");
+  mapper.SetActiveColorTable(colorTable);
+
+  vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  camera.Azimuth(azimuth);
+  camera.Elevation(30.f);
+
+  vtkm::cont::Field field = dataset.GetField("pointvar");
+  mapper.RenderCells(
+    dataset.GetCellSet(), coords, field, colorTable, camera, field.GetRange().ReadPortal().Get(0));
+
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> colors;
+  vtkm::cont::ArrayCopy(canvas.GetColorBuffer(), colors);
+  mapper.SetCanvas(nullptr);
+  return colors;
+}
+
+// A mapper that already rendered the data must render each new frame like a new mapper.
+// Copies of a mapper share their shapes, so each mapper is made by `makeMapper`.
+template <typename MakeMapper>
+void TestMapper(MakeMapper makeMapper)
+{
+  vtkm::cont::DataSet dataset = MakeTriangles();
+
+  auto cachedMapper = makeMapper();
+  RenderFrame(cachedMapper, dataset, 0.f);
+  auto cachedFrame = RenderFrame(cachedMapper, dataset, 45.f);
+  auto newMapper = makeMapper();
+  auto newFrame = RenderFrame(newMapper, dataset, 45.f);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(cachedFrame, newFrame),
+                   "Cached shapes render differently.");
+
+  // Changing the coordinates in place must rebuild the shapes.
+  MoveApex(dataset);
+  auto movedFrame = RenderFrame(cachedMapper, dataset, 45.f);
+  auto movedMapper = makeMapper();
+  auto newMovedFrame = RenderFrame(movedMapper, dataset, 45.f);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(movedFrame, newMovedFrame),
+                   "Shapes of modified coordinates not rebuilt.");
+  VTKM_TEST_ASSERT(!test_equal_ArrayHandles(movedFrame, cachedFrame),
+                   "Moving the coordinates should change the image.");
+}
+
+void TestMappers()
+{
+  std::cout << "Testing MapperRayTracer" << std::endl;
+  TestMapper([]() { return vtkm::rendering::MapperRayTracer{}; });
+
+  std::cout << "Testing MapperPoint" << std::endl;
+  TestMapper([]() {
+    vtkm::rendering::MapperPoint mapper;
+    mapper.SetRadius(0.1f);
+    return mapper;
+  });
+
+  std::cout << "Testing MapperCylinder" << std::endl;
+  TestMapper([]() {
+    vtkm::rendering::MapperCylinder mapper;
+    mapper.SetRadius(0.05f);
+    return mapper;
+  });
+}
+
+void TestShapeIntersectorCache()
+{
+  TestKeys();
+  TestMappers();
+}
+
+} //namespace
+
+int UnitTestShapeIntersectorCache(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestShapeIntersectorCache, argc, argv);
+}
@@ -0,0 +1,260 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/rendering/Camera.h>
+#include <vtkm/rendering/raytracing/Camera.h>
+#include <vtkm/rendering/raytracing/Ray.h>
+#include <vtkm/rendering/raytracing/VolumeRendererStructured.h>
+
+#include <vector>
+
+namespace
+{
+
+using VolumeRenderer = vtkm::rendering::raytracing::VolumeRendererStructured;
+
+constexpr vtkm::Id Dim = 32;
+
+// A ball in the middle of the grid: the scalar is the distance to the center, and only
+// distances below a sixth of the grid are visible under the color map. Distances below the
+// scalar range get the first color, which is visible.
+vtkm::Float32 Scalar(vtkm::Float32 x, vtkm::Float32 y, vtkm::Float32 z)
+{
+  const vtkm::Float32 center = static_cast<vtkm::Float32>(Dim - 1) / 2.f;
+  return vtkm::Magnitude(vtkm::Vec3f_32(x - center, y - center, z - center));
+}
+
+void AddFields(vtkm::cont::DataSet& dataset)
+{
+  std::vector<vtkm::Float32> pointScalars;
+  for (vtkm::Id z = 0; z < Dim; ++z)
+    for (vtkm::Id y = 0; y < Dim; ++y)
+      for (vtkm::Id x = 0; x < Dim; ++x)
+        pointScalars.push_back(Scalar(vtkm::Float32(x), vtkm::Float32(y), vtkm::Float32(z)));
+  dataset.AddPointField("pointvar", pointScalars);
+
+  std::vector<vtkm::Float32> cellScalars;
+  for (vtkm::Id z = 0; z < Dim - 1; ++z)
+    for (vtkm::Id y = 0; y < Dim - 1; ++y)
+      for (vtkm::Id x = 0; x < Dim - 1; ++x)
+        cellScalars.push_back(
+          Scalar(vtkm::Float32(x) + 0.5f, vtkm::Float32(y) + 0.5f, vtkm::Float32(z) + 0.5f));
+  dataset.AddCellField("cellvar", cellScalars);
+}
+
+vtkm::cont::DataSet MakeUniformDataSet()
+{
+  vtkm::cont::DataSet dataset = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(Dim));
+  AddFields(dataset);
+  return dataset;
+}
+
+// Same coordinates as the uniform data set, so the same field applies.
+vtkm::cont::DataSet MakeRectilinearDataSet()
+{
+  std::vector<vtkm::Float32> coords;
+  for (vtkm::Id i = 0; i < Dim; ++i)
+    coords.push_back(vtkm::Float32(i));
+  vtkm::cont::DataSet dataset =
+    vtkm::cont::DataSetBuilderRectilinear::Create(coords, coords, coords);
+  AddFields(dataset);
+  return dataset;
+}
+
+vtkm::cont::ArrayHandle<vtkm::Vec4f_32> MakeColorMap(const vtkm::Range& range)
+{
+  constexpr vtkm::Id numColors = 256;
+  const vtkm::Float64 visibleScalar = static_cast<vtkm::Float64>(Dim) / 6.;
+  vtkm::cont::ArrayHandle<vtkm::Vec4f_32> colorMap;
+  colorMap.Allocate(numColors);
+  auto portal = colorMap.WritePortal();
+  for (vtkm::Id i = 0; i < numColors; ++i)
+  {
+    const vtkm::Float64 scalar =
+      range.Min + range.Length() * static_cast<vtkm::Float64>(i) / (numColors - 1);
+    const vtkm::Float32 t = static_cast<vtkm::Float32>(i) / static_cast<vtkm::Float32>(numColors);
+    const vtkm::Float32 alpha = scalar < visibleScalar ? 0.05f : 0.f;
+    portal.Set(i, vtkm::Vec4f_32(t, 1.f - t, 0.5f, alpha));
+  }
+  return colorMap;
+}
+
+struct RenderResult
+{
+  std::vector<vtkm::Float32> Colors;
+  vtkm::Id NumberOfSamples;
+};
+
+RenderResult Render(const vtkm::cont::DataSet& dataset,
+                    const std::string& fieldName,
+                    bool skipping,
+                    vtkm::Id macroCellSize,
+                    vtkm::Float32 opacityThreshold,
+                    vtkm::Range range = vtkm::Range())
+{
+  const vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  const vtkm::cont::Field& field = dataset.GetField(fieldName);
+  if (!range.IsNonEmpty())
+  {
+    field.GetRange(&range);
+  }
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  camera.Azimuth(30.f);
+  camera.Elevation(20.f);
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 64, 64);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+  rayCamera.CreateRays(rays, coords.GetBounds());
+  rays.Buffers.at(0).InitConst(0.f);
+
+  VolumeRenderer tracer;
+  tracer.SetEmptySpaceSkipping(skipping);
+  tracer.SetMacroCellSize(macroCellSize);
+  tracer.SetOpacityThreshold(opacityThreshold);
+  tracer.SetCountSamples(true);
+  tracer.SetData(coords,
+                 field,
+                 dataset.GetCellSet().Cast<vtkm::cont::CellSetStructured<3>>(),
+                 range);
+  tracer.SetColorMap(MakeColorMap(range));
+  tracer.Render(rays);
+
+  RenderResult result;
+  auto colors = rays.Buffers.at(0).Buffer.ReadPortal();
+  for (vtkm::Id i = 0; i < colors.GetNumberOfValues(); ++i)
+  {
+    result.Colors.push_back(colors.Get(i));
+  }
+  result.NumberOfSamples = 0;
+  auto counts = tracer.GetSampleCounts().ReadPortal();
+  VTKM_TEST_ASSERT(counts.GetNumberOfValues() == rays.NumRays, "Wrong number of sample counts.");
+  for (vtkm::Id i = 0; i < counts.GetNumberOfValues(); ++i)
+  {
+    result.NumberOfSamples += counts.Get(i);
+  }
+  return result;
+}
+
+// Skipped samples are fully transparent, so skipping must not change the image.
+void TestSkipping(const vtkm::cont::DataSet& dataset,
+                  const std::string& fieldName,
+                  const vtkm::Range& range = vtkm::Range())
+{
+  const RenderResult full = Render(dataset, fieldName, false, 8, 1.f, range);
+  VTKM_TEST_ASSERT(full.NumberOfSamples > 0, "No samples taken.");
+
+  for (vtkm::Id macroCellSize : { 1, 5, 8 })
+  {
+    std::cout << "  macro cell size " << macroCellSize << std::endl;
+    const RenderResult skipped = Render(dataset, fieldName, true, macroCellSize, 1.f, range);
+    VTKM_TEST_ASSERT(skipped.NumberOfSamples < full.NumberOfSamples,
+                     "Skipping did not reduce the samples.");
+    bool anyVisible = false;
+    for (std::size_t i = 0; i < full.Colors.size(); ++i)
+    {
+      VTKM_TEST_ASSERT(test_equal(skipped.Colors[i], full.Colors[i], 0.01),
+                       "Skipping changed the image.");
+      anyVisible = anyVisible || full.Colors[i] > 0.f;
+    }
+    VTKM_TEST_ASSERT(anyVisible, "Nothing visible in the image.");
+  }
+}
+
+// Rays stop once their opacity reaches the threshold; other rays are unchanged.
+void TestOpacityThreshold(const vtkm::cont::DataSet& dataset)
+{
+  const vtkm::Float32 threshold = 0.3f;
+  const RenderResult full = Render(dataset, "pointvar", true, 8, 1.f);
+  const RenderResult early = Render(dataset, "pointvar", true, 8, threshold);
+  VTKM_TEST_ASSERT(early.NumberOfSamples < full.NumberOfSamples,
+                   "Early termination did not reduce the samples.");
+  for (std::size_t i = 3; i < full.Colors.size(); i += 4)
+  {
+    if (early.Colors[i] < threshold)
+    {
+      VTKM_TEST_ASSERT(test_equal(early.Colors[i], full.Colors[i]), "Ray stopped too early.");
+    }
+    else
+    {
+      VTKM_TEST_ASSERT(early.Colors[i] <= full.Colors[i] + 0.0001f, "Ray went too far.");
+    }
+  }
+
+  VolumeRenderer tracer;
+  bool threw = false;
+  try
+  {
+    tracer.SetOpacityThreshold(0.f);
+  }
+  catch (const vtkm::cont::ErrorBadValue&)
+  {
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "A threshold of 0 was accepted.");
+}
+
+// The samples are only counted on request.
+void TestSampleCounts(const vtkm::cont::DataSet& dataset)
+{
+  const vtkm::cont::CoordinateSystem coords = dataset.GetCoordinateSystem();
+  const vtkm::cont::Field& field = dataset.GetField("pointvar");
+  vtkm::Range range;
+  field.GetRange(&range);
+
+  vtkm::rendering::Camera camera;
+  camera.ResetToBounds(coords.GetBounds());
+  vtkm::rendering::raytracing::Camera rayCamera;
+  rayCamera.SetParameters(camera, 16, 16);
+  vtkm::rendering::raytracing::Ray<vtkm::Float32> rays;
+  rayCamera.CreateRays(rays, coords.GetBounds());
+  rays.Buffers.at(0).InitConst(0.f);
+
+  VolumeRenderer tracer;
+  VTKM_TEST_ASSERT(!tracer.GetCountSamples(), "Samples counted by default.");
+  tracer.SetData(coords,
+                 field,
+                 dataset.GetCellSet().Cast<vtkm::cont::CellSetStructured<3>>(),
+                 range);
+  tracer.SetColorMap(MakeColorMap(range));
+  tracer.Render(rays);
+  VTKM_TEST_ASSERT(tracer.GetSampleCounts().GetNumberOfValues() == 0,
+                   "Samples counted without a request.");
+}
+
+void TestVolumeSkipping()
+{
+  const vtkm::cont::DataSet uniform = MakeUniformDataSet();
+  std::cout << "Uniform point field" << std::endl;
+  TestSkipping(uniform, "pointvar");
+  std::cout << "Uniform cell field" << std::endl;
+  TestSkipping(uniform, "cellvar");
+  std::cout << "Rectilinear point field" << std::endl;
+  TestSkipping(MakeRectilinearDataSet(), "pointvar");
+  std::cout << "Scalar range narrower than the data" << std::endl;
+  TestSkipping(uniform, "pointvar", vtkm::Range(4., 20.));
+  TestSkipping(uniform, "cellvar", vtkm::Range(4., 20.));
+  std::cout << "Opacity threshold" << std::endl;
+  TestOpacityThreshold(uniform);
+  std::cout << "Sample counts" << std::endl;
+  TestSampleCounts(uniform);
+}
+
+} //namespace
+
+int UnitTestVolumeSkipping(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestVolumeSkipping, argc, argv);
+}
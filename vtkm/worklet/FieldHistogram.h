@@ -154,8 +154,9 @@ public:
       binWorklet);
     setHistogramBinDispatcher.Invoke(fieldArray, binIndex);
 
-    // Sort the resulting bin array for counting
-    vtkm::cont::Algorithm::Sort(binIndex);
+    // Sort the resulting bin array for counting. The bins are known to be in
+    // [0, numberOfBins), so a counting sort can be used.
+    vtkm::cont::Algorithm::CountingSort(binIndex, numberOfBins);
 
     // Get the upper bound of each bin number
     vtkm::cont::ArrayHandle<vtkm::Id> totalCount;
@@ -0,0 +1,262 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_FusedMapField_h
+#define vtk_m_worklet_FusedMapField_h
+
+#include <vtkm/StaticAssert.h>
+
+#include <vtkm/worklet/ScatterIdentity.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/internal/Placeholders.h>
+
+#include <type_traits>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+/// \brief Names the output type of a stage in a `FusedMapField`.
+///
+/// The output of a stage whose `ExecutionSignature` returns the value (`_2(_1)`) is deduced
+/// from its `operator()`. Stages that write their output through an argument (`void(_1, _2)`)
+/// usually accept any output type, so the type of the value passed on to the next stage has to
+/// be given. `FusedStage` is the worklet itself with that type attached. It is easiest to
+/// create with `vtkm::worklet::MakeFusedStage`.
+///
+template <typename WorkletType, typename OutputType_>
+class FusedStage : public WorkletType
+{
+public:
+  using OutputType = OutputType_;
+
+  FusedStage() = default;
+
+  VTKM_CONT FusedStage(const WorkletType& worklet)
+    : WorkletType(worklet)
+  {
+  }
+};
+
+template <typename OutputType, typename WorkletType>
+VTKM_CONT vtkm::worklet::FusedStage<WorkletType, OutputType> MakeFusedStage(
+  const WorkletType& worklet)
+{
+  return vtkm::worklet::FusedStage<WorkletType, OutputType>(worklet);
+}
+
+namespace detail
+{
+
+template <typename Stage>
+struct FusedStageTraits
+{
+  static_assert(std::is_base_of<vtkm::worklet::WorkletMapField, Stage>::value,
+                "Only WorkletMapField worklets can be fused.");
+  static_assert(std::is_same<typename Stage::ControlSignature,
+                             void(vtkm::worklet::WorkletMapField::FieldIn,
+                                  vtkm::worklet::WorkletMapField::FieldOut)>::value,
+                "Fused worklets must have a ControlSignature of void(FieldIn, FieldOut).");
+  static_assert(std::is_same<typename Stage::ScatterType, vtkm::worklet::ScatterIdentity>::value,
+                "Fused worklets cannot have a scatter.");
+
+  using ExecutionSignature = typename vtkm::placeholders::GetExecSig<Stage>::ExecutionSignature;
+
+  using ReturnsOutput =
+    typename std::is_same<ExecutionSignature,
+                          vtkm::placeholders::Arg<2>(vtkm::placeholders::Arg<1>)>::type;
+  static_assert(ReturnsOutput::value ||
+                  std::is_same<ExecutionSignature,
+                               void(vtkm::placeholders::Arg<1>, vtkm::placeholders::Arg<2>)>::value,
+                "Fused worklets must have an ExecutionSignature of _2(_1) or void(_1, _2).");
+};
+
+template <typename Stage, typename S = typename Stage::OutputType>
+std::true_type HasFusedOutputType(int);
+template <typename Stage>
+std::false_type HasFusedOutputType(...);
+
+// The type of the value a stage passes on to the next stage when given an `InType`.
+template <typename Stage,
+          typename InType,
+          bool Named = decltype(HasFusedOutputType<Stage>(0))::value,
+          bool Returns = FusedStageTraits<Stage>::ReturnsOutput::value>
+struct FusedStageOutput
+{
+  using type = typename Stage::OutputType;
+};
+
+template <typename Stage, typename InType>
+struct FusedStageOutput<Stage, InType, false, true>
+{
+  using type = typename std::decay<decltype(
+    std::declval<const Stage&>()(std::declval<const InType&>()))>::type;
+};
+
+template <typename Stage, typename InType>
+struct FusedStageOutput<Stage, InType, false, false>
+{
+  static_assert(!std::is_same<Stage, Stage>::value,
+                "A fused worklet with ExecutionSignature void(_1, _2) that is not the last stage "
+                "needs its output type named with vtkm::worklet::MakeFusedStage.");
+  using type = InType;
+};
+
+VTKM_SUPPRESS_EXEC_WARNINGS
+template <typename Stage, typename InType, typename OutType>
+VTKM_EXEC void CallFusedStage(std::true_type, const Stage& stage, const InType& in, OutType& out)
+{
+  out = static_cast<OutType>(stage(in));
+}
+
+VTKM_SUPPRESS_EXEC_WARNINGS
+template <typename Stage, typename InType, typename OutType>
+VTKM_EXEC void CallFusedStage(std::false_type, const Stage& stage, const InType& in, OutType& out)
+{
+  stage(in, out);
+}
+
+template <typename... Stages>
+class FusedChain;
+
+template <typename Stage>
+class FusedChain<Stage>
+{
+public:
+  FusedChain() = default;
+
+  VTKM_CONT FusedChain(const Stage& stage)
+    : Head(stage)
+  {
+  }
+
+  VTKM_CONT void SetErrorMessageBuffer(const vtkm::exec::internal::ErrorMessageBuffer& buffer)
+  {
+    this->Head.SetErrorMessageBuffer(buffer);
+  }
+
+  template <typename InType, typename OutType>
+  VTKM_EXEC void operator()(const InType& in, OutType& out) const
+  {
+    CallFusedStage(typename FusedStageTraits<Stage>::ReturnsOutput{}, this->Head, in, out);
+  }
+
+private:
+  Stage Head;
+};
+
+template <typename Stage, typename... Rest>
+class FusedChain<Stage, Rest...>
+{
+public:
+  FusedChain() = default;
+
+  VTKM_CONT FusedChain(const Stage& stage, const Rest&... rest)
+    : Head(stage)
+    , Tail(rest...)
+  {
+  }
+
+  VTKM_CONT void SetErrorMessageBuffer(const vtkm::exec::internal::ErrorMessageBuffer& buffer)
+  {
+    this->Head.SetErrorMessageBuffer(buffer);
+    this->Tail.SetErrorMessageBuffer(buffer);
+  }
+
+  template <typename InType, typename OutType>
+  VTKM_EXEC void operator()(const InType& in, OutType& out) const
+  {
+    typename FusedStageOutput<Stage, InType>::type value;
+    CallFusedStage(typename FusedStageTraits<Stage>::ReturnsOutput{}, this->Head, in, value);
+    this->Tail(value, out);
+  }
+
+private:
+  Stage Head;
+  FusedChain<Rest...> Tail;
+};
+
+} // namespace detail
+
+/// \brief A worklet that runs a chain of map field worklets in a single pass.
+///
+/// Simple field pipelines often run several `WorkletMapField`s one after another, each of which
+/// reads the whole output of the previous one from memory and writes a whole new array. When the
+/// worklets are cheap, these passes are limited by memory bandwidth. `FusedMapField` invokes all
+/// of the worklets (the stages) for each value in a single dispatch. The output of each stage is
+/// handed directly to the next stage in registers, so no intermediate arrays are allocated.
+///
+/// Each stage must have a `ControlSignature` of `void(FieldIn, FieldOut)` and an
+/// `ExecutionSignature` of `_2(_1)` or `void(_1, _2)` (the default). The fused worklet has the
+/// `ControlSignature` `void(FieldIn, FieldOut)` taking the input of the first stage and the
+/// output of the last. The output type of a `void(_1, _2)` stage that is not last has to be
+/// given with `vtkm::worklet::MakeFusedStage`.
+///
+/// The stages are not dispatched on their own. The chain is a plain functor called from the
+/// `operator()` of the fused worklet, so only the fused worklet goes through the dispatcher's
+/// invocation and transport machinery. The `FieldIn` and `FieldOut` transports and type checks
+/// are applied to the input of the first stage and the output of the last stage only. The
+/// values handed between stages are not transported or checked against the `ControlSignature`
+/// of the stages, and the stages cannot use execution signature tags other than `_1` and `_2`
+/// (such as `WorkIndex`). The stages do share the error message buffer of the fused worklet, so
+/// an error raised by any stage is reported as usual.
+///
+/// \code{cpp}
+/// auto fused = vtkm::worklet::MakeFusedMapField(
+///   vtkm::worklet::MakeFusedStage<vtkm::Vec3f>(vtkm::worklet::Normal{}),
+///   vtkm::worklet::PointElevation{});
+/// invoke(fused, vectors, elevation);
+/// \endcode
+///
+template <typename... Stages>
+class FusedMapField : public vtkm::worklet::WorkletMapField
+{
+  VTKM_STATIC_ASSERT_MSG(sizeof...(Stages) > 0, "FusedMapField needs at least one stage.");
+
+public:
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = void(_1, _2);
+
+  FusedMapField() = default;
+
+  VTKM_CONT explicit FusedMapField(const Stages&... stages)
+    : Chain(stages...)
+  {
+  }
+
+  /// Passes the error buffer on to all the stages so that they can raise errors.
+  ///
+  VTKM_CONT void SetErrorMessageBuffer(const vtkm::exec::internal::ErrorMessageBuffer& buffer)
+  {
+    this->WorkletMapField::SetErrorMessageBuffer(buffer);
+    this->Chain.SetErrorMessageBuffer(buffer);
+  }
+
+  template <typename InType, typename OutType>
+  VTKM_EXEC void operator()(const InType& in, OutType& out) const
+  {
+    this->Chain(in, out);
+  }
+
+private:
+  detail::FusedChain<Stages...> Chain;
+};
+
+/// Creates a `FusedMapField` running the given worklets in order.
+///
+template <typename... Stages>
+VTKM_CONT vtkm::worklet::FusedMapField<Stages...> MakeFusedMapField(const Stages&... stages)
+{
+  return vtkm::worklet::FusedMapField<Stages...>(stages...);
+}
+}
+} // namespace vtkm::worklet
+
+#endif //vtk_m_worklet_FusedMapField_h
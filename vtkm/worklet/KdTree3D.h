@@ -11,7 +11,9 @@
 #define vtkm_m_worklet_KdTree3D_h
 
 #include <vtkm/worklet/spatialstructure/KdTree3DConstruction.h>
+#include <vtkm/worklet/spatialstructure/KdTree3DKNNSearch.h>
 #include <vtkm/worklet/spatialstructure/KdTree3DNNSearch.h>
+#include <vtkm/worklet/spatialstructure/KdTree3DRadiusSearch.h>
 
 namespace vtkm
 {
@@ -66,6 +68,57 @@ public:
       coords, this->PointIds, this->SplitIds, queryPoints, nearestNeighborIds, distances, deviceId);
   }
 
+  /// \brief K nearest neighbor search using KD-Tree
+  ///
+  /// Parallel search of the \c k nearest neighbors for each point in the \c queryPoints in the
+  /// set of \c coords. The neighbors of query point \c i are returned in entries
+  /// [i * k, (i + 1) * k) of \c nearestNeighborIds, sorted from the nearest, and their distances
+  /// in the same entries of \c distances. If \c coords has fewer than \c k points, the remaining
+  /// entries have id -1 and the largest distance of \c CoordType.
+  ///
+  /// \param coords Point coordinates for training data set (haystack)
+  /// \param queryPoints Point coordinates to query for nearest neighbors (needles).
+  /// \param k Number of neighbors to find for each query point.
+  /// \param nearestNeighborIds The \c k nearest neighbors of each query point.
+  /// \param distances Distances between query points and their nearest neighbors.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunKNearest(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coords,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& queryPoints,
+    vtkm::IdComponent k,
+    vtkm::cont::ArrayHandle<vtkm::Id>& nearestNeighborIds,
+    vtkm::cont::ArrayHandle<CoordType>& distances)
+  {
+    vtkm::worklet::spatialstructure::KdTree3DKNNSearch().Run(
+      coords, this->PointIds, this->SplitIds, queryPoints, k, nearestNeighborIds, distances);
+  }
+
+  /// \brief Radius search using KD-Tree
+  ///
+  /// Parallel search of all the points in \c coords within \c radius of each point in the
+  /// \c queryPoints. The neighbors of query point \c i are returned in entries
+  /// [offsets[i], offsets[i + 1]) of \c neighborIds, in no particular order, and their
+  /// distances in the same entries of \c distances.
+  ///
+  /// \param coords Point coordinates for training data set (haystack)
+  /// \param queryPoints Point coordinates to query for neighbors (needles).
+  /// \param radius Largest distance of a neighbor.
+  /// \param neighborIds Neighbors of all query points.
+  /// \param distances Distances between query points and their neighbors.
+  /// \param offsets Start of the neighbors of each query point, followed by their total number.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void RunRadius(
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coords,
+    const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& queryPoints,
+    CoordType radius,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+    vtkm::cont::ArrayHandle<CoordType>& distances,
+    vtkm::cont::ArrayHandle<vtkm::Id>& offsets)
+  {
+    vtkm::worklet::spatialstructure::KdTree3DRadiusSearch().Run(
+      coords, this->PointIds, this->SplitIds, queryPoints, radius, neighborIds, distances, offsets);
+  }
+
 private:
   vtkm::cont::ArrayHandle<vtkm::Id> PointIds;
   vtkm::cont::ArrayHandle<vtkm::Id> SplitIds;
@@ -118,10 +118,16 @@ protected:
 /// Select the type of sort for BuildArrays calls. Unstable sorting is faster
 /// but will not produce consistent ordering for equal keys. Stable sorting
 /// is slower, but keeps equal keys in their original order.
+///
+/// Hash does not sort at all. Equal keys are grouped with a parallel hash
+/// table, which avoids the cost of sorting large arrays. The unique keys are
+/// ordered by where they first appear in the input rather than by value, and
+/// the values within each group are in no particular order.
 enum class KeysSortType
 {
   Unstable = 0,
-  Stable = 1
+  Stable = 1,
+  Hash = 2
 };
 
 /// \brief Manage keys for a \c WorkletReduceByKey.
@@ -237,6 +243,10 @@ private:
   template <typename KeyArrayType>
   VTKM_CONT void BuildArraysInternalStable(const KeyArrayType& keys,
                                            vtkm::cont::DeviceAdapterId device);
+
+  template <typename KeyArrayType>
+  VTKM_CONT void BuildArraysInternalHash(const KeyArrayType& keys,
+                                         vtkm::cont::DeviceAdapterId device);
   /// @endcond
 };
 
@@ -12,10 +12,199 @@
 
 #include <vtkm/worklet/Keys.h>
 
+#include <vtkm/Pair.h>
+#include <vtkm/VecTraits.h>
+
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <cstring>
+#include <type_traits>
+
 namespace vtkm
 {
 namespace worklet
 {
+
+namespace detail
+{
+
+// Hashes for the keys grouped by KeysSortType::Hash. Unlike vtkm::Hash, these handle any
+// scalar, Vec, or Pair key.
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHashCombine(vtkm::UInt64 hash, vtkm::UInt64 value)
+{
+  // FNV-1a on 64-bit words.
+  return (hash ^ value) * 1099511628211ULL;
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHashBits(T key, std::false_type)
+{
+  return static_cast<vtkm::UInt64>(key);
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHashBits(T key, std::true_type)
+{
+  // Adding 0 turns -0 into 0 so that equal values have the same bits.
+  const vtkm::Float64 value = static_cast<vtkm::Float64>(key) + 0.0;
+  vtkm::UInt64 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHash(vtkm::UInt64 hash, const T& key, std::true_type)
+{
+  return KeysHashCombine(hash, KeysHashBits(key, typename std::is_floating_point<T>::type{}));
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHash(vtkm::UInt64 hash, const T& key, std::false_type);
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHash(vtkm::UInt64 hash, const T& key)
+{
+  return KeysHash(hash, key, typename std::is_arithmetic<T>::type{});
+}
+
+template <typename T1, typename T2>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHash(vtkm::UInt64 hash, const vtkm::Pair<T1, T2>& key)
+{
+  return KeysHash(KeysHash(hash, key.first), key.second);
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::UInt64 KeysHash(vtkm::UInt64 hash, const T& key, std::false_type)
+{
+  using Traits = vtkm::VecTraits<T>;
+  const vtkm::IdComponent numComponents = Traits::GetNumberOfComponents(key);
+  for (vtkm::IdComponent index = 0; index < numComponents; ++index)
+  {
+    hash = KeysHash(hash, Traits::GetComponent(key, index));
+  }
+  return hash;
+}
+
+template <typename T>
+VTKM_EXEC_CONT inline vtkm::Id KeysHashSlot(const T& key, vtkm::Id mask)
+{
+  vtkm::UInt64 hash = KeysHash(14695981039346656037ULL, key);
+  // Fold the high bits in so that masking to a power of two uses all of them.
+  hash ^= hash >> 29;
+  return static_cast<vtkm::Id>(hash) & mask;
+}
+
+// Inserts every key in an open addressing hash table that maps to the smallest index holding
+// an equal key. Outputs the table slot of each key.
+struct KeysHashInsert : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key,
+                                WholeArrayIn keys,
+                                AtomicArrayInOut table,
+                                FieldOut slot);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3, _4);
+
+  template <typename KeyType, typename KeysPortal, typename TableType>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const KeyType& key,
+                            const KeysPortal& keys,
+                            const TableType& table,
+                            vtkm::Id& slot) const
+  {
+    const vtkm::Id mask = table.GetNumberOfValues() - 1;
+    slot = KeysHashSlot(key, mask);
+    while (true)
+    {
+      vtkm::Id current = -1;
+      if (table.CompareExchange(slot, &current, index))
+      {
+        return;
+      }
+      // `current` is now the index held by the slot. Every index ever held by a slot has the
+      // same key, so compare against it and keep the smaller index.
+      if (keys.Get(current) == key)
+      {
+        while ((index < current) && !table.CompareExchange(slot, &current, index))
+        {
+        }
+        return;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+};
+
+struct KeysHashIsFirst : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn slot, WholeArrayIn table, FieldOut isFirst);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3);
+
+  template <typename TablePortal>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            vtkm::Id slot,
+                            const TablePortal& table,
+                            vtkm::UInt8& isFirst) const
+  {
+    isFirst = (table.Get(slot) == index) ? 1 : 0;
+  }
+};
+
+// Replaces the index stored in the slot of each unique key with the number of the group.
+struct KeysHashNumberGroups : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn firstIndex, WholeArrayIn slots, WholeArrayOut table);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3);
+
+  template <typename SlotsPortal, typename TablePortal>
+  VTKM_EXEC void operator()(vtkm::Id group,
+                            vtkm::Id firstIndex,
+                            const SlotsPortal& slots,
+                            const TablePortal& table) const
+  {
+    table.Set(slots.Get(firstIndex), group);
+  }
+};
+
+// Replaces the slot of each key with its group and counts the values in each group.
+struct KeysHashCount : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldInOut slotToGroup,
+                                WholeArrayIn table,
+                                AtomicArrayInOut counts);
+
+  template <typename TablePortal, typename CountsType>
+  VTKM_EXEC void operator()(vtkm::Id& slotToGroup,
+                            const TablePortal& table,
+                            const CountsType& counts) const
+  {
+    slotToGroup = table.Get(slotToGroup);
+    counts.Add(slotToGroup, 1);
+  }
+};
+
+struct KeysHashPlace : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn group,
+                                WholeArrayIn offsets,
+                                AtomicArrayInOut cursors,
+                                WholeArrayOut sortedValuesMap);
+  using ExecutionSignature = void(InputIndex, _1, _2, _3, _4);
+
+  template <typename OffsetsPortal, typename CursorsType, typename MapPortal>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            vtkm::Id group,
+                            const OffsetsPortal& offsets,
+                            const CursorsType& cursors,
+                            const MapPortal& sortedValuesMap) const
+  {
+    sortedValuesMap.Set(offsets.Get(group) + cursors.Add(group, 1), index);
+  }
+};
+
+} // namespace detail
+
 /// Build the internal arrays without modifying the input. This is more
 /// efficient for stable sorted arrays, but requires an extra copy of the
 /// keys for unstable sorting.
@@ -40,6 +229,9 @@ VTKM_CONT void Keys<T>::BuildArrays(const KeyArrayType& keys,
     case KeysSortType::Stable:
       this->BuildArraysInternalStable(keys, device);
       break;
+    case KeysSortType::Hash:
+      this->BuildArraysInternalHash(keys, device);
+      break;
   }
 }
 
@@ -60,8 +252,16 @@ VTKM_CONT void Keys<T>::BuildArraysInPlace(KeyArrayType& keys,
       this->BuildArraysInternal(keys, device);
       break;
     case KeysSortType::Stable:
+    case KeysSortType::Hash:
     {
-      this->BuildArraysInternalStable(keys, device);
+      if (sort == KeysSortType::Stable)
+      {
+        this->BuildArraysInternalStable(keys, device);
+      }
+      else
+      {
+        this->BuildArraysInternalHash(keys, device);
+      }
       KeyArrayHandleType tmp;
       // Copy into a temporary array so that the permutation array copy
       // won't alias input/output memory:
@@ -130,6 +330,63 @@ VTKM_CONT void Keys<T>::BuildArraysInternalStable(const KeyArrayType& keys,
   VTKM_ASSERT(numKeys ==
               vtkm::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
 }
+
+template <typename T>
+template <typename KeyArrayType>
+VTKM_CONT void Keys<T>::BuildArraysInternalHash(const KeyArrayType& keys,
+                                                vtkm::cont::DeviceAdapterId device)
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Keys::BuildArraysInternalHash");
+
+  const vtkm::Id numKeys = keys.GetNumberOfValues();
+  vtkm::cont::Invoker invoke(device);
+
+  // Size the table to a power of two at least twice the number of keys so that probe
+  // sequences stay short.
+  vtkm::Id tableSize = 1;
+  while (tableSize < 2 * numKeys)
+  {
+    tableSize *= 2;
+  }
+  vtkm::cont::ArrayHandle<vtkm::Id> table;
+  vtkm::cont::Algorithm::Fill(device, table, vtkm::Id(-1), tableSize);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> slots;
+  invoke(detail::KeysHashInsert{}, keys, keys, table, slots);
+
+  // The first value with each key represents its group. Numbering the groups in the order of
+  // these values makes the result independent of the order the keys were inserted.
+  vtkm::cont::ArrayHandle<vtkm::Id> firstIndices;
+  {
+    vtkm::cont::ArrayHandle<vtkm::UInt8> isFirst;
+    invoke(detail::KeysHashIsFirst{}, slots, table, isFirst);
+    vtkm::cont::Algorithm::CopyIf(
+      device, vtkm::cont::ArrayHandleIndex(numKeys), isFirst, firstIndices);
+  }
+  const vtkm::Id numUniqueKeys = firstIndices.GetNumberOfValues();
+  invoke(detail::KeysHashNumberGroups{}, firstIndices, slots, table);
+
+  // From here on `slots` holds the group of each value.
+  vtkm::cont::Algorithm::Fill(device, this->Counts, vtkm::IdComponent(0), numUniqueKeys);
+  invoke(detail::KeysHashCount{}, slots, table, this->Counts);
+  table.ReleaseResources();
+
+  vtkm::cont::Algorithm::ScanExtended(
+    device, vtkm::cont::make_ArrayHandleCast(this->Counts, vtkm::Id()), this->Offsets);
+
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> cursors;
+    vtkm::cont::Algorithm::Fill(device, cursors, vtkm::Id(0), numUniqueKeys);
+    this->SortedValuesMap.Allocate(numKeys);
+    invoke(detail::KeysHashPlace{}, slots, this->Offsets, cursors, this->SortedValuesMap);
+  }
+
+  vtkm::cont::Algorithm::Copy(
+    device, vtkm::cont::make_ArrayHandlePermutation(firstIndices, keys), this->UniqueKeys);
+
+  VTKM_ASSERT(numKeys ==
+              vtkm::cont::ArrayGetValue(this->Offsets.GetNumberOfValues() - 1, this->Offsets));
+}
 }
 }
 #endif
@@ -70,6 +70,7 @@ public:
     vtkm::cont::ArrayHandle<vtkm::Id> freqs;
     vtkm::cont::ArrayCopy(freqsIn, freqs);
     vtkm::Id numMarginalVariables = 0; //count num of marginal variables
+    vtkm::Id numMarginalBins = 1;       //range of the marginal 1D index
     const auto marginalPortal = marginalVariables.ReadPortal();
     const auto numBinsPortal = numberOfBins.ReadPortal();
     for (vtkm::Id i = 0; i < numOfVariable; i++)
@@ -79,6 +80,7 @@ public:
         // Worklet to calculate 1D index for marginal variables
         numMarginalVariables++;
         const vtkm::Id nFieldBins = numBinsPortal.Get(i);
+        numMarginalBins = vtkm::Min(numMarginalBins * nFieldBins, numberOfValues + 1);
         vtkm::worklet::histogram::To1DIndex binWorklet(nFieldBins);
         vtkm::worklet::DispatcherMapField<vtkm::worklet::histogram::To1DIndex> to1DIndexDispatcher(
           binWorklet);
@@ -102,7 +104,15 @@ public:
 
 
     // Sort the freq array for counting by key(1DIndex)
-    vtkm::cont::Algorithm::SortByKey(bin1DIndex, freqs);
+    // Use a counting sort when the range of the 1D index is not larger than the data
+    if (numMarginalBins <= numberOfValues)
+    {
+      vtkm::cont::Algorithm::CountingSortByKey(bin1DIndex, freqs, numMarginalBins);
+    }
+    else
+    {
+      vtkm::cont::Algorithm::SortByKey(bin1DIndex, freqs);
+    }
 
     // Add frequency within same 1d index bin (this get a nonSparse representation)
     vtkm::cont::ArrayHandle<vtkm::Id> nonSparseMarginalFreqs;
@@ -153,6 +163,7 @@ public:
     vtkm::cont::ArrayHandle<vtkm::Id> freqs;
     vtkm::cont::ArrayCopy(freqsIn, freqs);
     vtkm::Id numMarginalVariables = 0; //count num of marginal variables
+    vtkm::Id numMarginalBins = 1;       //range of the marginal 1D index
     const auto marginalPortal = marginalVariables.ReadPortal();
     const auto numBinsPortal = numberOfBins.ReadPortal();
     for (vtkm::Id i = 0; i < numOfVariable; i++)
@@ -162,6 +173,7 @@ public:
         // Worklet to calculate 1D index for marginal variables
         numMarginalVariables++;
         const vtkm::Id nFieldBins = numBinsPortal.Get(i);
+        numMarginalBins = vtkm::Min(numMarginalBins * nFieldBins, numberOfValues + 1);
         vtkm::worklet::histogram::To1DIndex binWorklet(nFieldBins);
         vtkm::worklet::DispatcherMapField<vtkm::worklet::histogram::To1DIndex> to1DIndexDispatcher(
           binWorklet);
@@ -171,7 +183,15 @@ public:
     }
 
     // Sort the freq array for counting by key (1DIndex)
-    vtkm::cont::Algorithm::SortByKey(bin1DIndex, freqs);
+    // Use a counting sort when the range of the 1D index is not larger than the data
+    if (numMarginalBins <= numberOfValues)
+    {
+      vtkm::cont::Algorithm::CountingSortByKey(bin1DIndex, freqs, numMarginalBins);
+    }
+    else
+    {
+      vtkm::cont::Algorithm::SortByKey(bin1DIndex, freqs);
+    }
 
     // Add frequency within same 1d index bin
     vtkm::cont::Algorithm::ReduceByKey(bin1DIndex, freqs, bin1DIndex, marginalFreqs, vtkm::Add());
@@ -101,8 +101,26 @@ public:
   {
     binId.resize(NumberOfBins.size());
 
-    // Sort the resulting bin(1D) array for counting
-    vtkm::cont::Algorithm::Sort(Bin1DIndex);
+    // Sort the resulting bin(1D) array for counting. The 1D bins are in
+    // [0, product of the number of bins). Use a counting sort unless that range
+    // is larger than the data.
+    vtkm::Id numberOfBins1D = 1;
+    for (vtkm::Id numberOfBins : NumberOfBins)
+    {
+      if (numberOfBins1D > NumDataPoints)
+      {
+        break;
+      }
+      numberOfBins1D *= numberOfBins;
+    }
+    if (numberOfBins1D <= NumDataPoints)
+    {
+      vtkm::cont::Algorithm::CountingSort(Bin1DIndex, numberOfBins1D);
+    }
+    else
+    {
+      vtkm::cont::Algorithm::Sort(Bin1DIndex);
+    }
 
     // Count frequency of each bin
     vtkm::cont::ArrayHandleConstant<vtkm::Id> constArray(1, NumDataPoints);
@@ -15,10 +15,12 @@
 #include <vtkm/internal/FunctionInterface.h>
 #include <vtkm/internal/Invocation.h>
 
+#include <vtkm/cont/AsyncEvent.h>
 #include <vtkm/cont/CastAndCall.h>
 #include <vtkm/cont/ErrorBadType.h>
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/TryExecute.h>
+#include <vtkm/cont/WorkletProfiler.h>
 
 #include <vtkm/cont/arg/ControlSignatureTagBase.h>
 #include <vtkm/cont/arg/Transport.h>
@@ -601,6 +603,14 @@ public:
   VTKM_CONT vtkm::cont::DeviceAdapterId GetDevice() const { return this->Device; }
   //@}
 
+  /// Setting an async event makes `Invoke` return as soon as the arguments are prepared for
+  /// the device rather than waiting for the worklet to finish. The event tracking the
+  /// invocation is written to the given pointer. Set to `nullptr` (the default) to invoke
+  /// synchronously. `vtkm::cont::Invoker::Async` is the usual way to use this.
+  ///
+  VTKM_CONT
+  void SetAsyncEvent(vtkm::cont::AsyncEvent* event) { this->AsyncEventOutput = event; }
+
   using ScatterType = typename WorkletType::ScatterType;
   using MaskType = typename WorkletType::MaskType;
 
@@ -626,6 +636,7 @@ protected:
     , Scatter(scatter)
     , Mask(mask)
     , Device(vtkm::cont::DeviceAdapterTagAny())
+    , AsyncEventOutput(nullptr)
   {
   }
 
@@ -639,6 +650,7 @@ protected:
     , Scatter(scatter)
     , Mask(mask)
     , Device(vtkm::cont::DeviceAdapterTagAny())
+    , AsyncEventOutput(nullptr)
   {
   }
 
@@ -654,6 +666,7 @@ protected:
     , Scatter(scatter)
     , Mask(mask)
     , Device(vtkm::cont::DeviceAdapterTagAny())
+    , AsyncEventOutput(nullptr)
   {
   }
 
@@ -667,6 +680,7 @@ protected:
     , Scatter(scatter)
     , Mask(mask)
     , Device(vtkm::cont::DeviceAdapterTagAny())
+    , AsyncEventOutput(nullptr)
   {
   }
 
@@ -718,6 +732,7 @@ private:
   void operator=(const MyType&) = delete;
 
   vtkm::cont::DeviceAdapterId Device;
+  vtkm::cont::AsyncEvent* AsyncEventOutput;
 
   template <typename Invocation,
             typename InputRangeType,
@@ -730,6 +745,16 @@ private:
                                            ThreadRangeType&& threadRange,
                                            DeviceAdapter device) const
   {
+    // When the profiler is on, this invocation is recorded once it finishes.
+    vtkm::cont::WorkletProfiler& profiler = vtkm::cont::GetWorkletProfiler();
+    const bool profile = profiler.GetEnabled();
+    vtkm::cont::WorkletProfileEvent profileEvent;
+    if (profile)
+    {
+      profileEvent =
+        profiler.StartEvent(vtkm::cont::TypeToString<WorkletType>(), device, inputRange);
+    }
+
     // This token represents the scope of the execution objects. It should
     // exist as long as things run on the device.
     vtkm::cont::Token token;
@@ -780,11 +805,53 @@ private:
                         visitArray.PrepareForInput(device, token),
                         threadToOutputMap.PrepareForInput(device, token));
 
-    this->InvokeSchedule(changedInvocation, threadRange, device);
+    if (profile)
+    {
+      profiler.FinishTransfer(profileEvent);
+    }
+
+    if (this->AsyncEventOutput != nullptr)
+    {
+      // The token moves into the event so that the arguments stay attached to it (and any
+      // conflicting access to them waits) until the worklet finishes running.
+      using RangeType = typename std::decay<ThreadRangeType>::type;
+      const WorkletType& worklet = this->Worklet;
+      const RangeType range = threadRange;
+      profileEvent.Async = true;
+      *this->AsyncEventOutput = vtkm::cont::LaunchAsync(
+        device,
+        std::move(token),
+        [worklet, changedInvocation, range, device, profile, profileEvent]() {
+          InvokeSchedule(worklet, changedInvocation, range, device);
+          if (profile)
+          {
+            FinishProfileEvent(profileEvent, device);
+          }
+        });
+      return;
+    }
+
+    InvokeSchedule(this->Worklet, changedInvocation, threadRange, device);
+    if (profile)
+    {
+      FinishProfileEvent(profileEvent, device);
+    }
+  }
+
+  template <typename DeviceAdapter>
+  VTKM_CONT static void FinishProfileEvent(const vtkm::cont::WorkletProfileEvent& event,
+                                           DeviceAdapter)
+  {
+    // Wait for the device so that the elapsed time covers the whole execution.
+    vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapter>::Synchronize();
+    vtkm::cont::GetWorkletProfiler().FinishEvent(event);
   }
 
   template <typename Invocation, typename RangeType, typename DeviceAdapter>
-  VTKM_CONT void InvokeSchedule(const Invocation& invocation, RangeType range, DeviceAdapter) const
+  VTKM_CONT static void InvokeSchedule(const WorkletType& worklet,
+                                       const Invocation& invocation,
+                                       RangeType range,
+                                       DeviceAdapter)
   {
     using Algorithm = vtkm::cont::DeviceAdapterAlgorithm<DeviceAdapter>;
     using TaskTypes = typename vtkm::cont::DeviceTaskTypes<DeviceAdapter>;
@@ -796,7 +863,7 @@ private:
     // vtkm::exec::internal::TaskSingular
     // vtkm::exec::internal::TaskTiling1D
     // vtkm::exec::internal::TaskTiling3D
-    auto task = TaskTypes::MakeTask(this->Worklet, invocation, range);
+    auto task = TaskTypes::MakeTask(worklet, invocation, range);
     Algorithm::ScheduleTask(task, range);
   }
 };
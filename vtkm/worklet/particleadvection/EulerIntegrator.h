@@ -24,6 +24,8 @@ template <typename EvaluatorType>
 class ExecEulerIntegrator
 {
 public:
+  using LastCell = typename EvaluatorType::LastCell;
+
   VTKM_EXEC_CONT
   ExecEulerIntegrator(const EvaluatorType& evaluator)
     : Evaluator(evaluator)
@@ -33,12 +35,13 @@ public:
   template <typename Particle>
   VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
                                        vtkm::FloatDefault stepLength,
-                                       vtkm::Vec3f& velocity) const
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
   {
     auto time = particle.Time;
     auto inpos = particle.Pos;
     vtkm::VecVariable<vtkm::Vec3f, 2> vectors;
-    GridEvaluatorStatus status = this->Evaluator.Evaluate(inpos, time, vectors);
+    GridEvaluatorStatus status = this->Evaluator.Evaluate(inpos, time, vectors, lastCell);
     if (status.CheckOk())
       velocity = particle.Velocity(vectors, stepLength);
     return IntegratorStatus(status);
@@ -16,6 +16,7 @@
 #include <vtkm/Types.h>
 #include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/CellLocatorCache.h>
 #include <vtkm/cont/CellLocatorGeneral.h>
 #include <vtkm/cont/CellLocatorRectilinearGrid.h>
 #include <vtkm/cont/CellLocatorTwoLevel.h>
@@ -38,8 +39,13 @@ template <typename FieldType>
 class ExecutionGridEvaluator
 {
   using GhostCellArrayType = vtkm::cont::ArrayHandle<vtkm::UInt8>;
+  using LocatorType = typename vtkm::cont::CellLocatorGeneral::ExecObjType;
 
 public:
+  /// The cell found by the last evaluation of a particle. Passing it to the next evaluation
+  /// of the same particle lets the locator start its search from that cell.
+  using LastCell = typename LocatorType::LastCell;
+
   VTKM_CONT
   ExecutionGridEvaluator() = default;
 
@@ -92,6 +98,16 @@ public:
   VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& point,
                                          const vtkm::FloatDefault& time,
                                          vtkm::VecVariable<Point, 2>& out) const
+  {
+    LastCell lastCell;
+    return this->Evaluate(point, time, out, lastCell);
+  }
+
+  template <typename Point>
+  VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& point,
+                                         const vtkm::FloatDefault& time,
+                                         vtkm::VecVariable<Point, 2>& out,
+                                         LastCell& lastCell) const
   {
     vtkm::Id cellId = -1;
     Point parametric;
@@ -104,7 +120,7 @@ public:
       status.SetTemporalBounds();
     }
 
-    this->Locator.FindCell(point, cellId, parametric);
+    this->Locator.FindCell(point, cellId, parametric, lastCell);
     if (cellId == -1)
     {
       status.SetFail();
@@ -148,7 +164,7 @@ private:
   GhostCellPortal GhostCells;
   bool HaveGhostCells;
   vtkm::exec::CellInterpolationHelper InterpolationHelper;
-  typename vtkm::cont::CellLocatorGeneral::ExecObjType Locator;
+  LocatorType Locator;
 };
 
 template <typename FieldType>
@@ -212,8 +228,12 @@ private:
   VTKM_CONT void InitializeLocator(const vtkm::cont::CoordinateSystem& coordinates,
                                    const vtkm::cont::DynamicCellSet& cellset)
   {
-    this->Locator.SetCoordinates(coordinates);
-    this->Locator.SetCellSet(cellset);
+    // Reuse the locator if the locator cache is enabled and the mesh did not change since the
+    // last evaluator was made for it.
+    this->Locator = vtkm::cont::GetCellLocatorCache().GetLocator<vtkm::cont::CellLocatorGeneral>(
+      cellset, coordinates);
+    // Build the search structure now rather than on first use, so that threads advecting
+    // through the same evaluator at once do not race to build it.
     this->Locator.Update();
     this->InterpolationHelper = vtkm::cont::CellInterpolationHelper(cellset);
   }
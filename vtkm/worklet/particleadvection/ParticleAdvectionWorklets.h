@@ -23,6 +23,7 @@
 #include <vtkm/Particle.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/particleadvection/Particles.h>
+#include <vtkm/worklet/particleadvection/ParticlesSOA.h>
 #include <vtkm/worklet/particleadvection/Stepper.h>
 
 #ifdef VTKM_CUDA
@@ -62,11 +63,14 @@ public:
     // 2. could you have success AND at spatial?
     // 3. all three?
 
+    // Each step starts its cell search from the cell of the previous one.
+    typename IntegratorType::LastCell lastCell;
+
     integralCurve.PreStepUpdate(idx);
     do
     {
       vtkm::Vec3f outpos;
-      auto status = integrator.Step(particle, time, outpos);
+      auto status = integrator.Step(particle, time, outpos, lastCell);
       if (status.CheckOk())
       {
         integralCurve.StepUpdate(idx, time, outpos);
@@ -78,7 +82,7 @@ public:
       //Try and take a step just past the boundary.
       else if (status.CheckSpatialBounds())
       {
-        status = integrator.SmallStep(particle, time, outpos);
+        status = integrator.SmallStep(particle, time, outpos, lastCell);
         if (status.CheckOk())
         {
           integralCurve.StepUpdate(idx, time, outpos);
@@ -107,13 +111,31 @@ public:
            vtkm::cont::ArrayHandle<ParticleType>& particles,
            vtkm::Id& MaxSteps)
   {
+    using ParticleArrayType = vtkm::worklet::particleadvection::Particles<ParticleType>;
+    this->RunImpl(integrator, ParticleArrayType(particles, MaxSteps), MaxSteps);
+  }
+
+  /// Advects particles stored as a structure of arrays. The arrays are updated in place.
+  ///
+  void Run(const IntegratorType& integrator,
+           vtkm::worklet::particleadvection::ParticleArraysSOA& particles,
+           vtkm::Id& MaxSteps)
+  {
+    this->RunImpl(
+      integrator, vtkm::worklet::particleadvection::ParticlesSOA(particles, MaxSteps), MaxSteps);
+  }
 
+private:
+  template <typename ParticleObjectType>
+  void RunImpl(const IntegratorType& integrator,
+               const ParticleObjectType& particlesObj,
+               vtkm::Id MaxSteps)
+  {
     using ParticleAdvectWorkletType = vtkm::worklet::particleadvection::ParticleAdvectWorklet;
     using ParticleWorkletDispatchType =
       typename vtkm::worklet::DispatcherMapField<ParticleAdvectWorkletType>;
-    using ParticleArrayType = vtkm::worklet::particleadvection::Particles<ParticleType>;
 
-    vtkm::Id numSeeds = static_cast<vtkm::Id>(particles.GetNumberOfValues());
+    vtkm::Id numSeeds = particlesObj.GetNumberOfParticles();
     //Create and invoke the particle advection.
     vtkm::cont::ArrayHandleConstant<vtkm::Id> maxSteps(MaxSteps, numSeeds);
     vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
@@ -124,8 +146,6 @@ public:
     (void)stack;
 #endif // VTKM_CUDA
 
-    ParticleArrayType particlesObj(particles, MaxSteps);
-
     //Invoke particle advection worklet
     ParticleWorkletDispatchType particleWorkletDispatch;
 
@@ -146,6 +166,10 @@ public:
   {
     numSteps = p.NumSteps;
   }
+  VTKM_EXEC void operator()(const vtkm::Id& pNumSteps, vtkm::Id& numSteps) const
+  {
+    numSteps = pNumSteps;
+  }
 };
 
 class ComputeNumPoints : public vtkm::worklet::WorkletMapField
@@ -164,6 +188,12 @@ public:
   {
     diff = 1 + p.NumSteps - initialNumSteps;
   }
+  VTKM_EXEC void operator()(const vtkm::Id& numSteps,
+                            const vtkm::Id& initialNumSteps,
+                            vtkm::Id& diff) const
+  {
+    diff = 1 + numSteps - initialNumSteps;
+  }
 };
 } // namespace detail
 
@@ -179,19 +209,60 @@ public:
            vtkm::cont::ArrayHandle<vtkm::Vec3f, PointStorage2>& positions,
            vtkm::cont::CellSetExplicit<>& polyLines)
   {
+    using StreamlineArrayType =
+      vtkm::worklet::particleadvection::StateRecordingParticles<ParticleType>;
+
+    this->RunImpl(it,
+                  StreamlineArrayType(particles, MaxSteps),
+                  particles,
+                  MaxSteps,
+                  positions,
+                  polyLines);
+  }
 
+  /// Computes streamlines of particles stored as a structure of arrays. The arrays are updated
+  /// in place.
+  ///
+  template <typename PointStorage2>
+  void Run(const IntegratorType& it,
+           vtkm::worklet::particleadvection::ParticleArraysSOA& particles,
+           vtkm::Id& MaxSteps,
+           vtkm::cont::ArrayHandle<vtkm::Vec3f, PointStorage2>& positions,
+           vtkm::cont::CellSetExplicit<>& polyLines)
+  {
+    using StreamlineArrayType = vtkm::worklet::particleadvection::
+      StateRecordingParticles<vtkm::Particle, vtkm::worklet::particleadvection::ParticlesSOA>;
+
+    this->RunImpl(it,
+                  StreamlineArrayType(
+                    vtkm::worklet::particleadvection::ParticlesSOA(particles, MaxSteps), MaxSteps),
+                  particles.GetNumSteps(),
+                  MaxSteps,
+                  positions,
+                  polyLines);
+  }
+
+private:
+  // `steps` is an array that `detail::GetSteps` and `detail::ComputeNumPoints` can get the
+  // number of steps of each particle from.
+  template <typename StreamlineArrayType, typename StepsArrayType, typename PointStorage2>
+  void RunImpl(const IntegratorType& it,
+               StreamlineArrayType streamlines,
+               const StepsArrayType& steps,
+               vtkm::Id MaxSteps,
+               vtkm::cont::ArrayHandle<vtkm::Vec3f, PointStorage2>& positions,
+               vtkm::cont::CellSetExplicit<>& polyLines)
+  {
     using ParticleWorkletDispatchType = typename vtkm::worklet::DispatcherMapField<
       vtkm::worklet::particleadvection::ParticleAdvectWorklet>;
-    using StreamlineArrayType =
-      vtkm::worklet::particleadvection::StateRecordingParticles<ParticleType>;
 
     vtkm::cont::ArrayHandle<vtkm::Id> initialStepsTaken;
 
-    vtkm::Id numSeeds = static_cast<vtkm::Id>(particles.GetNumberOfValues());
+    vtkm::Id numSeeds = static_cast<vtkm::Id>(steps.GetNumberOfValues());
     vtkm::cont::ArrayHandleIndex idxArray(numSeeds);
 
     vtkm::worklet::DispatcherMapField<detail::GetSteps> getStepDispatcher{ (detail::GetSteps{}) };
-    getStepDispatcher.Invoke(particles, initialStepsTaken);
+    getStepDispatcher.Invoke(steps, initialStepsTaken);
 
 #ifdef VTKM_CUDA
     // This worklet needs some extra space on CUDA.
@@ -200,7 +271,6 @@ public:
 #endif // VTKM_CUDA
 
     //Run streamline worklet
-    StreamlineArrayType streamlines(particles, MaxSteps);
     ParticleWorkletDispatchType particleWorkletDispatch;
     vtkm::cont::ArrayHandleConstant<vtkm::Id> maxSteps(MaxSteps, numSeeds);
     particleWorkletDispatch.Invoke(idxArray, it, streamlines, maxSteps);
@@ -212,7 +282,7 @@ public:
     vtkm::cont::ArrayHandle<vtkm::Id> numPoints;
     vtkm::worklet::DispatcherMapField<detail::ComputeNumPoints> computeNumPointsDispatcher{ (
       detail::ComputeNumPoints{}) };
-    computeNumPointsDispatcher.Invoke(particles, initialStepsTaken, numPoints);
+    computeNumPointsDispatcher.Invoke(steps, initialStepsTaken, numPoints);
 
     vtkm::cont::ArrayHandle<vtkm::Id> cellIndex;
     vtkm::Id connectivityLen = vtkm::cont::Algorithm::ScanExclusive(numPoints, cellIndex);
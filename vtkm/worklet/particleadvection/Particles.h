@@ -113,15 +113,16 @@ template <typename ParticleType>
 class Particles : public vtkm::cont::ExecutionObjectBase
 {
 public:
-  VTKM_CONT vtkm::worklet::particleadvection::ParticleExecutionObject<ParticleType>
-  PrepareForExecution(vtkm::cont::DeviceAdapterId device, vtkm::cont::Token& token) const
+  using ExecObjectType = vtkm::worklet::particleadvection::ParticleExecutionObject<ParticleType>;
+
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
   {
-    return vtkm::worklet::particleadvection::ParticleExecutionObject<ParticleType>(
-      this->ParticleArray, this->MaxSteps, device, token);
+    return ExecObjectType(this->ParticleArray, this->MaxSteps, device, token);
   }
 
   VTKM_CONT
-  Particles(vtkm::cont::ArrayHandle<ParticleType>& pArray, vtkm::Id& maxSteps)
+  Particles(const vtkm::cont::ArrayHandle<ParticleType>& pArray, const vtkm::Id& maxSteps)
     : ParticleArray(pArray)
     , MaxSteps(maxSteps)
   {
@@ -129,19 +130,29 @@ public:
 
   Particles() {}
 
+  VTKM_CONT vtkm::Id GetNumberOfParticles() const
+  {
+    return this->ParticleArray.GetNumberOfValues();
+  }
+
 protected:
   vtkm::cont::ArrayHandle<ParticleType> ParticleArray;
   vtkm::Id MaxSteps;
 };
 
 
-template <typename ParticleType>
-class StateRecordingParticleExecutionObject : public ParticleExecutionObject<ParticleType>
+/// Records the position of every step of the particles in addition to updating them.
+/// `ParticleExecObjectType` is the execution object that holds the particles, either a
+/// `ParticleExecutionObject` or a `ParticleSOAExecutionObject`.
+///
+template <typename ParticleType,
+          typename ParticleExecObjectType = ParticleExecutionObject<ParticleType>>
+class StateRecordingParticleExecutionObject : public ParticleExecObjectType
 {
 public:
   VTKM_EXEC_CONT
   StateRecordingParticleExecutionObject()
-    : ParticleExecutionObject<ParticleType>()
+    : ParticleExecObjectType()
     , History()
     , Length(0)
     , StepCount()
@@ -149,17 +160,17 @@ public:
   {
   }
 
-  StateRecordingParticleExecutionObject(vtkm::cont::ArrayHandle<ParticleType> pArray,
+  StateRecordingParticleExecutionObject(const ParticleExecObjectType& particles,
+                                        vtkm::Id numPos,
                                         vtkm::cont::ArrayHandle<vtkm::Vec3f> historyArray,
                                         vtkm::cont::ArrayHandle<vtkm::Id> validPointArray,
                                         vtkm::cont::ArrayHandle<vtkm::Id> stepCountArray,
                                         vtkm::Id maxSteps,
                                         vtkm::cont::DeviceAdapterId device,
                                         vtkm::cont::Token& token)
-    : ParticleExecutionObject<ParticleType>(pArray, maxSteps, device, token)
+    : ParticleExecObjectType(particles)
     , Length(maxSteps + 1)
   {
-    vtkm::Id numPos = pArray.GetNumberOfValues();
     History = historyArray.PrepareForOutput(numPos * Length, device, token);
     ValidPoint = validPointArray.PrepareForInPlace(device, token);
     StepCount = stepCountArray.PrepareForInPlace(device, token);
@@ -168,7 +179,7 @@ public:
   VTKM_EXEC
   void PreStepUpdate(const vtkm::Id& idx)
   {
-    ParticleType p = this->ParticleExecutionObject<ParticleType>::GetParticle(idx);
+    ParticleType p = this->ParticleExecObjectType::GetParticle(idx);
     if (this->StepCount.Get(idx) == 0)
     {
       vtkm::Id loc = idx * Length;
@@ -181,7 +192,7 @@ public:
   VTKM_EXEC
   void StepUpdate(const vtkm::Id& idx, vtkm::FloatDefault time, const vtkm::Vec3f& pt)
   {
-    this->ParticleExecutionObject<ParticleType>::StepUpdate(idx, time, pt);
+    this->ParticleExecObjectType::StepUpdate(idx, time, pt);
 
     //local step count.
     vtkm::Id stepCount = this->StepCount.Get(idx);
@@ -202,10 +213,17 @@ protected:
   IdPortal ValidPoint;
 };
 
-template <typename ParticleType>
+/// Records the position of every step of the particles held by `ParticleObjectType`, either
+/// `Particles` or `ParticlesSOA`.
+///
+template <typename ParticleType, typename ParticleObjectType = Particles<ParticleType>>
 class StateRecordingParticles : vtkm::cont::ExecutionObjectBase
 {
 public:
+  using ParticleExecObjectType = typename ParticleObjectType::ExecObjectType;
+  using ExecObjectType = vtkm::worklet::particleadvection::
+    StateRecordingParticleExecutionObject<ParticleType, ParticleExecObjectType>;
+
   //Helper functor for compacting history
   struct IsOne
   {
@@ -217,24 +235,30 @@ public:
   };
 
 
-  VTKM_CONT vtkm::worklet::particleadvection::StateRecordingParticleExecutionObject<ParticleType>
-  PrepareForExecution(vtkm::cont::DeviceAdapterId device, vtkm::cont::Token& token) const
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
   {
-    return vtkm::worklet::particleadvection::StateRecordingParticleExecutionObject<ParticleType>(
-      this->ParticleArray,
-      this->HistoryArray,
-      this->ValidPointArray,
-      this->StepCountArray,
-      this->MaxSteps,
-      device,
-      token);
+    return ExecObjectType(this->ParticleObject.PrepareForExecution(device, token),
+                          this->ParticleObject.GetNumberOfParticles(),
+                          this->HistoryArray,
+                          this->ValidPointArray,
+                          this->StepCountArray,
+                          this->MaxSteps,
+                          device,
+                          token);
   }
   VTKM_CONT
   StateRecordingParticles(vtkm::cont::ArrayHandle<ParticleType>& pArray, const vtkm::Id& maxSteps)
+    : StateRecordingParticles(ParticleObjectType(pArray, maxSteps), maxSteps)
+  {
+  }
+
+  VTKM_CONT
+  StateRecordingParticles(const ParticleObjectType& particles, const vtkm::Id& maxSteps)
     : MaxSteps(maxSteps)
-    , ParticleArray(pArray)
+    , ParticleObject(particles)
   {
-    vtkm::Id numParticles = static_cast<vtkm::Id>(pArray.GetNumberOfValues());
+    vtkm::Id numParticles = particles.GetNumberOfParticles();
 
     //Create ValidPointArray initialized to zero.
     vtkm::cont::ArrayHandleConstant<vtkm::Id> tmp(0, (this->MaxSteps + 1) * numParticles);
@@ -250,8 +274,8 @@ public:
                           vtkm::cont::ArrayHandle<vtkm::Vec3f>& historyArray,
                           vtkm::cont::ArrayHandle<vtkm::Id>& validPointArray,
                           vtkm::Id& maxSteps)
+    : ParticleObject(pArray, maxSteps)
   {
-    ParticleArray = pArray;
     HistoryArray = historyArray;
     ValidPointArray = validPointArray;
     MaxSteps = maxSteps;
@@ -266,7 +290,7 @@ public:
 protected:
   vtkm::cont::ArrayHandle<vtkm::Vec3f> HistoryArray;
   vtkm::Id MaxSteps;
-  vtkm::cont::ArrayHandle<ParticleType> ParticleArray;
+  ParticleObjectType ParticleObject;
   vtkm::cont::ArrayHandle<vtkm::Id> StepCountArray;
   vtkm::cont::ArrayHandle<vtkm::Id> ValidPointArray;
 };
@@ -0,0 +1,311 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_particleadvection_ParticlesSOA_h
+#define vtk_m_worklet_particleadvection_ParticlesSOA_h
+
+#include <vtkm/Particle.h>
+#include <vtkm/Types.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleSOA.h>
+#include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/particleadvection/IntegratorStatus.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace particleadvection
+{
+
+namespace detail
+{
+
+class SplitParticles : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn particle,
+                                FieldOut pos,
+                                FieldOut id,
+                                FieldOut steps,
+                                FieldOut status,
+                                FieldOut time);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+  VTKM_EXEC void operator()(const vtkm::Particle& particle,
+                            vtkm::Vec3f& pos,
+                            vtkm::Id& id,
+                            vtkm::Id& numSteps,
+                            vtkm::ParticleStatus& status,
+                            vtkm::FloatDefault& time) const
+  {
+    pos = particle.Pos;
+    id = particle.ID;
+    numSteps = particle.NumSteps;
+    status = particle.Status;
+    time = particle.Time;
+  }
+};
+
+class MergeParticles : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature =
+    void(FieldIn pos, FieldIn id, FieldIn steps, FieldIn status, FieldIn time, FieldOut particle);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+  VTKM_EXEC void operator()(const vtkm::Vec3f& pos,
+                            const vtkm::Id& id,
+                            const vtkm::Id& numSteps,
+                            const vtkm::ParticleStatus& status,
+                            const vtkm::FloatDefault& time,
+                            vtkm::Particle& particle) const
+  {
+    particle = vtkm::Particle(pos, id, numSteps, status, time);
+  }
+};
+
+} // namespace detail
+
+/// \brief Particles stored as a structure of arrays.
+///
+/// Holds the same state as an `ArrayHandle` of `vtkm::Particle`, but each member is kept in its
+/// own array and the positions are stored one component per array (with `ArrayHandleSOA`).
+/// Advecting these particles only reads and writes the members a step touches: checking whether
+/// a particle can continue reads one byte of status instead of a whole `vtkm::Particle`, and
+/// consecutive particles have their coordinates next to each other in memory.
+///
+/// `ParticleAdvectionWorklet` and `StreamlineWorklet` advect these arrays in place.
+///
+class ParticleArraysSOA
+{
+public:
+  using PositionArrayType = vtkm::cont::ArrayHandleSOA<vtkm::Vec3f>;
+  using IdArrayType = vtkm::cont::ArrayHandle<vtkm::Id>;
+  using StatusArrayType = vtkm::cont::ArrayHandle<vtkm::ParticleStatus>;
+  using TimeArrayType = vtkm::cont::ArrayHandle<vtkm::FloatDefault>;
+
+  VTKM_CONT ParticleArraysSOA() = default;
+
+  /// Creates particles at the given positions with IDs 0 to n-1 at time 0.
+  ///
+  template <typename PointStorage>
+  VTKM_CONT explicit ParticleArraysSOA(
+    const vtkm::cont::ArrayHandle<vtkm::Vec3f, PointStorage>& positions)
+  {
+    vtkm::Id numParticles = positions.GetNumberOfValues();
+    vtkm::cont::ArrayCopy(positions, this->Positions);
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numParticles), this->IDs);
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(0), numParticles),
+                          this->NumSteps);
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::make_ArrayHandleConstant(vtkm::ParticleStatus(), numParticles), this->Status);
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::make_ArrayHandleConstant(vtkm::FloatDefault(0), numParticles), this->Times);
+  }
+
+  /// Copies the members of an array of `vtkm::Particle` into separate arrays.
+  ///
+  template <typename ParticleStorage>
+  VTKM_CONT explicit ParticleArraysSOA(
+    const vtkm::cont::ArrayHandle<vtkm::Particle, ParticleStorage>& particles)
+  {
+    vtkm::cont::Invoker invoke;
+    invoke(detail::SplitParticles{},
+           particles,
+           this->Positions,
+           this->IDs,
+           this->NumSteps,
+           this->Status,
+           this->Times);
+  }
+
+  /// Copies the particles back into an array of `vtkm::Particle`.
+  ///
+  VTKM_CONT void CopyTo(vtkm::cont::ArrayHandle<vtkm::Particle>& particles) const
+  {
+    vtkm::cont::Invoker invoke;
+    invoke(detail::MergeParticles{},
+           this->Positions,
+           this->IDs,
+           this->NumSteps,
+           this->Status,
+           this->Times,
+           particles);
+  }
+
+  VTKM_CONT vtkm::Id GetNumberOfValues() const { return this->Positions.GetNumberOfValues(); }
+
+  VTKM_CONT const PositionArrayType& GetPositions() const { return this->Positions; }
+  VTKM_CONT const IdArrayType& GetIDs() const { return this->IDs; }
+  VTKM_CONT const IdArrayType& GetNumSteps() const { return this->NumSteps; }
+  VTKM_CONT const StatusArrayType& GetStatus() const { return this->Status; }
+  VTKM_CONT const TimeArrayType& GetTimes() const { return this->Times; }
+
+private:
+  PositionArrayType Positions;
+  IdArrayType IDs;
+  IdArrayType NumSteps;
+  StatusArrayType Status;
+  TimeArrayType Times;
+};
+
+/// The execution side of `ParticlesSOA`. It has the same interface as
+/// `ParticleExecutionObject<vtkm::Particle>`, but each update only touches the arrays of the
+/// members it changes.
+///
+class ParticleSOAExecutionObject
+{
+public:
+  VTKM_EXEC_CONT
+  ParticleSOAExecutionObject()
+    : MaxSteps(0)
+  {
+  }
+
+  ParticleSOAExecutionObject(const vtkm::worklet::particleadvection::ParticleArraysSOA& particles,
+                             vtkm::Id maxSteps,
+                             vtkm::cont::DeviceAdapterId device,
+                             vtkm::cont::Token& token)
+    : MaxSteps(maxSteps)
+  {
+    // The arrays are shared handles, so preparing copies of them updates the caller's arrays.
+    auto positions = particles.GetPositions();
+    auto ids = particles.GetIDs();
+    auto numSteps = particles.GetNumSteps();
+    auto status = particles.GetStatus();
+    auto times = particles.GetTimes();
+    this->Positions = positions.PrepareForInPlace(device, token);
+    this->IDs = ids.PrepareForInput(device, token);
+    this->NumSteps = numSteps.PrepareForInPlace(device, token);
+    this->Status = status.PrepareForInPlace(device, token);
+    this->Times = times.PrepareForInPlace(device, token);
+  }
+
+  VTKM_EXEC
+  vtkm::Particle GetParticle(const vtkm::Id& idx)
+  {
+    return vtkm::Particle(this->Positions.Get(idx),
+                          this->IDs.Get(idx),
+                          this->NumSteps.Get(idx),
+                          this->Status.Get(idx),
+                          this->Times.Get(idx));
+  }
+
+  VTKM_EXEC
+  void PreStepUpdate(const vtkm::Id& vtkmNotUsed(idx)) {}
+
+  VTKM_EXEC
+  void StepUpdate(const vtkm::Id& idx, vtkm::FloatDefault time, const vtkm::Vec3f& pt)
+  {
+    this->Positions.Set(idx, pt);
+    this->Times.Set(idx, time);
+    this->NumSteps.Set(idx, this->NumSteps.Get(idx) + 1);
+  }
+
+  VTKM_EXEC
+  void StatusUpdate(const vtkm::Id& idx,
+                    const vtkm::worklet::particleadvection::IntegratorStatus& status,
+                    vtkm::Id maxSteps)
+  {
+    vtkm::ParticleStatus pStatus = this->Status.Get(idx);
+
+    if (this->NumSteps.Get(idx) == maxSteps)
+      pStatus.SetTerminate();
+
+    if (status.CheckFail())
+      pStatus.SetFail();
+    if (status.CheckSpatialBounds())
+      pStatus.SetSpatialBounds();
+    if (status.CheckTemporalBounds())
+      pStatus.SetTemporalBounds();
+    if (status.CheckInGhostCell())
+      pStatus.SetInGhostCell();
+    this->Status.Set(idx, pStatus);
+  }
+
+  VTKM_EXEC
+  bool CanContinue(const vtkm::Id& idx)
+  {
+    vtkm::ParticleStatus pStatus = this->Status.Get(idx);
+
+    return (pStatus.CheckOk() && !pStatus.CheckTerminate() && !pStatus.CheckSpatialBounds() &&
+            !pStatus.CheckTemporalBounds() && !pStatus.CheckInGhostCell());
+  }
+
+  VTKM_EXEC
+  void UpdateTookSteps(const vtkm::Id& idx, bool val)
+  {
+    vtkm::ParticleStatus pStatus = this->Status.Get(idx);
+    if (val)
+      pStatus.SetTookAnySteps();
+    else
+      pStatus.ClearTookAnySteps();
+    this->Status.Set(idx, pStatus);
+  }
+
+protected:
+  using PositionPortal = ParticleArraysSOA::PositionArrayType::WritePortalType;
+  using IdReadPortal = ParticleArraysSOA::IdArrayType::ReadPortalType;
+  using IdPortal = ParticleArraysSOA::IdArrayType::WritePortalType;
+  using StatusPortal = ParticleArraysSOA::StatusArrayType::WritePortalType;
+  using TimePortal = ParticleArraysSOA::TimeArrayType::WritePortalType;
+
+  PositionPortal Positions;
+  IdReadPortal IDs;
+  IdPortal NumSteps;
+  StatusPortal Status;
+  TimePortal Times;
+  vtkm::Id MaxSteps;
+};
+
+/// The counterpart of `Particles` for particles stored in a `ParticleArraysSOA`.
+///
+class ParticlesSOA : public vtkm::cont::ExecutionObjectBase
+{
+public:
+  using ExecObjectType = vtkm::worklet::particleadvection::ParticleSOAExecutionObject;
+
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
+  {
+    return ExecObjectType(this->ParticleArrays, this->MaxSteps, device, token);
+  }
+
+  VTKM_CONT
+  ParticlesSOA(const vtkm::worklet::particleadvection::ParticleArraysSOA& particles,
+               const vtkm::Id& maxSteps)
+    : ParticleArrays(particles)
+    , MaxSteps(maxSteps)
+  {
+  }
+
+  ParticlesSOA() {}
+
+  VTKM_CONT vtkm::Id GetNumberOfParticles() const
+  {
+    return this->ParticleArrays.GetNumberOfValues();
+  }
+
+protected:
+  vtkm::worklet::particleadvection::ParticleArraysSOA ParticleArrays;
+  vtkm::Id MaxSteps = 0;
+};
+
+} //namespace particleadvection
+} //namespace worklet
+} //namespace vtkm
+
+#endif // vtk_m_worklet_particleadvection_ParticlesSOA_h
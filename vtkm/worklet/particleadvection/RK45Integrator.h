@@ -0,0 +1,237 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//=============================================================================
+
+#ifndef vtk_m_worklet_particleadvection_RK45Integrator_h
+#define vtk_m_worklet_particleadvection_RK45Integrator_h
+
+#include <vtkm/Math.h>
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/worklet/particleadvection/IntegratorStatus.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace particleadvection
+{
+
+template <typename ExecEvaluatorType>
+class ExecRK45Integrator
+{
+public:
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
+  VTKM_EXEC_CONT
+  ExecRK45Integrator(const ExecEvaluatorType& evaluator,
+                     vtkm::FloatDefault tolerance,
+                     vtkm::FloatDefault minimumStepSize,
+                     vtkm::FloatDefault maximumStepSize)
+    : Evaluator(evaluator)
+    , Tolerance(tolerance)
+    , MinimumStepSize(minimumStepSize)
+    , MaximumStepSize(maximumStepSize)
+  {
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
+                                       vtkm::FloatDefault stepLength,
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
+  {
+    using T = vtkm::FloatDefault;
+
+    auto time = particle.Time;
+    auto inpos = particle.Pos;
+    T boundary = this->Evaluator.GetTemporalBoundary(static_cast<vtkm::Id>(1));
+    if ((time + stepLength + vtkm::Epsilon<T>() - boundary) > 0.0)
+      stepLength = boundary - time;
+
+    //Dormand-Prince 5(4). The step over stepLength is split into substeps. Each substep is
+    //taken with the 5th order solution, and the difference to the embedded 4th order solution
+    //estimates its error, which decides whether the substep is kept and how long the next one
+    //is. The last stage of a kept substep is the first stage of the next one.
+    const T c2 = T(1.0 / 5.0), c3 = T(3.0 / 10.0), c4 = T(4.0 / 5.0), c5 = T(8.0 / 9.0);
+    const T a21 = T(1.0 / 5.0);
+    const T a31 = T(3.0 / 40.0), a32 = T(9.0 / 40.0);
+    const T a41 = T(44.0 / 45.0), a42 = T(-56.0 / 15.0), a43 = T(32.0 / 9.0);
+    const T a51 = T(19372.0 / 6561.0), a52 = T(-25360.0 / 2187.0), a53 = T(64448.0 / 6561.0),
+            a54 = T(-212.0 / 729.0);
+    const T a61 = T(9017.0 / 3168.0), a62 = T(-355.0 / 33.0), a63 = T(46732.0 / 5247.0),
+            a64 = T(49.0 / 176.0), a65 = T(-5103.0 / 18656.0);
+    const T b1 = T(35.0 / 384.0), b3 = T(500.0 / 1113.0), b4 = T(125.0 / 192.0),
+            b5 = T(-2187.0 / 6784.0), b6 = T(11.0 / 84.0);
+    const T e1 = T(71.0 / 57600.0), e3 = T(-71.0 / 16695.0), e4 = T(71.0 / 1920.0),
+            e5 = T(-17253.0 / 339200.0), e6 = T(22.0 / 525.0), e7 = T(-1.0 / 40.0);
+
+    vtkm::VecVariable<vtkm::Vec3f, 2> k;
+    GridEvaluatorStatus evalStatus = this->Evaluator.Evaluate(inpos, time, k, lastCell);
+    if (evalStatus.CheckFail())
+      return IntegratorStatus(evalStatus);
+    vtkm::Vec3f v1 = particle.Velocity(k, stepLength);
+
+    const T length = vtkm::Abs(stepLength);
+    if (length <= T(0))
+    {
+      velocity = v1;
+      return IntegratorStatus(evalStatus);
+    }
+    const T direction = (stepLength < T(0)) ? T(-1) : T(1);
+    const T maxStep =
+      (this->MaximumStepSize > T(0)) ? vtkm::Min(this->MaximumStepSize, length) : length;
+    const T minStep = (this->MinimumStepSize > T(0)) ? vtkm::Min(this->MinimumStepSize, maxStep)
+                                                     : maxStep * T(0.001);
+
+    vtkm::Vec3f pos = inpos;
+    T t = time;
+    T integrated = 0;
+    T substep = maxStep;
+    while (integrated < length)
+    {
+      substep = vtkm::Min(substep, length - integrated);
+      const T h = direction * substep;
+
+      vtkm::Vec3f v2, v3, v4, v5, v6, v7;
+      evalStatus = this->Evaluator.Evaluate(pos + h * (a21 * v1), t + c2 * h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v2 = particle.Velocity(k, h);
+
+      evalStatus =
+        this->Evaluator.Evaluate(pos + h * (a31 * v1 + a32 * v2), t + c3 * h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v3 = particle.Velocity(k, h);
+
+      evalStatus = this->Evaluator.Evaluate(
+        pos + h * (a41 * v1 + a42 * v2 + a43 * v3), t + c4 * h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v4 = particle.Velocity(k, h);
+
+      evalStatus = this->Evaluator.Evaluate(
+        pos + h * (a51 * v1 + a52 * v2 + a53 * v3 + a54 * v4), t + c5 * h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v5 = particle.Velocity(k, h);
+
+      evalStatus = this->Evaluator.Evaluate(
+        pos + h * (a61 * v1 + a62 * v2 + a63 * v3 + a64 * v4 + a65 * v5), t + h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v6 = particle.Velocity(k, h);
+
+      vtkm::Vec3f next = pos + h * (b1 * v1 + b3 * v3 + b4 * v4 + b5 * v5 + b6 * v6);
+      evalStatus = this->Evaluator.Evaluate(next, t + h, k, lastCell);
+      if (evalStatus.CheckFail())
+        return IntegratorStatus(evalStatus);
+      v7 = particle.Velocity(k, h);
+
+      //The error may be at most Tolerance times the distance the substep moves.
+      T error = vtkm::Magnitude(h * (e1 * v1 + e3 * v3 + e4 * v4 + e5 * v5 + e6 * v6 + e7 * v7));
+      T allowed = this->Tolerance * vtkm::Magnitude(next - pos);
+      if (error <= allowed || substep <= minStep)
+      {
+        pos = next;
+        t += h;
+        integrated += substep;
+        v1 = v7;
+      }
+
+      T scale = T(5);
+      if (error > T(0))
+        scale = vtkm::Min(T(5), vtkm::Max(T(0.2), T(0.9) * vtkm::Pow(allowed / error, T(0.2))));
+      substep = vtkm::Min(maxStep, vtkm::Max(minStep, substep * scale));
+    }
+
+    velocity = (pos - inpos) / stepLength;
+    return IntegratorStatus(evalStatus);
+  }
+
+private:
+  ExecEvaluatorType Evaluator;
+  vtkm::FloatDefault Tolerance;
+  vtkm::FloatDefault MinimumStepSize;
+  vtkm::FloatDefault MaximumStepSize;
+};
+
+/// \brief Adaptive Runge-Kutta integrator (Dormand-Prince 5(4)).
+///
+/// Each step of the `Stepper` is integrated with as many substeps as the field needs: long
+/// substeps where the field is smooth and short ones where it changes quickly. A substep is
+/// kept if its estimated error is at most the tolerance times the distance it moves the
+/// particle. Otherwise it is retried with a shorter length.
+///
+/// A large step size with this integrator can so replace the small step size a fixed step
+/// integrator needs to be accurate in the regions with the highest gradients.
+///
+template <typename EvaluatorType>
+class RK45Integrator
+{
+private:
+  EvaluatorType Evaluator;
+  vtkm::FloatDefault Tolerance = static_cast<vtkm::FloatDefault>(1e-5);
+  vtkm::FloatDefault MinimumStepSize = 0;
+  vtkm::FloatDefault MaximumStepSize = 0;
+
+public:
+  VTKM_CONT
+  RK45Integrator() = default;
+
+  VTKM_CONT
+  RK45Integrator(const EvaluatorType& evaluator)
+    : Evaluator(evaluator)
+  {
+  }
+
+  VTKM_CONT
+  RK45Integrator(const EvaluatorType& evaluator,
+                 vtkm::FloatDefault tolerance,
+                 vtkm::FloatDefault minimumStepSize = 0,
+                 vtkm::FloatDefault maximumStepSize = 0)
+    : Evaluator(evaluator)
+    , Tolerance(tolerance)
+    , MinimumStepSize(minimumStepSize)
+    , MaximumStepSize(maximumStepSize)
+  {
+  }
+
+  /// The largest error allowed for a substep, relative to the distance it moves the particle.
+  /// The default is 1e-5.
+  VTKM_CONT void SetTolerance(vtkm::FloatDefault tolerance) { this->Tolerance = tolerance; }
+  VTKM_CONT vtkm::FloatDefault GetTolerance() const { return this->Tolerance; }
+
+  /// The shortest substep. Substeps this short are kept even if their error is too large. The
+  /// default of 0 uses a thousandth of the maximum step size.
+  VTKM_CONT void SetMinimumStepSize(vtkm::FloatDefault size) { this->MinimumStepSize = size; }
+  VTKM_CONT vtkm::FloatDefault GetMinimumStepSize() const { return this->MinimumStepSize; }
+
+  /// The longest substep. The default of 0 allows substeps as long as the step.
+  VTKM_CONT void SetMaximumStepSize(vtkm::FloatDefault size) { this->MaximumStepSize = size; }
+  VTKM_CONT vtkm::FloatDefault GetMaximumStepSize() const { return this->MaximumStepSize; }
+
+  VTKM_CONT auto PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                     vtkm::cont::Token& token) const
+    -> ExecRK45Integrator<decltype(this->Evaluator.PrepareForExecution(device, token))>
+  {
+    auto evaluator = this->Evaluator.PrepareForExecution(device, token);
+    using ExecEvaluatorType = decltype(evaluator);
+    return ExecRK45Integrator<ExecEvaluatorType>(
+      evaluator, this->Tolerance, this->MinimumStepSize, this->MaximumStepSize);
+  }
+};
+
+} //namespace particleadvection
+} //namespace worklet
+} //namespace vtkm
+
+#endif // vtk_m_worklet_particleadvection_RK45Integrator_h
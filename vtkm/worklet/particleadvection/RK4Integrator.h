@@ -24,6 +24,8 @@ template <typename ExecEvaluatorType>
 class ExecRK4Integrator
 {
 public:
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
   VTKM_EXEC_CONT
   ExecRK4Integrator(const ExecEvaluatorType& evaluator)
     : Evaluator(evaluator)
@@ -33,7 +35,8 @@ public:
   template <typename Particle>
   VTKM_EXEC IntegratorStatus CheckStep(Particle& particle,
                                        vtkm::FloatDefault stepLength,
-                                       vtkm::Vec3f& velocity) const
+                                       vtkm::Vec3f& velocity,
+                                       LastCell& lastCell) const
   {
     auto time = particle.Time;
     auto inpos = particle.Pos;
@@ -57,22 +60,22 @@ public:
 
     GridEvaluatorStatus evalStatus;
 
-    evalStatus = this->Evaluator.Evaluate(inpos, time, k1);
+    evalStatus = this->Evaluator.Evaluate(inpos, time, k1, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v1 = particle.Velocity(k1, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v1, var2, k2, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v2 = particle.Velocity(k2, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3);
+    evalStatus = this->Evaluator.Evaluate(inpos + var1 * v2, var2, k3, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v3 = particle.Velocity(k3, stepLength);
 
-    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4);
+    evalStatus = this->Evaluator.Evaluate(inpos + stepLength * v3, var3, k4, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
     v4 = particle.Velocity(k4, stepLength);
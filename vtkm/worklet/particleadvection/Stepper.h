@@ -43,6 +43,10 @@ private:
   vtkm::FloatDefault Tolerance;
 
 public:
+  /// The cell of the last evaluation of a particle. Keeping one per particle across steps
+  /// speeds up finding the cells of the following positions, which are usually nearby.
+  using LastCell = typename ExecEvaluatorType::LastCell;
+
   VTKM_EXEC_CONT
   StepperImpl(const ExecIntegratorType& integrator,
               const ExecEvaluatorType& evaluator,
@@ -59,9 +63,19 @@ public:
   VTKM_EXEC IntegratorStatus Step(Particle& particle,
                                   vtkm::FloatDefault& time,
                                   vtkm::Vec3f& outpos) const
+  {
+    LastCell lastCell;
+    return this->Step(particle, time, outpos, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus Step(Particle& particle,
+                                  vtkm::FloatDefault& time,
+                                  vtkm::Vec3f& outpos,
+                                  LastCell& lastCell) const
   {
     vtkm::Vec3f velocity(0, 0, 0);
-    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity);
+    auto status = this->Integrator.CheckStep(particle, this->DeltaT, velocity, lastCell);
     if (status.CheckOk())
     {
       outpos = particle.Pos + this->DeltaT * velocity;
@@ -77,6 +91,16 @@ public:
   VTKM_EXEC IntegratorStatus SmallStep(Particle particle,
                                        vtkm::FloatDefault& time,
                                        vtkm::Vec3f& outpos) const
+  {
+    LastCell lastCell;
+    return this->SmallStep(particle, time, outpos, lastCell);
+  }
+
+  template <typename Particle>
+  VTKM_EXEC IntegratorStatus SmallStep(Particle particle,
+                                       vtkm::FloatDefault& time,
+                                       vtkm::Vec3f& outpos,
+                                       LastCell& lastCell) const
   {
     //Stepping by this->DeltaT goes beyond the bounds of the dataset.
     //We need to take an Euler step that goes outside of the dataset.
@@ -91,7 +115,7 @@ public:
     vtkm::Vec3f currPos(particle.Pos);
     vtkm::Vec3f currVelocity(0, 0, 0);
     vtkm::VecVariable<vtkm::Vec3f, 2> currValue, tmp;
-    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.Time, currValue);
+    auto evalStatus = this->Evaluator.Evaluate(currPos, particle.Time, currValue, lastCell);
     if (evalStatus.CheckFail())
       return IntegratorStatus(evalStatus);
 
@@ -104,13 +128,14 @@ public:
       vtkm::FloatDefault currStep = stepRange[0] + (this->DeltaT / div);
 
       //See if we can step by currStep
-      IntegratorStatus status = this->Integrator.CheckStep(particle, currStep, currVelocity);
+      IntegratorStatus status =
+        this->Integrator.CheckStep(particle, currStep, currVelocity, lastCell);
 
       if (status.CheckOk()) //Integration step succedded.
       {
         //See if this point is in/out.
         auto newPos = particle.Pos + currStep * currVelocity;
-        evalStatus = this->Evaluator.Evaluate(newPos, particle.Time + currStep, tmp);
+        evalStatus = this->Evaluator.Evaluate(newPos, particle.Time + currStep, tmp, lastCell);
         if (evalStatus.CheckOk())
         {
           //Point still in. Update currPos and set range to {currStep, stepRange[1]}
@@ -131,7 +156,8 @@ public:
       }
     }
 
-    evalStatus = this->Evaluator.Evaluate(currPos, particle.Time + stepRange[0], currValue);
+    evalStatus =
+      this->Evaluator.Evaluate(currPos, particle.Time + stepRange[0], currValue, lastCell);
     // The eval at Time + stepRange[0] better be *inside*
     VTKM_ASSERT(evalStatus.CheckOk() && !evalStatus.CheckSpatialBounds());
     if (evalStatus.CheckFail() || evalStatus.CheckSpatialBounds())
@@ -142,7 +168,7 @@ public:
     time += stepRange[1];
 
     // Get the evaluation status for the point that is *just* outside of the data.
-    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue);
+    evalStatus = this->Evaluator.Evaluate(outpos, time, currValue, lastCell);
 
     // The eval should fail, and the point should be outside either spatially or temporally.
     VTKM_ASSERT(evalStatus.CheckFail() &&
@@ -178,6 +204,18 @@ public:
   {
   }
 
+  /// Uses an integrator that was configured beforehand, such as an `RK45Integrator` with its
+  /// tolerance and step size limits set.
+  VTKM_CONT
+  Stepper(const IntegratorType& integrator,
+          const EvaluatorType& evaluator,
+          const vtkm::FloatDefault deltaT)
+    : Integrator(integrator)
+    , Evaluator(evaluator)
+    , DeltaT(deltaT)
+  {
+  }
+
   VTKM_CONT
   void SetTolerance(vtkm::FloatDefault tolerance) { this->Tolerance = tolerance; }
 
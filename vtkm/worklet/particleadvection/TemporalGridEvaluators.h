@@ -30,6 +30,13 @@ private:
     vtkm::worklet::particleadvection::ExecutionGridEvaluator<FieldType>;
 
 public:
+  /// The cells found in each time slice by the last evaluation of a particle.
+  struct LastCell
+  {
+    typename ExecutionGridEvaluator::LastCell One;
+    typename ExecutionGridEvaluator::LastCell Two;
+  };
+
   VTKM_CONT
   ExecutionTemporalGridEvaluator() = default;
 
@@ -74,6 +81,16 @@ public:
   VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
                                          vtkm::FloatDefault time,
                                          vtkm::VecVariable<Point, 2>& out) const
+  {
+    LastCell lastCell;
+    return this->Evaluate(particle, time, out, lastCell);
+  }
+
+  template <typename Point>
+  VTKM_EXEC GridEvaluatorStatus Evaluate(const Point& particle,
+                                         vtkm::FloatDefault time,
+                                         vtkm::VecVariable<Point, 2>& out,
+                                         LastCell& lastCell) const
   {
     // Validate time is in bounds for the current two slices.
     GridEvaluatorStatus status;
@@ -86,10 +103,10 @@ public:
     }
 
     vtkm::VecVariable<Point, 2> e1, e2;
-    status = this->EvaluatorOne.Evaluate(particle, time, e1);
+    status = this->EvaluatorOne.Evaluate(particle, time, e1, lastCell.One);
     if (status.CheckFail())
       return status;
-    status = this->EvaluatorTwo.Evaluate(particle, time, e2);
+    status = this->EvaluatorTwo.Evaluate(particle, time, e2, lastCell.Two);
     if (status.CheckFail())
       return status;
 
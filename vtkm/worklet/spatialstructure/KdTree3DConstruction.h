@@ -15,7 +15,8 @@
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleCounting.h>
-#include <vtkm/cont/ArrayHandleReverse.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/DeviceAdapterAlgorithm.h>
 #include <vtkm/cont/arg/ControlSignatureTagBase.h>
 #include <vtkm/cont/serial/DeviceAdapterSerial.h>
@@ -25,6 +26,10 @@
 #include <vtkm/worklet/internal/DispatcherBase.h>
 #include <vtkm/worklet/internal/WorkletBase.h>
 
+#ifdef VTKM_CUDA
+#include <vtkm/cont/cuda/internal/ScopedCudaStackSize.h>
+#endif
+
 namespace vtkm
 {
 namespace worklet
@@ -35,498 +40,236 @@ namespace spatialstructure
 class KdTree3DConstruction
 {
 public:
-  ////////// General WORKLET for Kd-tree  //////
-  class ComputeFlag : public vtkm::worklet::WorkletMapField
+  /////////////Median selection construction /////////////////////
+  /// \brief Finds the node of a tree level that holds a position of the point order.
+  ///
+  /// Nodes are numbered from 0 at each level, the children of node \c i being \c 2i and
+  /// \c 2i+1. A node covering [\c start, \c end) keeps its first ceil(n/2) points in its left
+  /// child and the rest in its right child.
+  VTKM_EXEC_CONT static void FindNode(vtkm::Id index,
+                                      vtkm::Id nPoints,
+                                      vtkm::Int32 level,
+                                      vtkm::Id& start,
+                                      vtkm::Id& end)
   {
-  public:
-    using ControlSignature = void(FieldIn rank, FieldIn pointCountInSeg, FieldOut flag);
-    using ExecutionSignature = void(_1, _2, _3);
-
-    VTKM_CONT
-    ComputeFlag() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& rank, const T& pointCountInSeg, T& flag) const
+    start = 0;
+    end = nPoints;
+    for (vtkm::Int32 i = 0; i < level; ++i)
     {
-      if (static_cast<float>(rank) >= static_cast<float>(pointCountInSeg) / 2.0f)
-        flag = 1; //right subtree
-      else
-        flag = 0; //left subtree
-    }
-  };
-
-  class InverseArray : public vtkm::worklet::WorkletMapField
-  { //only for 0/1 array
-  public:
-    using ControlSignature = void(FieldIn in, FieldOut out);
-    using ExecutionSignature = void(_1, _2);
-
-    VTKM_CONT
-    InverseArray() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& in, T& out) const
-    {
-      if (in == 0)
-        out = 1;
+      vtkm::Id split = start + (end - start + 1) / 2;
+      if (index < split)
+      {
+        end = split;
+      }
       else
-        out = 0;
+      {
+        start = split;
+      }
     }
-  };
+  }
 
-  class SegmentedSplitTransform : public vtkm::worklet::WorkletMapField
+  /// \brief Finds the range of the points of node \c nodeId at a tree level.
+  VTKM_EXEC_CONT static void FindNodeRange(vtkm::Id nodeId,
+                                           vtkm::Id nPoints,
+                                           vtkm::Int32 level,
+                                           vtkm::Id& start,
+                                           vtkm::Id& end)
   {
-  public:
-    using ControlSignature =
-      void(FieldIn B, FieldIn D, FieldIn F, FieldIn G, FieldIn H, FieldOut I);
-    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
-
-    VTKM_CONT
-    SegmentedSplitTransform() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& B, const T& D, const T& F, const T& G, const T& H, T& I)
-      const
+    start = 0;
+    end = nPoints;
+    for (vtkm::Int32 i = level - 1; i >= 0; --i)
     {
-      if (B == 1)
+      vtkm::Id split = start + (end - start + 1) / 2;
+      if ((nodeId >> i) & 1)
       {
-        I = F + H + D;
+        start = split;
       }
       else
       {
-        I = F + G - 1;
+        end = split;
       }
     }
-  };
+  }
 
-  class ScatterArray : public vtkm::worklet::WorkletMapField
+  /// \brief Sort key that orders the points by node and then by the split axis of \c level.
+  class ComputeLevelSortKey : public vtkm::worklet::WorkletMapField
   {
   public:
-    using ControlSignature = void(FieldIn in, FieldIn index, WholeArrayOut out);
-    using ExecutionSignature = void(_1, _2, _3);
+    using ControlSignature = void(FieldIn pointId, WholeArrayIn coordi, FieldOut key);
+    using ExecutionSignature = void(WorkIndex, _1, _2, _3);
 
     VTKM_CONT
-    ScatterArray() {}
-
-    template <typename T, typename OutputArrayPortalType>
-    VTKM_EXEC void operator()(const T& in,
-                              const T& index,
-                              const OutputArrayPortalType& outputPortal) const
+    ComputeLevelSortKey(vtkm::Id nPoints, vtkm::Int32 level)
+      : NPoints(nPoints)
+      , Level(level)
     {
-      outputPortal.Set(index, in);
     }
-  };
-
-  class NewSegmentId : public vtkm::worklet::WorkletMapField
-  {
-  public:
-    using ControlSignature = void(FieldIn inSegmentId, FieldIn flag, FieldOut outSegmentId);
-    using ExecutionSignature = void(_1, _2, _3);
 
-    VTKM_CONT
-    NewSegmentId() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& oldSegId, const T& flag, T& newSegId) const
+    template <typename CoordiPortalType, typename CoordType>
+    VTKM_EXEC void operator()(vtkm::Id index,
+                              vtkm::Id pointId,
+                              const CoordiPortalType& coordiPortal,
+                              vtkm::Pair<vtkm::Id, CoordType>& key) const
     {
-      if (flag == 0)
-        newSegId = oldSegId * 2;
-      else
-        newSegId = oldSegId * 2 + 1;
+      vtkm::Id start, end;
+      FindNode(index, this->NPoints, this->Level, start, end);
+      key.first = start;
+      key.second = static_cast<CoordType>(coordiPortal.Get(pointId)[this->Level % 3]);
     }
-  };
-
-  class SaveSplitPointId : public vtkm::worklet::WorkletMapField
-  {
-  public:
-    using ControlSignature = void(FieldIn pointId,
-                                  FieldIn flag,
-                                  FieldIn oldSplitPointId,
-                                  FieldOut newSplitPointId);
-    using ExecutionSignature = void(_1, _2, _3, _4);
-
-    VTKM_CONT
-    SaveSplitPointId() {}
 
-    template <typename T>
-    VTKM_EXEC void operator()(const T& pointId,
-                              const T& flag,
-                              const T& oldSplitPointId,
-                              T& newSplitPointId) const
-    {
-      if (flag == 0) //do not change
-        newSplitPointId = oldSplitPointId;
-      else //split point id
-        newSplitPointId = pointId;
-    }
+  private:
+    vtkm::Id NPoints;
+    vtkm::Int32 Level;
   };
 
-  class FindSplitPointId : public vtkm::worklet::WorkletMapField
+  /// \brief Saves the split points of the nodes of \c level once their points are sorted.
+  class SaveLevelSplitId : public vtkm::worklet::WorkletMapField
   {
   public:
-    using ControlSignature = void(FieldIn pointId, FieldIn rank, FieldOut splitIdInsegment);
-    using ExecutionSignature = void(_1, _2, _3);
+    using ControlSignature = void(FieldIn pointId, WholeArrayInOut splitId);
+    using ExecutionSignature = void(WorkIndex, _1, _2);
 
     VTKM_CONT
-    FindSplitPointId() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& pointId, const T& rank, T& splitIdInsegment) const
+    SaveLevelSplitId(vtkm::Id nPoints, vtkm::Int32 level)
+      : NPoints(nPoints)
+      , Level(level)
     {
-      if (rank == 0) //do not change
-        splitIdInsegment = pointId;
-      else                     //split point id
-        splitIdInsegment = -1; //indicate this is not split point
     }
-  };
 
-  class ArrayAdd : public vtkm::worklet::WorkletMapField
-  {
-  public:
-    using ControlSignature = void(FieldIn inArray0, FieldIn inArray1, FieldOut outArray);
-    using ExecutionSignature = void(_1, _2, _3);
-
-    VTKM_CONT
-    ArrayAdd() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const T& in0, const T& in1, T& out) const
+    template <typename IdPortalType>
+    VTKM_EXEC void operator()(vtkm::Id index,
+                              vtkm::Id pointId,
+                              const IdPortalType& splitIdPortal) const
     {
-      out = in0 + in1;
+      vtkm::Id start, end;
+      FindNode(index, this->NPoints, this->Level, start, end);
+      if (end - start > 1 && index == start + (end - start + 1) / 2)
+      {
+        splitIdPortal.Set(index, pointId);
+      }
     }
+
+  private:
+    vtkm::Id NPoints;
+    vtkm::Int32 Level;
   };
 
-  class SeprateVec3AryHandle : public vtkm::worklet::WorkletMapField
+  /// \brief Builds the subtrees below the nodes of one level, one node per thread.
+  ///
+  /// The points of each node are partitioned around their median with quickselect, which
+  /// needs linear time per level instead of the sort of all points. The coordinates are given
+  /// in the order of the points and are reordered with them, so that the selection reads
+  /// memory in order.
+  class BuildSubtree : public vtkm::worklet::WorkletMapField
   {
   public:
-    using ControlSignature = void(FieldIn inVec3, FieldOut out0, FieldOut out1, FieldOut out2);
+    using ControlSignature = void(FieldIn nodeId,
+                                  WholeArrayInOut pointId,
+                                  WholeArrayInOut splitId,
+                                  WholeArrayInOut pointCoordi);
     using ExecutionSignature = void(_1, _2, _3, _4);
 
     VTKM_CONT
-    SeprateVec3AryHandle() {}
-
-    template <typename T>
-    VTKM_EXEC void operator()(const Vec<T, 3>& inVec3, T& out0, T& out1, T& out2) const
+    BuildSubtree(vtkm::Id nPoints, vtkm::Int32 level)
+      : NPoints(nPoints)
+      , Level(level)
     {
-      out0 = inVec3[0];
-      out1 = inVec3[1];
-      out2 = inVec3[2];
     }
-  };
-
-  ////////// General worklet WRAPPER for Kd-tree //////
-  template <typename T, class BinaryFunctor>
-  vtkm::cont::ArrayHandle<T> ReverseScanInclusiveByKey(vtkm::cont::ArrayHandle<T>& keyHandle,
-                                                       vtkm::cont::ArrayHandle<T>& dataHandle,
-                                                       BinaryFunctor binary_functor)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::cont::ArrayHandle<T> resultHandle;
-
-    auto reversedResultHandle = vtkm::cont::make_ArrayHandleReverse(resultHandle);
-
-    Algorithm::ScanInclusiveByKey(vtkm::cont::make_ArrayHandleReverse(keyHandle),
-                                  vtkm::cont::make_ArrayHandleReverse(dataHandle),
-                                  reversedResultHandle,
-                                  binary_functor);
 
-    return resultHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> Inverse01ArrayWrapper(vtkm::cont::ArrayHandle<T>& inputHandle)
-  {
-    vtkm::cont::ArrayHandle<T> InverseHandle;
-    InverseArray invWorklet;
-    vtkm::worklet::DispatcherMapField<InverseArray> inverseArrayDispatcher(invWorklet);
-    inverseArrayDispatcher.Invoke(inputHandle, InverseHandle);
-    return InverseHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> ScatterArrayWrapper(vtkm::cont::ArrayHandle<T>& inputHandle,
-                                                 vtkm::cont::ArrayHandle<T>& indexHandle)
-  {
-    vtkm::cont::ArrayHandle<T> outputHandle;
-    outputHandle.Allocate(inputHandle.GetNumberOfValues());
-    ScatterArray scatterWorklet;
-    vtkm::worklet::DispatcherMapField<ScatterArray> scatterArrayDispatcher(scatterWorklet);
-    scatterArrayDispatcher.Invoke(inputHandle, indexHandle, outputHandle);
-    return outputHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> NewKeyWrapper(vtkm::cont::ArrayHandle<T>& oldSegIdHandle,
-                                           vtkm::cont::ArrayHandle<T>& flagHandle)
-  {
-    vtkm::cont::ArrayHandle<T> newSegIdHandle;
-    NewSegmentId newsegidWorklet;
-    vtkm::worklet::DispatcherMapField<NewSegmentId> newSegIdDispatcher(newsegidWorklet);
-    newSegIdDispatcher.Invoke(oldSegIdHandle, flagHandle, newSegIdHandle);
-    return newSegIdHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> SaveSplitPointIdWrapper(vtkm::cont::ArrayHandle<T>& pointIdHandle,
-                                                     vtkm::cont::ArrayHandle<T>& flagHandle,
-                                                     vtkm::cont::ArrayHandle<T>& rankHandle,
-                                                     vtkm::cont::ArrayHandle<T>& oldSplitIdHandle)
-  {
-    vtkm::cont::ArrayHandle<T> splitIdInSegmentHandle;
-    FindSplitPointId findSplitPointIdWorklet;
-    vtkm::worklet::DispatcherMapField<FindSplitPointId> findSplitPointIdWorkletDispatcher(
-      findSplitPointIdWorklet);
-    findSplitPointIdWorkletDispatcher.Invoke(pointIdHandle, rankHandle, splitIdInSegmentHandle);
-
-    vtkm::cont::ArrayHandle<T> splitIdInSegmentByScanHandle =
-      ReverseScanInclusiveByKey(flagHandle, splitIdInSegmentHandle, vtkm::Maximum());
-
-    vtkm::cont::ArrayHandle<T> splitIdHandle;
-    SaveSplitPointId saveSplitPointIdWorklet;
-    vtkm::worklet::DispatcherMapField<SaveSplitPointId> saveSplitPointIdWorkletDispatcher(
-      saveSplitPointIdWorklet);
-    saveSplitPointIdWorkletDispatcher.Invoke(
-      splitIdInSegmentByScanHandle, flagHandle, oldSplitIdHandle, splitIdHandle);
-
-    return splitIdHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> ArrayAddWrapper(vtkm::cont::ArrayHandle<T>& array0Handle,
-                                             vtkm::cont::ArrayHandle<T>& array1Handle)
-  {
-    vtkm::cont::ArrayHandle<T> resultHandle;
-    ArrayAdd arrayAddWorklet;
-    vtkm::worklet::DispatcherMapField<ArrayAdd> arrayAddDispatcher(arrayAddWorklet);
-    arrayAddDispatcher.Invoke(array0Handle, array1Handle, resultHandle);
-    return resultHandle;
-  }
-
-  ///////////////////////////////////////////////////
-  ////////General Kd tree function //////////////////
-  ///////////////////////////////////////////////////
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> ComputeFlagProcedure(vtkm::cont::ArrayHandle<T>& rankHandle,
-                                                  vtkm::cont::ArrayHandle<T>& segIdHandle)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::cont::ArrayHandle<T> segCountAryHandle;
+    template <typename IdPortalType, typename CoordiPortalType>
+    VTKM_EXEC void operator()(vtkm::Id nodeId,
+                              const IdPortalType& pointIdPortal,
+                              const IdPortalType& splitIdPortal,
+                              const CoordiPortalType& coordiPortal) const
     {
-      vtkm::cont::ArrayHandle<T> tmpAryHandle;
-      vtkm::cont::ArrayHandleConstant<T> constHandle(1, rankHandle.GetNumberOfValues());
-      Algorithm::ScanInclusiveByKey(
-        segIdHandle, constHandle, tmpAryHandle, vtkm::Add()); //compute ttl segs in segment
-
-      segCountAryHandle = ReverseScanInclusiveByKey(segIdHandle, tmpAryHandle, vtkm::Maximum());
+      vtkm::Id start, end;
+      FindNodeRange(nodeId, this->NPoints, this->Level, start, end);
+      this->Build(start, end, this->Level, pointIdPortal, splitIdPortal, coordiPortal);
     }
 
-    vtkm::cont::ArrayHandle<T> flagHandle;
-    vtkm::worklet::DispatcherMapField<ComputeFlag> computeFlagDispatcher;
-    computeFlagDispatcher.Invoke(rankHandle, segCountAryHandle, flagHandle);
-
-    return flagHandle;
-  }
-
-  template <typename T>
-  vtkm::cont::ArrayHandle<T> SegmentedSplitProcedure(vtkm::cont::ArrayHandle<T>& A_Handle,
-                                                     vtkm::cont::ArrayHandle<T>& B_Handle,
-                                                     vtkm::cont::ArrayHandle<T>& C_Handle)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::cont::ArrayHandle<T> D_Handle;
-    T initValue = 0;
-    Algorithm::ScanExclusiveByKey(C_Handle, B_Handle, D_Handle, initValue, vtkm::Add());
-
-    vtkm::cont::ArrayHandleCounting<T> Ecouting_Handle(0, 1, A_Handle.GetNumberOfValues());
-    vtkm::cont::ArrayHandle<T> E_Handle;
-    Algorithm::Copy(Ecouting_Handle, E_Handle);
-
-    vtkm::cont::ArrayHandle<T> F_Handle;
-    Algorithm::ScanInclusiveByKey(C_Handle, E_Handle, F_Handle, vtkm::Minimum());
-
-    vtkm::cont::ArrayHandle<T> InvB_Handle = Inverse01ArrayWrapper(B_Handle);
-    vtkm::cont::ArrayHandle<T> G_Handle;
-    Algorithm::ScanInclusiveByKey(C_Handle, InvB_Handle, G_Handle, vtkm::Add());
-
-    vtkm::cont::ArrayHandle<T> H_Handle =
-      ReverseScanInclusiveByKey(C_Handle, G_Handle, vtkm::Maximum());
-
-    vtkm::cont::ArrayHandle<T> I_Handle;
-    SegmentedSplitTransform sstWorklet;
-    vtkm::worklet::DispatcherMapField<SegmentedSplitTransform> segmentedSplitTransformDispatcher(
-      sstWorklet);
-    segmentedSplitTransformDispatcher.Invoke(
-      B_Handle, D_Handle, F_Handle, G_Handle, H_Handle, I_Handle);
-
-    return ScatterArrayWrapper(A_Handle, I_Handle);
-  }
-
-  template <typename T>
-  void RenumberRanksProcedure(vtkm::cont::ArrayHandle<T>& A_Handle,
-                              vtkm::cont::ArrayHandle<T>& B_Handle,
-                              vtkm::cont::ArrayHandle<T>& C_Handle,
-                              vtkm::cont::ArrayHandle<T>& D_Handle)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::Id nPoints = A_Handle.GetNumberOfValues();
-
-    vtkm::cont::ArrayHandleCounting<T> Ecouting_Handle(0, 1, nPoints);
-    vtkm::cont::ArrayHandle<T> E_Handle;
-    Algorithm::Copy(Ecouting_Handle, E_Handle);
-
-    vtkm::cont::ArrayHandle<T> F_Handle;
-    Algorithm::ScanInclusiveByKey(D_Handle, E_Handle, F_Handle, vtkm::Minimum());
-
-    vtkm::cont::ArrayHandle<T> G_Handle;
-    G_Handle = ArrayAddWrapper(A_Handle, F_Handle);
-
-    vtkm::cont::ArrayHandleConstant<T> HConstant_Handle(1, nPoints);
-    vtkm::cont::ArrayHandle<T> H_Handle;
-    Algorithm::Copy(HConstant_Handle, H_Handle);
-
-    vtkm::cont::ArrayHandle<T> I_Handle;
-    T initValue = 0;
-    Algorithm::ScanExclusiveByKey(C_Handle, H_Handle, I_Handle, initValue, vtkm::Add());
-
-    vtkm::cont::ArrayHandle<T> J_Handle;
-    J_Handle = ScatterArrayWrapper(I_Handle, G_Handle);
-
-    vtkm::cont::ArrayHandle<T> K_Handle;
-    K_Handle = ScatterArrayWrapper(B_Handle, G_Handle);
-
-    vtkm::cont::ArrayHandle<T> L_Handle;
-    L_Handle = SegmentedSplitProcedure(J_Handle, K_Handle, D_Handle);
-
-    vtkm::cont::ArrayHandle<T> M_Handle;
-    Algorithm::ScanInclusiveByKey(C_Handle, E_Handle, M_Handle, vtkm::Minimum());
-
-    vtkm::cont::ArrayHandle<T> N_Handle;
-    N_Handle = ArrayAddWrapper(L_Handle, M_Handle);
-
-    A_Handle = ScatterArrayWrapper(I_Handle, N_Handle);
-  }
-
-  /////////////3D construction      /////////////////////
-  /// \brief Segmented split for 3D x, y, z coordinates
-  ///
-  /// Split \c pointId_Handle, \c X_Handle, \c Y_Handle and \c Z_Handle within each segment
-  /// as indicated by \c segId_Handle according to flags in \c flag_Handle.
-  ///
-  /// \tparam T
-  /// \param pointId_Handle
-  /// \param flag_Handle
-  /// \param segId_Handle
-  /// \param X_Handle
-  /// \param Y_Handle
-  /// \param Z_Handle
-  template <typename T>
-  void SegmentedSplitProcedure3D(vtkm::cont::ArrayHandle<T>& pointId_Handle,
-                                 vtkm::cont::ArrayHandle<T>& flag_Handle,
-                                 vtkm::cont::ArrayHandle<T>& segId_Handle,
-                                 vtkm::cont::ArrayHandle<T>& X_Handle,
-                                 vtkm::cont::ArrayHandle<T>& Y_Handle,
-                                 vtkm::cont::ArrayHandle<T>& Z_Handle)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::cont::ArrayHandle<T> D_Handle;
-    T initValue = 0;
-    Algorithm::ScanExclusiveByKey(segId_Handle, flag_Handle, D_Handle, initValue, vtkm::Add());
-
-    vtkm::cont::ArrayHandleCounting<T> Ecouting_Handle(0, 1, pointId_Handle.GetNumberOfValues());
-    vtkm::cont::ArrayHandle<T> E_Handle;
-    Algorithm::Copy(Ecouting_Handle, E_Handle);
-
-    vtkm::cont::ArrayHandle<T> F_Handle;
-    Algorithm::ScanInclusiveByKey(segId_Handle, E_Handle, F_Handle, vtkm::Minimum());
-
-    vtkm::cont::ArrayHandle<T> InvB_Handle = Inverse01ArrayWrapper(flag_Handle);
-    vtkm::cont::ArrayHandle<T> G_Handle;
-    Algorithm::ScanInclusiveByKey(segId_Handle, InvB_Handle, G_Handle, vtkm::Add());
-
-    vtkm::cont::ArrayHandle<T> H_Handle =
-      ReverseScanInclusiveByKey(segId_Handle, G_Handle, vtkm::Maximum());
-
-    vtkm::cont::ArrayHandle<T> I_Handle;
-    SegmentedSplitTransform sstWorklet;
-    vtkm::worklet::DispatcherMapField<SegmentedSplitTransform> segmentedSplitTransformDispatcher(
-      sstWorklet);
-    segmentedSplitTransformDispatcher.Invoke(
-      flag_Handle, D_Handle, F_Handle, G_Handle, H_Handle, I_Handle);
-
-    pointId_Handle = ScatterArrayWrapper(pointId_Handle, I_Handle);
-
-    flag_Handle = ScatterArrayWrapper(flag_Handle, I_Handle);
-
-    X_Handle = ScatterArrayWrapper(X_Handle, I_Handle);
-
-    Y_Handle = ScatterArrayWrapper(Y_Handle, I_Handle);
-
-    Z_Handle = ScatterArrayWrapper(Z_Handle, I_Handle);
-  }
-
-  /// \brief Perform one level of KD-Tree construction
-  ///
-  /// Construct a level of KD-Tree by segemeted splits (partitioning) of \c pointId_Handle,
-  /// \c xrank_Handle, \c yrank_Handle and \c zrank_Handle according to the medium element
-  /// in each segment as indicated by \c segId_Handle alone the axis determined by \c level.
-  /// The split point of each segment will be updated in \c splitId_Handle.
-  template <typename T>
-  void OneLevelSplit3D(vtkm::cont::ArrayHandle<T>& pointId_Handle,
-                       vtkm::cont::ArrayHandle<T>& xrank_Handle,
-                       vtkm::cont::ArrayHandle<T>& yrank_Handle,
-                       vtkm::cont::ArrayHandle<T>& zrank_Handle,
-                       vtkm::cont::ArrayHandle<T>& segId_Handle,
-                       vtkm::cont::ArrayHandle<T>& splitId_Handle,
-                       vtkm::Int32 level)
-  {
-    using Algorithm = vtkm::cont::Algorithm;
-
-    vtkm::cont::ArrayHandle<T> flag_Handle;
-    if (level % 3 == 0)
-    {
-      flag_Handle = ComputeFlagProcedure(xrank_Handle, segId_Handle);
-    }
-    else if (level % 3 == 1)
-    {
-      flag_Handle = ComputeFlagProcedure(yrank_Handle, segId_Handle);
-    }
-    else
+    template <typename IdPortalType, typename CoordiPortalType>
+    VTKM_EXEC void Build(vtkm::Id start,
+                         vtkm::Id end,
+                         vtkm::Int32 level,
+                         const IdPortalType& pointIdPortal,
+                         const IdPortalType& splitIdPortal,
+                         const CoordiPortalType& coordiPortal) const
     {
-      flag_Handle = ComputeFlagProcedure(zrank_Handle, segId_Handle);
+      if (end - start < 2)
+      {
+        return;
+      }
+      vtkm::Id split = start + (end - start + 1) / 2;
+      Select(start, end, split, level % 3, pointIdPortal, coordiPortal);
+      splitIdPortal.Set(split, pointIdPortal.Get(split));
+      this->Build(start, split, level + 1, pointIdPortal, splitIdPortal, coordiPortal);
+      this->Build(split, end, level + 1, pointIdPortal, splitIdPortal, coordiPortal);
     }
 
-    SegmentedSplitProcedure3D(
-      pointId_Handle, flag_Handle, segId_Handle, xrank_Handle, yrank_Handle, zrank_Handle);
-
-    vtkm::cont::ArrayHandle<T> segIdOld_Handle;
-    Algorithm::Copy(segId_Handle, segIdOld_Handle);
-    segId_Handle = NewKeyWrapper(segIdOld_Handle, flag_Handle);
-
-    RenumberRanksProcedure(xrank_Handle, flag_Handle, segId_Handle, segIdOld_Handle);
-    RenumberRanksProcedure(yrank_Handle, flag_Handle, segId_Handle, segIdOld_Handle);
-    RenumberRanksProcedure(zrank_Handle, flag_Handle, segId_Handle, segIdOld_Handle);
-
-    if (level % 3 == 0)
+    /// Reorders [\c start, \c end) so that the point at \c k has no larger coordinate along
+    /// \c axis in front of it and no smaller one behind it.
+    template <typename IdPortalType, typename CoordiPortalType>
+    VTKM_EXEC static void Select(vtkm::Id start,
+                                 vtkm::Id end,
+                                 vtkm::Id k,
+                                 vtkm::IdComponent axis,
+                                 const IdPortalType& pointIdPortal,
+                                 const CoordiPortalType& coordiPortal)
     {
-      splitId_Handle =
-        SaveSplitPointIdWrapper(pointId_Handle, flag_Handle, xrank_Handle, splitId_Handle);
-    }
-    else if (level % 3 == 1)
-    {
-      splitId_Handle =
-        SaveSplitPointIdWrapper(pointId_Handle, flag_Handle, yrank_Handle, splitId_Handle);
-    }
-    else
-    {
-      splitId_Handle =
-        SaveSplitPointIdWrapper(pointId_Handle, flag_Handle, zrank_Handle, splitId_Handle);
+      vtkm::Id low = start;
+      vtkm::Id high = end - 1;
+      while (low < high)
+      {
+        // Median of three pivot.
+        auto a = coordiPortal.Get(low)[axis];
+        auto b = coordiPortal.Get(low + (high - low) / 2)[axis];
+        auto c = coordiPortal.Get(high)[axis];
+        auto pivot = vtkm::Max(vtkm::Min(a, b), vtkm::Min(vtkm::Max(a, b), c));
+
+        vtkm::Id i = low;
+        vtkm::Id j = high;
+        while (i <= j)
+        {
+          while (coordiPortal.Get(i)[axis] < pivot)
+          {
+            ++i;
+          }
+          while (coordiPortal.Get(j)[axis] > pivot)
+          {
+            --j;
+          }
+          if (i <= j)
+          {
+            vtkm::Id tmpId = pointIdPortal.Get(i);
+            pointIdPortal.Set(i, pointIdPortal.Get(j));
+            pointIdPortal.Set(j, tmpId);
+            auto tmpCoordi = coordiPortal.Get(i);
+            coordiPortal.Set(i, coordiPortal.Get(j));
+            coordiPortal.Set(j, tmpCoordi);
+            ++i;
+            --j;
+          }
+        }
+        // Now [low, j] <= pivot, [i, high] >= pivot and everything in between equals pivot.
+        if (k <= j)
+        {
+          high = j;
+        }
+        else if (k >= i)
+        {
+          low = i;
+        }
+        else
+        {
+          break;
+        }
+      }
     }
-  }
+
+  private:
+    vtkm::Id NPoints;
+    vtkm::Int32 Level;
+  };
 
   /// \brief Construct KdTree from x y z coordinate vector.
   ///
@@ -536,6 +279,10 @@ public:
   /// the leaf nodes are returned in \c pointId_Handle and indices to internal nodes (splits)
   /// are returned in splitId_handle.
   ///
+  /// The top levels, which have too few nodes to keep a device busy, are split by sorting the
+  /// points of all nodes at once. Below them, each thread builds the subtree of one node by
+  /// median selection.
+  ///
   /// \param coordi_Handle (in) x, y, z coordinates of input points
   /// \param pointId_Handle (out) returns indices to leaf nodes of the KD-tree
   /// \param splitId_Handle (out) returns indices to internal nodes of the KD-tree
@@ -548,49 +295,48 @@ public:
     using Algorithm = vtkm::cont::Algorithm;
 
     vtkm::Id nTrainingPoints = coordi_Handle.GetNumberOfValues();
-    vtkm::cont::ArrayHandleCounting<vtkm::Id> counting_Handle(0, 1, nTrainingPoints);
-    Algorithm::Copy(counting_Handle, pointId_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> xorder_Handle;
-    Algorithm::Copy(counting_Handle, xorder_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> yorder_Handle;
-    Algorithm::Copy(counting_Handle, yorder_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> zorder_Handle;
-    Algorithm::Copy(counting_Handle, zorder_Handle);
-
-    splitId_Handle.Allocate(nTrainingPoints);
-
-    vtkm::cont::ArrayHandle<CoordType> xcoordi_Handle;
-    vtkm::cont::ArrayHandle<CoordType> ycoordi_Handle;
-    vtkm::cont::ArrayHandle<CoordType> zcoordi_Handle;
-
-    SeprateVec3AryHandle sepVec3Worklet;
-    vtkm::worklet::DispatcherMapField<SeprateVec3AryHandle> sepVec3Dispatcher(sepVec3Worklet);
-    sepVec3Dispatcher.Invoke(coordi_Handle, xcoordi_Handle, ycoordi_Handle, zcoordi_Handle);
-
-    Algorithm::SortByKey(xcoordi_Handle, xorder_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> xrank_Handle =
-      ScatterArrayWrapper(pointId_Handle, xorder_Handle);
-
-    Algorithm::SortByKey(ycoordi_Handle, yorder_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> yrank_Handle =
-      ScatterArrayWrapper(pointId_Handle, yorder_Handle);
-
-    Algorithm::SortByKey(zcoordi_Handle, zorder_Handle);
-    vtkm::cont::ArrayHandle<vtkm::Id> zrank_Handle =
-      ScatterArrayWrapper(pointId_Handle, zorder_Handle);
-
-    vtkm::cont::ArrayHandle<vtkm::Id> segId_Handle;
-    vtkm::cont::ArrayHandleConstant<vtkm::Id> constHandle(0, nTrainingPoints);
-    Algorithm::Copy(constHandle, segId_Handle);
-
-    ///// build kd tree /////
-    vtkm::Int32 maxLevel = static_cast<vtkm::Int32>(ceil(vtkm::Log2(nTrainingPoints) + 1));
-    for (vtkm::Int32 i = 0; i < maxLevel - 1; i++)
+    Algorithm::Copy(vtkm::cont::ArrayHandleIndex(nTrainingPoints), pointId_Handle);
+    Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(-1), nTrainingPoints),
+                    splitId_Handle);
+
+    vtkm::Int32 level = 0;
+    for (; (vtkm::Id(1) << level) < this->SubtreeNodesPerLevel &&
+         (nTrainingPoints >> level) > this->SubtreeMinimumPoints;
+         ++level)
     {
-      OneLevelSplit3D(
-        pointId_Handle, xrank_Handle, yrank_Handle, zrank_Handle, segId_Handle, splitId_Handle, i);
+      vtkm::cont::ArrayHandle<vtkm::Pair<vtkm::Id, CoordType>> key_Handle;
+      vtkm::worklet::DispatcherMapField<ComputeLevelSortKey> keyDispatcher(
+        ComputeLevelSortKey(nTrainingPoints, level));
+      keyDispatcher.Invoke(pointId_Handle, coordi_Handle, key_Handle);
+      Algorithm::SortByKey(key_Handle, pointId_Handle);
+
+      vtkm::worklet::DispatcherMapField<SaveLevelSplitId> splitDispatcher(
+        SaveLevelSplitId(nTrainingPoints, level));
+      splitDispatcher.Invoke(pointId_Handle, splitId_Handle);
     }
+
+    vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>> pointCoordi_Handle;
+    Algorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(pointId_Handle, coordi_Handle),
+                    pointCoordi_Handle);
+
+#ifdef VTKM_CUDA
+    vtkm::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+    (void)stack;
+#endif
+
+    vtkm::worklet::DispatcherMapField<BuildSubtree> subtreeDispatcher(
+      BuildSubtree(nTrainingPoints, level));
+    subtreeDispatcher.Invoke(vtkm::cont::ArrayHandleIndex(vtkm::Id(1) << level),
+                             pointId_Handle,
+                             splitId_Handle,
+                             pointCoordi_Handle);
   }
+
+private:
+  // Levels are split by sorting until a level has this many nodes, ...
+  vtkm::Id SubtreeNodesPerLevel = 64;
+  // ... or until its nodes are this small.
+  vtkm::Id SubtreeMinimumPoints = 4096;
 };
 }
 }
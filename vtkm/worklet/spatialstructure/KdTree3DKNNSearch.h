@@ -0,0 +1,233 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_KdTree3DKNNSearch_h
+#define vtk_m_worklet_KdTree3DKNNSearch_h
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#ifdef VTKM_CUDA
+#include <vtkm/cont/cuda/internal/ScopedCudaStackSize.h>
+#endif
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace spatialstructure
+{
+
+class KdTree3DKNNSearch
+{
+public:
+  /// \brief Finds the k nearest neighbors of each query point.
+  ///
+  /// The neighbors of query \c i are kept in entries [ik, (i+1)k) of the output arrays, sorted
+  /// from the nearest. While searching, the entries hold squared distances.
+  class KNearestNeighborSearch3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  WholeArrayInOut knnIdOut,
+                                  WholeArrayInOut knnDisOut);
+    using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5, _6);
+
+    VTKM_CONT
+    KNearestNeighborSearch3DWorklet(vtkm::IdComponent k)
+      : K(k)
+    {
+    }
+
+    template <typename KnnIdPortalT, typename KnnDisPortalT>
+    VTKM_EXEC void Insert(vtkm::Id first,
+                          vtkm::Id pointId,
+                          typename KnnDisPortalT::ValueType dis2,
+                          const KnnIdPortalT& knnIdPortal,
+                          const KnnDisPortalT& knnDisPortal) const
+    {
+      vtkm::Id index = first + this->K - 1;
+      if (!(dis2 < knnDisPortal.Get(index)))
+      {
+        return;
+      }
+      // Insertion sort, dropping the farthest neighbor.
+      while (index > first && knnDisPortal.Get(index - 1) > dis2)
+      {
+        knnIdPortal.Set(index, knnIdPortal.Get(index - 1));
+        knnDisPortal.Set(index, knnDisPortal.Get(index - 1));
+        --index;
+      }
+      knnIdPortal.Set(index, pointId);
+      knnDisPortal.Set(index, dis2);
+    }
+
+    template <typename CooriVecT,
+              typename IdPortalT,
+              typename CoordiPortalT,
+              typename KnnIdPortalT,
+              typename KnnDisPortalT>
+    VTKM_EXEC void KNearestNeighborSearch3D(const CooriVecT& qc,
+                                            vtkm::Id first,
+                                            vtkm::Int32 level,
+                                            vtkm::Id sIdx,
+                                            vtkm::Id tIdx,
+                                            const IdPortalT& treePortal,
+                                            const IdPortalT& splitIdPortal,
+                                            const CoordiPortalT& coordiPortal,
+                                            const KnnIdPortalT& knnIdPortal,
+                                            const KnnDisPortalT& knnDisPortal) const
+    {
+      using CooriT = typename KnnDisPortalT::ValueType;
+
+      if (tIdx - sIdx == 1)
+      { ///// leaf node
+        vtkm::Id leafNodeIdx = treePortal.Get(sIdx);
+        auto diff = coordiPortal.Get(leafNodeIdx) - qc;
+        CooriT dis2 = static_cast<CooriT>(vtkm::Dot(diff, diff));
+        this->Insert(first, leafNodeIdx, dis2, knnIdPortal, knnDisPortal);
+        return;
+      }
+
+      //normal Node
+      vtkm::Id splitNodeLoc = sIdx + (tIdx - sIdx + 1) / 2;
+      vtkm::IdComponent axis = level % 3;
+      CooriT splitAxis = coordiPortal.Get(splitIdPortal.Get(splitNodeLoc))[axis];
+      CooriT diff = static_cast<CooriT>(qc[axis]) - splitAxis;
+
+      vtkm::Id nearS = sIdx, nearT = splitNodeLoc, farS = splitNodeLoc, farT = tIdx;
+      if (diff > 0)
+      { //right tree first
+        nearS = splitNodeLoc;
+        nearT = tIdx;
+        farS = sIdx;
+        farT = splitNodeLoc;
+      }
+      this->KNearestNeighborSearch3D(qc,
+                                     first,
+                                     level + 1,
+                                     nearS,
+                                     nearT,
+                                     treePortal,
+                                     splitIdPortal,
+                                     coordiPortal,
+                                     knnIdPortal,
+                                     knnDisPortal);
+      // The farthest neighbor found so far bounds the search.
+      if (diff * diff <= knnDisPortal.Get(first + this->K - 1))
+      {
+        this->KNearestNeighborSearch3D(qc,
+                                       first,
+                                       level + 1,
+                                       farS,
+                                       farT,
+                                       treePortal,
+                                       splitIdPortal,
+                                       coordiPortal,
+                                       knnIdPortal,
+                                       knnDisPortal);
+      }
+    }
+
+    template <typename CoordiVecType,
+              typename IdPortalType,
+              typename CoordiPortalType,
+              typename KnnIdPortalType,
+              typename KnnDisPortalType>
+    VTKM_EXEC void operator()(vtkm::Id queryIndex,
+                              const CoordiVecType& qc,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              const KnnIdPortalType& knnIdPortal,
+                              const KnnDisPortalType& knnDisPortal) const
+    {
+      vtkm::Id first = queryIndex * this->K;
+      if (treeIdPortal.GetNumberOfValues() > 0)
+      {
+        this->KNearestNeighborSearch3D(qc,
+                                       first,
+                                       0,
+                                       0,
+                                       treeIdPortal.GetNumberOfValues(),
+                                       treeIdPortal,
+                                       treeSplitIdPortal,
+                                       treeCoordiPortal,
+                                       knnIdPortal,
+                                       knnDisPortal);
+      }
+      for (vtkm::Id i = first; i < first + this->K; ++i)
+      {
+        if (knnIdPortal.Get(i) >= 0)
+        {
+          knnDisPortal.Set(i, vtkm::Sqrt(knnDisPortal.Get(i)));
+        }
+      }
+    }
+
+  private:
+    vtkm::IdComponent K;
+  };
+
+  /// \brief Execute the k nearest neighbor search given kdtree and search points
+  ///
+  /// For each point in \c qc_Handle, finds the \c k nearest training data points in
+  /// \c coordi_Handle using the kdtree in \c pointId_Handle and \c splitId_Handle. The
+  /// neighbors of query point \c i are returned in entries [ik, (i+1)k) of \c knnId_Handle,
+  /// sorted from the nearest, and their distances in the same entries of \c knnDis_Handle.
+  /// When there are fewer than \c k training points, the remaining entries have id -1 and the
+  /// largest distance.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coordi_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Id>& pointId_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Id>& splitId_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& qc_Handle,
+           vtkm::IdComponent k,
+           vtkm::cont::ArrayHandle<vtkm::Id>& knnId_Handle,
+           vtkm::cont::ArrayHandle<CoordType>& knnDis_Handle)
+  {
+    if (k < 1)
+    {
+      throw vtkm::cont::ErrorBadValue("The number of neighbors must be at least 1.");
+    }
+
+    vtkm::Id nOutput = qc_Handle.GetNumberOfValues() * k;
+    vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(-1), nOutput),
+                                knnId_Handle);
+    vtkm::cont::Algorithm::Copy(
+      vtkm::cont::make_ArrayHandleConstant(std::numeric_limits<CoordType>::max(), nOutput),
+      knnDis_Handle);
+
+//set up stack size for cuda environment
+#ifdef VTKM_CUDA
+    vtkm::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+    (void)stack;
+#endif
+
+    vtkm::worklet::DispatcherMapField<KNearestNeighborSearch3DWorklet> knnDispatcher(
+      KNearestNeighborSearch3DWorklet{ k });
+    knnDispatcher.Invoke(
+      qc_Handle, pointId_Handle, splitId_Handle, coordi_Handle, knnId_Handle, knnDis_Handle);
+  }
+};
+}
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_KdTree3DKNNSearch_h
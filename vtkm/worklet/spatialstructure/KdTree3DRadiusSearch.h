@@ -0,0 +1,262 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_KdTree3DRadiusSearch_h
+#define vtk_m_worklet_KdTree3DRadiusSearch_h
+
+#include <vtkm/Math.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleView.h>
+
+#include <vtkm/worklet/DispatcherMapField.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#ifdef VTKM_CUDA
+#include <vtkm/cont/cuda/internal/ScopedCudaStackSize.h>
+#endif
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace spatialstructure
+{
+
+class KdTree3DRadiusSearch
+{
+public:
+  /// \brief Visits all the points of a kdtree within a radius of a query point.
+  template <typename CoordType>
+  struct RadiusSearch3D
+  {
+    CoordType Radius2;
+
+    template <typename CooriVecT,
+              typename IdPortalT,
+              typename CoordiPortalT,
+              typename VisitorT>
+    VTKM_EXEC void Search(const CooriVecT& qc,
+                          vtkm::Int32 level,
+                          vtkm::Id sIdx,
+                          vtkm::Id tIdx,
+                          const IdPortalT& treePortal,
+                          const IdPortalT& splitIdPortal,
+                          const CoordiPortalT& coordiPortal,
+                          VisitorT& visitor) const
+    {
+      if (tIdx - sIdx == 1)
+      { ///// leaf node
+        vtkm::Id leafNodeIdx = treePortal.Get(sIdx);
+        auto diff = coordiPortal.Get(leafNodeIdx) - qc;
+        CoordType dis2 = static_cast<CoordType>(vtkm::Dot(diff, diff));
+        if (dis2 <= this->Radius2)
+        {
+          visitor(leafNodeIdx, vtkm::Sqrt(dis2));
+        }
+        return;
+      }
+
+      //normal Node
+      vtkm::Id splitNodeLoc = sIdx + (tIdx - sIdx + 1) / 2;
+      vtkm::IdComponent axis = level % 3;
+      CoordType splitAxis = coordiPortal.Get(splitIdPortal.Get(splitNodeLoc))[axis];
+      CoordType diff = static_cast<CoordType>(qc[axis]) - splitAxis;
+
+      if (diff <= 0 || diff * diff <= this->Radius2)
+      {
+        this->Search(
+          qc, level + 1, sIdx, splitNodeLoc, treePortal, splitIdPortal, coordiPortal, visitor);
+      }
+      if (diff >= 0 || diff * diff <= this->Radius2)
+      {
+        this->Search(
+          qc, level + 1, splitNodeLoc, tIdx, treePortal, splitIdPortal, coordiPortal, visitor);
+      }
+    }
+  };
+
+  /// \brief Counts the points within the radius of each query point.
+  template <typename CoordType>
+  class CountNeighbors3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  FieldOut countOut);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+    VTKM_CONT
+    CountNeighbors3DWorklet(CoordType radius)
+      : Radius(radius)
+    {
+    }
+
+    struct Counter
+    {
+      vtkm::Id Count = 0;
+      VTKM_EXEC void operator()(vtkm::Id, CoordType) { ++this->Count; }
+    };
+
+    template <typename CoordiVecType, typename IdPortalType, typename CoordiPortalType>
+    VTKM_EXEC void operator()(const CoordiVecType& qc,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              vtkm::Id& count) const
+    {
+      Counter counter;
+      RadiusSearch3D<CoordType> search{ this->Radius * this->Radius };
+      search.Search(qc,
+                    0,
+                    0,
+                    treeIdPortal.GetNumberOfValues(),
+                    treeIdPortal,
+                    treeSplitIdPortal,
+                    treeCoordiPortal,
+                    counter);
+      count = counter.Count;
+    }
+
+  private:
+    CoordType Radius;
+  };
+
+  /// \brief Writes the points within the radius of each query point from its offset on.
+  template <typename CoordType>
+  class FindNeighbors3DWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn qcIn,
+                                  FieldIn offsetIn,
+                                  WholeArrayIn treeIdIn,
+                                  WholeArrayIn treeSplitIdIn,
+                                  WholeArrayIn treeCoordiIn,
+                                  WholeArrayOut neighborIdOut,
+                                  WholeArrayOut neighborDisOut);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7);
+
+    VTKM_CONT
+    FindNeighbors3DWorklet(CoordType radius)
+      : Radius(radius)
+    {
+    }
+
+    template <typename IdPortalType, typename DisPortalType>
+    struct Writer
+    {
+      vtkm::Id Index;
+      const IdPortalType& IdPortal;
+      const DisPortalType& DisPortal;
+
+      VTKM_EXEC void operator()(vtkm::Id pointId, CoordType dis)
+      {
+        this->IdPortal.Set(this->Index, pointId);
+        this->DisPortal.Set(this->Index, dis);
+        ++this->Index;
+      }
+    };
+
+    template <typename CoordiVecType,
+              typename IdPortalType,
+              typename CoordiPortalType,
+              typename OutIdPortalType,
+              typename OutDisPortalType>
+    VTKM_EXEC void operator()(const CoordiVecType& qc,
+                              vtkm::Id offset,
+                              const IdPortalType& treeIdPortal,
+                              const IdPortalType& treeSplitIdPortal,
+                              const CoordiPortalType& treeCoordiPortal,
+                              const OutIdPortalType& neighborIdPortal,
+                              const OutDisPortalType& neighborDisPortal) const
+    {
+      Writer<OutIdPortalType, OutDisPortalType> writer{ offset,
+                                                        neighborIdPortal,
+                                                        neighborDisPortal };
+      RadiusSearch3D<CoordType> search{ this->Radius * this->Radius };
+      search.Search(qc,
+                    0,
+                    0,
+                    treeIdPortal.GetNumberOfValues(),
+                    treeIdPortal,
+                    treeSplitIdPortal,
+                    treeCoordiPortal,
+                    writer);
+    }
+
+  private:
+    CoordType Radius;
+  };
+
+  /// \brief Execute the radius search given kdtree and search points
+  ///
+  /// For each point in \c qc_Handle, finds all the training data points in \c coordi_Handle
+  /// whose distance is at most \c radius, using the kdtree in \c pointId_Handle and
+  /// \c splitId_Handle. The search runs twice: once to count the neighbors of each query
+  /// point and once to write them. The neighbors of query point \c i are returned in entries
+  /// [offsets[i], offsets[i+1]) of \c neighborId_Handle, in no particular order, with their
+  /// distances in the same entries of \c neighborDis_Handle. \c offsets_Handle has one more
+  /// value than there are query points.
+  template <typename CoordType, typename CoordStorageTag1, typename CoordStorageTag2>
+  void Run(const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag1>& coordi_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Id>& pointId_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Id>& splitId_Handle,
+           const vtkm::cont::ArrayHandle<vtkm::Vec<CoordType, 3>, CoordStorageTag2>& qc_Handle,
+           CoordType radius,
+           vtkm::cont::ArrayHandle<vtkm::Id>& neighborId_Handle,
+           vtkm::cont::ArrayHandle<CoordType>& neighborDis_Handle,
+           vtkm::cont::ArrayHandle<vtkm::Id>& offsets_Handle)
+  {
+    vtkm::Id nQueries = qc_Handle.GetNumberOfValues();
+    if (pointId_Handle.GetNumberOfValues() == 0)
+    {
+      vtkm::cont::Algorithm::Copy(vtkm::cont::make_ArrayHandleConstant(vtkm::Id(0), nQueries + 1),
+                                  offsets_Handle);
+      neighborId_Handle.Allocate(0);
+      neighborDis_Handle.Allocate(0);
+      return;
+    }
+
+//set up stack size for cuda environment
+#ifdef VTKM_CUDA
+    vtkm::cont::cuda::internal::ScopedCudaStackSize stack(16 * 1024);
+    (void)stack;
+#endif
+
+    vtkm::cont::ArrayHandle<vtkm::Id> count_Handle;
+    vtkm::worklet::DispatcherMapField<CountNeighbors3DWorklet<CoordType>> countDispatcher(
+      CountNeighbors3DWorklet<CoordType>{ radius });
+    countDispatcher.Invoke(qc_Handle, pointId_Handle, splitId_Handle, coordi_Handle, count_Handle);
+
+    vtkm::cont::Algorithm::ScanExtended(count_Handle, offsets_Handle);
+    vtkm::Id nNeighbors = vtkm::cont::ArrayGetValue(nQueries, offsets_Handle);
+    neighborId_Handle.Allocate(nNeighbors);
+    neighborDis_Handle.Allocate(nNeighbors);
+
+    vtkm::worklet::DispatcherMapField<FindNeighbors3DWorklet<CoordType>> findDispatcher(
+      FindNeighbors3DWorklet<CoordType>{ radius });
+    findDispatcher.Invoke(qc_Handle,
+                          vtkm::cont::make_ArrayHandleView(offsets_Handle, 0, nQueries),
+                          pointId_Handle,
+                          splitId_Handle,
+                          coordi_Handle,
+                          neighborId_Handle,
+                          neighborDis_Handle);
+  }
+};
+}
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_KdTree3DRadiusSearch_h
@@ -55,6 +55,32 @@ struct BoundingIntervalHierarchyTester : public vtkm::worklet::WorkletMapField
   }
 }; // struct BoundingIntervalHierarchyTester
 
+// Finds the cell of each point after finding the cell of the previous point, so that the
+// search starts from the previous cell, then finds it again from its own cell.
+struct BoundingIntervalHierarchyHintTester : public vtkm::worklet::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, WholeArrayIn, ExecObject, FieldOut);
+  typedef _4 ExecutionSignature(_1, _2, _3);
+
+  template <typename PointsPortal, typename BoundingIntervalHierarchyExecObject>
+  VTKM_EXEC vtkm::IdComponent operator()(const vtkm::Id index,
+                                         const PointsPortal& points,
+                                         const BoundingIntervalHierarchyExecObject& bih) const
+  {
+    typename BoundingIntervalHierarchyExecObject::LastCell lastCell;
+    vtkm::Vec3f parametric;
+    vtkm::Id cellId = -1;
+    if (index > 0)
+    {
+      bih.FindCell(points.Get(index - 1), cellId, parametric, lastCell);
+    }
+    bih.FindCell(points.Get(index), cellId, parametric, lastCell);
+    vtkm::IdComponent numDiffs = static_cast<vtkm::IdComponent>(cellId != index);
+    bih.FindCell(points.Get(index), cellId, parametric, lastCell);
+    return numDiffs + static_cast<vtkm::IdComponent>(cellId != index);
+  }
+}; // struct BoundingIntervalHierarchyHintTester
+
 vtkm::cont::DataSet ConstructDataSet(vtkm::Id size)
 {
   return vtkm::cont::DataSetBuilderUniform().Create(vtkm::Id3(size, size, size));
@@ -85,6 +111,11 @@ void TestBoundingIntervalHierarchy(vtkm::cont::DataSet dataSet, vtkm::IdComponen
 
   vtkm::Id numDiffs = vtkm::cont::Algorithm::Reduce(results, 0, vtkm::Add());
   VTKM_TEST_ASSERT(numDiffs == 0, "Calculated cell Ids not the same as expected cell Ids");
+
+  vtkm::worklet::DispatcherMapField<BoundingIntervalHierarchyHintTester>().Invoke(
+    expectedCellIds, centroids, bih, results);
+  numDiffs = vtkm::cont::Algorithm::Reduce(results, 0, vtkm::Add());
+  VTKM_TEST_ASSERT(numDiffs == 0, "Cell Ids found from the last cell not the same as expected");
 }
 
 void RunTest()
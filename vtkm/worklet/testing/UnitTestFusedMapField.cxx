@@ -0,0 +1,158 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/worklet/FusedMapField.h>
+#include <vtkm/worklet/Magnitude.h>
+#include <vtkm/worklet/Normalize.h>
+#include <vtkm/worklet/PointElevation.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ErrorExecution.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 1000;
+
+struct Negate : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+  using ExecutionSignature = _2(_1);
+
+  template <typename T>
+  VTKM_EXEC T operator()(const T& value) const
+  {
+    return -value;
+  }
+};
+
+struct CheckPositive : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn, FieldOut);
+
+  template <typename T>
+  VTKM_EXEC void operator()(const T& in, T& out) const
+  {
+    if (in < 0)
+    {
+      this->RaiseError("Expected error.");
+    }
+    out = in;
+  }
+};
+
+vtkm::cont::ArrayHandle<vtkm::Vec3f> MakeInput()
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> input;
+  input.Allocate(ARRAY_SIZE);
+  auto portal = input.WritePortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    portal.Set(index, TestValue(index, vtkm::Vec3f{}));
+  }
+  return input;
+}
+
+void TestFusedChain()
+{
+  std::cout << "Test fused chain against separate invocations" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> input = MakeInput();
+
+  vtkm::worklet::PointElevation elevation;
+  elevation.SetLowPoint(vtkm::Vec3f_64(0.0, 0.0, 0.0));
+  elevation.SetHighPoint(vtkm::Vec3f_64(1.0, 1.0, 1.0));
+  elevation.SetRange(-1.0, 1.0);
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> normals;
+  vtkm::cont::ArrayHandle<vtkm::Float64> elevations;
+  vtkm::cont::ArrayHandle<vtkm::Float64> negated;
+  vtkm::cont::ArrayHandle<vtkm::Float32> expected;
+  invoke(vtkm::worklet::Normal{}, input, normals);
+  invoke(elevation, normals, elevations);
+  invoke(Negate{}, elevations, negated);
+  invoke(vtkm::worklet::Magnitude{}, negated, expected);
+
+  auto fused = vtkm::worklet::MakeFusedMapField(
+    vtkm::worklet::MakeFusedStage<vtkm::Vec3f>(vtkm::worklet::Normal{}),
+    elevation,
+    Negate{},
+    vtkm::worklet::Magnitude{});
+  vtkm::cont::ArrayHandle<vtkm::Float32> result;
+  invoke(fused, input, result);
+
+  VTKM_TEST_ASSERT(result.GetNumberOfValues() == ARRAY_SIZE);
+  auto resultPortal = result.ReadPortal();
+  auto expectedPortal = expected.ReadPortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(resultPortal.Get(index), expectedPortal.Get(index)),
+                     "Bad value at ",
+                     index);
+  }
+}
+
+void TestSingleStage()
+{
+  std::cout << "Test single stage" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> input = MakeInput();
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> result;
+  invoke(vtkm::worklet::MakeFusedMapField(Negate{}), input, result);
+
+  auto inputPortal = input.ReadPortal();
+  auto resultPortal = result.ReadPortal();
+  for (vtkm::Id index = 0; index < ARRAY_SIZE; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(resultPortal.Get(index), -inputPortal.Get(index)));
+  }
+}
+
+void TestStageError()
+{
+  std::cout << "Test error raised by a stage" << std::endl;
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> input = MakeInput();
+
+  auto fused = vtkm::worklet::MakeFusedMapField(
+    vtkm::worklet::MakeFusedStage<vtkm::FloatDefault>(vtkm::worklet::Magnitude{}),
+    Negate{},
+    CheckPositive{});
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> result;
+  bool threw = false;
+  try
+  {
+    invoke(fused, input, result);
+  }
+  catch (vtkm::cont::ErrorExecution& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Error in a fused stage was not reported.");
+}
+
+void DoTest()
+{
+  TestFusedChain();
+  TestSingleStage();
+  TestStageError();
+}
+
+} // anonymous namespace
+
+int UnitTestFusedMapField(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
@@ -8,7 +8,9 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <algorithm>
 #include <random>
+#include <vtkm/VectorAnalysis.h>
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/worklet/KdTree3D.h>
 
@@ -130,9 +132,159 @@ void TestKdTreeBuildNNS(vtkm::cont::DeviceAdapterId deviceId)
   VTKM_TEST_ASSERT(passTest, "Kd tree NN search result incorrect.");
 }
 
+// Points on a coarse lattice share coordinates along every axis, which gives ties at the splits.
+std::vector<vtkm::Vec3f_32> MakeTrainingPoints(vtkm::Id nPoints)
+{
+  std::default_random_engine dre;
+  std::uniform_real_distribution<vtkm::Float32> dr(0.0f, 10.0f);
+  std::uniform_int_distribution<vtkm::Int32> di(0, 10);
+
+  std::vector<vtkm::Vec3f_32> coordi;
+  for (vtkm::Id i = 0; i < nPoints; i++)
+  {
+    if (i % 4 == 0)
+    {
+      coordi.push_back(vtkm::make_Vec(vtkm::Float32(di(dre)), dr(dre), vtkm::Float32(di(dre))));
+    }
+    else
+    {
+      coordi.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+    }
+  }
+  return coordi;
+}
+
+std::vector<vtkm::Float32> SortedDistances(const vtkm::Vec3f_32& qc,
+                                           const std::vector<vtkm::Vec3f_32>& coordi)
+{
+  std::vector<vtkm::Float32> distances;
+  for (const auto& point : coordi)
+  {
+    distances.push_back(vtkm::Magnitude(point - qc));
+  }
+  std::sort(distances.begin(), distances.end());
+  return distances;
+}
+
+void TestKdTreeKNearest(vtkm::cont::DeviceAdapterId deviceId)
+{
+  // Enough points for the top levels of the tree to be split by sorting.
+  const vtkm::Id nTrainingPoints = 20000;
+  const vtkm::Id nTestingPoint = 100;
+  const vtkm::IdComponent k = 8;
+
+  std::vector<vtkm::Vec3f_32> coordi = MakeTrainingPoints(nTrainingPoints);
+  auto coordi_Handle = vtkm::cont::make_ArrayHandle(coordi, vtkm::CopyFlag::Off);
+  std::vector<vtkm::Vec3f_32> qcVec = MakeTrainingPoints(nTestingPoint);
+  auto qc_Handle = vtkm::cont::make_ArrayHandle(qcVec, vtkm::CopyFlag::Off);
+
+  vtkm::worklet::KdTree3D kdtree3d;
+  kdtree3d.Build(coordi_Handle);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> nnId_Handle;
+  vtkm::cont::ArrayHandle<vtkm::Float32> nnDis_Handle;
+  kdtree3d.Run(coordi_Handle, qc_Handle, nnId_Handle, nnDis_Handle, deviceId);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> knnId_Handle;
+  vtkm::cont::ArrayHandle<vtkm::Float32> knnDis_Handle;
+  kdtree3d.RunKNearest(coordi_Handle, qc_Handle, k, knnId_Handle, knnDis_Handle);
+  VTKM_TEST_ASSERT(knnId_Handle.GetNumberOfValues() == nTestingPoint * k);
+
+  auto nnDisPortal = nnDis_Handle.ReadPortal();
+  auto knnIdPortal = knnId_Handle.ReadPortal();
+  auto knnDisPortal = knnDis_Handle.ReadPortal();
+  for (vtkm::Id i = 0; i < nTestingPoint; i++)
+  {
+    const vtkm::Vec3f_32& qc = qcVec[static_cast<std::size_t>(i)];
+    std::vector<vtkm::Float32> expected = SortedDistances(qc, coordi);
+    VTKM_TEST_ASSERT(test_equal(nnDisPortal.Get(i), expected[0]), "Wrong nearest neighbor.");
+    for (vtkm::IdComponent j = 0; j < k; j++)
+    {
+      vtkm::Id neighbor = knnIdPortal.Get(i * k + j);
+      vtkm::Float32 dis = knnDisPortal.Get(i * k + j);
+      VTKM_TEST_ASSERT(test_equal(dis, expected[static_cast<std::size_t>(j)]),
+                       "Wrong k nearest neighbor distance.");
+      const vtkm::Vec3f_32& point = coordi[static_cast<std::size_t>(neighbor)];
+      VTKM_TEST_ASSERT(test_equal(dis, vtkm::Magnitude(point - qc)),
+                       "Distance does not match neighbor.");
+    }
+  }
+
+  // Fewer points than neighbors asked for.
+  auto few_Handle = vtkm::cont::make_ArrayHandle(coordi.data(), 3, vtkm::CopyFlag::Off);
+  vtkm::worklet::KdTree3D fewTree;
+  fewTree.Build(few_Handle);
+  fewTree.RunKNearest(few_Handle, qc_Handle, 5, knnId_Handle, knnDis_Handle);
+  knnIdPortal = knnId_Handle.ReadPortal();
+  for (vtkm::Id i = 0; i < nTestingPoint; i++)
+  {
+    for (vtkm::IdComponent j = 0; j < 5; j++)
+    {
+      VTKM_TEST_ASSERT((knnIdPortal.Get(i * 5 + j) < 0) == (j >= 3), "Wrong padding.");
+    }
+  }
+}
+
+void TestKdTreeRadius()
+{
+  const vtkm::Id nTrainingPoints = 20000;
+  const vtkm::Id nTestingPoint = 100;
+  const vtkm::Float32 radius = 1.0f;
+
+  std::vector<vtkm::Vec3f_32> coordi = MakeTrainingPoints(nTrainingPoints);
+  auto coordi_Handle = vtkm::cont::make_ArrayHandle(coordi, vtkm::CopyFlag::Off);
+  std::vector<vtkm::Vec3f_32> qcVec = MakeTrainingPoints(nTestingPoint);
+  auto qc_Handle = vtkm::cont::make_ArrayHandle(qcVec, vtkm::CopyFlag::Off);
+
+  vtkm::worklet::KdTree3D kdtree3d;
+  kdtree3d.Build(coordi_Handle);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborId_Handle;
+  vtkm::cont::ArrayHandle<vtkm::Float32> neighborDis_Handle;
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets_Handle;
+  kdtree3d.RunRadius(
+    coordi_Handle, qc_Handle, radius, neighborId_Handle, neighborDis_Handle, offsets_Handle);
+  VTKM_TEST_ASSERT(offsets_Handle.GetNumberOfValues() == nTestingPoint + 1);
+
+  auto idPortal = neighborId_Handle.ReadPortal();
+  auto disPortal = neighborDis_Handle.ReadPortal();
+  auto offsetsPortal = offsets_Handle.ReadPortal();
+  for (vtkm::Id i = 0; i < nTestingPoint; i++)
+  {
+    const vtkm::Vec3f_32& qc = qcVec[static_cast<std::size_t>(i)];
+    std::vector<vtkm::Id> expected;
+    for (vtkm::Id j = 0; j < nTrainingPoints; j++)
+    {
+      if (vtkm::MagnitudeSquared(coordi[static_cast<std::size_t>(j)] - qc) <= radius * radius)
+      {
+        expected.push_back(j);
+      }
+    }
+
+    std::vector<vtkm::Id> found;
+    for (vtkm::Id j = offsetsPortal.Get(i); j < offsetsPortal.Get(i + 1); j++)
+    {
+      found.push_back(idPortal.Get(j));
+      VTKM_TEST_ASSERT(
+        test_equal(disPortal.Get(j),
+                   vtkm::Magnitude(coordi[static_cast<std::size_t>(idPortal.Get(j))] - qc)),
+        "Distance does not match neighbor.");
+    }
+    std::sort(found.begin(), found.end());
+    VTKM_TEST_ASSERT(found == expected, "Wrong neighbors within radius.");
+  }
+}
+
+void TestKdTree(vtkm::cont::DeviceAdapterId deviceId)
+{
+  TestKdTreeBuildNNS(deviceId);
+  TestKdTreeKNearest(deviceId);
+  TestKdTreeRadius();
+}
+
 } // anonymous namespace
 
 int UnitTestKdTreeBuildNNS(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::RunOnDevice(TestKdTreeBuildNNS, argc, argv);
+  return vtkm::cont::testing::Testing::RunOnDevice(TestKdTree, argc, argv);
 }
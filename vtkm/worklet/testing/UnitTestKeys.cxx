@@ -81,6 +81,24 @@ void TryKeyType(KeyType)
                  keys.GetSortedValuesMap().ReadPortal(),
                  keys.GetOffsets().ReadPortal(),
                  keys.GetCounts().ReadPortal());
+
+  std::cout << "  Hash grouping" << std::endl;
+  vtkm::worklet::Keys<KeyType> hashKeys;
+  hashKeys.BuildArrays(keyArray, vtkm::worklet::KeysSortType::Hash);
+  VTKM_TEST_ASSERT(hashKeys.GetInputRange() == NUM_UNIQUE, "Keys has bad input range.");
+
+  CheckKeyReduce(keyArray.ReadPortal(),
+                 hashKeys.GetUniqueKeys().ReadPortal(),
+                 hashKeys.GetSortedValuesMap().ReadPortal(),
+                 hashKeys.GetOffsets().ReadPortal(),
+                 hashKeys.GetCounts().ReadPortal());
+
+  // Groups are ordered by the first appearance of each key.
+  auto uniquePortal = hashKeys.GetUniqueKeys().ReadPortal();
+  for (vtkm::Id index = 0; index < NUM_UNIQUE; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(uniquePortal.Get(index), keyBuffer[index]), "Bad hash key order.");
+  }
 }
 
 void TestKeys()
@@ -20,6 +20,8 @@
 #include <vtkm/worklet/particleadvection/Field.h>
 #include <vtkm/worklet/particleadvection/GridEvaluators.h>
 #include <vtkm/worklet/particleadvection/Particles.h>
+#include <vtkm/worklet/particleadvection/ParticlesSOA.h>
+#include <vtkm/worklet/particleadvection/RK45Integrator.h>
 #include <vtkm/worklet/particleadvection/RK4Integrator.h>
 #include <vtkm/worklet/particleadvection/Stepper.h>
 #include <vtkm/worklet/testing/GenerateTestDataSets.h>
@@ -509,6 +511,89 @@ void TestIntegrators()
       res = pa.Run(euler, seeds, maxSteps);
       ValidateParticleAdvectionResult(res, nSeeds, maxSteps);
     }
+    {
+      auto seeds = vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On);
+      using IntegratorType = vtkm::worklet::particleadvection::RK45Integrator<GridEvalType>;
+      using Stepper = vtkm::worklet::particleadvection::Stepper<IntegratorType, GridEvalType>;
+      Stepper rk45(eval, stepSize);
+      res = pa.Run(rk45, seeds, maxSteps);
+      ValidateParticleAdvectionResult(res, nSeeds, maxSteps);
+    }
+  }
+}
+
+// Advects particles around circles in a rotating field, where the exact positions are known.
+template <typename IntegratorType, typename GridEvalType>
+vtkm::FloatDefault AdvectInRotatingField(const IntegratorType& integrator,
+                                         const GridEvalType& eval,
+                                         vtkm::FloatDefault stepSize,
+                                         vtkm::Id numSteps)
+{
+  using Stepper = vtkm::worklet::particleadvection::Stepper<IntegratorType, GridEvalType>;
+  Stepper stepper(integrator, eval, stepSize);
+
+  std::vector<vtkm::Particle> points;
+  for (vtkm::Id i = 0; i < 8; i++)
+  {
+    vtkm::FloatDefault angle =
+      static_cast<vtkm::FloatDefault>(i) * vtkm::Pi_4<vtkm::FloatDefault>();
+    points.push_back(vtkm::Particle(vtkm::Vec3f(vtkm::Cos(angle), vtkm::Sin(angle), 0), i));
+  }
+
+  vtkm::worklet::ParticleAdvection pa;
+  auto seeds = vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On);
+  auto res = pa.Run(stepper, seeds, numSteps);
+
+  vtkm::FloatDefault maxError = 0;
+  auto portal = res.Particles.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); i++)
+  {
+    auto p = portal.Get(i);
+    VTKM_TEST_ASSERT(p.NumSteps == numSteps, "Particle did not take all steps");
+    vtkm::Vec3f start = points[static_cast<std::size_t>(i)].Pos;
+    vtkm::Vec3f exact(start[0] * vtkm::Cos(p.Time) - start[1] * vtkm::Sin(p.Time),
+                      start[0] * vtkm::Sin(p.Time) + start[1] * vtkm::Cos(p.Time),
+                      0);
+    maxError = vtkm::Max(maxError, vtkm::Magnitude(p.Pos - exact));
+  }
+  return maxError;
+}
+
+void TestAdaptiveIntegrator()
+{
+  using FieldHandle = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
+  using FieldType = vtkm::worklet::particleadvection::VelocityField<FieldHandle>;
+  using GridEvalType = vtkm::worklet::particleadvection::GridEvaluator<FieldType>;
+  using RK4Type = vtkm::worklet::particleadvection::RK4Integrator<GridEvalType>;
+  using RK45Type = vtkm::worklet::particleadvection::RK45Integrator<GridEvalType>;
+
+  //The field (-y, x, 0) is linear, so it is interpolated exactly.
+  const vtkm::Id3 dims(9, 9, 3);
+  const vtkm::Bounds bounds(-2, 2, -2, 2, -1, 1);
+  auto dataSets = vtkm::worklet::testing::CreateAllDataSets(bounds, dims, false);
+  for (auto& ds : dataSets)
+  {
+    auto coords = ds.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+    std::vector<vtkm::Vec3f> fieldData;
+    for (vtkm::Id i = 0; i < coords.GetNumberOfValues(); i++)
+      fieldData.push_back(vtkm::Vec3f(-coords.Get(i)[1], coords.Get(i)[0], 0));
+    FieldType velocities(vtkm::cont::make_ArrayHandle(fieldData, vtkm::CopyFlag::On));
+    GridEvalType eval(ds, velocities);
+
+    //Ten steps of half a radian.
+    const vtkm::FloatDefault stepSize = 0.5f;
+    const vtkm::Id numSteps = 10;
+    vtkm::FloatDefault rk4Error = AdvectInRotatingField(RK4Type(eval), eval, stepSize, numSteps);
+    vtkm::FloatDefault rk45Error =
+      AdvectInRotatingField(RK45Type(eval, 1e-6f), eval, stepSize, numSteps);
+    std::cout << "Rotating field error RK4: " << rk4Error << " RK45: " << rk45Error << std::endl;
+    VTKM_TEST_ASSERT(rk45Error < 1e-4f, "Adaptive integrator is not accurate enough");
+    VTKM_TEST_ASSERT(rk45Error < rk4Error, "Adaptive integrator less accurate than RK4");
+
+    //Substeps limited to the full step are still accurate as they are refined.
+    vtkm::FloatDefault limitedError =
+      AdvectInRotatingField(RK45Type(eval, 1e-6f, 0, 0.1f), eval, stepSize, numSteps);
+    VTKM_TEST_ASSERT(limitedError < 1e-4f, "Adaptive integrator with maximum step failed");
   }
 }
 
@@ -779,6 +864,109 @@ void TestWorkletsBasic()
   }
 }
 
+void TestParticleWorkletsSOA()
+{
+  using FieldHandle = vtkm::cont::ArrayHandle<vtkm::Vec3f>;
+  using FieldType = vtkm::worklet::particleadvection::VelocityField<FieldHandle>;
+  using GridEvalType = vtkm::worklet::particleadvection::GridEvaluator<FieldType>;
+  using RK4Type = vtkm::worklet::particleadvection::RK4Integrator<GridEvalType>;
+  using Stepper = vtkm::worklet::particleadvection::Stepper<RK4Type, GridEvalType>;
+
+  vtkm::Bounds bounds(0, 1, 0, 1, 0, 1);
+  const vtkm::Id3 dims(5, 5, 5);
+  vtkm::Id nElements = dims[0] * dims[1] * dims[2];
+
+  FieldHandle fieldArray;
+  CreateConstantVectorField(nElements, vtkm::Vec3f(1, 0, 0), fieldArray);
+  FieldType velocities(fieldArray);
+
+  // Some particles leave the domain before the last step and one starts outside of it.
+  std::vector<vtkm::Particle> pts;
+  GenerateRandomParticles(pts, 16, bounds);
+  pts.push_back(vtkm::Particle(vtkm::Vec3f(-1, -1, -1), static_cast<vtkm::Id>(pts.size())));
+
+  auto checkParticles = [](const vtkm::cont::ArrayHandle<vtkm::Particle>& expected,
+                           const vtkm::worklet::particleadvection::ParticleArraysSOA& soa) {
+    vtkm::cont::ArrayHandle<vtkm::Particle> result;
+    soa.CopyTo(result);
+    VTKM_TEST_ASSERT(result.GetNumberOfValues() == expected.GetNumberOfValues(),
+                     "Wrong number of SOA particles");
+    auto expectedPortal = expected.ReadPortal();
+    auto resultPortal = result.ReadPortal();
+    for (vtkm::Id i = 0; i < result.GetNumberOfValues(); i++)
+    {
+      vtkm::Particle e = expectedPortal.Get(i);
+      vtkm::Particle r = resultPortal.Get(i);
+      VTKM_TEST_ASSERT(test_equal(r.Pos, e.Pos), "SOA particle position is wrong");
+      VTKM_TEST_ASSERT(r.ID == e.ID, "SOA particle ID is wrong");
+      VTKM_TEST_ASSERT(r.NumSteps == e.NumSteps, "SOA particle NumSteps is wrong");
+      VTKM_TEST_ASSERT(test_equal(r.Time, e.Time), "SOA particle Time is wrong");
+      VTKM_TEST_ASSERT(r.Status.CheckOk() == e.Status.CheckOk() &&
+                         r.Status.CheckTerminate() == e.Status.CheckTerminate() &&
+                         r.Status.CheckSpatialBounds() == e.Status.CheckSpatialBounds() &&
+                         r.Status.CheckTookAnySteps() == e.Status.CheckTookAnySteps(),
+                       "SOA particle Status is wrong");
+    }
+  };
+
+  auto dataSets = vtkm::worklet::testing::CreateAllDataSets(bounds, dims, false);
+  for (auto& ds : dataSets)
+  {
+    GridEvalType eval(ds, velocities);
+    Stepper rk4(eval, 0.01f);
+    vtkm::Id maxSteps = 50;
+
+    {
+      auto aos = vtkm::cont::make_ArrayHandle(pts, vtkm::CopyFlag::On);
+      vtkm::worklet::particleadvection::ParticleArraysSOA soa(aos);
+      VTKM_TEST_ASSERT(soa.GetNumberOfValues() == aos.GetNumberOfValues());
+
+      vtkm::worklet::particleadvection::ParticleAdvectionWorklet<Stepper, vtkm::Particle> worklet;
+      worklet.Run(rk4, aos, maxSteps);
+      worklet.Run(rk4, soa, maxSteps);
+      checkParticles(aos, soa);
+    }
+
+    {
+      auto aos = vtkm::cont::make_ArrayHandle(pts, vtkm::CopyFlag::On);
+      vtkm::worklet::particleadvection::ParticleArraysSOA soa(aos);
+
+      vtkm::worklet::particleadvection::StreamlineWorklet<Stepper, vtkm::Particle> worklet;
+      vtkm::cont::ArrayHandle<vtkm::Vec3f> aosPositions, soaPositions;
+      vtkm::cont::CellSetExplicit<> aosLines, soaLines;
+      worklet.Run(rk4, aos, maxSteps, aosPositions, aosLines);
+      worklet.Run(rk4, soa, maxSteps, soaPositions, soaLines);
+      checkParticles(aos, soa);
+
+      VTKM_TEST_ASSERT(test_equal_portals(aosPositions.ReadPortal(), soaPositions.ReadPortal()),
+                       "SOA streamline points are wrong");
+      VTKM_TEST_ASSERT(soaLines.GetNumberOfCells() == aosLines.GetNumberOfCells(),
+                       "Wrong number of SOA streamlines");
+      for (vtkm::Id i = 0; i < soaLines.GetNumberOfCells(); i++)
+      {
+        VTKM_TEST_ASSERT(soaLines.GetNumberOfPointsInCell(i) ==
+                           aosLines.GetNumberOfPointsInCell(i),
+                         "Wrong number of points in SOA streamline");
+      }
+    }
+  }
+
+  // Particles created from positions.
+  std::vector<vtkm::Vec3f> points = { vtkm::Vec3f(.5f, .5f, .5f), vtkm::Vec3f(.2f, .3f, .4f) };
+  vtkm::worklet::particleadvection::ParticleArraysSOA soa(
+    vtkm::cont::make_ArrayHandle(points, vtkm::CopyFlag::On));
+  vtkm::cont::ArrayHandle<vtkm::Particle> particles;
+  soa.CopyTo(particles);
+  auto portal = particles.ReadPortal();
+  for (vtkm::Id i = 0; i < particles.GetNumberOfValues(); i++)
+  {
+    vtkm::Particle p = portal.Get(i);
+    VTKM_TEST_ASSERT(p.Pos == points[static_cast<std::size_t>(i)], "Wrong SOA position");
+    VTKM_TEST_ASSERT(p.ID == i && p.NumSteps == 0 && p.Time == 0 && p.Status.CheckOk(),
+                     "Wrong initial SOA particle");
+  }
+}
+
 template <class ResultType>
 void ValidateResult(const ResultType& res,
                     vtkm::Id maxSteps,
@@ -882,12 +1070,14 @@ void TestParticleAdvectionFile(const std::string& fname,
 void TestParticleAdvection()
 {
   TestIntegrators();
+  TestAdaptiveIntegrator();
   TestEvaluators();
   TestGhostCellEvaluators();
 
   TestParticleStatus();
   TestWorkletsBasic();
   TestParticleWorkletsWithDataSetTypes();
+  TestParticleWorkletsSOA();
 
   //Fusion test.
   std::vector<vtkm::Vec3f> fusionPts, fusionEndPts;